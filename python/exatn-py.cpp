@@ -183,6 +183,10 @@ py::class_<exatn::numerics::TensorExpansion,
       .value("float64", exatn::TensorElementType::REAL64, "")
       .value("complex32", exatn::TensorElementType::COMPLEX32, "")
       .value("complex64", exatn::TensorElementType::COMPLEX64, "")
+      .value("float16", exatn::TensorElementType::REAL16, "")
+      .value("bfloat16", exatn::TensorElementType::REALBF16, "")
+      .value("complex16", exatn::TensorElementType::COMPLEX16, "")
+      .value("complexbf16", exatn::TensorElementType::COMPLEXBF16, "")
       .value("complex", exatn::TensorElementType::COMPLEX64, "")
       .value("float", exatn::TensorElementType::REAL64, "");
 
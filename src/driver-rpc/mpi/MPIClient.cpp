@@ -1,5 +1,7 @@
 #include "MPIClient.hpp"
 
+#include <string>
+
 namespace exatn {
 namespace rpc {
 namespace mpi {
@@ -8,6 +10,12 @@ int MPIClient::SENDTAPROL_TAG = 0;
 int MPIClient::REGISTER_TENSORMETHOD = 1;
 int MPIClient::SYNC_TAG = 2;
 int MPIClient::SHUTDOWN_TAG = 3;
+int MPIClient::REGISTER_EXTDATA = 4;
+int MPIClient::EXTDATA_CHUNK_TAG = 5;
+int MPIClient::RESULTS_TAG = 6;
+int MPIClient::JOB_FAILED_TAG = 7;
+
+constexpr std::size_t MPIClient::EXTDATA_CHUNK_SIZE;
 
 void MPIClient::connect() {
   char portName[MPI_MAX_PORT_NAME];
@@ -27,23 +35,45 @@ void MPIClient::connect() {
 
 }
 
+void MPIClient::progressTransfers(bool wait) {
+
+  auto transfer = dataTransfers.begin();
+  while (transfer != dataTransfers.end()) {
+    int done = 0;
+    auto & chunkRequests = transfer->first;
+    if (wait) {
+      MPI_Waitall(chunkRequests.size(), chunkRequests.data(), MPI_STATUSES_IGNORE);
+      done = 1;
+    } else {
+      MPI_Testall(chunkRequests.size(), chunkRequests.data(), &done, MPI_STATUSES_IGNORE);
+    }
+    if (done) {
+      transfer = dataTransfers.erase(transfer);
+    } else {
+      ++transfer;
+    }
+  }
+  return;
+}
+
 void MPIClient::registerTensorMethod(const std::string& varName, talsh::TensorFunctor<exatn::Identifiable>& method) {
 
   if (!connected) connect();
 
-//  char buf[1];
-  auto name = method.name();
-  std::cout << "[mpi-client] Sending TensorFunctor " << name << " to remote server.\n";
-  MPI_Send(name.c_str(), name.size(), MPI_CHAR, 0, REGISTER_TENSORMETHOD, serverComm);
-
-//  MPI_Send(buf, 1, MPI_CHAR, 0, REGISTER_TENSORMETHOD, serverComm);
-
   BytePacket packet;
   initBytePacket(&packet);
   method.pack(packet);
 
-  std::cout << "[mpi-client] Sending TensorFunctor data to remote server.\n";
-  MPI_Send(packet.base_addr, packet.size_bytes, MPI_BYTE, 0, 0, serverComm);
+  // Message: tensor method name '\0' packed tensor method
+  auto name = method.name();
+  std::vector<char> message(name.begin(), name.end());
+  message.emplace_back('\0');
+  message.insert(message.end(), static_cast<char*>(packet.base_addr),
+                 static_cast<char*>(packet.base_addr) + packet.size_bytes);
+  destroyBytePacket(&packet);
+
+  std::cout << "[mpi-client] Sending TensorFunctor " << name << " to remote server.\n";
+  MPI_Send(message.data(), message.size(), MPI_BYTE, 0, REGISTER_TENSORMETHOD, serverComm);
 
   return;
 }
@@ -51,12 +81,26 @@ void MPIClient::registerTensorMethod(const std::string& varName, talsh::TensorFu
 void MPIClient::registerExternalData(const std::string& name, BytePacket& packet) {
 
   if (!connected) connect();
+  progressTransfers();
 
+  // Header message: external data name '\n' total size in bytes
   std::cout << "[mpi-client] Sending External Data ID " << name << " to remote server.\n";
-  //MPI_Send(name.c_str(), name.size(), MPI_CHAR, 0, REGISTER_EXTDATA, serverComm);
+  const std::string header = name + "\n" + std::to_string(packet.size_bytes);
+  MPI_Send(header.c_str(), header.size(), MPI_BYTE, 0, REGISTER_EXTDATA, serverComm);
 
+  // The data itself is copied and sent asynchronously in chunks:
   std::cout << "[mpi-client] Sending External Data to remote server.\n";
-  //MPI_Send(packet.base_addr, packet.size_bytes, MPI_BYTE, 0, 0, serverComm);
+  dataTransfers.emplace_back(std::make_pair(std::vector<MPI_Request>{},
+                             std::vector<char>(static_cast<char*>(packet.base_addr),
+                                               static_cast<char*>(packet.base_addr) + packet.size_bytes)));
+  auto & transfer = dataTransfers.back();
+  for (std::size_t offset = 0; offset < transfer.second.size(); offset += EXTDATA_CHUNK_SIZE) {
+    const auto chunkSize = std::min(EXTDATA_CHUNK_SIZE, transfer.second.size() - offset);
+    MPI_Request request;
+    MPI_Isend(transfer.second.data() + offset, chunkSize, MPI_BYTE, 0, EXTDATA_CHUNK_TAG,
+              serverComm, &request);
+    transfer.first.emplace_back(request);
+  }
 
   return;
 }
@@ -65,29 +109,22 @@ void MPIClient::registerExternalData(const std::string& name, BytePacket& packet
 const std::string MPIClient::interpretTAProL(const std::string& taProlStr) {
 
   if (!connected) connect();
+  progressTransfers();
 
   auto jobId = generateRandomString();
+  while (requests.find(jobId) != requests.end()) jobId = generateRandomString();
 
-  // Analyze the taProlStr to see how many GET commands there are
-  // and populate the jobId2NResults map
-  int nResults = 0;
-  auto position = taProlStr.find("save",0);
-  while (position != std::string::npos) {
-      nResults++;
-      position = taProlStr.find("save",position+1);
-  }
-  std::cout << "[mpi-client] This TAProL program produces " << nResults << " scalar results.\n";
-
-  jobId2NResults.insert({jobId, nResults});
-
-  // Asynchronously send the taProl string to the server
+  // Asynchronously send the job (jobId '\n' TAProL source) to the server,
+  // the message buffer must persist until the send completes
+  auto & message = messages[jobId];
+  message = jobId + "\n" + taProlStr;
   MPI_Request request;
   std::cout << "[mpi-client] sending request with jobid " << jobId << "\n";
-  MPI_Isend(taProlStr.c_str(), taProlStr.size(), MPI_CHAR, 0, SENDTAPROL_TAG, serverComm,
+  MPI_Isend(message.c_str(), message.size(), MPI_BYTE, 0, SENDTAPROL_TAG, serverComm,
             &request);
 
   // Store the request object for us to use
-  // later to wait on results in retrieveResult
+  // later to wait on results in getResults
   requests.insert({jobId, request});
 
   return jobId;
@@ -99,25 +136,35 @@ const std::vector<std::complex<double>> MPIClient::getResults(const std::string&
 
   if (!connected) connect();
 
-  auto request = requests[jobId];
-
-  MPI_Status status, status2;
-  MPI_Wait(&request, &status);
+  std::vector<std::complex<double>> results;
 
-  // now we know the execution has occurred,
-  // send a synchronize command to driver
-  // Tag of 1 == SYNCHRONIZE command
-  char buf[1];
-  MPI_Send(buf, 1, MPI_CHAR, 0, SYNC_TAG, serverComm);
+  auto iter = requests.find(jobId);
+  if (iter == requests.end()) {
+    std::cout << "#ERROR(exatn::rpc::mpi::MPIClient): Unknown job " << jobId << "\n";
+    return results;
+  }
+  MPI_Wait(&(iter->second), MPI_STATUS_IGNORE);
+  requests.erase(iter);
+  messages.erase(jobId);
 
-  // now get all the results
+  // Ask the server for the results of the job,
+  // it will answer once the job has been executed
+  MPI_Send(jobId.c_str(), jobId.size(), MPI_BYTE, 0, SYNC_TAG, serverComm);
 
-  std::vector<std::complex<double>> results;
-  for (int k = 0; k < jobId2NResults[jobId]; k++) {
-    double r, i;
-    MPI_Recv(&r, 1, MPI_DOUBLE, MPI_ANY_SOURCE, MPI_ANY_TAG, serverComm, &status2);
-    MPI_Recv(&i, 1, MPI_DOUBLE, MPI_ANY_SOURCE, MPI_ANY_TAG, serverComm, &status2);
-    results.push_back(std::complex<double>(r,i));
+  // Results arrive as (real,imag) pairs of all saved scalars
+  MPI_Status status;
+  MPI_Probe(0, MPI_ANY_TAG, serverComm, &status);
+  int count;
+  MPI_Get_count(&status, MPI_DOUBLE, &count);
+  std::vector<double> values(count);
+  MPI_Recv(values.data(), count, MPI_DOUBLE, 0, status.MPI_TAG, serverComm, MPI_STATUS_IGNORE);
+
+  if (status.MPI_TAG == RESULTS_TAG) {
+    for (int k = 0; k + 1 < count; k += 2) {
+      results.push_back(std::complex<double>(values[k], values[k+1]));
+    }
+  } else {
+    std::cout << "#ERROR(exatn::rpc::mpi::MPIClient): Job " << jobId << " failed on the server\n";
   }
   return results;
 }
@@ -125,11 +172,17 @@ const std::vector<std::complex<double>> MPIClient::getResults(const std::string&
 void MPIClient::shutdown() {
   if (!connected) connect();
 
+  // Complete all outstanding sends first
+  progressTransfers(true);
+  for (auto & request : requests) MPI_Wait(&(request.second), MPI_STATUS_IGNORE);
+  requests.clear();
+  messages.clear();
+
   char buf[1];
   MPI_Request request;
   std::cout << "[mpi-client] sending shutdown.\n";
   // Tag of 2 == SHUTDOWN command
-  MPI_Isend(buf, 1, MPI_CHAR, 0, SHUTDOWN_TAG, serverComm, &request);
+  MPI_Isend(buf, 1, MPI_BYTE, 0, SHUTDOWN_TAG, serverComm, &request);
    MPI_Status status;
    std::cout << "[mpi-client] waiting for shutdown.\n";
   MPI_Wait(&request, &status);
@@ -7,6 +7,8 @@
 #include <algorithm>
 #include <functional>
 #include <map>
+#include <list>
+#include <vector>
 #include <iostream>
 
 namespace exatn {
@@ -32,28 +34,39 @@ private:
 
 protected:
 
+  // External data is sent in chunks of this size (bytes):
+  static constexpr std::size_t EXTDATA_CHUNK_SIZE = 64 * 1024 * 1024;
+
   MPI_Comm serverComm;
-  std::map<std::string, MPI_Request> requests;
-  std::map<std::string, int> jobId2NResults;
-  std::vector<std::complex<double>> results;
+  std::map<std::string, MPI_Request> requests;   // in-flight jobs: jobId --> send request
+  std::map<std::string, std::string> messages;   // in-flight jobs: jobId --> message buffer
+  std::list<std::pair<std::vector<MPI_Request>, std::vector<char>>> dataTransfers; // in-flight external data
 
   static int SYNC_TAG;
   static int SHUTDOWN_TAG;
   static int SENDTAPROL_TAG;
   static int REGISTER_TENSORMETHOD;
+  static int REGISTER_EXTDATA;
+  static int EXTDATA_CHUNK_TAG;
+  static int RESULTS_TAG;
+  static int JOB_FAILED_TAG;
 
   bool connected = false;
   void connect();
+  // Releases the buffers of completed external data transfers.
+  void progressTransfers(bool wait = false);
 
 public:
 
   MPIClient() = default;
 
   // Send TAProL code, get a jobId string, so this is a non-blocking asynchronous call.
+  // Any number of jobs may be in flight; the server executes them in submission order.
   const std::string interpretTAProL(const std::string& taProlStr) override;
 
-  // Retrieve results of a TAProL job with given jobId.
-  // Currently retrieves saved complex<double> scalars.
+  // Retrieve results of a TAProL job with given jobId, blocking until the job has been executed.
+  // Currently retrieves saved complex<double> scalars in the order of the save statements
+  // (empty if the job failed).
   const std::vector<std::complex<double>> getResults(const std::string& jobId) override;
 
   // Register an external tensor method, a subclass of TensorFunctor class
@@ -64,6 +77,8 @@ public:
 
   // Register external data under some symbolic name. This data will be accessible
   // in TAProL text. It can be used to define tensor dimensions dynamically, for example.
+  // The data is copied and sent asynchronously in chunks; it becomes available
+  // to all jobs submitted after this call.
   void registerExternalData(const std::string& name, BytePacket& packet) override;
 
   // Shut down MPIClient.
@@ -1,7 +1,9 @@
 #include "MPIServer.hpp"
 #include "exatn.hpp"
 
-#include <future>
+#include <thread>
+#include <chrono>
+#include <algorithm>
 
 namespace exatn {
 namespace rpc {
@@ -11,24 +13,20 @@ int MPIServer::SENDTAPROL_TAG = 0;
 int MPIServer::REGISTER_TENSORMETHOD = 1;
 int MPIServer::SYNC_TAG = 2;
 int MPIServer::SHUTDOWN_TAG = 3;
+int MPIServer::REGISTER_EXTDATA = 4;
+int MPIServer::EXTDATA_CHUNK_TAG = 5;
+int MPIServer::RESULTS_TAG = 6;
+int MPIServer::JOB_FAILED_TAG = 7;
 
 void MPIServer::start() {
 
   parser = std::make_shared<exatn::parser::TAProLInterpreter>();
-  // FIXME Provide hook for specifying this at runtime
-//   backend = exatn::getService<exatn::numerics::Backend>("talsh");
-
-//   backend->initialize();
 
   listen = true;
 
-  MPI_Comm client;
-  MPI_Status status;
-
   int size;
   MPI_Comm_size(MPI_COMM_WORLD, &size);
 
-  char buf[1000];
   char portName[MPI_MAX_PORT_NAME];
 
   MPI_Open_port(MPI_INFO_NULL, portName);
@@ -36,102 +34,206 @@ void MPIServer::start() {
 
   MPI_Send(portName, MPI_MAX_PORT_NAME, MPI_CHAR, 1, 0, MPI_COMM_WORLD);
   MPI_Comm_accept(portName, MPI_INFO_NULL, 0, MPI_COMM_SELF, &client);
+  std::cout << "[mpi-server] accepted incoming connection, listening for requests.\n";
 
   while (listen) {
-    std::cout << "[mpi-server] accepting incoming connection.\n";
-
-    std::cout << "[mpi-server] Listening for requests.\n";
-    std::cout << "[mpi-server] Running MPI_Recv.\n";
-
-    int messageLength;
+    bool busy = receiveMessages();
+    busy = progressTransfers() || busy;
+    busy = executeJob() || busy;
+    busy = answerResultRequests() || busy;
+    // Do not spin while the client is quiet:
+    if (!busy) std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
 
-    MPI_Recv(buf, 1000, MPI_CHAR, MPI_ANY_SOURCE, MPI_ANY_TAG, client, &status);
-    MPI_Get_count(&status, MPI_CHAR, &messageLength);
-    buf[messageLength] = '\0';
+  std::cout << "[mpi-server] Out of event loop.\n";
+  for (auto & transfer : transfers) {
+    MPI_Waitall(transfer.requests.size(), transfer.requests.data(), MPI_STATUSES_IGNORE);
+  }
+  progressTransfers();
+  if (!jobs.empty()) {
+    std::cout << "[mpi-server] Finishing " << jobs.size() << " remaining jobs.\n";
+    while (!jobs.empty()) executeJob();
+  }
+  MPI_Comm_disconnect(&client);
+  return;
+}
 
-    std::cout << "[mpi-server] received: " << std::string(buf) << "\n";
+bool MPIServer::receiveMessages() {
 
-    if (status.MPI_TAG == SYNC_TAG) {
+  bool received = false;
+  int flag = 1;
+  while (listen && flag) {
+    MPI_Status status;
+    MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, client, &flag, &status);
+    if (!flag) break;
+    received = true;
 
-      // ExaTensor SYNCHRONIZE commands
-      std::cout << "[mpi-server] synchronizing!\n";
+    int messageLength;
+    MPI_Get_count(&status, MPI_BYTE, &messageLength);
+
+    if (status.MPI_TAG == EXTDATA_CHUNK_TAG) {
+
+      // External data chunks are received directly into the packet
+      // of the oldest transfer which has not been fully posted yet:
+      auto transfer = transfers.begin();
+      while (transfer != transfers.end() && transfer->posted >= transfer->size) ++transfer;
+      assert(transfer != transfers.end());
+      assert(transfer->posted + messageLength <= transfer->size);
+      MPI_Request request;
+      MPI_Irecv(static_cast<char*>(transfer->packet->base_addr) + transfer->posted, messageLength,
+                MPI_BYTE, status.MPI_SOURCE, EXTDATA_CHUNK_TAG, client, &request);
+      transfer->requests.emplace_back(request);
+      transfer->posted += messageLength;
+      continue;
+    }
 
-      // FIXME SYNCHRONIZE TALSH/EXATENSOR
-    //   parser->numerics_server->synchronize();
+    std::vector<char> buf(messageLength + 1);
+    MPI_Recv(buf.data(), messageLength, MPI_BYTE, status.MPI_SOURCE, status.MPI_TAG, client, MPI_STATUS_IGNORE);
+    buf[messageLength] = '\0';
 
-      // Now take the results and execute an
-      // asynchronous Isend back to the client rank 0
-      for (int i = 0; i < nResults; i++) {
-        MPI_Request request;
-        std::cout << "[mpi-server] processed taprol, returning result.\n";
+    if (status.MPI_TAG == SENDTAPROL_TAG) {
 
-        // We have a set of results for each GET in the
-        // TAPROL program, so now lets send them
-        // to the client as (real,imag) complex numbers
-        // FIXME assuming 1 value right now
-        double real = (i+1)*3.3;
-        double imag = (i+1)*3.3;
+      // Message: jobId '\n' TAProL source
+      std::string message(buf.data(), messageLength);
+      auto separator = message.find('\n');
+      assert(separator != std::string::npos);
+      Job job{message.substr(0, separator), message.substr(separator + 1), numTransfers};
+      std::cout << "[mpi-server] Queued job " << job.id << " (" << jobs.size() << " jobs ahead).\n";
+      jobs.emplace_back(std::move(job));
 
-        MPI_Isend(&real, 1, MPI_DOUBLE, 0, 0, client, &request);
-        MPI_Isend(&imag, 1, MPI_DOUBLE, 0, 0, client, &request);
-      }
+    } else if (status.MPI_TAG == SYNC_TAG) {
 
-      nResults = 0;
+      std::string jobId(buf.data(), messageLength);
+      std::cout << "[mpi-server] Results requested for job " << jobId << ".\n";
+      resultRequests.emplace_back(jobId);
 
     } else if (status.MPI_TAG == SHUTDOWN_TAG) {
 
       std::cout << "[mpi-server] received stop command\n";
       stop();
 
-    } else if (status.MPI_TAG == SENDTAPROL_TAG) {
-
-      std::cout << "[mpi-server] Executing taprol commands.\n";
-
-      std::string taProlProg(buf);
-      auto position = taProlProg.find("save", 0);
-      while (position != std::string::npos) {
-        nResults++;
-        position = taProlProg.find("save", position + 1);
-      }
-
-      std::cout << "[mpi-server] Found " << nResults << " save calls.\n";
-
-      // FIXME with DMITRY:
-      // Execute the TAPROL with our Numerics backend
-    //   backend->execute(taProlProg);
-      parser->interpret(taProlProg);
-
     } else if (status.MPI_TAG == REGISTER_TENSORMETHOD) {
 
-        std::string tmName(buf);
+      // Message: tensor method name '\0' packed tensor method
+      std::string tmName(buf.data());
+      std::cout << "[mpi-server] Registering tensor method " << tmName << ".\n";
+
+      BytePacket packet;
+      initBytePacket(&packet);
+      const std::size_t dataLength = messageLength - (tmName.length() + 1);
+      assert(dataLength <= packet.capacity);
+      std::copy(buf.data() + tmName.length() + 1, buf.data() + messageLength,
+                static_cast<char*>(packet.base_addr));
+      packet.size_bytes = dataLength;
+
+      auto tensor_method = exatn::getService<talsh::TensorFunctor<Identifiable>>(tmName);
+      tensor_method->unpack(packet);
+      exatn::numericalServer->registerTensorMethod(tensor_method->name(),tensor_method);
+      destroyBytePacket(&packet);
+
+      std::cout << "[mpi-server] Successfully created tensor method, added to backend.\n";
+
+    } else if (status.MPI_TAG == REGISTER_EXTDATA) {
+
+      // Message: external data name '\n' total size in bytes
+      std::string message(buf.data(), messageLength);
+      auto separator = message.find('\n');
+      assert(separator != std::string::npos);
+      const std::size_t dataSize = std::stoull(message.substr(separator + 1));
+      std::shared_ptr<BytePacket> packet(new BytePacket, [](BytePacket * packet) {
+        destroyBytePacket(packet);
+        delete packet;
+      });
+      initBytePacket(packet.get(), std::max(dataSize, std::size_t{1}));
+      transfers.emplace_back(Transfer{numTransfers++, message.substr(0, separator), packet,
+                                      dataSize, 0, std::vector<MPI_Request>{}});
+      std::cout << "[mpi-server] Receiving external data " << transfers.back().name
+                << " (" << dataSize << " bytes).\n";
+    }
+  }
+  return received;
+}
 
-        std::cout << "[mpi-server] Registering tensor method " << tmName << ".\n";
+bool MPIServer::progressTransfers() {
 
-        MPI_Status status;
-        BytePacket packet;
-        int count;
-        initBytePacket(&packet);
-        MPI_Recv(packet.base_addr, packet.capacity, MPI_BYTE, 0, 0, client, &status);
-        MPI_Get_count(&status, MPI_BYTE, &count);
-        packet.size_bytes = count;
+  bool progressed = false;
+  auto transfer = transfers.begin();
+  while (transfer != transfers.end()) {
+    int done = 0;
+    if (transfer->posted >= transfer->size) {
+      MPI_Testall(transfer->requests.size(), transfer->requests.data(), &done, MPI_STATUSES_IGNORE);
+    }
+    if (done) {
+      transfer->packet->size_bytes = transfer->size;
+      if (exatn::numericalServer->getExternalData(transfer->name)) {
+        std::cout << "#ERROR(exatn::rpc::mpi::MPIServer): External data already exists: "
+                  << transfer->name << ", discarding new data.\n";
+      } else {
+        exatn::numericalServer->registerExternalData(transfer->name, transfer->packet);
+        std::cout << "[mpi-server] Registered external data " << transfer->name << ".\n";
+      }
+      transfer = transfers.erase(transfer);
+      progressed = true;
+    } else {
+      ++transfer;
+    }
+  }
+  return progressed;
+}
 
-        auto tensor_method = exatn::getService<talsh::TensorFunctor<Identifiable>>(tmName);
-        tensor_method->unpack(packet);
-        exatn::numericalServer->registerTensorMethod(tensor_method->name(),tensor_method);
+bool MPIServer::executeJob() {
 
-        std::cout << "[mpi-server] Successfully created tensor method, added to backend.\n";
+  if (jobs.empty()) return false;
+  // The job may use any external data registered before it:
+  auto & job = jobs.front();
+  if (!transfers.empty() && transfers.front().id < job.dataEpoch) return false;
 
-    }
+  std::cout << "[mpi-server] Executing job " << job.id << ".\n";
+  std::vector<std::pair<std::string, std::complex<double>>> saved;
+  JobResults results;
+  results.success = parser->execute(job.source, saved);
+  for (const auto & result : saved) {
+    results.values.emplace_back(std::real(result.second));
+    results.values.emplace_back(std::imag(result.second));
   }
+  std::cout << "[mpi-server] Job " << job.id << (results.success ? " completed with " : " failed with ")
+            << saved.size() << " saved scalars.\n";
+  completed.emplace(std::make_pair(job.id, std::move(results)));
+  jobs.pop_front();
+  return true;
+}
 
-  std::cout << "[mpi-server] Out of event loop.\n";
-  MPI_Comm_disconnect(&client);
-//   backend->shutdown();
-  return;
+bool MPIServer::answerResultRequests() {
+
+  bool answered = false;
+  while (!resultRequests.empty()) {
+    const auto & jobId = resultRequests.front();
+    auto iter = completed.find(jobId);
+    if (iter == completed.end()) {
+      // The job may still be queued; otherwise it is unknown:
+      bool queued = false;
+      for (const auto & job : jobs) {
+        if (job.id == jobId) { queued = true; break; }
+      }
+      if (queued) break;
+      std::cout << "#ERROR(exatn::rpc::mpi::MPIServer): Unknown job " << jobId << ".\n";
+      MPI_Send(nullptr, 0, MPI_DOUBLE, 0, JOB_FAILED_TAG, client);
+    } else {
+      // Send all saved scalars of the job to the client as (real,imag) pairs:
+      const auto & results = iter->second;
+      std::cout << "[mpi-server] Returning results of job " << jobId << ".\n";
+      MPI_Send(results.values.data(), results.values.size(), MPI_DOUBLE, 0,
+               results.success ? RESULTS_TAG : JOB_FAILED_TAG, client);
+      completed.erase(iter);
+    }
+    resultRequests.pop_front();
+    answered = true;
+  }
+  return answered;
 }
 
 void MPIServer::stop() { listen = false; }
 
 } // namespace mpi
 } // namespace rpc
-} // namespace exatn
\ No newline at end of file
+} // namespace exatn
@@ -6,24 +6,78 @@
 
 #include <string>
 #include <memory>
+#include <vector>
+#include <deque>
+#include <list>
+#include <map>
 
 namespace exatn {
 namespace rpc {
 namespace mpi {
+
+// The MPIServer event loop never blocks on the client: It polls for incoming
+// messages (MPI_Iprobe), receives bulk external data chunks directly into
+// their destination packets (MPI_Irecv), and executes the queued TAProL jobs
+// one at a time in between, each job within its own numerical server scope(s).
+// A job is only started once all external data registered before it has arrived.
+// The results of a job (its saved scalars) are kept until the client requests them.
 class MPIServer : public DriverServer {
 
 protected:
+
+  // A queued TAProL job:
+  struct Job {
+    std::string id;          // job id
+    std::string source;      // TAProL source
+    std::size_t dataEpoch;   // number of external data transfers begun before the job arrived
+  };
+
+  // Results of a completed TAProL job:
+  struct JobResults {
+    bool success;                 // whether the job succeeded
+    std::vector<double> values;   // saved scalars as (real,imag) pairs
+  };
+
+  // An external data transfer in progress:
+  struct Transfer {
+    std::size_t id;                       // transfer sequence number
+    std::string name;                     // external data name
+    std::shared_ptr<BytePacket> packet;   // destination packet
+    std::size_t size;                     // total size in bytes
+    std::size_t posted;                   // number of bytes for which receives have been posted
+    std::vector<MPI_Request> requests;    // pending chunk receives
+  };
+
   bool listen = false;
-  int nResults = 0;
   static int SYNC_TAG;
   static int SHUTDOWN_TAG;
   static int SENDTAPROL_TAG;
   static int REGISTER_TENSORMETHOD;
+  static int REGISTER_EXTDATA;
+  static int EXTDATA_CHUNK_TAG;
+  static int RESULTS_TAG;
+  static int JOB_FAILED_TAG;
 
   std::string portName = "exatn-mpi-driver";
 
   std::map<std::string, std::shared_ptr<talsh::TensorFunctor<Identifiable>>> registeredTensorMethods;
 
+  MPI_Comm client;
+  std::deque<Job> jobs;                          // queued jobs in arrival order
+  std::map<std::string, JobResults> completed;   // completed jobs whose results have not been requested yet
+  std::deque<std::string> resultRequests;        // jobs whose results were requested, in request order
+  std::list<Transfer> transfers;                 // external data transfers in progress
+  std::size_t numTransfers = 0;                  // number of external data transfers begun
+
+  // Receives all arrived messages without blocking, returns TRUE if any.
+  bool receiveMessages();
+  // Completes the arrived external data transfers, returns TRUE if any.
+  bool progressTransfers();
+  // Executes the next queued job if its data is available, returns TRUE if any.
+  bool executeJob();
+  // Answers the result requests for completed jobs in request order, returns TRUE if any.
+  bool answerResultRequests();
+
 public:
   MPIServer() : DriverServer() {}
 
@@ -5,15 +5,16 @@
 
 using namespace exatn::rpc;
 
+// The upper bound "dim" of subspace s0 is registered as external data
 const std::string src = R"src(
 entry: main
 scope main group()
- subspace(): s0=[0:127]
+ subspace(): s0=[0:dim]
  index(s0): a,b,c,d,i,j,k,l
  H2(a,b,c,d) = method("HamiltonianTest")
- T2(a,b,c,d) = {1.0,0.0}
+ T2(a,b,c,d) = {0.5,0.0}
  Z2(a,b,c,d) = {0.0,0.0}
- Z2(a,b,c,d) += H2(i,j,k,l) * T2(c,d,i,j) * T2(a,b,k,l)
+ Z2(a,b,c,d) += T2(i,j,a,b) * T2(c,d,i,j)
  X2() = {0.0,0.0}
  X2() += Z2+(a,b,c,d) * Z2(a,b,c,d)
  save X2: tag("Z2_norm")
@@ -40,26 +41,40 @@ TEST(client_test, checkSimple) {
   auto client = exatn::getService<DriverClient>("mpi");
   client->registerTensorMethod("test", *tm.get());
 
-  // Send some taprol asynchronously, here its just
-  // a test so just send any string
+  // Register the subspace bound used by the TAProL source
+  BytePacket dim;
+  initBytePacket(&dim);
+  appendToBytePacket(&dim, exatn::DimOffset{7});
+  client->registerExternalData("dim", dim);
+  destroyBytePacket(&dim);
+
+  // Send some taprol asynchronously
   auto jobId = client->interpretTAProL(src);
 
   std::cout << "[client.cpp] job-id = " << jobId << ".\n";
 
-  // Retrieve the result
+  // Retrieve the result: Z2 = 8*8 * 0.5^2 = 16 elementwise, X2 = 8^4 * 16^2
   auto values = client->getResults(jobId);
-  EXPECT_EQ(3.3, std::real(values[0]));
-  EXPECT_EQ(3.3, std::imag(values[0]));
+  ASSERT_EQ(1, values.size());
+  EXPECT_NEAR(1048576.0, std::real(values[0]), 1e-6);
+  EXPECT_NEAR(0.0, std::imag(values[0]), 1e-6);
 
   std::cout << "[client.cpp] value is " << std::real(values[0]) << ", " << std::imag(values[0]) << "\n";
 
-  // Try it again!
-  jobId = client->interpretTAProL(src);
-  values = client->getResults(jobId);
-
-  EXPECT_EQ(3.3, std::real(values[0]));
-  EXPECT_EQ(3.3, std::imag(values[0]));
-  std::cout << "[client.cpp] value second time is " << std::real(values[0]) << ", " << std::imag(values[0]) << "\n";
+  // Now keep several jobs in flight at once
+  auto src2 = src;
+  src2.replace(src2.find("{0.5,0.0}"), 9, "{1.0,0.0}");
+  std::vector<std::string> jobIds;
+  for (int i = 0; i < 4; ++i) jobIds.emplace_back(client->interpretTAProL((i % 2 == 0) ? src : src2));
+  for (int i = 0; i < 4; ++i) {
+    values = client->getResults(jobIds[i]);
+    ASSERT_EQ(1, values.size());
+    EXPECT_NEAR((i % 2 == 0) ? 1048576.0 : 16777216.0, std::real(values[0]), 1e-6);
+  }
+
+  // Results can only be retrieved once
+  values = client->getResults(jobIds[0]);
+  EXPECT_TRUE(values.empty());
 
   // Shutdown the client, this
   // also tells the server to shutdown.
@@ -0,0 +1,76 @@
+#include "DriverClient.hpp"
+#include "exatn.hpp"
+#include "mpi.h"
+
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace exatn::rpc;
+
+// Small TAProL job: X2 = 16^4 * (16^2 * 0.5^2)^2
+const std::string src = R"src(
+entry: main
+scope main group()
+ subspace(): s1=[0:15]
+ index(s1): a,b,c,d,i,j
+ T2(a,b,c,d) = {0.5,0.0}
+ Z2(a,b,c,d) = {0.0,0.0}
+ Z2(a,b,c,d) += T2(a,b,i,j) * T2(i,j,c,d)
+ X2() = {0.0,0.0}
+ X2() += Z2+(a,b,c,d) * Z2(a,b,c,d)
+ save X2: tag("Z2_norm")
+ ~X2
+ ~Z2
+ ~T2
+end scope main
+)src";
+
+// Measures the job throughput of the driver with a single job in flight
+// (submit, then retrieve) versus all jobs in flight (submit all, then retrieve all).
+// Usage: mpirun -np 1 server_test : -np 1 throughput_test [number of jobs]
+int main(int argc, char** argv) {
+
+  MPI_Init(&argc, &argv);
+  exatn::initialize();
+
+  const int numJobs = (argc > 1) ? std::stoi(argv[1]) : 64;
+  const double expected = 65536.0 * 4096.0;
+  int numErrors = 0;
+
+  auto client = exatn::getService<DriverClient>("mpi");
+
+  // One job in flight:
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < numJobs; ++i) {
+    auto jobId = client->interpretTAProL(src);
+    auto results = client->getResults(jobId);
+    if (results.size() != 1 || std::abs(std::real(results[0]) - expected) > 1e-9 * expected) ++numErrors;
+  }
+  std::chrono::duration<double> seqTime = std::chrono::high_resolution_clock::now() - start;
+
+  // All jobs in flight:
+  start = std::chrono::high_resolution_clock::now();
+  std::vector<std::string> jobIds;
+  for (int i = 0; i < numJobs; ++i) jobIds.emplace_back(client->interpretTAProL(src));
+  for (const auto & jobId : jobIds) {
+    auto results = client->getResults(jobId);
+    if (results.size() != 1 || std::abs(std::real(results[0]) - expected) > 1e-9 * expected) ++numErrors;
+  }
+  std::chrono::duration<double> pipeTime = std::chrono::high_resolution_clock::now() - start;
+
+  std::cout << "[throughput.cpp] " << numJobs << " jobs, one in flight: " << seqTime.count()
+            << " s (" << numJobs / seqTime.count() << " jobs/s)\n";
+  std::cout << "[throughput.cpp] " << numJobs << " jobs, all in flight: " << pipeTime.count()
+            << " s (" << numJobs / pipeTime.count() << " jobs/s)\n";
+  std::cout << "[throughput.cpp] " << numErrors << " jobs returned wrong results\n";
+
+  client->shutdown();
+
+  exatn::finalize();
+  MPI_Finalize();
+  return (numErrors == 0) ? 0 : 1;
+}
@@ -1,5 +1,5 @@
 /** ExaTN::Numerics: General client header
-REVISION: 2020/11/11
+REVISION: 2020/12/14
 
 Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
@@ -93,6 +93,28 @@ inline ScopeId closeScope()
  {return numericalServer->closeScope();}
 
 
+/** Pauses the execution of the currently open TAProL scope until it is resumed
+    upon closing its child scope. Tensor operations of the paused scope which
+    conflict with tensor operations submitted into other scopes are still executed. **/
+inline void pauseScope()
+ {return numericalServer->pauseScope();}
+
+
+/** Sets the fair-share priority (default 1) of an open TAProL scope.
+    Open scopes are executed concurrently, issuing tensor operations
+    in proportion to their priorities. **/
+inline void setScopePriority(const std::string & scope_name, //in: open scope name
+                             unsigned int priority)          //in: scope priority (>0)
+ {return numericalServer->setScopePriority(scope_name,priority);}
+
+
+/** Retrieves the execution progress (number of submitted/executed tensor operations,
+    elapsed time, throughput) of an open TAProL scope. **/
+inline bool getScopeProgress(const std::string & scope_name, //in: open scope name
+                             ScopeProgress & progress)       //out: execution progress of the scope
+ {return numericalServer->getScopeProgress(scope_name,progress);}
+
+
 /** Creates a named vector space, returns its registered id, and,
     optionally, a non-owning pointer to it. **/
 inline SpaceId createVectorSpace(const std::string & space_name,           //in: vector space name
@@ -100,6 +122,14 @@ inline SpaceId createVectorSpace(const std::string & space_name,           //in:
                                  const VectorSpace ** space_ptr = nullptr) //out: non-owning pointer to the created vector space
  {return numericalServer->createVectorSpace(space_name,space_dim,space_ptr);}
 
+/** Creates a named vector space with symmetry subranges, returns its registered id,
+    and, optionally, a non-owning pointer to it (see numerics::BlockSparseTensor). **/
+inline SpaceId createVectorSpace(const std::string & space_name,                        //in: vector space name
+                                 DimExtent space_dim,                                   //in: vector space dimension
+                                 const std::vector<SymmetryRange> & symmetry_subranges, //in: symmetry subranges
+                                 const VectorSpace ** space_ptr = nullptr)              //out: non-owning pointer to the created vector space
+ {return numericalServer->createVectorSpace(space_name,space_dim,symmetry_subranges,space_ptr);}
+
 
 /** Destroys a previously created named vector space. **/
 inline void destroyVectorSpace(const std::string & space_name) //in: name of the vector space to destroy
@@ -109,6 +139,12 @@ inline void destroyVectorSpace(SpaceId space_id) //in: id of the vector space to
  {return numericalServer->destroyVectorSpace(space_id);}
 
 
+/** Returns a non-owning pointer to a previosuly registered vector space,
+    including the anonymous vector space. Returns nullptr if not found. **/
+inline const VectorSpace * getVectorSpace(const std::string & space_name) //in: name of the vector space to get
+ {return numericalServer->getVectorSpace(space_name);}
+
+
 /** Creates a named subspace of a named vector space,
     returns its registered id, and, optionally, a non-owning pointer to it. **/
 inline SubspaceId createSubspace(const std::string & subspace_name,           //in: subspace name
@@ -334,6 +370,14 @@ inline bool computeNorm2Sync(const std::string & name, //in: tensor name
  {return numericalServer->computeNorm2Sync(name,norm);}
 
 
+/** Computes 1-norm, 2-norm and max-abs norm of a tensor in a single pass. **/
+inline bool computeNormsSync(const std::string & name, //in: tensor name
+                             double & norm1,           //out: tensor 1-norm
+                             double & norm2,           //out: tensor 2-norm
+                             double & maxabs)          //out: tensor max-abs norm
+ {return numericalServer->computeNormsSync(name,norm1,norm2,maxabs);}
+
+
 /** Computes partial 2-norms over a chosen tensor dimension. **/
 inline bool computePartialNormsSync(const std::string & name,            //in: tensor name
                                     unsigned int tensor_dimension,       //in: chosen tensor dimension
@@ -483,6 +527,80 @@ inline bool contractTensorsSync(const std::string & contraction, //in: symbolic
  {return numericalServer->contractTensorsSync(contraction,alpha);}
 
 
+/** HANDLE-BASED API: Tensors are referenced directly by their shared pointers (handles)
+    obtained once via getTensor(), thus bypassing the name lookup. The tensor handle
+    must refer to a tensor that has been created and not yet destroyed. **/
+
+/** Initializes a tensor to some scalar value. **/
+template<typename NumericType>
+inline bool initTensor(std::shared_ptr<Tensor> tensor, //in: tensor handle
+                       NumericType value)              //in: scalar value
+ {return numericalServer->initTensor(tensor,value);}
+
+template<typename NumericType>
+inline bool initTensorSync(std::shared_ptr<Tensor> tensor, //in: tensor handle
+                           NumericType value)              //in: scalar value
+ {return numericalServer->initTensorSync(tensor,value);}
+
+
+/** Scales a tensor by a scalar value. **/
+template<typename NumericType>
+inline bool scaleTensor(std::shared_ptr<Tensor> tensor, //in: tensor handle
+                        NumericType value)              //in: scalar value
+ {return numericalServer->scaleTensor(tensor,value);}
+
+template<typename NumericType>
+inline bool scaleTensorSync(std::shared_ptr<Tensor> tensor, //in: tensor handle
+                            NumericType value)              //in: scalar value
+ {return numericalServer->scaleTensorSync(tensor,value);}
+
+
+/** Transforms (updates) a tensor according to a user-defined tensor functor. **/
+inline bool transformTensor(std::shared_ptr<Tensor> tensor,            //in: tensor handle
+                            std::shared_ptr<TensorMethod> functor)     //in: functor defining the tensor transformation
+ {return numericalServer->transformTensor(tensor,functor);}
+
+inline bool transformTensorSync(std::shared_ptr<Tensor> tensor,        //in: tensor handle
+                                std::shared_ptr<TensorMethod> functor) //in: functor defining the tensor transformation
+ {return numericalServer->transformTensorSync(tensor,functor);}
+
+
+/** Pre-parses a symbolic tensor addition specification, binds its tensor operands
+    and returns a reusable tensor operation template (nullptr on failure). **/
+inline std::shared_ptr<TensorOperation> prepareTensorAddition(const std::string & addition) //in: symbolic tensor addition specification
+ {return numericalServer->prepareTensorAddition(addition);}
+
+
+/** Pre-parses a symbolic tensor contraction specification, binds its tensor operands
+    and returns a reusable tensor operation template (nullptr on failure). **/
+inline std::shared_ptr<TensorOperation> prepareTensorContraction(const std::string & contraction) //in: symbolic tensor contraction specification
+ {return numericalServer->prepareTensorContraction(contraction);}
+
+
+/** Submits a fresh instance of a prepared tensor operation template with
+    a new alpha prefactor. No string parsing or name lookup is involved. **/
+template<typename NumericType>
+inline bool submitPrepared(const TensorOperation & op_template, //in: prepared tensor operation template
+                           NumericType alpha)                   //in: alpha prefactor
+ {return numericalServer->submitPrepared(op_template,alpha);}
+
+template<typename NumericType>
+inline bool submitPreparedSync(const TensorOperation & op_template, //in: prepared tensor operation template
+                               NumericType alpha)                   //in: alpha prefactor
+ {return numericalServer->submitPreparedSync(op_template,alpha);}
+
+
+/** Submits a list of prepared tensor contractions (see prepareTensorContraction) as batched
+    tensor operations: Tensor contractions with the same index pattern (up to tensor names
+    and index labels) and congruent tensor operands are grouped into a single runtime task
+    executed in a fused loop. **/
+inline bool contractTensorsBatch(const std::vector<std::shared_ptr<TensorOperation>> & contractions) //in: prepared tensor contractions
+ {return numericalServer->contractTensorsBatch(contractions);}
+
+inline bool contractTensorsBatchSync(const std::vector<std::shared_ptr<TensorOperation>> & contractions) //in: prepared tensor contractions
+ {return numericalServer->contractTensorsBatchSync(contractions);}
+
+
 /** Decomposes a tensor into three tensor factors via SVD. The symbolic
     tensor contraction specification specifies the decomposition,
     for example:
@@ -541,6 +659,51 @@ inline bool decomposeTensorSVDLRSync(const std::string & contraction) //in: two-
  {return numericalServer->decomposeTensorSVDLRSync(contraction);}
 
 
+/** Decomposes a tensor into three tensor factors via truncated SVD. The symbolic
+    tensor contraction specification specifies the decomposition with strictly
+    one contracted (bond) index, for example:
+     D(a,b,c,d,e) = L(c,i,e) * S(i) * R(b,a,i,d)
+    where
+     L(c,i,e) is the left SVD factor,
+     R(b,a,i,d) is the right SVD factor,
+     S(i) is the middle SVD factor (singular values).
+    Singular values beyond the max rank or not exceeding the cutoff are discarded.
+    The tensor factors are (re)created with the bond extent equal to the retained rank.
+    The truncation error is the Frobenius norm of the discarded part. **/
+inline bool decomposeTensorSVDTruncSync(const std::string & contraction,      //in: three-factor symbolic tensor contraction specification
+                                        std::size_t max_rank,                 //in: max retained rank (0: no limit)
+                                        double cutoff = 0.0,                  //in: singular value cutoff
+                                        double * truncation_error = nullptr)  //out: truncation error
+ {return numericalServer->decomposeTensorSVDTruncSync(contraction,max_rank,cutoff,truncation_error);}
+
+
+/** Decomposes a tensor into two tensor factors via truncated SVD,
+    with the singular values absorbed into the left factor. **/
+inline bool decomposeTensorSVDLTruncSync(const std::string & contraction,      //in: two-factor symbolic tensor contraction specification
+                                         std::size_t max_rank,                 //in: max retained rank (0: no limit)
+                                         double cutoff = 0.0,                  //in: singular value cutoff
+                                         double * truncation_error = nullptr)  //out: truncation error
+ {return numericalServer->decomposeTensorSVDLTruncSync(contraction,max_rank,cutoff,truncation_error);}
+
+
+/** Decomposes a tensor into two tensor factors via truncated SVD,
+    with the singular values absorbed into the right factor. **/
+inline bool decomposeTensorSVDRTruncSync(const std::string & contraction,      //in: two-factor symbolic tensor contraction specification
+                                         std::size_t max_rank,                 //in: max retained rank (0: no limit)
+                                         double cutoff = 0.0,                  //in: singular value cutoff
+                                         double * truncation_error = nullptr)  //out: truncation error
+ {return numericalServer->decomposeTensorSVDRTruncSync(contraction,max_rank,cutoff,truncation_error);}
+
+
+/** Decomposes a tensor into two tensor factors via truncated SVD, with the
+    square root of singular values absorbed into both left and right factors. **/
+inline bool decomposeTensorSVDLRTruncSync(const std::string & contraction,      //in: two-factor symbolic tensor contraction specification
+                                          std::size_t max_rank,                 //in: max retained rank (0: no limit)
+                                          double cutoff = 0.0,                  //in: singular value cutoff
+                                          double * truncation_error = nullptr)  //out: truncation error
+ {return numericalServer->decomposeTensorSVDLRTruncSync(contraction,max_rank,cutoff,truncation_error);}
+
+
 /** Orthogonalizes a tensor by decomposing it via SVD while discarding
     the middle tensor factor with singular values. The symbolic tensor contraction
     specification specifies the decomposition. It must contain strictly one contracted index. **/
@@ -612,6 +775,41 @@ inline bool evaluateSync(const ProcessGroup & process_group, //in: chosen group
   return success;}
 
 
+/** Evaluates a batch of tensor networks which differ from the given tensor network only
+    by substitution of its boundary input tensors (e.g., output projectors). The shared trunk,
+    chosen to fit in memory, is contracted once. The batch result tensor is created with the shape of the network output
+    tensor with one more (last) dimension enumerating the batch items. **/
+inline bool evaluateBatch(TensorNetwork & network,                       //in: finalized tensor network
+                          const std::vector<unsigned int> & boundary_ids, //in: ids of the boundary input tensors
+                          const std::vector<std::vector<std::shared_ptr<Tensor>>> & boundary_tensors, //in: boundary tensors for each batch item
+                          const std::string & result_name)              //in: name of the batch result tensor (to be created)
+ {return numericalServer->evaluateTensorNetworkBatch(network,boundary_ids,boundary_tensors,result_name);}
+
+inline bool evaluateBatchSync(TensorNetwork & network,                       //in: finalized tensor network
+                              const std::vector<unsigned int> & boundary_ids, //in: ids of the boundary input tensors
+                              const std::vector<std::vector<std::shared_ptr<Tensor>>> & boundary_tensors, //in: boundary tensors for each batch item
+                              const std::string & result_name)              //in: name of the batch result tensor (to be created)
+ {bool success = numericalServer->evaluateTensorNetworkBatch(network,boundary_ids,boundary_tensors,result_name);
+  if(success) success = numericalServer->sync(result_name);
+  return success;}
+
+inline bool evaluateBatch(const ProcessGroup & process_group,            //in: chosen group of MPI processes
+                          TensorNetwork & network,                       //in: finalized tensor network
+                          const std::vector<unsigned int> & boundary_ids, //in: ids of the boundary input tensors
+                          const std::vector<std::vector<std::shared_ptr<Tensor>>> & boundary_tensors, //in: boundary tensors for each batch item
+                          const std::string & result_name)              //in: name of the batch result tensor (to be created)
+ {return numericalServer->evaluateTensorNetworkBatch(process_group,network,boundary_ids,boundary_tensors,result_name);}
+
+inline bool evaluateBatchSync(const ProcessGroup & process_group,            //in: chosen group of MPI processes
+                              TensorNetwork & network,                       //in: finalized tensor network
+                              const std::vector<unsigned int> & boundary_ids, //in: ids of the boundary input tensors
+                              const std::vector<std::vector<std::shared_ptr<Tensor>>> & boundary_tensors, //in: boundary tensors for each batch item
+                              const std::string & result_name)              //in: name of the batch result tensor (to be created)
+ {bool success = numericalServer->evaluateTensorNetworkBatch(process_group,network,boundary_ids,boundary_tensors,result_name);
+  if(success) success = numericalServer->sync(process_group,result_name);
+  return success;}
+
+
 /** Synchronizes all outstanding operations on a given tensor network object.
     If ProcessGroup is not provided, defaults to the local process. **/
 inline bool sync(TensorNetwork & network, //in: finalized tensor network
@@ -672,6 +870,73 @@ inline bool sync(const ProcessGroup & process_group,  //in: chosen group of MPI
  {return numericalServer->sync(process_group,wait);}
 
 
+/** Declares, registers, and actually creates a block-sparse tensor via the processing backend,
+    that is, creates all its symmetry-allowed blocks (see numerics::BlockSparseTensor). **/
+inline bool createTensorBlockSparse(const std::string & name,                     //in: tensor name
+                                    TensorElementType element_type,               //in: tensor element type
+                                    const std::vector<std::string> & space_names, //in: vector space for each tensor dimension
+                                    const std::vector<LegDirection> & directions, //in: direction of each tensor dimension
+                                    SymmetryId total_symmetry = 0,                //in: total symmetry id of the tensor
+                                    SymmetryId modulus = 0)                       //in: symmetry modulus (0: U(1) symmetry)
+ {return numericalServer->createTensorBlockSparse(name,element_type,space_names,directions,total_symmetry,modulus);}
+
+
+/** Destroys a block-sparse tensor, including all its blocks. **/
+inline bool destroyTensorBlockSparse(const std::string & name) //in: tensor name
+ {return numericalServer->destroyTensorBlockSparse(name);}
+
+
+/** Returns the requested block-sparse tensor, or nullptr if not found. **/
+inline std::shared_ptr<BlockSparseTensor> getTensorBlockSparse(const std::string & name) //in: tensor name
+ {return numericalServer->getTensorBlockSparse(name);}
+
+
+/** Initializes all blocks of a block-sparse tensor to some scalar value. **/
+template<typename NumericType>
+inline bool initTensorBlockSparse(const std::string & name, //in: tensor name
+                                  NumericType value)        //in: scalar value
+ {return numericalServer->initTensorBlockSparse(name,value);}
+
+
+/** Initializes all blocks of a block-sparse tensor to some random value. **/
+inline bool initTensorRndBlockSparse(const std::string & name) //in: tensor name
+ {return numericalServer->initTensorRndBlockSparse(name);}
+
+
+/** Computes max-abs norm of a block-sparse tensor. **/
+inline bool computeMaxAbsBlockSparseSync(const std::string & name, //in: tensor name
+                                         double & norm)            //out: tensor norm
+ {return numericalServer->computeMaxAbsBlockSparseSync(name,norm);}
+
+
+/** Computes 1-norm of a block-sparse tensor. **/
+inline bool computeNorm1BlockSparseSync(const std::string & name, //in: tensor name
+                                        double & norm)            //out: tensor norm
+ {return numericalServer->computeNorm1BlockSparseSync(name,norm);}
+
+
+/** Computes 2-norm of a block-sparse tensor. **/
+inline bool computeNorm2BlockSparseSync(const std::string & name, //in: tensor name
+                                        double & norm)            //out: tensor norm
+ {return numericalServer->computeNorm2BlockSparseSync(name,norm);}
+
+
+/** Performs block-sparse tensor addition: tensor0 += tensor1 * alpha,
+    processing only the compatible block combinations. **/
+template<typename NumericType>
+inline bool addTensorsBlockSparse(const std::string & addition, //in: symbolic tensor addition specification
+                                  NumericType alpha)            //in: alpha prefactor
+ {return numericalServer->addTensorsBlockSparse(addition,alpha);}
+
+
+/** Performs block-sparse tensor contraction: tensor0 += tensor1 * tensor2 * alpha,
+    processing only the compatible block combinations. **/
+template<typename NumericType>
+inline bool contractTensorsBlockSparse(const std::string & contraction, //in: symbolic tensor contraction specification
+                                       NumericType alpha)               //in: alpha prefactor
+ {return numericalServer->contractTensorsBlockSparse(contraction,alpha);}
+
+
 /** Returns a locally stored tensor slice (talsh::Tensor) providing access to tensor elements.
     This slice will be extracted from the exatn::numerics::Tensor implementation as a copy.
     The returned future becomes ready once the execution thread has retrieved the slice copy. **/
@@ -720,6 +985,82 @@ inline void deactivateContrSeqCaching()
  {return numericalServer->deactivateContrSeqCaching();}
 
 
+/** Activates the mixed-precision evaluation of tensor networks: Intermediate
+    tensors are computed in the lower precision (REAL32/COMPLEX32) while input
+    and output tensors retain their own precision. **/
+inline void activateMixedPrecision()
+ {return numericalServer->activateMixedPrecision();}
+
+
+/** Deactivates the mixed-precision evaluation of tensor networks,
+    including the per-network decisions made by calibrateMixedPrecisionSync. **/
+inline void deactivateMixedPrecision()
+ {return numericalServer->deactivateMixedPrecision();}
+
+
+/** Returns whether the mixed-precision evaluation of tensor networks is globally active. **/
+inline bool mixedPrecisionIsActive()
+ {return numericalServer->mixedPrecisionIsActive();}
+
+
+/** Returns whether the mixed-precision evaluation is active for a given tensor network
+    (calibrated per-network decision, if any, otherwise the global mode). **/
+inline bool mixedPrecisionIsActive(const std::string & network_name) //in: tensor network name
+ {return numericalServer->mixedPrecisionIsActive(network_name);}
+
+
+/** Activates caching of intermediate tensors across tensor network evaluations
+    within the given memory budget (bytes): A re-evaluation of a tensor network
+    after an update of some of its input tensors only recomputes the intermediates
+    depending on the updated tensors. **/
+inline void activateIntermediateCaching(std::size_t memory_limit)
+ {return numericalServer->activateIntermediateCaching(memory_limit);}
+
+
+/** Deactivates caching of intermediate tensors and destroys all cached intermediates. **/
+inline void deactivateIntermediateCaching()
+ {return numericalServer->deactivateIntermediateCaching();}
+
+
+/** Returns whether caching of intermediate tensors is active. **/
+inline bool intermediateCachingIsActive()
+ {return numericalServer->intermediateCachingIsActive();}
+
+
+/** Activates concurrent evaluation of tensor network expansion components by
+    process subgroups sized according to the component cost estimates. **/
+inline void activateExpansionParallelism()
+ {return numericalServer->activateExpansionParallelism();}
+
+
+/** Deactivates concurrent evaluation of tensor network expansion components. **/
+inline void deactivateExpansionParallelism()
+ {return numericalServer->deactivateExpansionParallelism();}
+
+
+/** Returns whether concurrent evaluation of tensor network expansion components is active. **/
+inline bool expansionParallelismIsActive()
+ {return numericalServer->expansionParallelismIsActive();}
+
+
+/** Evaluates a tensor network in full and mixed precision and activates the
+    mixed-precision mode for this tensor network only if the relative error of
+    the output tensor does not exceed the given tolerance. Returns the relative
+    error and speedup (-1 and 0 on processes outside the process group). **/
+inline bool calibrateMixedPrecisionSync(TensorNetwork & network,      //inout: tensor network
+                                        double tolerance,             //in: relative error tolerance
+                                        double * rel_error = nullptr, //out: relative error of the mixed-precision result
+                                        double * speedup = nullptr)   //out: speedup of the mixed-precision evaluation
+ {return numericalServer->calibrateMixedPrecisionSync(network,tolerance,rel_error,speedup);}
+
+inline bool calibrateMixedPrecisionSync(const ProcessGroup & process_group, //in: chosen group of MPI processes
+                                        TensorNetwork & network,      //inout: tensor network
+                                        double tolerance,             //in: relative error tolerance
+                                        double * rel_error = nullptr, //out: relative error of the mixed-precision result
+                                        double * speedup = nullptr)   //out: speedup of the mixed-precision evaluation
+ {return numericalServer->calibrateMixedPrecisionSync(process_group,network,tolerance,rel_error,speedup);}
+
+
 /** Resets client logging level (0:none). **/
 inline void resetClientLoggingLevel(int level = 0)
  {return numericalServer->resetClientLoggingLevel(level);}
@@ -743,6 +1084,11 @@ inline std::size_t getMemoryBufferSize()
  {return numericalServer->getMemoryBufferSize();}
 
 
+/** Returns the peak memory usage in bytes observed by the runtime (0: not tracked). **/
+inline std::size_t getPeakMemorySize()
+ {return numericalServer->getPeakMemorySize();}
+
+
 /** Returns the default process group comprising all MPI processes and their communicator. **/
 inline const ProcessGroup & getDefaultProcessGroup()
  {return numericalServer->getDefaultProcessGroup();}
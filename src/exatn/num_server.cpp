@@ -1,18 +1,22 @@
 /** ExaTN::Numerics: Numerical server
-REVISION: 2020/11/16
+REVISION: 2020/12/14
 
 Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
 
 #include "num_server.hpp"
 #include "tensor_range.hpp"
+#include "matrix_svd.hpp"
 #include "timers.hpp"
 
+#include "talshxx.hpp"
+
 #include <vector>
 #include <list>
 #include <map>
 #include <future>
 #include <algorithm>
+#include <cmath>
 
 #ifdef MPI_ENABLED
 #include "mpi.h"
@@ -31,7 +35,9 @@ NumServer::NumServer(const MPICommProxy & communicator,
                      const ParamConf & parameters,
                      const std::string & graph_executor_name,
                      const std::string & node_executor_name):
- contr_seq_optimizer_("metis"), contr_seq_caching_(false), logging_(0), intra_comm_(communicator)
+ contr_seq_optimizer_("metis"), contr_seq_caching_(false), mixed_precision_(false),
+ intermediate_cache_limit_(0), intermediate_cache_size_(0), intermediate_cache_clock_(0),
+ expansion_parallelism_(false), logging_(0), intra_comm_(communicator)
 {
  int mpi_error = MPI_Comm_size(*(communicator.get<MPI_Comm>()),&num_processes_); assert(mpi_error == MPI_SUCCESS);
  mpi_error = MPI_Comm_rank(*(communicator.get<MPI_Comm>()),&process_rank_); assert(mpi_error == MPI_SUCCESS);
@@ -56,7 +62,9 @@ NumServer::NumServer(const MPICommProxy & communicator,
 NumServer::NumServer(const ParamConf & parameters,
                      const std::string & graph_executor_name,
                      const std::string & node_executor_name):
- contr_seq_optimizer_("metis"), contr_seq_caching_(false), logging_(0)
+ contr_seq_optimizer_("metis"), contr_seq_caching_(false), mixed_precision_(false),
+ intermediate_cache_limit_(0), intermediate_cache_size_(0), intermediate_cache_clock_(0),
+ expansion_parallelism_(false), logging_(0)
 {
  num_processes_ = 1; process_rank_ = 0; global_process_rank_ = 0;
  process_world_ = std::make_shared<ProcessGroup>(intra_comm_,num_processes_); //intra-communicator is empty here
@@ -80,6 +88,7 @@ NumServer::NumServer(const ParamConf & parameters,
 
 NumServer::~NumServer()
 {
+ deactivateIntermediateCaching(); //destroys cached intermediates
  destroyOrphanedTensors(); //garbage collection
  auto iter = tensors_.begin();
  while(iter != tensors_.end()){
@@ -138,6 +147,68 @@ void NumServer::deactivateContrSeqCaching()
  return;
 }
 
+void NumServer::activateMixedPrecision()
+{
+ mixed_precision_ = true;
+ return;
+}
+
+void NumServer::deactivateMixedPrecision()
+{
+ mixed_precision_ = false;
+ mixed_precision_networks_.clear();
+ return;
+}
+
+bool NumServer::mixedPrecisionIsActive() const
+{
+ return mixed_precision_;
+}
+
+bool NumServer::mixedPrecisionIsActive(const std::string & network_name) const
+{
+ auto iter = mixed_precision_networks_.find(network_name);
+ if(iter != mixed_precision_networks_.cend()) return iter->second;
+ return mixed_precision_;
+}
+
+void NumServer::activateIntermediateCaching(std::size_t memory_limit)
+{
+ if(memory_limit < intermediate_cache_size_) deactivateIntermediateCaching();
+ intermediate_cache_limit_ = memory_limit;
+ return;
+}
+
+void NumServer::deactivateIntermediateCaching()
+{
+ while(!intermediate_cache_.empty()) evictIntermediate(intermediate_cache_.begin()->first);
+ intermediate_cache_limit_ = 0;
+ intermediate_cache_clock_ = 0;
+ return;
+}
+
+bool NumServer::intermediateCachingIsActive() const
+{
+ return (intermediate_cache_limit_ > 0);
+}
+
+void NumServer::activateExpansionParallelism()
+{
+ expansion_parallelism_ = true;
+ return;
+}
+
+void NumServer::deactivateExpansionParallelism()
+{
+ expansion_parallelism_ = false;
+ return;
+}
+
+bool NumServer::expansionParallelismIsActive() const
+{
+ return expansion_parallelism_;
+}
+
 void NumServer::resetClientLoggingLevel(int level){
  if(logging_ == 0){
   if(level != 0) logfile_.open("exatn_main_thread."+std::to_string(global_process_rank_)+".log", std::ios::out | std::ios::trunc);
@@ -161,6 +232,12 @@ std::size_t NumServer::getMemoryBufferSize() const
  return tensor_rt_->getMemoryBufferSize();
 }
 
+std::size_t NumServer::getPeakMemorySize() const
+{
+ while(!tensor_rt_);
+ return tensor_rt_->getPeakMemorySize();
+}
+
 const ProcessGroup & NumServer::getDefaultProcessGroup() const
 {
  return *process_world_;
@@ -204,7 +281,9 @@ void NumServer::registerExternalData(const std::string & tag, std::shared_ptr<By
 
 std::shared_ptr<BytePacket> NumServer::getExternalData(const std::string & tag)
 {
- return ext_data_[tag];
+ auto iter = ext_data_.find(tag);
+ if(iter == ext_data_.end()) return std::shared_ptr<BytePacket>(nullptr);
+ return iter->second;
 }
 
 
@@ -213,6 +292,7 @@ ScopeId NumServer::openScope(const std::string & scope_name)
  assert(scope_name.length() > 0);
  ScopeId new_scope_id = scopes_.size();
  scopes_.push(std::pair<std::string,ScopeId>{scope_name,new_scope_id});
+ tensor_rt_->openScope(scope_name); //parental scope keeps executing concurrently
  return new_scope_id;
 }
 
@@ -222,9 +302,31 @@ ScopeId NumServer::closeScope()
  const auto & prev_scope = scopes_.top();
  ScopeId prev_scope_id = std::get<1>(prev_scope);
  scopes_.pop();
+ if(!scopes_.empty()){ //GLOBAL scope is closed by the destructor
+  tensor_rt_->closeScope(); //completes all tensor operations of the closed scope
+  tensor_rt_->resumeScope(scopes_.top().first);
+ }
  return prev_scope_id;
 }
 
+void NumServer::pauseScope()
+{
+ assert(!scopes_.empty());
+ tensor_rt_->pauseScope();
+ return;
+}
+
+void NumServer::setScopePriority(const std::string & scope_name, unsigned int priority)
+{
+ tensor_rt_->setScopePriority(scope_name,priority);
+ return;
+}
+
+bool NumServer::getScopeProgress(const std::string & scope_name, ScopeProgress & progress)
+{
+ return tensor_rt_->getScopeProgress(scope_name,progress);
+}
+
 
 SpaceId NumServer::createVectorSpace(const std::string & space_name, DimExtent space_dim,
                                      const VectorSpace ** space_ptr)
@@ -235,6 +337,16 @@ SpaceId NumServer::createVectorSpace(const std::string & space_name, DimExtent s
  return space_id;
 }
 
+SpaceId NumServer::createVectorSpace(const std::string & space_name, DimExtent space_dim,
+                                     const std::vector<SymmetryRange> & symmetry_subranges,
+                                     const VectorSpace ** space_ptr)
+{
+ assert(space_name.length() > 0);
+ SpaceId space_id = space_register_->registerSpace(std::make_shared<VectorSpace>(space_dim,space_name,symmetry_subranges));
+ if(space_ptr != nullptr) *space_ptr = space_register_->getSpace(space_id);
+ return space_id;
+}
+
 void NumServer::destroyVectorSpace(const std::string & space_name)
 {
  assert(false);
@@ -334,7 +446,15 @@ bool NumServer::submit(std::shared_ptr<TensorOperation> operation)
     submitted = false;
    }
   }
-  if(submitted) tensor_rt_->submit(operation);
+  if(submitted){
+   if(!intermediate_dependents_.empty()){ //evict cached intermediates depending on updated tensors
+    const auto num_operands = operation->getNumOperands();
+    for(unsigned int i = 0; i < num_operands; ++i){
+     if(operation->operandIsMutable(i)) evictIntermediatesDependingOn(operation->getTensorOperand(i)->getName());
+    }
+   }
+   tensor_rt_->submit(operation);
+  }
  }
  return submitted;
 }
@@ -417,7 +537,12 @@ bool NumServer::submit(const ProcessGroup & process_group,
                            << " with volume " << max_intermediate_volume << " -> ";
 
  //Split some of the tensor network indices based on the requested memory limit:
- const std::size_t proc_mem_volume = process_group.getMemoryLimitPerProcess() / sizeof(std::complex<double>);
+ const bool mixed_precision = mixedPrecisionIsActive(network.getName()); //intermediates will be computed in the lower precision
+ std::size_t elem_size = mixed_precision ? sizeof(std::complex<float>) : sizeof(std::complex<double>);
+ const auto output_elem_type = network.getTensor(0)->getElementType();
+ if(isHalfPrecisionElementType(output_elem_type)) //16-bit tensors are processed in single precision
+  elem_size = numerics::tensor_element_type_size(getComputeElementType(output_elem_type));
+ const std::size_t proc_mem_volume = process_group.getMemoryLimitPerProcess() / elem_size;
  if(max_intermediate_presence_volume > 0.0 && max_intermediate_volume > 0.0){
   const double shrink_coef = std::min(1.0,
    static_cast<double>(proc_mem_volume) / (max_intermediate_presence_volume * 1.5 * 2.0)); //{1.5:memory fragmentation}; {2.0:tensor transpose}
@@ -442,14 +567,30 @@ bool NumServer::submit(const ProcessGroup & process_group,
   submitted = submit(op0); if(!submitted) return false; //this CREATE operation will also register the output tensor
  }
 
- //Initialize the output tensor to zero:
- std::shared_ptr<TensorOperation> op1 = tensor_op_factory_->createTensorOp(TensorOpCode::TRANSFORM);
- op1->setTensorOperand(output_tensor);
- std::dynamic_pointer_cast<numerics::TensorOpTransform>(op1)->
-  resetFunctor(std::shared_ptr<TensorMethod>(new numerics::FunctorInitVal(0.0)));
- submitted = submit(op1); if(!submitted) return false;
- //Submit all tensor operations for tensor network evaluation:
+ //Fuse the zero initialization of the output tensor into the tensor contraction producing it (unsliced case):
  const auto num_split_indices = network.getNumSplitIndices(); //total number of indices that were split
+ std::list<std::shared_ptr<TensorOperation>> fused_op_list; //operation list with the output tensor contraction overwriting it
+ if(num_split_indices == 0){
+  auto output_op = std::find_if(op_list.rbegin(),op_list.rend(),
+                                [&output_tensor](const std::shared_ptr<TensorOperation> & op){
+                                 return (op->getNumOperands() > 0 && op->getTensorOperand(0) == output_tensor);
+                                });
+  if(output_op != op_list.rend() && (*output_op)->getOpcode() == TensorOpCode::CONTRACT){
+   fused_op_list = op_list;
+   auto fused_op = std::next(fused_op_list.begin(),std::distance(op_list.begin(),output_op.base()) - 1);
+   *fused_op = (*output_op)->clone();
+   (*fused_op)->setScalar(1,std::complex<double>{0.0,0.0}); //beta = 0: overwrite the output tensor
+  }
+ }
+ //Initialize the output tensor to zero (unless the tensor contraction overwrites it):
+ if(fused_op_list.empty()){
+  std::shared_ptr<TensorOperation> op1 = tensor_op_factory_->createTensorOp(TensorOpCode::TRANSFORM);
+  op1->setTensorOperand(output_tensor);
+  std::dynamic_pointer_cast<numerics::TensorOpTransform>(op1)->
+   resetFunctor(std::shared_ptr<TensorMethod>(new numerics::FunctorInitVal(0.0)));
+  submitted = submit(op1); if(!submitted) return false;
+ }
+ //Submit all tensor operations for tensor network evaluation:
  if(logging_ > 0) logfile_ << "Number of split indices = " << num_split_indices << std::endl << std::flush;
  std::size_t num_items_executed = 0; //number of tensor sub-networks executed
  if(num_split_indices > 0){ //multiple tensor sub-networks need to be executed by all processes ditributively
@@ -478,6 +619,8 @@ bool NumServer::submit(const ProcessGroup & process_group,
     }
     const auto num_operands = (*op)->getNumOperands();
     std::shared_ptr<TensorOperation> tens_op = (*op)->clone();
+    if(mixed_precision) lowerIntermediatePrecision(**op,*tens_op,*output_tensor);
+    const bool overwrite_output = ((*op)->getOpcode() == TensorOpCode::CONTRACT);
     //Substitute sliced tensor operands with their respective slices from the current tensor sub-network:
     std::shared_ptr<numerics::Tensor> output_tensor_slice;
     for(unsigned int op_num = 0; op_num < num_operands; ++op_num){
@@ -547,28 +690,34 @@ bool NumServer::submit(const ProcessGroup & process_group,
        std::dynamic_pointer_cast<numerics::TensorOpCreate>(create_slice)->
         resetTensorElementType(tensor->getElementType());
        submitted = submit(create_slice); if(!submitted) return false;
-       //Extract the slice contents from the input/output tensor:
+       //Extract the slice contents from the input/output tensor (a tensor contraction overwrites the output tensor slice instead):
        if(tensor_is_output){ //make sure the output tensor slice only shows up once
         //assert(tensor == output_tensor);
         assert(!output_tensor_slice);
         output_tensor_slice = tensor_slice;
        }
-       std::shared_ptr<TensorOperation> extract_slice = tensor_op_factory_->createTensorOp(TensorOpCode::SLICE);
-       extract_slice->setTensorOperand(tensor_slice);
-       extract_slice->setTensorOperand(tensor);
-       submitted = submit(extract_slice); if(!submitted) return false;
+       if(!(tensor_is_output && overwrite_output)){
+        std::shared_ptr<TensorOperation> extract_slice = tensor_op_factory_->createTensorOp(TensorOpCode::SLICE);
+        extract_slice->setTensorOperand(tensor_slice);
+        extract_slice->setTensorOperand(tensor);
+        submitted = submit(extract_slice); if(!submitted) return false;
+       }
       }
      }else{
       if(debugging && logging_ > 1) logfile_ << " without split indices" << std::endl; //debug
      }
     } //loop over tensor operands
     //Submit the primary tensor operation with the current slices:
+    if(output_tensor_slice && overwrite_output){ //the fresh output tensor slice is overwritten by the tensor contraction
+     tens_op->setScalar(1,std::complex<double>{0.0,0.0}); //beta = 0: overwrite
+    }
     submitted = submit(tens_op); if(!submitted) return false;
-    //Insert the output tensor slice back into the output tensor:
+    //Accumulate the output tensor slice into the output tensor:
     if(output_tensor_slice){
      std::shared_ptr<TensorOperation> insert_slice = tensor_op_factory_->createTensorOp(TensorOpCode::INSERT);
      insert_slice->setTensorOperand(output_tensor);
      insert_slice->setTensorOperand(output_tensor_slice);
+     if(overwrite_output) insert_slice->setScalar(0,std::complex<double>{1.0,0.0}); //beta = 1: accumulate
      submitted = submit(insert_slice); if(!submitted) return false;
      output_tensor_slice.reset();
     }
@@ -595,8 +744,20 @@ bool NumServer::submit(const ProcessGroup & process_group,
    submitted = submit(allreduce); if(!submitted) return false;
   }
  }else{ //only a single tensor (sub-)network executed redundantly by all processes
-  for(auto op = op_list.begin(); op != op_list.end(); ++op){
-   submitted = submit(*op); if(!submitted) return false;
+  if(intermediate_cache_limit_ > 0){ //reuse and retain intermediate tensors
+   submitted = submitCachingIntermediates((fused_op_list.empty() ? op_list : fused_op_list),
+                                          output_tensor,mixed_precision); if(!submitted) return false;
+  }else{
+   auto & exec_op_list = (fused_op_list.empty() ? op_list : fused_op_list);
+   for(auto op = exec_op_list.begin(); op != exec_op_list.end(); ++op){
+    if(mixed_precision && (*op)->getOpcode() == TensorOpCode::CREATE){
+     std::shared_ptr<TensorOperation> tens_op = (*op)->clone();
+     lowerIntermediatePrecision(**op,*tens_op,*output_tensor);
+     submitted = submit(tens_op); if(!submitted) return false;
+    }else{
+     submitted = submit(*op); if(!submitted) return false;
+    }
+   }
   }
   ++num_items_executed;
  }
@@ -604,6 +765,169 @@ bool NumServer::submit(const ProcessGroup & process_group,
  return true;
 }
 
+void NumServer::lowerIntermediatePrecision(const TensorOperation & op,
+                                           TensorOperation & op_clone,
+                                           const Tensor & output_tensor)
+{
+ if(op.getOpcode() == TensorOpCode::CREATE){
+  const auto & tensor = *(op.getTensorOperand(0));
+  bool tensor_is_output;
+  bool tensor_is_intermediate = tensorNameIsIntermediate(tensor,&tensor_is_output);
+  if(tensor_is_intermediate && (!tensor_is_output) && tensor.getName() != output_tensor.getName()){
+   //An intermediate without an explicit element type is resolved from its tensor upon submission: Lowering it
+   //would also lower the tensor shared with the original CREATE operation (see submit), thus it is kept as is:
+   const auto elem_type = dynamic_cast<const numerics::TensorOpCreate&>(op).getTensorElementType();
+   //Lower the element type in the cloned CREATE operation only:
+   if(elem_type != TensorElementType::VOID)
+    dynamic_cast<numerics::TensorOpCreate&>(op_clone).resetTensorElementType(getLowerPrecisionElementType(elem_type));
+  }
+ }
+ return;
+}
+
+bool NumServer::submitCachingIntermediates(std::list<std::shared_ptr<TensorOperation>> & op_list,
+                                           std::shared_ptr<Tensor> output_tensor,
+                                           bool mixed_precision)
+{
+ //Identify intermediate tensors by the structure of their contraction subtrees:
+ std::unordered_map<std::string,std::string> keys; //intermediate tensor name --> cache key (contraction subtree signature)
+ std::unordered_map<std::string,std::vector<std::string>> leaves; //intermediate tensor name --> input tensors it depends on
+ for(const auto & op: op_list){
+  if(op->getOpcode() == TensorOpCode::CONTRACT){
+   const auto result = op->getTensorOperand(0);
+   if(result == output_tensor) continue; //output tensor is always recomputed
+   std::string signature = op->getIndexPattern() + (mixed_precision ? ";L" : ";F");
+   std::vector<std::string> deps;
+   const auto num_operands = op->getNumOperands();
+   for(unsigned int i = 1; i < num_operands; ++i){
+    const auto & name = op->getTensorOperand(i)->getName();
+    auto key_iter = keys.find(name);
+    if(key_iter != keys.end()){ //intermediate tensor operand
+     signature += ";(" + key_iter->second + ")";
+     const auto & operand_leaves = leaves[name];
+     deps.insert(deps.end(),operand_leaves.cbegin(),operand_leaves.cend());
+    }else{ //input tensor operand
+     signature += ";" + name;
+     deps.emplace_back(name);
+    }
+   }
+   std::sort(deps.begin(),deps.end());
+   deps.erase(std::unique(deps.begin(),deps.end()),deps.end());
+   keys[result->getName()] = std::move(signature);
+   leaves[result->getName()] = std::move(deps);
+  }
+ }
+ //Evict stale cached versions of the same intermediate tensors (e.g., computed in a different precision):
+ for(const auto & kv: keys){
+  if(intermediate_cache_.find(kv.second) == intermediate_cache_.end() && tensors_.find(kv.first) != tensors_.end()){
+   for(const auto & entry: intermediate_cache_){
+    if(entry.second.tensor->getName() == kv.first){
+     evictIntermediate(entry.first);
+     break;
+    }
+   }
+  }
+ }
+ //Look up the cached intermediate tensors:
+ std::unordered_map<std::string,std::shared_ptr<Tensor>> reused; //intermediate tensor name --> cached intermediate tensor
+ std::unordered_set<std::string> pinned; //cache keys in use by the current tensor network
+ for(const auto & kv: keys){
+  auto cache_iter = intermediate_cache_.find(kv.second);
+  if(cache_iter != intermediate_cache_.end()){
+   cache_iter->second.last_use = ++intermediate_cache_clock_;
+   reused.emplace(std::make_pair(kv.first,cache_iter->second.tensor));
+   pinned.emplace(kv.second);
+  }
+ }
+ //Submit the tensor operations for the intermediate tensors which are not cached:
+ for(auto op = op_list.begin(); op != op_list.end(); ++op){
+  const auto tensor = (*op)->getTensorOperand(0);
+  if(reused.find(tensor->getName()) != reused.end()) continue; //cached intermediate tensor: No need to recompute
+  if((*op)->getOpcode() == TensorOpCode::DESTROY){ //retain the intermediate tensor instead of destroying it
+   auto key_iter = keys.find(tensor->getName());
+   if(key_iter != keys.end()){
+    if(retainIntermediate(key_iter->second,tensor,leaves[tensor->getName()],pinned)) continue;
+   }
+  }
+  std::shared_ptr<TensorOperation> tens_op = *op;
+  if(mixed_precision && (*op)->getOpcode() == TensorOpCode::CREATE){
+   tens_op = (*op)->clone();
+   lowerIntermediatePrecision(**op,*tens_op,*output_tensor);
+  }else{ //substitute cached intermediate tensors computed in another tensor network
+   const auto num_operands = (*op)->getNumOperands();
+   for(unsigned int i = 1; i < num_operands; ++i){
+    const auto operand = (*op)->getTensorOperand(i);
+    auto reused_iter = reused.find(operand->getName());
+    if(reused_iter != reused.end() && reused_iter->second != operand){
+     if(tens_op == *op) tens_op = (*op)->clone();
+     bool replaced = tens_op->resetTensorOperand(i,reused_iter->second); assert(replaced);
+    }
+   }
+  }
+  bool submitted = submit(tens_op); if(!submitted) return false;
+ }
+ return true;
+}
+
+bool NumServer::retainIntermediate(const std::string & key,
+                                   std::shared_ptr<Tensor> tensor,
+                                   const std::vector<std::string> & leaves,
+                                   const std::unordered_set<std::string> & pinned)
+{
+ if(intermediate_cache_.find(key) != intermediate_cache_.end()) return false; //an equivalent intermediate is already cached
+ auto elem_type = tensor->getElementType();
+ if(elem_type == TensorElementType::VOID) elem_type = TensorElementType::COMPLEX64;
+ const std::size_t size = tensor->getVolume() * numerics::tensor_element_type_size(elem_type);
+ if(size > intermediate_cache_limit_) return false;
+ //Evict the least recently used unpinned intermediates until the new one fits:
+ while(intermediate_cache_size_ + size > intermediate_cache_limit_){
+  auto victim = intermediate_cache_.end();
+  for(auto iter = intermediate_cache_.begin(); iter != intermediate_cache_.end(); ++iter){
+   if(pinned.find(iter->first) == pinned.end()){
+    if(victim == intermediate_cache_.end() || iter->second.last_use < victim->second.last_use) victim = iter;
+   }
+  }
+  if(victim == intermediate_cache_.end()) return false; //all cached intermediates are in use
+  evictIntermediate(victim->first);
+ }
+ intermediate_cache_.emplace(std::make_pair(key,CachedIntermediate{tensor,leaves,size,++intermediate_cache_clock_}));
+ intermediate_cache_size_ += size;
+ for(const auto & leaf: leaves) intermediate_dependents_[leaf].emplace_back(key);
+ return true;
+}
+
+void NumServer::evictIntermediate(const std::string & key)
+{
+ auto iter = intermediate_cache_.find(key);
+ if(iter != intermediate_cache_.end()){
+  auto tensor = iter->second.tensor;
+  for(const auto & leaf: iter->second.leaves){
+   auto dep_iter = intermediate_dependents_.find(leaf);
+   if(dep_iter != intermediate_dependents_.end()){
+    auto & deps = dep_iter->second;
+    deps.erase(std::remove(deps.begin(),deps.end(),key),deps.end());
+    if(deps.empty()) intermediate_dependents_.erase(dep_iter);
+   }
+  }
+  intermediate_cache_size_ -= iter->second.size;
+  intermediate_cache_.erase(iter);
+  std::shared_ptr<TensorOperation> destroy_op = tensor_op_factory_->createTensorOp(TensorOpCode::DESTROY);
+  destroy_op->setTensorOperand(tensor);
+  auto submitted = submit(destroy_op); assert(submitted);
+ }
+ return;
+}
+
+void NumServer::evictIntermediatesDependingOn(const std::string & tensor_name)
+{
+ auto iter = intermediate_dependents_.find(tensor_name);
+ if(iter != intermediate_dependents_.end()){
+  const auto keys = iter->second; //eviction updates the dependency lists
+  for(const auto & key: keys) evictIntermediate(key);
+ }
+ return;
+}
+
 bool NumServer::submit(const ProcessGroup & process_group,
                        std::shared_ptr<TensorNetwork> network)
 {
@@ -611,6 +935,270 @@ bool NumServer::submit(const ProcessGroup & process_group,
  return false;
 }
 
+bool NumServer::calibrateMixedPrecisionSync(TensorNetwork & network,
+                                            double tolerance,
+                                            double * rel_error,
+                                            double * speedup)
+{
+ return calibrateMixedPrecisionSync(getDefaultProcessGroup(),network,tolerance,rel_error,speedup);
+}
+
+bool NumServer::calibrateMixedPrecisionSync(const ProcessGroup & process_group,
+                                            TensorNetwork & network,
+                                            double tolerance,
+                                            double * rel_error,
+                                            double * speedup)
+{
+ if(!process_group.rankIsIn(process_rank_)){ //process is not in the group: Do nothing
+  if(rel_error != nullptr) *rel_error = -1.0;
+  if(speedup != nullptr) *speedup = 0.0;
+  return true;
+ }
+ auto & mixed_precision = mixed_precision_networks_[network.getName()]; //per-network decision
+ //Determine the tensor contraction sequence in advance (excluded from timing):
+ if(network.exportContractionSequence().empty()) network.determineContractionSequence(contr_seq_optimizer_);
+ //Evaluate the tensor network in full precision (reference):
+ mixed_precision = false;
+ double time_full = exatn::Timer::timeInSecHR();
+ bool success = submit(process_group,network);
+ if(success) success = sync(process_group,network);
+ time_full = exatn::Timer::timeInSecHR(time_full);
+ if(!success) return false;
+ //Save the reference output tensor:
+ auto output_tensor = network.getTensor(0);
+ auto reference = std::make_shared<Tensor>(*output_tensor);
+ reference->rename();
+ success = createTensorSync(reference,output_tensor->getElementType());
+ if(success) success = initTensorSync(reference->getName(),0.0);
+ if(!success) return false;
+ std::string add_pattern;
+ auto generated = generate_addition_pattern(output_tensor->getRank(),add_pattern); assert(generated);
+ std::shared_ptr<TensorOperation> op = tensor_op_factory_->createTensorOp(TensorOpCode::ADD);
+ op->setTensorOperand(reference);
+ op->setTensorOperand(output_tensor);
+ op->setIndexPattern(add_pattern);
+ success = submit(op); if(success) success = sync(*op);
+ double ref_norm = 0.0;
+ if(success) success = computeNorm2Sync(reference->getName(),ref_norm);
+ //Evaluate the tensor network in mixed precision:
+ double time_mixed = 0.0;
+ if(success){
+  mixed_precision = true;
+  time_mixed = exatn::Timer::timeInSecHR();
+  success = submit(process_group,network);
+  if(success) success = sync(process_group,network);
+  time_mixed = exatn::Timer::timeInSecHR(time_mixed);
+ }
+ //Compute the relative error of the mixed-precision evaluation:
+ double error = -1.0;
+ if(success){
+  op = tensor_op_factory_->createTensorOp(TensorOpCode::ADD);
+  op->setTensorOperand(reference);
+  op->setTensorOperand(output_tensor);
+  op->setIndexPattern(add_pattern);
+  op->setScalar(0,std::complex<double>{-1.0,0.0});
+  success = submit(op); if(success) success = sync(*op); //reference now contains the error tensor
+  double err_norm = 0.0;
+  if(success) success = computeNorm2Sync(reference->getName(),err_norm);
+  if(success){
+   error = (ref_norm > 0.0) ? err_norm / ref_norm : err_norm;
+   mixed_precision = (error <= tolerance);
+   //Restore the full-precision result if the mixed-precision one is rejected (no iterative refinement):
+   if(!mixed_precision){
+    op = tensor_op_factory_->createTensorOp(TensorOpCode::ADD);
+    op->setTensorOperand(output_tensor);
+    op->setTensorOperand(reference);
+    op->setIndexPattern(add_pattern);
+    success = submit(op); if(success) success = sync(*op);
+   }
+  }
+ }
+ if(!success) mixed_precision = false;
+ if(logging_ > 0) logfile_ << "[" << std::fixed << std::setprecision(6) << exatn::Timer::timeInSecHR(getTimeStampStart())
+                           << "]: Mixed-precision calibration on tensor network <" << network.getName()
+                           << ">: Relative error = " << std::scientific << error << "; Speedup = "
+                           << ((time_mixed > 0.0) ? (time_full / time_mixed) : 0.0)
+                           << "; Mixed precision activated = " << mixed_precision << std::endl << std::flush;
+ if(rel_error != nullptr) *rel_error = error;
+ if(speedup != nullptr) *speedup = (time_mixed > 0.0) ? (time_full / time_mixed) : 0.0;
+ auto destroyed = destroyTensorSync(reference->getName());
+ return success && destroyed;
+}
+
+bool NumServer::evaluateTensorNetworkBatch(TensorNetwork & network,
+                                           const std::vector<unsigned int> & boundary_ids,
+                                           const std::vector<std::vector<std::shared_ptr<Tensor>>> & boundary_tensors,
+                                           const std::string & result_name)
+{
+ return evaluateTensorNetworkBatch(getDefaultProcessGroup(),network,boundary_ids,boundary_tensors,result_name);
+}
+
+bool NumServer::evaluateTensorNetworkBatch(const ProcessGroup & process_group,
+                                           TensorNetwork & network,
+                                           const std::vector<unsigned int> & boundary_ids,
+                                           const std::vector<std::vector<std::shared_ptr<Tensor>>> & boundary_tensors,
+                                           const std::string & result_name)
+{
+ if(!process_group.rankIsIn(process_rank_)) return true; //process is not in the group: Do nothing
+ const auto batch_size = boundary_tensors.size();
+ const auto num_boundary = boundary_ids.size();
+ if(batch_size == 0 || num_boundary == 0 || num_boundary >= network.getNumTensors()){
+  std::cout << "#ERROR(exatn::NumServer::evaluateTensorNetworkBatch): Invalid batch specification for tensor network "
+            << network.getName() << std::endl << std::flush;
+  return false;
+ }
+ //Check the boundary tensors:
+ for(const auto & boundary_id: boundary_ids){
+  const auto * legs = network.getTensorConnections(boundary_id);
+  if(boundary_id == 0 || legs == nullptr){
+   std::cout << "#ERROR(exatn::NumServer::evaluateTensorNetworkBatch): Boundary tensor " << boundary_id
+             << " not found in tensor network " << network.getName() << std::endl << std::flush;
+   return false;
+  }
+  for(const auto & leg: *legs){
+   const auto other_id = leg.getTensorId();
+   if(other_id == 0 || std::find(boundary_ids.cbegin(),boundary_ids.cend(),other_id) != boundary_ids.cend()){
+    std::cout << "#ERROR(exatn::NumServer::evaluateTensorNetworkBatch): Boundary tensor " << boundary_id
+              << " must only be connected to non-boundary input tensors!" << std::endl << std::flush;
+    return false;
+   }
+  }
+ }
+ for(const auto & item: boundary_tensors){
+  bool congruent = (item.size() == num_boundary);
+  for(unsigned int i = 0; congruent && i < num_boundary; ++i){
+   congruent = item[i] && item[i]->isCongruentTo(*(network.getTensor(boundary_ids[i])));
+  }
+  if(!congruent){
+   std::cout << "#ERROR(exatn::NumServer::evaluateTensorNetworkBatch): Boundary tensors of a batch item "
+             << "are not congruent to the boundary tensors of tensor network " << network.getName() << std::endl << std::flush;
+   return false;
+  }
+ }
+ //The shared trunk (a subset of the non-boundary input tensors) is evaluated once and its output tensor
+ //stays alive while all batch items are evaluated, thus the trunk is chosen such that its output tensor
+ //takes at most half of the memory limit per process. The rest of the tensor network (branch), including
+ //the boundary tensors, is evaluated for each batch item. Without a suitable trunk, each batch item
+ //is evaluated as the whole tensor network:
+ auto elem_type = TensorElementType::VOID;
+ std::size_t elem_size = 0;
+ for(auto iter = network.cbegin(); iter != network.cend(); ++iter){
+  if(iter->first != 0 && std::find(boundary_ids.cbegin(),boundary_ids.cend(),iter->first) == boundary_ids.cend()){
+   const auto tensor_elem_type = iter->second.getTensor()->getElementType();
+   if(numerics::tensor_element_type_size(tensor_elem_type) > elem_size){
+    elem_type = tensor_elem_type;
+    elem_size = numerics::tensor_element_type_size(tensor_elem_type);
+   }
+  }
+ }
+ if(elem_size == 0) elem_size = sizeof(std::complex<double>);
+ std::vector<unsigned int> trunk_ids;
+ const double max_trunk_volume = static_cast<double>(process_group.getMemoryLimitPerProcess()) / (2.0 * static_cast<double>(elem_size));
+ const double trunk_volume = network.selectBatchTrunk(boundary_ids,max_trunk_volume,trunk_ids);
+ const bool shared_trunk = !(trunk_ids.empty());
+ auto output_tensor = network.getTensor(0);
+ const auto output_rank = output_tensor->getRank();
+ const unsigned int trunk_id = network.getMaxTensorId() + 1; //trunk output tensor in a batch item tensor network
+ const unsigned int unit_id = trunk_id + 1; //unit tensor enumerating batch items in a batch item tensor network
+ std::map<unsigned int,std::vector<TensorLeg>> branch_legs; //legs of the branch tensors in a batch item tensor network
+ for(auto iter = network.cbegin(); iter != network.cend(); ++iter){
+  if(iter->first != 0 && std::find(trunk_ids.cbegin(),trunk_ids.cend(),iter->first) == trunk_ids.cend()){
+   const auto & legs = iter->second.getTensorLegs();
+   branch_legs.emplace(iter->first,std::vector<TensorLeg>(legs.cbegin(),legs.cend()));
+  }
+ }
+ const auto * network_output_legs = network.getTensorConnections(0);
+ std::vector<TensorLeg> output_legs(network_output_legs->cbegin(),network_output_legs->cend());
+ bool success = true;
+ std::shared_ptr<Tensor> trunk_output;
+ std::vector<TensorLeg> trunk_output_legs; //trunk output legs in a batch item tensor network
+ if(shared_trunk){
+  TensorNetwork trunk(network);
+  trunk.rename(network.getName() + "_trunk");
+  for(const auto & branch: branch_legs){
+   auto deleted = trunk.deleteTensor(branch.first); assert(deleted);
+  }
+  //Evaluate the shared trunk once:
+  success = submit(process_group,trunk);
+  if(!success) return false;
+  trunk_output = trunk.getTensor(0);
+  elem_type = trunk_output->getElementType();
+  //Reconnect the released trunk output legs to the branch tensors and the output tensor:
+  const auto * trunk_legs = trunk.getTensorConnections(0);
+  const auto trunk_rank = trunk_legs->size();
+  trunk_output_legs.resize(trunk_rank);
+  for(unsigned int mode = 0; mode < trunk_rank; ++mode){
+   const auto & leg = (*trunk_legs)[mode];
+   const auto & original_leg = (*(network.getTensorConnections(leg.getTensorId())))[leg.getDimensionId()];
+   trunk_output_legs[mode] = TensorLeg(original_leg.getTensorId(),original_leg.getDimensionId());
+   if(original_leg.getTensorId() == 0){
+    output_legs[original_leg.getDimensionId()] = TensorLeg(trunk_id,mode);
+   }else{
+    branch_legs[original_leg.getTensorId()][original_leg.getDimensionId()] = TensorLeg(trunk_id,mode);
+   }
+  }
+  if(logging_ > 0) logfile_ << "[" << std::fixed << std::setprecision(6) << exatn::Timer::timeInSecHR(getTimeStampStart())
+                            << "]: Batched evaluation of tensor network <" << network.getName() << ">: Shared trunk of "
+                            << trunk_ids.size() << " tensors with output volume " << std::scientific << trunk_volume
+                            << "; Branch of " << branch_legs.size() << " tensors" << std::endl << std::flush;
+ }else{
+  if(logging_ > 0) logfile_ << "[" << std::fixed << std::setprecision(6) << exatn::Timer::timeInSecHR(getTimeStampStart())
+                            << "]: Batched evaluation of tensor network <" << network.getName() << ">: No trunk output tensor "
+                            << "fits in the memory limit: Evaluating batch items as a whole" << std::endl << std::flush;
+ }
+ //Create the batch result tensor and the unit tensor enumerating batch items:
+ auto result = std::make_shared<Tensor>(*output_tensor);
+ result->rename(result_name);
+ result->appendDimension({SOME_SPACE,0},batch_size);
+ success = createTensor(process_group,result,elem_type);
+ auto unit = std::make_shared<Tensor>("_unit",TensorShape{1});
+ unit->rename();
+ if(success) success = createTensor(process_group,unit,elem_type);
+ if(success) success = initTensor(unit->getName(),1.0);
+ if(!success) return false;
+ implicit_tensors_.emplace_back(unit); //garbage collected once all batch items have been evaluated
+ output_legs.emplace_back(TensorLeg(unit_id,0));
+ //Evaluate batch items by contracting the trunk output (if any) with their branch tensors:
+ std::list<numerics::ContrTriple> contr_seq;
+ double contr_seq_flops = 0.0;
+ for(std::size_t item = 0; item < batch_size; ++item){
+  auto item_output = std::make_shared<Tensor>(*output_tensor);
+  item_output->appendDimension({SOME_SPACE,item},1);
+  item_output->rename(tensor_hex_name("z",item_output->getTensorHash()));
+  TensorNetwork item_network(network.getName() + "_item" + std::to_string(item),item_output,output_legs);
+  bool placed = true;
+  if(shared_trunk) placed = item_network.placeTensor(trunk_id,trunk_output,trunk_output_legs);
+  for(auto iter = branch_legs.cbegin(); placed && iter != branch_legs.cend(); ++iter){
+   bool conjugated = false;
+   auto tensor = network.getTensor(iter->first,&conjugated);
+   const auto pos = std::distance(boundary_ids.cbegin(),std::find(boundary_ids.cbegin(),boundary_ids.cend(),iter->first));
+   if(pos < num_boundary) tensor = boundary_tensors[item][pos];
+   placed = item_network.placeTensor(iter->first,tensor,iter->second,conjugated);
+  }
+  if(placed) placed = item_network.placeTensor(unit_id,unit,std::vector<TensorLeg>{TensorLeg(0,output_rank)});
+  if(placed) placed = item_network.finalize();
+  if(!placed){
+   std::cout << "#ERROR(exatn::NumServer::evaluateTensorNetworkBatch): Unable to build batch item "
+             << item << " of tensor network " << network.getName() << std::endl << std::flush;
+   return false;
+  }
+  //All batch items share the same contraction sequence:
+  if(item == 0){
+   contr_seq_flops = item_network.determineContractionSequence(contr_seq_optimizer_);
+   contr_seq = item_network.exportContractionSequence();
+  }else{
+   item_network.importContractionSequence(contr_seq,contr_seq_flops);
+  }
+  success = submit(process_group,item_network);
+  if(success) success = insertTensorSlice(result_name,item_output->getName());
+  if(!success) return false;
+ }
+ if(logging_ > 0) logfile_ << "[" << std::fixed << std::setprecision(6) << exatn::Timer::timeInSecHR(getTimeStampStart())
+                           << "]: Submitted batched evaluation of tensor network <" << network.getName()
+                           << "> with " << batch_size << " items into tensor " << result_name << std::endl << std::flush;
+ return success;
+}
+
 bool NumServer::submit(TensorExpansion & expansion,
                        std::shared_ptr<Tensor> accumulator)
 {
@@ -629,6 +1217,8 @@ bool NumServer::submit(const ProcessGroup & process_group,
 {
  if(!process_group.rankIsIn(process_rank_)) return true; //process is not in the group: Do nothing
  assert(accumulator);
+ if(expansion_parallelism_ && process_group.getSize() > 1 && expansion.getNumComponents() > 1)
+  return submitConcurrently(process_group,expansion,accumulator);
  std::list<std::shared_ptr<TensorOperation>> accumulations;
  for(auto component = expansion.begin(); component != expansion.end(); ++component){
   //Evaluate the tensor network component (compute its output tensor):
@@ -653,6 +1243,163 @@ bool NumServer::submit(const ProcessGroup & process_group,
  return true;
 }
 
+bool NumServer::submitConcurrently(const ProcessGroup & process_group,
+                                   TensorExpansion & expansion,
+                                   std::shared_ptr<Tensor> accumulator)
+{
+ unsigned int local_rank; //local process rank within the process group
+ if(!process_group.rankIsIn(process_rank_,&local_rank)) return true; //process is not in the group: Do nothing
+ assert(accumulator);
+ const auto num_components = expansion.getNumComponents();
+ //Estimate the flop count and memory footprint of each tensor network component:
+ std::vector<double> costs(num_components*2,0.0); //{flops,memory} per component
+ std::size_t comp_id = 0;
+ for(auto component = expansion.begin(); component != expansion.end(); ++component, ++comp_id){
+  auto & network = *(component->network_);
+  network.getOperationList(contr_seq_optimizer_,true);
+  const auto elem_size = numerics::tensor_element_type_size(network.getTensor(0)->getElementType());
+  costs[comp_id*2] = network.getFMAFlops();
+  costs[comp_id*2+1] = network.getMaxIntermediatePresenceVolume() * static_cast<double>(elem_size);
+ }
+#ifdef MPI_ENABLED
+ //Make sure all processes use the same cost estimates:
+ auto errc = MPI_Bcast(costs.data(),costs.size(),MPI_DOUBLE,0,process_group.getMPICommProxy().getRef<MPI_Comm>());
+ assert(errc == MPI_SUCCESS);
+#endif
+ std::vector<double> flops(num_components), memory(num_components);
+ for(std::size_t i = 0; i < num_components; ++i){
+  flops[i] = costs[i*2];
+  memory[i] = costs[i*2+1];
+ }
+ //Partition the process group into subgroups:
+ std::vector<unsigned int> component_groups;
+ std::vector<std::pair<unsigned int,unsigned int>> group_ranks;
+ const auto num_groups = partitionProcessGroup(process_group,flops,memory,component_groups,group_ranks);
+ int my_group = -1;
+ for(unsigned int i = 0; i < num_groups; ++i){
+  if(local_rank >= group_ranks[i].first && local_rank < group_ranks[i].second) my_group = i;
+ }
+ assert(my_group >= 0);
+ auto subgroup = process_group.split(my_group); assert(subgroup);
+ unsigned int subgroup_rank;
+ bool in_subgroup = subgroup->rankIsIn(process_rank_,&subgroup_rank); assert(in_subgroup);
+ if(logging_ > 0) logfile_ << "[" << std::fixed << std::setprecision(6) << exatn::Timer::timeInSecHR(getTimeStampStart())
+                           << "]: Concurrent evaluation of tensor network expansion <" << expansion.getName() << "> with "
+                           << num_components << " components by " << num_groups << " process subgroups: Current process joined subgroup "
+                           << my_group << " of size " << subgroup->getSize() << std::endl << std::flush;
+ //Create the partial accumulator for the contributions of the current process subgroup:
+ auto partial = std::make_shared<Tensor>(*accumulator);
+ partial->rename(); //unique automatic name will be generated
+ std::shared_ptr<TensorOperation> create_op = tensor_op_factory_->createTensorOp(TensorOpCode::CREATE);
+ create_op->setTensorOperand(partial);
+ std::dynamic_pointer_cast<numerics::TensorOpCreate>(create_op)->resetTensorElementType(accumulator->getElementType());
+ auto submitted = submit(create_op); if(!submitted) return false;
+ std::shared_ptr<TensorOperation> init_op = tensor_op_factory_->createTensorOp(TensorOpCode::TRANSFORM);
+ init_op->setTensorOperand(partial);
+ std::dynamic_pointer_cast<numerics::TensorOpTransform>(init_op)->
+  resetFunctor(std::shared_ptr<TensorMethod>(new numerics::FunctorInitVal(0.0)));
+ submitted = submit(init_op); if(!submitted) return false;
+ //Evaluate the tensor network components assigned to the current process subgroup:
+ std::string add_pattern;
+ auto generated = generate_addition_pattern(accumulator->getRank(),add_pattern); assert(generated);
+ std::list<std::shared_ptr<TensorOperation>> accumulations;
+ comp_id = 0;
+ for(auto component = expansion.begin(); component != expansion.end(); ++component, ++comp_id){
+  if(component_groups[comp_id] != static_cast<unsigned int>(my_group)) continue;
+  auto & network = *(component->network_);
+  submitted = submit(*subgroup,network); if(!submitted) return false;
+  if(subgroup_rank == 0){ //only one process per subgroup contributes to the reduction
+   bool conjugated;
+   auto output_tensor = network.getTensor(0,&conjugated); assert(!conjugated); //output tensor cannot be conjugated
+   std::shared_ptr<TensorOperation> op = tensor_op_factory_->createTensorOp(TensorOpCode::ADD);
+   op->setTensorOperand(partial);
+   op->setTensorOperand(output_tensor,conjugated);
+   op->setScalar(0,component->coefficient_);
+   op->setIndexPattern(add_pattern);
+   accumulations.emplace_back(op);
+  }
+ }
+ for(auto & accumulation: accumulations){
+  submitted = submit(accumulation); if(!submitted) return false;
+ }
+ //Reduce the contributions of all process subgroups into the accumulator:
+ std::shared_ptr<TensorOperation> allreduce = tensor_op_factory_->createTensorOp(TensorOpCode::ALLREDUCE);
+ allreduce->setTensorOperand(partial);
+ std::dynamic_pointer_cast<numerics::TensorOpAllreduce>(allreduce)->resetMPICommunicator(process_group.getMPICommProxy());
+ submitted = submit(allreduce); if(!submitted) return false;
+ std::shared_ptr<TensorOperation> add_op = tensor_op_factory_->createTensorOp(TensorOpCode::ADD);
+ add_op->setTensorOperand(accumulator);
+ add_op->setTensorOperand(partial);
+ add_op->setScalar(0,std::complex<double>{1.0,0.0});
+ add_op->setIndexPattern(add_pattern);
+ submitted = submit(add_op); if(!submitted) return false;
+ std::shared_ptr<TensorOperation> destroy_op = tensor_op_factory_->createTensorOp(TensorOpCode::DESTROY);
+ destroy_op->setTensorOperand(partial);
+ submitted = submit(destroy_op);
+ return submitted;
+}
+
+unsigned int NumServer::partitionProcessGroup(const ProcessGroup & process_group,
+                                              const std::vector<double> & flops,
+                                              const std::vector<double> & memory,
+                                              std::vector<unsigned int> & component_groups,
+                                              std::vector<std::pair<unsigned int,unsigned int>> & group_ranks) const
+{
+ assert(flops.size() == memory.size());
+ const unsigned int num_procs = process_group.getSize();
+ const auto num_components = flops.size();
+ assert(num_components > 0);
+ const unsigned int num_groups = std::min(static_cast<std::size_t>(num_procs),num_components);
+ //Distribute the components among the subgroups (longest processing time first):
+ std::vector<std::size_t> order(num_components);
+ for(std::size_t i = 0; i < num_components; ++i) order[i] = i;
+ std::stable_sort(order.begin(),order.end(),[&flops](std::size_t i, std::size_t j){return flops[i] > flops[j];});
+ std::vector<double> group_flops(num_groups,0.0);
+ std::vector<double> group_memory(num_groups,0.0);
+ component_groups.assign(num_components,0);
+ for(const auto comp: order){
+  const auto group = std::distance(group_flops.cbegin(),std::min_element(group_flops.cbegin(),group_flops.cend()));
+  component_groups[comp] = group;
+  group_flops[group] += flops[comp];
+  group_memory[group] = std::max(group_memory[group],memory[comp]);
+ }
+ //Each subgroup gets enough processes to hold its largest component, if possible:
+ const double proc_memory = static_cast<double>(process_group.getMemoryLimitPerProcess());
+ std::vector<unsigned int> group_sizes(num_groups,1);
+ unsigned int num_assigned = 0;
+ for(unsigned int i = 0; i < num_groups; ++i){
+  group_sizes[i] = std::max(1U,static_cast<unsigned int>(std::min(static_cast<double>(num_procs),std::ceil(group_memory[i]/proc_memory))));
+  num_assigned += group_sizes[i];
+ }
+ if(num_assigned > num_procs){ //memory footprints cannot be satisfied: Tensor slicing will take care of them
+  std::fill(group_sizes.begin(),group_sizes.end(),1);
+  num_assigned = num_groups;
+ }
+ //The remaining processes are distributed proportionally to the subgroup flop count:
+ while(num_assigned < num_procs){
+  unsigned int group = 0;
+  double max_load = -1.0;
+  for(unsigned int i = 0; i < num_groups; ++i){
+   const double load = (group_flops[i] + 1.0) / static_cast<double>(group_sizes[i]);
+   if(load > max_load){
+    max_load = load;
+    group = i;
+   }
+  }
+  ++group_sizes[group];
+  ++num_assigned;
+ }
+ //Each subgroup occupies a contiguous range of local process ranks:
+ group_ranks.resize(num_groups);
+ unsigned int first_rank = 0;
+ for(unsigned int i = 0; i < num_groups; ++i){
+  group_ranks[i] = std::make_pair(first_rank,first_rank+group_sizes[i]);
+  first_rank += group_sizes[i];
+ }
+ assert(first_rank == num_procs);
+ return num_groups;
+}
+
 bool NumServer::submit(const ProcessGroup & process_group,
                        std::shared_ptr<TensorExpansion> expansion,
                        std::shared_ptr<Tensor> accumulator)
@@ -1059,6 +1806,39 @@ bool NumServer::computeNorm2Sync(const std::string & name,
  return submitted;
 }
 
+bool NumServer::computeNormsSync(const std::string & name,
+                                double & norm1,
+                                double & norm2,
+                                double & maxabs)
+{
+ norm1 = -1.0; norm2 = -1.0; maxabs = -1.0;
+ auto iter = tensors_.find(name);
+ if(iter == tensors_.end()){
+  std::cout << "#ERROR(exatn::NumServer::computeNormsSync): Tensor " << name << " not found!" << std::endl;
+  return false;
+ }
+ auto functor_norm1 = std::make_shared<numerics::FunctorNorm1>();
+ auto functor_norm2 = std::make_shared<numerics::FunctorNorm2>();
+ auto functor_maxabs = std::make_shared<numerics::FunctorMaxAbs>();
+ auto functor = std::make_shared<numerics::FunctorFused>();
+ bool fused = functor->append(functor_norm1); assert(fused);
+ fused = functor->append(functor_norm2); assert(fused);
+ fused = functor->append(functor_maxabs); assert(fused);
+ std::shared_ptr<TensorOperation> op = tensor_op_factory_->createTensorOp(TensorOpCode::TRANSFORM);
+ op->setTensorOperand(iter->second);
+ std::dynamic_pointer_cast<numerics::TensorOpTransform>(op)->resetFunctor(functor);
+ auto submitted = submit(op);
+ if(submitted){
+  submitted = sync(*op);
+  if(submitted){
+   norm1 = functor_norm1->getNorm();
+   norm2 = functor_norm2->getNorm();
+   maxabs = functor_maxabs->getNorm();
+  }
+ }
+ return submitted;
+}
+
 bool NumServer::computePartialNormsSync(const std::string & name,            //in: tensor name
                                         unsigned int tensor_dimension,       //in: chosen tensor dimension
                                         std::vector<double> & partial_norms) //out: partial 2-norms over the chosen tensor dimension
@@ -1310,6 +2090,33 @@ bool NumServer::transformTensorSync(const std::string & name, const std::string
  return transformTensorSync(name,getTensorMethod(functor_name));
 }
 
+bool NumServer::transformTensor(std::shared_ptr<Tensor> tensor, std::shared_ptr<TensorMethod> functor)
+{
+ if(!tensor){
+  std::cout << "#ERROR(exatn::NumServer::transformTensor): Empty tensor handle!" << std::endl;
+  return false;
+ }
+ std::shared_ptr<TensorOperation> op = tensor_op_factory_->createTensorOp(TensorOpCode::TRANSFORM);
+ op->setTensorOperand(tensor);
+ std::dynamic_pointer_cast<numerics::TensorOpTransform>(op)->resetFunctor(functor);
+ auto submitted = submit(op);
+ return submitted;
+}
+
+bool NumServer::transformTensorSync(std::shared_ptr<Tensor> tensor, std::shared_ptr<TensorMethod> functor)
+{
+ if(!tensor){
+  std::cout << "#ERROR(exatn::NumServer::transformTensorSync): Empty tensor handle!" << std::endl;
+  return false;
+ }
+ std::shared_ptr<TensorOperation> op = tensor_op_factory_->createTensorOp(TensorOpCode::TRANSFORM);
+ op->setTensorOperand(tensor);
+ std::dynamic_pointer_cast<numerics::TensorOpTransform>(op)->resetFunctor(functor);
+ auto submitted = submit(op);
+ if(submitted) submitted = sync(*op);
+ return submitted;
+}
+
 bool NumServer::extractTensorSlice(const std::string & tensor_name,
                                    const std::string & slice_name)
 {
@@ -1412,6 +2219,133 @@ bool NumServer::insertTensorSliceSync(const std::string & tensor_name,
  return success;
 }
 
+std::shared_ptr<TensorOperation> NumServer::prepareTensorAddition(const std::string & addition)
+{
+ std::shared_ptr<TensorOperation> op;
+ std::vector<std::string> tensors;
+ auto parsed = parse_tensor_network(addition,tensors);
+ if(parsed){
+  if(tensors.size() == 2){
+   op = tensor_op_factory_->createTensorOp(TensorOpCode::ADD);
+   for(unsigned int i = 0; i < 2; ++i){
+    std::string tensor_name;
+    std::vector<IndexLabel> indices;
+    bool complex_conj;
+    parsed = parse_tensor(tensors[i],tensor_name,indices,complex_conj);
+    if(!parsed){
+     std::cout << "#ERROR(exatn::NumServer::prepareTensorAddition): Invalid argument#" << i
+               << " in tensor addition: " << addition << std::endl;
+     return std::shared_ptr<TensorOperation>(nullptr);
+    }
+    assert(i > 0 || !complex_conj);
+    auto iter = tensors_.find(tensor_name);
+    if(iter == tensors_.end()){
+     std::cout << "#ERROR(exatn::NumServer::prepareTensorAddition): Tensor " << tensor_name
+               << " not found in tensor addition: " << addition << std::endl;
+     return std::shared_ptr<TensorOperation>(nullptr);
+    }
+    op->setTensorOperand(iter->second,complex_conj);
+   }
+   op->setIndexPattern(addition);
+  }else{
+   std::cout << "#ERROR(exatn::NumServer::prepareTensorAddition): Invalid number of arguments in tensor addition: "
+             << addition << std::endl;
+  }
+ }else{
+  std::cout << "#ERROR(exatn::NumServer::prepareTensorAddition): Invalid tensor addition: " << addition << std::endl;
+ }
+ return op;
+}
+
+std::shared_ptr<TensorOperation> NumServer::prepareTensorContraction(const std::string & contraction)
+{
+ std::shared_ptr<TensorOperation> op;
+ std::vector<std::string> tensors;
+ auto parsed = parse_tensor_network(contraction,tensors);
+ if(parsed){
+  if(tensors.size() == 3){
+   op = tensor_op_factory_->createTensorOp(TensorOpCode::CONTRACT);
+   for(unsigned int i = 0; i < 3; ++i){
+    std::string tensor_name;
+    std::vector<IndexLabel> indices;
+    bool complex_conj;
+    parsed = parse_tensor(tensors[i],tensor_name,indices,complex_conj);
+    if(!parsed){
+     std::cout << "#ERROR(exatn::NumServer::prepareTensorContraction): Invalid argument#" << i
+               << " in tensor contraction: " << contraction << std::endl;
+     return std::shared_ptr<TensorOperation>(nullptr);
+    }
+    assert(i > 0 || !complex_conj);
+    auto iter = tensors_.find(tensor_name);
+    if(iter == tensors_.end()){
+     std::cout << "#ERROR(exatn::NumServer::prepareTensorContraction): Tensor " << tensor_name
+               << " not found in tensor contraction: " << contraction << std::endl;
+     return std::shared_ptr<TensorOperation>(nullptr);
+    }
+    op->setTensorOperand(iter->second,complex_conj);
+   }
+   op->setIndexPattern(contraction);
+  }else{
+   std::cout << "#ERROR(exatn::NumServer::prepareTensorContraction): Invalid number of arguments in tensor contraction: "
+             << contraction << std::endl;
+  }
+ }else{
+  std::cout << "#ERROR(exatn::NumServer::prepareTensorContraction): Invalid tensor contraction: " << contraction << std::endl;
+ }
+ return op;
+}
+
+bool NumServer::contractTensorsBatch(const std::vector<std::shared_ptr<TensorOperation>> & contractions)
+{
+ std::vector<std::shared_ptr<numerics::TensorOpContractBatch>> batches;
+ for(const auto & contraction: contractions){
+  if(!contraction || contraction->getOpcode() != TensorOpCode::CONTRACT || !(contraction->isSet())){
+   std::cout << "#ERROR(exatn::NumServer::contractTensorsBatch): Invalid or incomplete tensor contraction!" << std::endl;
+   return false;
+  }
+  //Append the tensor contraction to the latest compatible batch unless
+  //a batch created after it references any of its tensor operands:
+  bool appended = false;
+  for(auto batch = batches.rbegin(); batch != batches.rend(); ++batch){
+   appended = (*batch)->appendContraction(*contraction);
+   if(appended) break;
+   bool dependent = false;
+   for(unsigned int i = 0; i < contraction->getNumOperands(); ++i){
+    if((*batch)->referencesTensor(*(contraction->getTensorOperand(i)))){dependent = true; break;}
+   }
+   if(dependent) break;
+  }
+  if(!appended){
+   batches.emplace_back(std::dynamic_pointer_cast<numerics::TensorOpContractBatch>(
+    tensor_op_factory_->createTensorOpShared(TensorOpCode::CONTRACT_BATCH)));
+   appended = batches.back()->appendContraction(*contraction);
+   if(!appended){
+    std::cout << "#ERROR(exatn::NumServer::contractTensorsBatch): Tensor contraction cannot be batched "
+              << "(beta prefactor other than 0 or 1): " << contraction->getIndexPattern() << std::endl;
+    return false;
+   }
+  }
+ }
+ bool submitted = true;
+ for(auto & batch: batches){
+  submitted = submit(std::static_pointer_cast<TensorOperation>(batch));
+  if(!submitted) break;
+ }
+ return submitted;
+}
+
+bool NumServer::contractTensorsBatchSync(const std::vector<std::shared_ptr<TensorOperation>> & contractions)
+{
+ bool submitted = contractTensorsBatch(contractions);
+ if(submitted){
+  for(const auto & contraction: contractions){
+   submitted = sync(*(contraction->getTensorOperand(0)));
+   if(!submitted) break;
+  }
+ }
+ return submitted;
+}
+
 bool NumServer::decomposeTensorSVD(const std::string & contraction)
 {
  std::vector<std::string> tensors;
@@ -1758,6 +2692,241 @@ bool NumServer::decomposeTensorSVDLRSync(const std::string & contraction)
  return parsed;
 }
 
+bool NumServer::decomposeTensorSVDTruncSync(const std::string & contraction,
+                                            std::size_t max_rank,
+                                            double cutoff,
+                                            double * truncation_error)
+{
+ return decomposeTensorSVDTrunc(contraction,'N',max_rank,cutoff,truncation_error);
+}
+
+bool NumServer::decomposeTensorSVDLTruncSync(const std::string & contraction,
+                                             std::size_t max_rank,
+                                             double cutoff,
+                                             double * truncation_error)
+{
+ return decomposeTensorSVDTrunc(contraction,'L',max_rank,cutoff,truncation_error);
+}
+
+bool NumServer::decomposeTensorSVDRTruncSync(const std::string & contraction,
+                                             std::size_t max_rank,
+                                             double cutoff,
+                                             double * truncation_error)
+{
+ return decomposeTensorSVDTrunc(contraction,'R',max_rank,cutoff,truncation_error);
+}
+
+bool NumServer::decomposeTensorSVDLRTruncSync(const std::string & contraction,
+                                              std::size_t max_rank,
+                                              double cutoff,
+                                              double * truncation_error)
+{
+ return decomposeTensorSVDTrunc(contraction,'S',max_rank,cutoff,truncation_error);
+}
+
+bool NumServer::decomposeTensorSVDTrunc(const std::string & contraction,
+                                        char absorption,
+                                        std::size_t max_rank,
+                                        double cutoff,
+                                        double * truncation_error)
+{
+ const std::size_t num_factors = ((absorption == 'N') ? 3 : 2);
+ std::vector<std::string> tensors;
+ auto parsed = parse_tensor_network(contraction,tensors);
+ if(!parsed || tensors.size() != num_factors + 1){
+  std::cout << "#ERROR(exatn::NumServer::decomposeTensorSVDTrunc): Invalid tensor contraction: "
+            << contraction << std::endl;
+  return false;
+ }
+ //Parse the decomposed tensor and its tensor factors: D = L * R or D = L * S * R:
+ std::vector<std::string> names(tensors.size());
+ std::vector<std::vector<IndexLabel>> indices(tensors.size());
+ for(std::size_t i = 0; i < tensors.size(); ++i){
+  bool complex_conj;
+  parsed = parse_tensor(tensors[i],names[i],indices[i],complex_conj);
+  if(!parsed || complex_conj){
+   std::cout << "#ERROR(exatn::NumServer::decomposeTensorSVDTrunc): Invalid argument#" << i << " in tensor contraction: "
+             << contraction << std::endl;
+   return false;
+  }
+  for(std::size_t j = 0; j < i; ++j){
+   if(names[j] == names[i]){
+    std::cout << "#ERROR(exatn::NumServer::decomposeTensorSVDTrunc): Repeated tensor " << names[i] << " in tensor contraction: "
+              << contraction << std::endl;
+    return false;
+   }
+  }
+ }
+ auto iter = tensors_.find(names[0]);
+ if(iter == tensors_.end()){
+  std::cout << "#ERROR(exatn::NumServer::decomposeTensorSVDTrunc): Tensor " << names[0] << " not found in tensor contraction: "
+            << contraction << std::endl;
+  return false;
+ }
+ auto tensor = iter->second;
+ const auto & tensor_indices = indices[0];
+ if(tensor_indices.size() != tensor->getRank()){
+  std::cout << "#ERROR(exatn::NumServer::decomposeTensorSVDTrunc): Invalid rank of tensor " << names[0] << " in tensor contraction: "
+            << contraction << std::endl;
+  return false;
+ }
+ //Map the dimensions of the left and right tensor factors to the dimensions of the decomposed tensor (-1: bond dimension):
+ std::string bond_label;
+ std::vector<unsigned int> dim_use(tensor_indices.size(),0);
+ auto map_dims = [&](const std::vector<IndexLabel> & factor_indices, std::vector<int> & dims){
+  for(const auto & index: factor_indices){
+   int pos = -1;
+   for(unsigned int i = 0; i < tensor_indices.size(); ++i){
+    if(tensor_indices[i].label == index.label) pos = i;
+   }
+   if(pos >= 0){
+    if(dim_use[pos]++ > 0) return false;
+   }else{
+    if(bond_label.empty()) bond_label = index.label;
+    if(index.label != bond_label || std::find(dims.cbegin(),dims.cend(),-1) != dims.cend()) return false;
+   }
+   dims.emplace_back(pos);
+  }
+  return (std::find(dims.cbegin(),dims.cend(),-1) != dims.cend());
+ };
+ std::vector<int> left_dims, right_dims;
+ bool valid = map_dims(indices[1],left_dims) && map_dims(indices[num_factors],right_dims);
+ for(const auto & use: dim_use) valid = valid && (use == 1);
+ if(num_factors == 3) valid = valid && (indices[2].size() == 1 && indices[2][0].label == bond_label);
+ if(!valid){
+  std::cout << "#ERROR(exatn::NumServer::decomposeTensorSVDTrunc): Tensor contraction must contain strictly one contracted index: "
+            << contraction << std::endl;
+  return false;
+ }
+ //Compute the truncated SVD on the local copy of the decomposed tensor:
+ if(!sync(*tensor)) return false;
+ auto local_tensor = getLocalTensor(tensor);
+ if(!local_tensor) return false;
+ std::vector<std::string> factors{names[1],names[num_factors]};
+ if(num_factors == 3) factors.emplace_back(names[2]);
+ switch(tensor->getElementType()){
+ case TensorElementType::REAL32:
+  return decomposeTensorSVDTruncLocal<float>(*tensor,*local_tensor,factors,left_dims,right_dims,
+                                             absorption,max_rank,cutoff,truncation_error);
+ case TensorElementType::REAL64:
+  return decomposeTensorSVDTruncLocal<double>(*tensor,*local_tensor,factors,left_dims,right_dims,
+                                              absorption,max_rank,cutoff,truncation_error);
+ case TensorElementType::COMPLEX32:
+  return decomposeTensorSVDTruncLocal<std::complex<float>>(*tensor,*local_tensor,factors,left_dims,right_dims,
+                                                           absorption,max_rank,cutoff,truncation_error);
+ case TensorElementType::COMPLEX64:
+  return decomposeTensorSVDTruncLocal<std::complex<double>>(*tensor,*local_tensor,factors,left_dims,right_dims,
+                                                            absorption,max_rank,cutoff,truncation_error);
+ default:
+  std::cout << "#ERROR(exatn::NumServer::decomposeTensorSVDTrunc): Unsupported element type of tensor " << names[0]
+            << std::endl;
+ }
+ return false;
+}
+
+template<typename NumericType>
+bool NumServer::decomposeTensorSVDTruncLocal(const Tensor & tensor,
+                                             const talsh::Tensor & local_tensor,
+                                             const std::vector<std::string> & factors,
+                                             const std::vector<int> & left_dims,
+                                             const std::vector<int> & right_dims,
+                                             char absorption,
+                                             std::size_t max_rank,
+                                             double cutoff,
+                                             double * truncation_error)
+{
+ const NumericType * body = nullptr;
+ if(!local_tensor.getDataAccessHostConst(&body)) return false;
+ //Matricize the tensor: Rows are spanned by the left factor dimensions, columns by the right ones:
+ const auto & extents = tensor.getDimExtents();
+ const auto rank = extents.size();
+ std::vector<std::size_t> row_strides(rank,0), col_strides(rank,0);
+ std::size_t num_rows = 1, num_cols = 1;
+ for(const auto & dim: left_dims){
+  if(dim >= 0){row_strides[dim] = num_rows; num_rows *= extents[dim];}
+ }
+ for(const auto & dim: right_dims){
+  if(dim >= 0){col_strides[dim] = num_cols; num_cols *= extents[dim];}
+ }
+ if(num_rows * num_cols != local_tensor.getVolume()) return false;
+ std::vector<NumericType> matrix(num_rows * num_cols);
+ std::vector<DimExtent> mlndx(rank,0);
+ for(std::size_t offset = 0; offset < matrix.size(); ++offset){
+  std::size_t row = 0, col = 0;
+  for(unsigned int i = 0; i < rank; ++i){
+   row += mlndx[i] * row_strides[i];
+   col += mlndx[i] * col_strides[i];
+  }
+  matrix[row + col * num_rows] = body[offset];
+  for(unsigned int i = 0; i < rank; ++i){
+   if(++mlndx[i] < extents[i]) break;
+   mlndx[i] = 0;
+  }
+ }
+ //Truncated SVD: Matrix ~ U * diag(S) * V^H:
+ std::vector<NumericType> u, v;
+ std::vector<double> s;
+ const double error = numerics::computeTruncatedSVD(num_rows,num_cols,matrix.data(),max_rank,cutoff,u,s,v);
+ if(truncation_error != nullptr) *truncation_error = error;
+ const std::size_t bond_extent = s.size();
+ std::vector<double> left_scale(bond_extent,1.0), right_scale(bond_extent,1.0);
+ for(std::size_t i = 0; i < bond_extent; ++i){
+  if(absorption == 'L') left_scale[i] = s[i];
+  if(absorption == 'R') right_scale[i] = s[i];
+  if(absorption == 'S') left_scale[i] = right_scale[i] = std::sqrt(s[i]);
+ }
+ //(Re)create a tensor factor with the truncated bond extent and initialize it with the singular vectors:
+ auto create_factor = [&](const std::string & name, const std::vector<int> & dims,
+                          const std::vector<NumericType> & vectors, std::size_t num_vector_rows,
+                          const std::vector<double> & scale, bool conjugate){
+  const auto factor_rank = dims.size();
+  std::vector<DimExtent> factor_extents(factor_rank);
+  std::vector<std::pair<SpaceId,SubspaceId>> factor_signature(factor_rank);
+  for(unsigned int i = 0; i < factor_rank; ++i){
+   if(dims[i] >= 0){
+    factor_extents[i] = extents[dims[i]];
+    factor_signature[i] = tensor.getDimSpaceAttr(dims[i]);
+   }else{
+    factor_extents[i] = bond_extent;
+    factor_signature[i] = std::make_pair(SOME_SPACE,SubspaceId{0});
+   }
+  }
+  auto factor = std::make_shared<Tensor>(name,factor_extents,factor_signature);
+  std::vector<NumericType> data(factor->getVolume());
+  std::vector<DimExtent> factor_mlndx(factor_rank,0);
+  for(std::size_t offset = 0; offset < data.size(); ++offset){
+   std::size_t row = 0, bond = 0, stride = 1;
+   for(unsigned int i = 0; i < factor_rank; ++i){
+    if(dims[i] >= 0){
+     row += factor_mlndx[i] * stride;
+     stride *= factor_extents[i];
+    }else{
+     bond = factor_mlndx[i];
+    }
+   }
+   const auto & elem = vectors[row + bond * num_vector_rows];
+   data[offset] = (conjugate ? numerics::conjugated(elem) : elem) * NumericType(scale[bond]);
+   for(unsigned int i = 0; i < factor_rank; ++i){
+    if(++factor_mlndx[i] < factor_extents[i]) break;
+    factor_mlndx[i] = 0;
+   }
+  }
+  if(tensors_.find(name) != tensors_.end()){
+   if(!destroyTensorSync(name)) return false;
+  }
+  if(!createTensorSync(factor,tensor.getElementType())) return false;
+  return initTensorDataSync(name,data);
+ };
+ bool success = create_factor(factors[0],left_dims,u,num_rows,left_scale,false);
+ if(success) success = create_factor(factors[1],right_dims,v,num_cols,right_scale,true);
+ if(success && factors.size() > 2){
+  std::vector<NumericType> singular_values(bond_extent);
+  for(std::size_t i = 0; i < bond_extent; ++i) singular_values[i] = NumericType(s[i]);
+  success = create_factor(factors[2],std::vector<int>{-1},singular_values,1,right_scale,false);
+ }
+ return success;
+}
+
 bool NumServer::orthogonalizeTensorSVD(const std::string & contraction)
 {
  std::vector<std::string> tensors;
@@ -2021,6 +3190,207 @@ bool NumServer::evaluateTensorNetworkSync(const ProcessGroup & process_group,
  return parsed;
 }
 
+bool NumServer::createTensorBlockSparse(const std::string & name,
+                                        TensorElementType element_type,
+                                        const std::vector<std::string> & space_names,
+                                        const std::vector<LegDirection> & directions,
+                                        SymmetryId total_symmetry,
+                                        SymmetryId modulus)
+{
+ if(block_sparse_tensors_.find(name) != block_sparse_tensors_.end()){
+  std::cout << "#ERROR(exatn::NumServer::createTensorBlockSparse): Block-sparse tensor " << name << " already exists!" << std::endl;
+  return false;
+ }
+ if(space_names.size() != directions.size()){
+  std::cout << "#ERROR(exatn::NumServer::createTensorBlockSparse): Mismatch in the number of tensor dimensions!" << std::endl;
+  return false;
+ }
+ std::vector<const VectorSpace*> spaces;
+ for(const auto & space_name: space_names){
+  const auto * space = space_register_->getSpace(space_name);
+  if(space == nullptr || space_name.empty()){
+   std::cout << "#ERROR(exatn::NumServer::createTensorBlockSparse): Vector space " << space_name << " not found!" << std::endl;
+   return false;
+  }
+  spaces.emplace_back(space);
+ }
+ auto tensor = std::make_shared<BlockSparseTensor>(name,spaces,directions,total_symmetry,modulus);
+ bool success = true;
+ const auto & blocks = tensor->getBlocks();
+ for(const auto & block: blocks){
+  if(tensors_.find(block.tensor->getName()) != tensors_.end()){
+   std::cout << "#ERROR(exatn::NumServer::createTensorBlockSparse): Block " << block.tensor->getName()
+             << " of block-sparse tensor " << name << " clashes with an existing tensor!" << std::endl;
+   return false;
+  }
+ }
+ std::size_t num_created = 0;
+ for(const auto & block: blocks){
+  success = createTensor(block.tensor,element_type);
+  if(!success) break;
+  ++num_created;
+ }
+ if(success){
+  block_sparse_tensors_.emplace(std::make_pair(name,tensor));
+ }else{ //destroy the already created blocks
+  std::cout << "#ERROR(exatn::NumServer::createTensorBlockSparse): Unable to create block "
+            << blocks[num_created].tensor->getName() << " of block-sparse tensor " << name << std::endl;
+  for(std::size_t i = 0; i < num_created; ++i){
+   auto destroyed = destroyTensor(blocks[i].tensor->getName()); assert(destroyed);
+  }
+ }
+ return success;
+}
+
+bool NumServer::destroyTensorBlockSparse(const std::string & name)
+{
+ auto iter = block_sparse_tensors_.find(name);
+ if(iter == block_sparse_tensors_.end()){
+  std::cout << "#WARNING(exatn::NumServer::destroyTensorBlockSparse): Block-sparse tensor " << name << " not found!" << std::endl;
+  return false;
+ }
+ bool success = true;
+ for(const auto & block: iter->second->getBlocks()){
+  const auto & block_name = block.tensor->getName();
+  if(tensorAllocated(block_name)){
+   if(!destroyTensor(block_name)) success = false;
+  }
+ }
+ block_sparse_tensors_.erase(iter);
+ return success;
+}
+
+std::shared_ptr<BlockSparseTensor> NumServer::getTensorBlockSparse(const std::string & name)
+{
+ auto iter = block_sparse_tensors_.find(name);
+ if(iter == block_sparse_tensors_.end()) return std::shared_ptr<BlockSparseTensor>(nullptr);
+ return iter->second;
+}
+
+bool NumServer::initTensorRndBlockSparse(const std::string & name)
+{
+ auto iter = block_sparse_tensors_.find(name);
+ if(iter == block_sparse_tensors_.end()){
+  std::cout << "#ERROR(exatn::NumServer::initTensorRndBlockSparse): Block-sparse tensor " << name << " not found!" << std::endl;
+  return false;
+ }
+ bool success = true;
+ for(const auto & block: iter->second->getBlocks()){
+  success = initTensorRnd(block.tensor->getName());
+  if(!success) break;
+ }
+ return success;
+}
+
+template<typename NormFunctor>
+bool NumServer::computeNormBlockSparseSync(const std::string & name,
+                                           std::vector<double> & block_norms)
+{
+ block_norms.clear();
+ auto iter = block_sparse_tensors_.find(name);
+ if(iter == block_sparse_tensors_.end()){
+  std::cout << "#ERROR(exatn::NumServer::computeNormBlockSparseSync): Block-sparse tensor " << name << " not found!" << std::endl;
+  return false;
+ }
+ //Submit all block norms first, then synchronize on them:
+ std::vector<std::shared_ptr<TensorMethod>> functors;
+ std::vector<std::shared_ptr<TensorOperation>> ops;
+ for(const auto & block: iter->second->getBlocks()){
+  functors.emplace_back(std::shared_ptr<TensorMethod>(new NormFunctor()));
+  ops.emplace_back(tensor_op_factory_->createTensorOp(TensorOpCode::TRANSFORM));
+  ops.back()->setTensorOperand(block.tensor);
+  std::dynamic_pointer_cast<numerics::TensorOpTransform>(ops.back())->resetFunctor(functors.back());
+  if(!submit(ops.back())) return false;
+ }
+ for(std::size_t i = 0; i < ops.size(); ++i){
+  if(!sync(*(ops[i]))) return false;
+  block_norms.emplace_back(std::dynamic_pointer_cast<NormFunctor>(functors[i])->getNorm());
+ }
+ return true;
+}
+
+bool NumServer::computeMaxAbsBlockSparseSync(const std::string & name,
+                                             double & norm)
+{
+ norm = -1.0;
+ std::vector<double> block_norms;
+ auto success = computeNormBlockSparseSync<numerics::FunctorMaxAbs>(name,block_norms);
+ if(success){
+  norm = 0.0;
+  for(const auto & block_norm: block_norms) norm = std::max(norm,block_norm);
+ }
+ return success;
+}
+
+bool NumServer::computeNorm1BlockSparseSync(const std::string & name,
+                                            double & norm)
+{
+ norm = -1.0;
+ std::vector<double> block_norms;
+ auto success = computeNormBlockSparseSync<numerics::FunctorNorm1>(name,block_norms);
+ if(success){
+  norm = 0.0;
+  for(const auto & block_norm: block_norms) norm += block_norm;
+ }
+ return success;
+}
+
+bool NumServer::computeNorm2BlockSparseSync(const std::string & name,
+                                            double & norm)
+{
+ norm = -1.0;
+ std::vector<double> block_norms;
+ auto success = computeNormBlockSparseSync<numerics::FunctorNorm2>(name,block_norms);
+ if(success){
+  norm = 0.0;
+  for(const auto & block_norm: block_norms) norm += block_norm * block_norm;
+  norm = std::sqrt(norm);
+ }
+ return success;
+}
+
+bool NumServer::expandBlockSparse(const std::string & operation,
+                                  unsigned int num_inputs,
+                                  std::vector<std::string> & block_ops)
+{
+ block_ops.clear();
+ std::vector<std::string> tensors;
+ if(!parse_tensor_network(operation,tensors)) return false;
+ if(tensors.size() != (num_inputs + 1)) return false;
+ std::vector<std::shared_ptr<BlockSparseTensor>> operands(tensors.size());
+ std::vector<std::vector<IndexLabel>> indices(tensors.size());
+ std::vector<std::vector<std::string>> labels(tensors.size());
+ std::vector<bool> conjugated(tensors.size());
+ for(unsigned int i = 0; i < tensors.size(); ++i){
+  std::string tensor_name;
+  bool conj = false;
+  if(!parse_tensor(tensors[i],tensor_name,indices[i],conj)) return false;
+  conjugated[i] = conj;
+  auto iter = block_sparse_tensors_.find(tensor_name);
+  if(iter == block_sparse_tensors_.end()){
+   std::cout << "#ERROR(exatn::NumServer::expandBlockSparse): Block-sparse tensor " << tensor_name << " not found!" << std::endl;
+   return false;
+  }
+  operands[i] = iter->second;
+  for(const auto & index: indices[i]) labels[i].emplace_back(index.label);
+ }
+ std::vector<std::vector<std::size_t>> matches;
+ bool matched = BlockSparseTensor::matchBlocks(*(operands[0]),labels[0],*(operands[1]),labels[1],
+                                               (num_inputs > 1) ? operands[2].get() : nullptr,
+                                               (num_inputs > 1) ? labels[2] : std::vector<std::string>{},
+                                               matches);
+ if(!matched) return false;
+ for(const auto & match: matches){
+  std::vector<std::string> block_tensors;
+  for(unsigned int i = 0; i < tensors.size(); ++i){
+   const auto & block_name = operands[i]->getBlocks()[match[i]].tensor->getName();
+   block_tensors.emplace_back(assemble_symbolic_tensor(block_name,indices[i],conjugated[i]));
+  }
+  block_ops.emplace_back(assemble_symbolic_tensor_network(block_tensors));
+ }
+ return true;
+}
+
 std::shared_ptr<talsh::Tensor> NumServer::getLocalTensor(std::shared_ptr<Tensor> tensor, //in: exatn::numerics::Tensor to get slice of (by copy)
                          const std::vector<std::pair<DimOffset,DimExtent>> & slice_spec) //in: tensor slice specification
 {
@@ -1,5 +1,5 @@
 /** ExaTN::Numerics: Numerical server
-REVISION: 2020/11/16
+REVISION: 2020/12/14
 
 Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
@@ -30,6 +30,49 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
      defines the interface which needs to be implemented by the application in order
      to perform an arbitrary custom unary transform operation on exatn::Tensor.
      This is the only portable way to arbitrarily modify tensor content.
+ (d) In the mixed-precision mode, all intermediate tensors of a tensor network
+     are computed in the lower precision (REAL64->REAL32, COMPLEX64->COMPLEX32)
+     whereas the input and output tensors of the tensor network, as well as
+     tensor expansion accumulators, retain their own precision. The runtime
+     converts tensor operands of different precision on the fly. The mixed-precision
+     mode can be activated globally or decided per tensor network (by its name)
+     via error-controlled calibration; a per-network decision takes precedence.
+ (e) Batched evaluation of a tensor network, where each batch item substitutes
+     a subset of its (boundary) input tensors, e.g., output projectors of a quantum
+     circuit, contracts the shared trunk (a subset of the non-boundary tensors)
+     only once. Each batch item then contracts the trunk output with the rest of
+     the tensor network (branch) containing its own boundary tensors, reusing the
+     same contraction sequence for all items. The trunk is chosen such that its
+     output tensor, which keeps all legs to the branch open, takes at most half of
+     the memory limit per process (see TensorNetwork::selectBatchTrunk). If there
+     is no such trunk, each batch item is evaluated as the whole tensor network.
+ (f) Intermediate tensor caching keeps the intermediates of evaluated tensor
+     networks alive (within a memory budget) for later reuse. Each intermediate
+     is identified by the structure of its contraction subtree and the names of
+     the input tensors it depends on (the full subtree signature is the cache key). Any subsequent update of an input tensor
+     evicts all cached intermediates depending on it, such that a re-evaluation
+     of the tensor network after an update of a single input tensor only
+     recomputes the contraction path from that tensor to the root.
+ (g) In the expansion parallelism mode, the components of a tensor network expansion
+     are evaluated concurrently by disjoint process subgroups instead of being
+     evaluated one after another by the whole process group. The components are
+     distributed among the subgroups based on their estimated flop count, whereas
+     the processes are distributed among the subgroups based on the subgroup
+     flop count and memory footprint. The contributions of all subgroups are
+     reduced into the accumulator tensor once at the end. In this mode, the output
+     tensors of the expansion components only exist within their subgroups.
+ (h) Each TAProL scope is executed by the runtime as a separate DAG. A parental scope
+     keeps executing its outstanding tensor operations concurrently with its child
+     scopes, issuing tensor operations according to the scope priorities (the memory
+     and threads of the runtime are not partitioned between the scopes).
+     Tensor operations on the tensors shared between the scopes are serialized.
+ (i) A block-sparse tensor is defined over vector spaces with symmetry subranges
+     and is stored as a collection of dense tensor blocks allowed by symmetry.
+     Tensor operations on block-sparse tensors are expanded into tensor operations
+     on the compatible block combinations, skipping the blocks vanishing by symmetry.
+ (j) Truncated SVD decompositions determine the retained rank at run time, thus they
+     are synchronous: The decomposed tensor is matricized and decomposed locally,
+     after which its tensor factors are (re)created with the truncated bond extent.
 **/
 
 #ifndef EXATN_NUM_SERVER_HPP_
@@ -45,6 +88,7 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
 #include "tensor_network.hpp"
 #include "tensor_operator.hpp"
 #include "tensor_expansion.hpp"
+#include "tensor_block_sparse.hpp"
 #include "network_build_factory.hpp"
 #include "contraction_seq_optimizer_factory.hpp"
 
@@ -60,6 +104,7 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
 #include "functor_norm1.hpp"
 #include "functor_norm2.hpp"
 #include "functor_diag_rank.hpp"
+#include "functor_fused.hpp"
 
 #include <iostream>
 #include <fstream>
@@ -69,6 +114,8 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
 #include <stack>
 #include <list>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "errors.hpp"
 
@@ -78,6 +125,7 @@ namespace exatn{
 
 //Primary numerics:: types exposed to the user:
 using numerics::VectorSpace;
+using numerics::SymmetryRange;
 using numerics::Subspace;
 using numerics::TensorRange;
 using numerics::TensorShape;
@@ -89,6 +137,7 @@ using numerics::TensorOpFactory;
 using numerics::TensorNetwork;
 using numerics::TensorOperator;
 using numerics::TensorExpansion;
+using numerics::BlockSparseTensor;
 
 using numerics::NetworkBuilder;
 using numerics::NetworkBuildFactory;
@@ -104,9 +153,15 @@ using numerics::FunctorMaxAbs;
 using numerics::FunctorNorm1;
 using numerics::FunctorNorm2;
 using numerics::FunctorDiagRank;
+using numerics::FunctorFused;
+
+using numerics::TensorMethodConcurrency;
+using numerics::TensorMethodConcurrencyTrait;
 
 using TensorMethod = talsh::TensorFunctor<Identifiable>;
 
+using runtime::ScopeProgress; //execution progress of a TAProL scope
+
 
 //Numerical Server:
 class NumServer final {
@@ -153,6 +208,41 @@ public:
  /** Deactivates optimized tensor contraction sequence caching. **/
  void deactivateContrSeqCaching();
 
+ /** Activates the mixed-precision evaluation of tensor networks (see Rationale (d)). **/
+ void activateMixedPrecision();
+
+ /** Deactivates the mixed-precision evaluation of tensor networks,
+     including the per-network decisions made by calibrateMixedPrecisionSync. **/
+ void deactivateMixedPrecision();
+
+ /** Returns whether the mixed-precision evaluation of tensor networks is globally active. **/
+ bool mixedPrecisionIsActive() const;
+
+ /** Returns whether the mixed-precision evaluation is active for a given tensor network:
+     The decision made by calibrateMixedPrecisionSync for this tensor network, if any,
+     otherwise the global mode. **/
+ bool mixedPrecisionIsActive(const std::string & network_name) const; //in: tensor network name
+
+ /** Activates caching of intermediate tensors across tensor network evaluations
+     within the given memory budget (see Rationale (f)). **/
+ void activateIntermediateCaching(std::size_t memory_limit); //in: memory budget for cached intermediates (bytes)
+
+ /** Deactivates caching of intermediate tensors and destroys all cached intermediates. **/
+ void deactivateIntermediateCaching();
+
+ /** Returns whether caching of intermediate tensors is active. **/
+ bool intermediateCachingIsActive() const;
+
+ /** Activates concurrent evaluation of tensor network expansion
+     components by process subgroups (see Rationale (g)). **/
+ void activateExpansionParallelism();
+
+ /** Deactivates concurrent evaluation of tensor network expansion components. **/
+ void deactivateExpansionParallelism();
+
+ /** Returns whether concurrent evaluation of tensor network expansion components is active. **/
+ bool expansionParallelismIsActive() const;
+
  /** Resets the client logging level (0:none). **/
  void resetClientLoggingLevel(int level = 0);
 
@@ -162,6 +252,9 @@ public:
  /** Returns the Host memory buffer size in bytes provided by the runtime. **/
  std::size_t getMemoryBufferSize() const;
 
+ /** Returns the peak memory usage in bytes observed by the runtime (0: not tracked). **/
+ std::size_t getPeakMemorySize() const;
+
  /** Returns the default process group comprising all MPI processes and their communicator. **/
  const ProcessGroup & getDefaultProcessGroup() const;
 
@@ -185,7 +278,7 @@ public:
  void registerExternalData(const std::string & tag,
                            std::shared_ptr<BytePacket> packet);
 
- /** Retrieves a registered external data packet. **/
+ /** Retrieves a registered external data packet (nullptr if not found). **/
  std::shared_ptr<BytePacket> getExternalData(const std::string & tag);
 
 
@@ -195,6 +288,21 @@ public:
  /** Closes the currently open TAProL scope and returns its parental scope id. **/
  ScopeId closeScope();
 
+ /** Pauses the execution of the currently open TAProL scope: Its tensor operations are
+     no longer issued until the scope is resumed (upon closing its child scope), except those
+     conflicting with tensor operations submitted into other scopes, which are still executed. **/
+ void pauseScope();
+
+ /** Sets the fair-share priority (default 1) of an open TAProL scope
+     executed concurrently with other open scopes (see Rationale (h)). **/
+ void setScopePriority(const std::string & scope_name, //in: open scope name
+                       unsigned int priority);         //in: scope priority (>0)
+
+ /** Retrieves the execution progress of an open TAProL scope.
+     Returns FALSE if the scope is not open. **/
+ bool getScopeProgress(const std::string & scope_name, //in: open scope name
+                       ScopeProgress & progress);      //out: execution progress of the scope
+
 
  /** Creates a named vector space, returns its registered id, and,
      optionally, a non-owning pointer to it. **/
@@ -202,6 +310,13 @@ public:
                            DimExtent space_dim,                       //in: vector space dimension
                            const VectorSpace ** space_ptr = nullptr); //out: non-owning pointer to the created vector space
 
+ /** Creates a named vector space with symmetry subranges, returns its registered id,
+     and, optionally, a non-owning pointer to it (see numerics::BlockSparseTensor). **/
+ SpaceId createVectorSpace(const std::string & space_name,                        //in: vector space name
+                           DimExtent space_dim,                                   //in: vector space dimension
+                           const std::vector<SymmetryRange> & symmetry_subranges, //in: symmetry subranges
+                           const VectorSpace ** space_ptr = nullptr);             //out: non-owning pointer to the created vector space
+
  /** Destroys a previously created named vector space. **/
  void destroyVectorSpace(const std::string & space_name); //in: name of the vector space to destroy
  void destroyVectorSpace(SpaceId space_id);               //in: id of the vector space to destroy
@@ -258,6 +373,51 @@ public:
              std::shared_ptr<TensorExpansion> expansion,  //in: tensor expansion for numerical evaluation
              std::shared_ptr<Tensor> accumulator);        //inout: tensor accumulator (result)
 
+ /** Partitions the process group into subgroups for concurrent evaluation of
+     tensor network components with the given cost estimates (expansion parallelism).
+     Returns the number of subgroups, the subgroup of each component, and the local
+     process ranks of each subgroup (contiguous range). No communication is involved. **/
+ unsigned int partitionProcessGroup(const ProcessGroup & process_group,                 //in: chosen group of MPI processes
+                                    const std::vector<double> & flops,                  //in: flop count estimate per component
+                                    const std::vector<double> & memory,                 //in: memory footprint estimate per component (bytes)
+                                    std::vector<unsigned int> & component_groups,       //out: subgroup of each component
+                                    std::vector<std::pair<unsigned int,unsigned int>> & group_ranks) const; //out: local process rank range [begin,end) of each subgroup
+
+ /** Evaluates a tensor network in full and mixed precision and activates the mixed-precision
+     mode for this tensor network (by its name) only if the relative 2-norm error of the output
+     tensor does not exceed the given tolerance, otherwise deactivates it for this tensor network.
+     The global mixed-precision mode is not affected. On return, the output tensor contains the
+     mixed-precision result if accepted, or the full-precision result otherwise (restored from
+     the saved difference; no iterative refinement is performed). Optionally returns the relative
+     error and the speedup (full-precision time over mixed-precision time). On processes outside
+     the process group, nothing is evaluated, the relative error is set to -1 and the speedup to 0. **/
+ bool calibrateMixedPrecisionSync(TensorNetwork & network,         //inout: tensor network for numerical evaluation
+                                  double tolerance,                //in: relative error tolerance
+                                  double * rel_error = nullptr,    //out: relative error of the mixed-precision result
+                                  double * speedup = nullptr);     //out: speedup of the mixed-precision evaluation
+ bool calibrateMixedPrecisionSync(const ProcessGroup & process_group, //in: chosen group of MPI processes
+                                  TensorNetwork & network,         //inout: tensor network for numerical evaluation
+                                  double tolerance,                //in: relative error tolerance
+                                  double * rel_error = nullptr,    //out: relative error of the mixed-precision result
+                                  double * speedup = nullptr);     //out: speedup of the mixed-precision evaluation
+
+ /** Evaluates a batch of tensor networks which differ from the given tensor network only by
+     substitution of its boundary input tensors (see Rationale (e)). The boundary input tensors
+     must only be connected to the non-boundary input tensors of the tensor network. The batch
+     result tensor will be created with the shape of the output tensor of the tensor network
+     (open legs are kept) with one more (last) dimension enumerating the batch items.
+     The shared trunk is only evaluated once, with its output tensor bounded by memory.
+     Synchronization is done via syncing on the batch result tensor. **/
+ bool evaluateTensorNetworkBatch(TensorNetwork & network,                       //in: tensor network
+                                 const std::vector<unsigned int> & boundary_ids, //in: ids of the boundary input tensors
+                                 const std::vector<std::vector<std::shared_ptr<Tensor>>> & boundary_tensors, //in: boundary tensors for each batch item
+                                 const std::string & result_name);              //in: name of the batch result tensor (to be created)
+ bool evaluateTensorNetworkBatch(const ProcessGroup & process_group,            //in: chosen group of MPI processes
+                                 TensorNetwork & network,                       //in: tensor network
+                                 const std::vector<unsigned int> & boundary_ids, //in: ids of the boundary input tensors
+                                 const std::vector<std::vector<std::shared_ptr<Tensor>>> & boundary_tensors, //in: boundary tensors for each batch item
+                                 const std::string & result_name);              //in: name of the batch result tensor (to be created)
+
  /** Synchronizes all update operations on a given tensor.
      Changing wait to FALSE, only tests for completion.
      If ProcessGroup is not provided, defaults to the local process. **/
@@ -427,6 +587,12 @@ public:
  bool computeNorm2Sync(const std::string & name, //in: tensor name
                        double & norm);           //out: tensor norm
 
+ /** Computes 1-norm, 2-norm and max-abs norm of a tensor in a single pass. **/
+ bool computeNormsSync(const std::string & name, //in: tensor name
+                       double & norm1,           //out: tensor 1-norm
+                       double & norm2,           //out: tensor 2-norm
+                       double & maxabs);         //out: tensor max-abs norm
+
  /** Computes partial 2-norms over a chosen tensor dimension. **/
  bool computePartialNormsSync(const std::string & name,             //in: tensor name
                               unsigned int tensor_dimension,        //in: chosen tensor dimension
@@ -539,6 +705,64 @@ public:
  bool contractTensorsSync(const std::string & contraction, //in: symbolic tensor contraction specification
                           NumericType alpha);              //in: alpha prefactor
 
+ /** HANDLE-BASED API: Tensors are referenced directly by their shared pointers (handles)
+     obtained once via getTensor(), thus bypassing the name lookup. The tensor handle
+     must refer to a tensor that has been created and not yet destroyed. **/
+
+ /** Initializes a tensor to some scalar value. **/
+ template<typename NumericType>
+ bool initTensor(std::shared_ptr<Tensor> tensor, //in: tensor handle
+                 NumericType value);             //in: scalar value
+
+ template<typename NumericType>
+ bool initTensorSync(std::shared_ptr<Tensor> tensor, //in: tensor handle
+                     NumericType value);             //in: scalar value
+
+ /** Scales a tensor by a scalar value. **/
+ template<typename NumericType>
+ bool scaleTensor(std::shared_ptr<Tensor> tensor, //in: tensor handle
+                  NumericType value);             //in: scalar value
+
+ template<typename NumericType>
+ bool scaleTensorSync(std::shared_ptr<Tensor> tensor, //in: tensor handle
+                      NumericType value);             //in: scalar value
+
+ /** Transforms (updates) a tensor according to a user-defined tensor functor. **/
+ bool transformTensor(std::shared_ptr<Tensor> tensor,         //in: tensor handle
+                      std::shared_ptr<TensorMethod> functor); //in: functor defining the tensor transformation
+
+ bool transformTensorSync(std::shared_ptr<Tensor> tensor,         //in: tensor handle
+                          std::shared_ptr<TensorMethod> functor); //in: functor defining the tensor transformation
+
+ /** Pre-parses a symbolic tensor addition specification, binds its tensor operands
+     and returns a reusable tensor operation template (nullptr on failure). **/
+ std::shared_ptr<TensorOperation> prepareTensorAddition(const std::string & addition); //in: symbolic tensor addition specification
+
+ /** Pre-parses a symbolic tensor contraction specification, binds its tensor operands
+     and returns a reusable tensor operation template (nullptr on failure). **/
+ std::shared_ptr<TensorOperation> prepareTensorContraction(const std::string & contraction); //in: symbolic tensor contraction specification
+
+ /** Submits a fresh instance of a prepared tensor operation template with
+     a new alpha prefactor. No string parsing or name lookup is involved,
+     thus the same template can be resubmitted any number of times.
+     Tensor operands of the template can be rebound via resetTensorOperand(). **/
+ template<typename NumericType>
+ bool submitPrepared(const TensorOperation & op_template, //in: prepared tensor operation template
+                     NumericType alpha);                  //in: alpha prefactor
+
+ template<typename NumericType>
+ bool submitPreparedSync(const TensorOperation & op_template, //in: prepared tensor operation template
+                         NumericType alpha);                  //in: alpha prefactor
+
+ /** Submits a list of prepared tensor contractions (see prepareTensorContraction) as batched
+     tensor operations: Tensor contractions with the same index pattern (up to tensor names
+     and index labels) and congruent tensor operands are grouped into a single runtime task
+     executed in a fused loop. The relative order of mutually dependent tensor contractions
+     is preserved. Only beta prefactors 0 (overwrite) and 1 (accumulate) are supported. **/
+ bool contractTensorsBatch(const std::vector<std::shared_ptr<TensorOperation>> & contractions); //in: prepared tensor contractions
+
+ bool contractTensorsBatchSync(const std::vector<std::shared_ptr<TensorOperation>> & contractions); //in: prepared tensor contractions
+
  /** Decomposes a tensor into three tensor factors via SVD. The symbolic
      tensor contraction specification specifies the decomposition,
      for example:
@@ -585,6 +809,56 @@ public:
 
  bool decomposeTensorSVDLRSync(const std::string & contraction); //in: two-factor symbolic tensor contraction specification
 
+ /** Decomposes a tensor into three tensor factors via truncated SVD. The symbolic
+     tensor contraction specification specifies the decomposition with strictly
+     one contracted (bond) index, for example:
+      D(a,b,c,d,e) = L(c,i,e) * S(i) * R(b,a,i,d)
+     where
+      L(c,i,e) is the left SVD factor,
+      R(b,a,i,d) is the right SVD factor,
+      S(i) is the middle SVD factor (singular values).
+     Singular values beyond the max rank or not exceeding the cutoff are discarded.
+     The tensor factors are (re)created with the bond extent equal to the retained rank,
+     thus they do not need to exist beforehand. The truncation error is the Frobenius
+     norm of the discarded part. Large tensors are decomposed via the randomized SVD. **/
+ bool decomposeTensorSVDTruncSync(const std::string & contraction,       //in: three-factor symbolic tensor contraction specification
+                                  std::size_t max_rank,                  //in: max retained rank (0: no limit)
+                                  double cutoff = 0.0,                   //in: singular value cutoff
+                                  double * truncation_error = nullptr);  //out: truncation error
+
+ /** Decomposes a tensor into two tensor factors via truncated SVD (see decomposeTensorSVDTruncSync),
+     for example:
+      D(a,b,c,d,e) = L(c,i,e) * R(b,a,i,d)
+     where
+      L(c,i,e) is the left SVD factor with absorbed singular values,
+      R(b,a,i,d) is the right SVD factor. **/
+ bool decomposeTensorSVDLTruncSync(const std::string & contraction,       //in: two-factor symbolic tensor contraction specification
+                                   std::size_t max_rank,                  //in: max retained rank (0: no limit)
+                                   double cutoff = 0.0,                   //in: singular value cutoff
+                                   double * truncation_error = nullptr);  //out: truncation error
+
+ /** Decomposes a tensor into two tensor factors via truncated SVD (see decomposeTensorSVDTruncSync),
+     for example:
+      D(a,b,c,d,e) = L(c,i,e) * R(b,a,i,d)
+     where
+      L(c,i,e) is the left SVD factor,
+      R(b,a,i,d) is the right SVD factor with absorbed singular values. **/
+ bool decomposeTensorSVDRTruncSync(const std::string & contraction,       //in: two-factor symbolic tensor contraction specification
+                                   std::size_t max_rank,                  //in: max retained rank (0: no limit)
+                                   double cutoff = 0.0,                   //in: singular value cutoff
+                                   double * truncation_error = nullptr);  //out: truncation error
+
+ /** Decomposes a tensor into two tensor factors via truncated SVD (see decomposeTensorSVDTruncSync),
+     for example:
+      D(a,b,c,d,e) = L(c,i,e) * R(b,a,i,d)
+     where
+      L(c,i,e) is the left SVD factor with absorbed square root of singular values,
+      R(b,a,i,d) is the right SVD factor with absorbed square root of singular values. **/
+ bool decomposeTensorSVDLRTruncSync(const std::string & contraction,       //in: two-factor symbolic tensor contraction specification
+                                    std::size_t max_rank,                  //in: max retained rank (0: no limit)
+                                    double cutoff = 0.0,                   //in: singular value cutoff
+                                    double * truncation_error = nullptr);  //out: truncation error
+
  /** Orthogonalizes a tensor by decomposing it via SVD while discarding
      the middle tensor factor with singular values. The symbolic tensor contraction
      specification specifies the decomposition. It must contain strictly one contracted index! **/
@@ -611,6 +885,56 @@ public:
                                 const std::string & name,           //in: tensor network name
                                 const std::string & network);       //in: symbolic tensor network specification
 
+ /** BLOCK-SPARSE API: A block-sparse tensor is defined over vector spaces with symmetry
+     subranges and only stores its symmetry-allowed blocks (see numerics::BlockSparseTensor).
+     Tensor operations on block-sparse tensors are given symbolically, like for dense tensors,
+     and only process the compatible block combinations. **/
+
+ /** Declares, registers, and actually creates a block-sparse tensor via the processing backend,
+     that is, creates all its symmetry-allowed blocks. **/
+ bool createTensorBlockSparse(const std::string & name,                     //in: tensor name
+                              TensorElementType element_type,               //in: tensor element type
+                              const std::vector<std::string> & space_names, //in: vector space for each tensor dimension
+                              const std::vector<LegDirection> & directions, //in: direction of each tensor dimension
+                              SymmetryId total_symmetry = 0,                //in: total symmetry id of the tensor
+                              SymmetryId modulus = 0);                      //in: symmetry modulus (0: U(1) symmetry)
+
+ /** Destroys a block-sparse tensor, including all its blocks. **/
+ bool destroyTensorBlockSparse(const std::string & name); //in: tensor name
+
+ /** Returns the requested block-sparse tensor, or nullptr if not found. **/
+ std::shared_ptr<numerics::BlockSparseTensor> getTensorBlockSparse(const std::string & name); //in: tensor name
+
+ /** Initializes all blocks of a block-sparse tensor to some scalar value. **/
+ template<typename NumericType>
+ bool initTensorBlockSparse(const std::string & name, //in: tensor name
+                            NumericType value);       //in: scalar value
+
+ /** Initializes all blocks of a block-sparse tensor to some random value. **/
+ bool initTensorRndBlockSparse(const std::string & name); //in: tensor name
+
+ /** Computes max-abs norm of a block-sparse tensor. **/
+ bool computeMaxAbsBlockSparseSync(const std::string & name, //in: tensor name
+                                   double & norm);           //out: tensor norm
+
+ /** Computes 1-norm of a block-sparse tensor. **/
+ bool computeNorm1BlockSparseSync(const std::string & name, //in: tensor name
+                                  double & norm);           //out: tensor norm
+
+ /** Computes 2-norm of a block-sparse tensor. **/
+ bool computeNorm2BlockSparseSync(const std::string & name, //in: tensor name
+                                  double & norm);           //out: tensor norm
+
+ /** Performs block-sparse tensor addition: tensor0 += tensor1 * alpha **/
+ template<typename NumericType>
+ bool addTensorsBlockSparse(const std::string & addition, //in: symbolic tensor addition specification
+                            NumericType alpha);           //in: alpha prefactor
+
+ /** Performs block-sparse tensor contraction: tensor0 += tensor1 * tensor2 * alpha **/
+ template<typename NumericType>
+ bool contractTensorsBlockSparse(const std::string & contraction, //in: symbolic tensor contraction specification
+                                 NumericType alpha);              //in: alpha prefactor
+
  /** Returns a locally stored tensor slice (talsh::Tensor) providing access to tensor elements.
      This slice will be extracted from the exatn::numerics::Tensor implementation as a copy.
      The returned future becomes ready once the execution thread has retrieved the slice copy. **/
@@ -633,14 +957,96 @@ private:
 
  void destroyOrphanedTensors();
 
+ /** Lowers the precision of an intermediate tensor in a clone of its CREATE operation (mixed precision).
+     The original (cached) tensor operation is left intact for subsequent full-precision evaluations. **/
+ void lowerIntermediatePrecision(const TensorOperation & op,    //in: original tensor operation (only CREATE is affected)
+                                 TensorOperation & op_clone,    //inout: cloned tensor operation to be submitted
+                                 const Tensor & output_tensor); //in: output tensor of the tensor network
+
+ /** Submits the tensor operations of an unsliced tensor network while reusing
+     and retaining its intermediate tensors in the cache (see Rationale (f)). **/
+ bool submitCachingIntermediates(std::list<std::shared_ptr<TensorOperation>> & op_list, //in: tensor operation list of the tensor network
+                                 std::shared_ptr<Tensor> output_tensor,                  //in: output tensor of the tensor network
+                                 bool mixed_precision);                                  //in: whether intermediates are computed in the lower precision
+
+ /** Submits a tensor network expansion for concurrent evaluation of its
+     components by disjoint process subgroups (see Rationale (g)). **/
+ bool submitConcurrently(const ProcessGroup & process_group, //in: chosen group of MPI processes
+                         TensorExpansion & expansion,        //in: tensor network expansion for numerical evaluation
+                         std::shared_ptr<Tensor> accumulator); //inout: tensor accumulator
+
+ /** Retains an intermediate tensor in the cache, evicting the least recently used
+     unpinned intermediates if needed. Returns FALSE if the tensor cannot be retained. **/
+ bool retainIntermediate(const std::string & key,                        //in: cache key of the intermediate tensor
+                         std::shared_ptr<Tensor> tensor,                  //in: intermediate tensor
+                         const std::vector<std::string> & leaves,         //in: names of the input tensors it depends on
+                         const std::unordered_set<std::string> & pinned); //in: cache keys which cannot be evicted
+
+ /** Evicts a cached intermediate tensor (destroys it). **/
+ void evictIntermediate(const std::string & key); //in: cache key of the intermediate tensor
+
+ /** Evicts all cached intermediate tensors depending on the given tensor. **/
+ void evictIntermediatesDependingOn(const std::string & tensor_name); //in: tensor name
+
+ /** Expands a symbolic tensor operation on block-sparse tensors into symbolic
+     tensor operations on their compatible block combinations. **/
+ bool expandBlockSparse(const std::string & operation,         //in: symbolic tensor operation specification
+                        unsigned int num_inputs,               //in: number of input tensors (1: addition, 2: contraction)
+                        std::vector<std::string> & block_ops); //out: symbolic tensor operations on tensor blocks
+
+ /** Decomposes a tensor via truncated SVD (see decomposeTensorSVDTruncSync). The absorption
+     mode specifies which tensor factor receives the singular values: 'N': middle factor,
+     'L': left factor, 'R': right factor, 'S': square root to both left and right factors. **/
+ bool decomposeTensorSVDTrunc(const std::string & contraction, //in: symbolic tensor contraction specification
+                              char absorption,                 //in: absorption mode of singular values
+                              std::size_t max_rank,            //in: max retained rank (0: no limit)
+                              double cutoff,                   //in: singular value cutoff
+                              double * truncation_error);      //out: truncation error
+
+ /** Computes the truncated SVD of the matricized local copy of a tensor and (re)creates
+     its tensor factors. Each tensor factor dimension refers to either a dimension of
+     the decomposed tensor or to the bond dimension (-1). **/
+ template<typename NumericType>
+ bool decomposeTensorSVDTruncLocal(const Tensor & tensor,                    //in: decomposed tensor
+                                   const talsh::Tensor & local_tensor,       //in: local copy of the decomposed tensor
+                                   const std::vector<std::string> & factors, //in: names of the left, right, and (optional) middle factors
+                                   const std::vector<int> & left_dims,       //in: tensor dimension (or -1) for each left factor dimension
+                                   const std::vector<int> & right_dims,      //in: tensor dimension (or -1) for each right factor dimension
+                                   char absorption,                          //in: absorption mode of singular values
+                                   std::size_t max_rank,                     //in: max retained rank (0: no limit)
+                                   double cutoff,                            //in: singular value cutoff
+                                   double * truncation_error);               //out: truncation error
+
+ /** Computes a norm of a block-sparse tensor by applying a norm functor to all its blocks. **/
+ template<typename NormFunctor>
+ bool computeNormBlockSparseSync(const std::string & name,           //in: tensor name
+                                 std::vector<double> & block_norms); //out: norm of each block
+
  std::shared_ptr<numerics::SpaceRegister> space_register_; //register of vector spaces and their named subspaces
  std::unordered_map<std::string,SpaceId> subname2id_; //maps a subspace name to its parental vector space id
 
  std::unordered_map<std::string,std::shared_ptr<Tensor>> tensors_; //registered tensors (by CREATE operation)
+ std::unordered_map<std::string,std::shared_ptr<numerics::BlockSparseTensor>> block_sparse_tensors_; //registered block-sparse tensors
  std::list<std::shared_ptr<Tensor>> implicit_tensors_; //tensors created implicitly by the runtime (for garbage collection)
 
  std::string contr_seq_optimizer_; //tensor contraction sequence optimizer invoked when evaluating tensor networks
  bool contr_seq_caching_; //regulates whether or not to cache pseudo-optimal tensor contraction orders for later reuse
+ bool mixed_precision_; //regulates whether or not intermediate tensors are computed in the lower precision
+ std::unordered_map<std::string,bool> mixed_precision_networks_; //calibrated per-network mixed-precision decisions (by tensor network name)
+
+ struct CachedIntermediate{
+  std::shared_ptr<Tensor> tensor;  //cached intermediate tensor
+  std::vector<std::string> leaves; //names of the input tensors it depends on
+  std::size_t size;                //tensor size in bytes
+  std::size_t last_use;            //logical time stamp of the last use
+ };
+ std::size_t intermediate_cache_limit_; //memory budget for cached intermediate tensors in bytes (0: caching is inactive)
+ std::size_t intermediate_cache_size_;  //current memory footprint of cached intermediate tensors in bytes
+ std::size_t intermediate_cache_clock_; //logical clock for the least-recently-used eviction
+ std::unordered_map<std::string,CachedIntermediate> intermediate_cache_; //cached intermediate tensors: cache key (subtree signature) --> intermediate
+ std::unordered_map<std::string,std::vector<std::string>> intermediate_dependents_; //input tensor name --> cache keys depending on it
+
+ bool expansion_parallelism_; //regulates whether or not tensor network expansion components are evaluated concurrently by process subgroups
 
  std::map<std::string,std::shared_ptr<TensorMethod>> ext_methods_; //external tensor methods
  std::map<std::string,std::shared_ptr<BytePacket>> ext_data_; //external data
@@ -1019,6 +1425,113 @@ bool NumServer::contractTensorsSync(const std::string & contraction,
  return parsed;
 }
 
+template<typename NumericType>
+bool NumServer::initTensorBlockSparse(const std::string & name,
+                                      NumericType value)
+{
+ auto iter = block_sparse_tensors_.find(name);
+ if(iter == block_sparse_tensors_.end()){
+  std::cout << "#ERROR(exatn::NumServer::initTensorBlockSparse): Block-sparse tensor " << name << " not found!" << std::endl;
+  return false;
+ }
+ bool success = true;
+ for(const auto & block: iter->second->getBlocks()){
+  success = initTensor(block.tensor->getName(),value);
+  if(!success) break;
+ }
+ return success;
+}
+
+template<typename NumericType>
+bool NumServer::addTensorsBlockSparse(const std::string & addition,
+                                      NumericType alpha)
+{
+ std::vector<std::string> block_ops;
+ bool success = expandBlockSparse(addition,1,block_ops);
+ if(success){
+  for(const auto & block_op: block_ops){
+   success = addTensors(block_op,alpha);
+   if(!success) break;
+  }
+ }else{
+  std::cout << "#ERROR(exatn::NumServer::addTensorsBlockSparse): Invalid block-sparse tensor addition: " << addition << std::endl;
+ }
+ return success;
+}
+
+template<typename NumericType>
+bool NumServer::contractTensorsBlockSparse(const std::string & contraction,
+                                           NumericType alpha)
+{
+ std::vector<std::string> block_ops;
+ bool success = expandBlockSparse(contraction,2,block_ops);
+ if(success){
+  for(const auto & block_op: block_ops){
+   success = contractTensors(block_op,alpha);
+   if(!success) break;
+  }
+ }else{
+  std::cout << "#ERROR(exatn::NumServer::contractTensorsBlockSparse): Invalid block-sparse tensor contraction: " << contraction << std::endl;
+ }
+ return success;
+}
+
+template<typename NumericType>
+bool NumServer::initTensor(std::shared_ptr<Tensor> tensor,
+                           NumericType value)
+{
+ return transformTensor(tensor,std::shared_ptr<TensorMethod>(new numerics::FunctorInitVal(value)));
+}
+
+template<typename NumericType>
+bool NumServer::initTensorSync(std::shared_ptr<Tensor> tensor,
+                               NumericType value)
+{
+ return transformTensorSync(tensor,std::shared_ptr<TensorMethod>(new numerics::FunctorInitVal(value)));
+}
+
+template<typename NumericType>
+bool NumServer::scaleTensor(std::shared_ptr<Tensor> tensor,
+                            NumericType value)
+{
+ return transformTensor(tensor,std::shared_ptr<TensorMethod>(new numerics::FunctorScale(value)));
+}
+
+template<typename NumericType>
+bool NumServer::scaleTensorSync(std::shared_ptr<Tensor> tensor,
+                                NumericType value)
+{
+ return transformTensorSync(tensor,std::shared_ptr<TensorMethod>(new numerics::FunctorScale(value)));
+}
+
+template<typename NumericType>
+bool NumServer::submitPrepared(const TensorOperation & op_template,
+                               NumericType alpha)
+{
+ if(!op_template.isSet()){
+  std::cout << "#ERROR(exatn::NumServer::submitPrepared): Tensor operation template is not fully set!" << std::endl;
+  return false;
+ }
+ std::shared_ptr<TensorOperation> op(op_template.clone());
+ op->setScalar(0,std::complex<double>(alpha));
+ return submit(op);
+}
+
+template<typename NumericType>
+bool NumServer::submitPreparedSync(const TensorOperation & op_template,
+                                   NumericType alpha)
+{
+ if(!op_template.isSet()){
+  std::cout << "#ERROR(exatn::NumServer::submitPreparedSync): Tensor operation template is not fully set!" << std::endl;
+  return false;
+ }
+ std::shared_ptr<TensorOperation> op(op_template.clone());
+ op->setScalar(0,std::complex<double>(alpha));
+ auto submitted = submit(op);
+ if(submitted) submitted = sync(*op);
+ return submitted;
+}
+
 } //namespace exatn
 
 #endif //EXATN_NUM_SERVER_HPP_
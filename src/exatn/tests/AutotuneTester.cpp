@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+
+#include "exatn.hpp"
+#include "talshxx.hpp"
+
+#ifdef MPI_ENABLED
+#include "mpi.h"
+#endif
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <cmath>
+
+#include "errors.hpp"
+
+//Test activation:
+#define EXATN_TEST0
+
+//Tuning database file (seeded before ExaTN initialization):
+const std::string TUNING_DATABASE("exatn_autotune_tester.tuning");
+
+
+/** Returns the autotuning signature of a tensor contraction
+    (the same as exatn::runtime::get_contraction_signature). **/
+std::string tuning_signature(const exatn::TensorOperation & op, int data_kind)
+{
+ std::string signature;
+ for(const auto & ch: op.getIndexPatternReduced()) if(ch != ' ') signature.push_back(ch);
+ signature.push_back('|');
+ for(unsigned int i = 0; i < op.getNumOperands(); ++i){
+  if(i > 0) signature.push_back(';');
+  const auto & tensor = *(op.getTensorOperand(i));
+  for(unsigned int j = 0; j < tensor.getRank(); ++j){
+   if(j > 0) signature.push_back(',');
+   signature += std::to_string(tensor.getDimExtent(j));
+  }
+ }
+ signature.push_back('|');
+ signature += std::to_string(data_kind);
+ return signature;
+}
+
+
+/** Returns the signature of the tensor contraction whose kernel is seeded into the tuning database. **/
+std::string seeded_signature()
+{
+ using exatn::Tensor;
+ using exatn::TensorShape;
+ using exatn::TensorOpCode;
+ auto op = exatn::TensorOpFactory::get()->createTensorOp(TensorOpCode::CONTRACT);
+ op->setTensorOperand(std::make_shared<Tensor>("D",TensorShape{16,16}));
+ op->setTensorOperand(std::make_shared<Tensor>("E",TensorShape{8,16}));
+ op->setTensorOperand(std::make_shared<Tensor>("F",TensorShape{16,8}));
+ op->setIndexPattern("D(i,j)+=E(k,i)*F(j,k)");
+ return tuning_signature(*op,talsh::REAL64);
+}
+
+
+/** Returns the kernel an executed tensor contraction has been executed with. **/
+const std::string & executed_kernel(const std::shared_ptr<exatn::TensorOperation> & op)
+{
+ return std::dynamic_pointer_cast<exatn::numerics::TensorOpContract>(op)->getKernel();
+}
+
+
+#ifdef EXATN_TEST0
+TEST(AutotuneTester, ContractionAutotuning) {
+ using exatn::TensorShape;
+ using exatn::TensorElementType;
+
+ //exatn::resetLoggingLevel(2,2); //debug
+
+ bool success = true;
+
+ //Create tensors:
+ success = exatn::createTensor("A",TensorElementType::COMPLEX64,TensorShape{4,6,5}); assert(success);
+ success = exatn::createTensor("B",TensorElementType::COMPLEX64,TensorShape{5,3,4,6}); assert(success);
+ success = exatn::createTensor("C",TensorElementType::COMPLEX64,TensorShape{6,6,3}); assert(success);
+ success = exatn::createTensor("D",TensorElementType::REAL64,TensorShape{16,16}); assert(success);
+ success = exatn::createTensor("E",TensorElementType::REAL64,TensorShape{8,16}); assert(success);
+ success = exatn::createTensor("F",TensorElementType::REAL64,TensorShape{16,8}); assert(success);
+ success = exatn::createTensor("G",TensorElementType::REAL64,TensorShape{64,64}); assert(success);
+ success = exatn::createTensor("H",TensorElementType::REAL64,TensorShape{64,64}); assert(success);
+ success = exatn::createTensor("P",TensorElementType::REAL64,TensorShape{64,64}); assert(success);
+
+ //Initialize tensors:
+ success = exatn::initTensor("A",std::complex<double>{0.5,0.5}); assert(success);
+ success = exatn::initTensor("B",std::complex<double>{1.0,1.0}); assert(success);
+ success = exatn::initTensor("C",std::complex<double>{0.0,0.0}); assert(success);
+ success = exatn::initTensor("D",0.0); assert(success);
+ success = exatn::initTensor("E",0.5); assert(success);
+ success = exatn::initTensor("F",2.0); assert(success);
+ success = exatn::initTensor("G",0.0); assert(success);
+ success = exatn::initTensor("H",0.5); assert(success);
+ success = exatn::initTensor("P",0.25); assert(success);
+
+ //Repeated tensor contractions (the kernel tuned upon the first occurrence of a signature is reused):
+ std::vector<std::shared_ptr<exatn::TensorOperation>> c_ops, d_ops;
+ for(int i = 0; i < 3; ++i){
+  c_ops.emplace_back(exatn::prepareTensorContraction("C(a,b,c)+=A+(k,a,l)*B(l,c,k,b)"));
+  success = exatn::numericalServer->submit(c_ops.back()); assert(success);
+  d_ops.emplace_back(exatn::prepareTensorContraction("D(i,j)+=E(k,i)*F(j,k)"));
+  success = exatn::numericalServer->submit(d_ops.back()); assert(success);
+ }
+ //Tensor contraction exceeding the max operand size of the direct kernel:
+ auto g_op = exatn::prepareTensorContraction("G(i,j)+=H(k,i)*P(j,k)");
+ success = exatn::numericalServer->submit(g_op); assert(success);
+
+ //Check the results (whichever kernel has been selected):
+ double norm1 = 0.0;
+ success = exatn::computeNorm1Sync("C",norm1); assert(success);
+ std::cout << " 1-norm of C = " << norm1 << std::endl;
+ assert(std::abs(norm1 - 6480.0) < 1e-9);
+ success = exatn::computeNorm1Sync("D",norm1); assert(success);
+ std::cout << " 1-norm of D = " << norm1 << std::endl;
+ assert(std::abs(norm1 - 6144.0) < 1e-9);
+ success = exatn::computeNorm1Sync("G",norm1); assert(success);
+ std::cout << " 1-norm of G = " << norm1 << std::endl;
+ assert(std::abs(norm1 - 32768.0) < 1e-9);
+
+ //Check the executed kernels:
+ for(int i = 0; i < 3; ++i){
+  std::cout << " Kernels: " << executed_kernel(c_ops[i]) << " " << executed_kernel(d_ops[i]) << std::endl;
+  assert(executed_kernel(c_ops[i]) == "talsh" || executed_kernel(c_ops[i]) == "direct");
+  assert(executed_kernel(c_ops[i]) == executed_kernel(c_ops[0])); //tuned once
+  assert(executed_kernel(d_ops[i]) == "direct"); //seeded in the tuning database
+ }
+ assert(executed_kernel(g_op) == "talsh");
+
+ //The newly tuned signature has been appended to the tuning database:
+ const auto signature = tuning_signature(*(c_ops[0]),talsh::COMPLEX64);
+ bool recorded = false;
+ std::ifstream database(TUNING_DATABASE);
+ std::string line;
+ while(std::getline(database,line)){
+  if(line.compare(0,signature.size()+1,signature+" ") == 0){
+   recorded = (line.find(" " + executed_kernel(c_ops[0]) + " ") != std::string::npos);
+  }
+ }
+ assert(recorded);
+
+ //Destroy tensors:
+ success = exatn::destroyTensor("P"); assert(success);
+ success = exatn::destroyTensor("H"); assert(success);
+ success = exatn::destroyTensor("G"); assert(success);
+ success = exatn::destroyTensor("F"); assert(success);
+ success = exatn::destroyTensor("E"); assert(success);
+ success = exatn::destroyTensor("D"); assert(success);
+ success = exatn::destroyTensor("C"); assert(success);
+ success = exatn::destroyTensor("B"); assert(success);
+ success = exatn::destroyTensor("A"); assert(success);
+
+ //Synchronize:
+ success = exatn::sync(); assert(success);
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
+
+int main(int argc, char **argv) {
+
+  exatn::ParamConf exatn_parameters;
+  //Set the available CPU Host RAM size to be used by ExaTN:
+  exatn_parameters.setParameter("host_memory_buffer_size",1L*1024L*1024L*1024L);
+  //Autotune tensor contraction kernels (tuning database file):
+  exatn_parameters.setParameter("contraction_autotuning",1L);
+  exatn_parameters.setParameter("contraction_tuning_database",TUNING_DATABASE);
+  exatn_parameters.setParameter("contraction_direct_max_bytes",64L*1024L);
+  int process_rank = 0;
+#ifdef MPI_ENABLED
+  int thread_provided;
+  int mpi_error = MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &thread_provided);
+  assert(mpi_error == MPI_SUCCESS);
+  assert(thread_provided == MPI_THREAD_MULTIPLE);
+  mpi_error = MPI_Comm_rank(MPI_COMM_WORLD,&process_rank); assert(mpi_error == MPI_SUCCESS);
+#endif
+  //Seed the tuning database saved by a previous run (loaded upon initialization):
+  if(process_rank == 0){
+   std::ofstream database(TUNING_DATABASE,std::ios::out|std::ios::trunc);
+   database << seeded_signature() << " direct 1.0e-03 2.0e-03" << std::endl;
+  }
+#ifdef MPI_ENABLED
+  mpi_error = MPI_Barrier(MPI_COMM_WORLD); assert(mpi_error == MPI_SUCCESS);
+  exatn::initialize(exatn::MPICommProxy(MPI_COMM_WORLD),exatn_parameters,"lazy-dag-executor");
+#else
+  exatn::initialize(exatn_parameters,"lazy-dag-executor");
+#endif
+
+  ::testing::InitGoogleTest(&argc, argv);
+  auto ret = RUN_ALL_TESTS();
+
+  exatn::finalize();
+#ifdef MPI_ENABLED
+  mpi_error = MPI_Finalize(); assert(mpi_error == MPI_SUCCESS);
+#endif
+  return ret;
+}
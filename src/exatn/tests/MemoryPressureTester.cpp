@@ -0,0 +1,247 @@
+#include <gtest/gtest.h>
+
+#include "exatn.hpp"
+#include "talshxx.hpp"
+
+#ifdef MPI_ENABLED
+#include "mpi.h"
+#endif
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <string>
+#include <cmath>
+
+#include "errors.hpp"
+
+//Test activation:
+#define EXATN_TEST0
+#define EXATN_TEST1
+#define EXATN_TEST2
+
+
+#ifdef EXATN_TEST0
+TEST(MemoryPressureTester, MemoryPressureScheduling) {
+ using exatn::TensorShape;
+ using exatn::TensorElementType;
+
+ //exatn::resetLoggingLevel(2,2); //debug
+
+ bool success = true;
+
+ //Stream tensors through the memory buffer: In the program order, the live tensors
+ //plus a new one exceed the memory buffer, thus tensor destructions must be executed
+ //ahead of tensor creations, with the memory pressure threshold being crossed:
+ const std::size_t buffer_size = exatn::getMemoryBufferSize();
+ const std::size_t tensor_size = buffer_size / 11; //bytes
+ const exatn::DimExtent tensor_volume = tensor_size / sizeof(double);
+ const int num_tensors = 24, window = 12;
+ success = exatn::createTensor("S",TensorElementType::REAL64,TensorShape{tensor_volume}); assert(success);
+ success = exatn::initTensor("S",0.0); assert(success);
+ for(int i = 0; i < num_tensors + window; ++i){
+  if(i < num_tensors){
+   success = exatn::createTensor("T"+std::to_string(i),TensorElementType::REAL64,TensorShape{tensor_volume}); assert(success);
+   success = exatn::initTensor("T"+std::to_string(i),static_cast<double>(i+1)); assert(success);
+  }
+  if(i >= window){
+   success = exatn::addTensors("S(a)+=T"+std::to_string(i-window)+"(a)",1.0); assert(success);
+   success = exatn::destroyTensor("T"+std::to_string(i-window)); assert(success);
+  }
+ }
+
+ //Check the results (all tensor creations must have been admitted):
+ double norm1 = 0.0;
+ success = exatn::computeNorm1Sync("S",norm1); assert(success);
+ const double reference = static_cast<double>(num_tensors * (num_tensors + 1) / 2) * static_cast<double>(tensor_volume);
+ std::cout << " 1-norm of S = " << norm1 << " (reference " << reference << ")" << std::endl;
+ assert(std::abs(norm1 - reference) <= 1e-12 * reference);
+ success = exatn::destroyTensor("S"); assert(success);
+
+ //Synchronize:
+ success = exatn::sync(); assert(success);
+ const std::size_t peak_size = exatn::getPeakMemorySize();
+ std::cout << " Peak memory usage = " << peak_size << " bytes out of " << buffer_size << std::endl;
+ assert(peak_size >= 2 * tensor_size && peak_size <= buffer_size);
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
+
+#ifdef EXATN_TEST1
+TEST(MemoryPressureTester, LargeTrunkBatch) {
+ using exatn::TensorShape;
+ using exatn::TensorElementType;
+ using exatn::TensorNetwork;
+ using exatn::Tensor;
+
+ //exatn::resetLoggingLevel(2,2); //debug
+
+ bool success = true;
+
+ //The trunk of the tensor network (A without the boundary tensors B and C) keeps
+ //all legs of A open, thus its output tensor does not fit in the memory buffer
+ //together with A, forcing each batch item to be evaluated as a whole:
+ const exatn::DimExtent rows = 2, extent = 1536;
+ success = exatn::createTensor("A",TensorElementType::REAL64,TensorShape{rows,extent,extent}); assert(success);
+ success = exatn::createTensor("B",TensorElementType::REAL64,TensorShape{extent}); assert(success);
+ success = exatn::createTensor("C",TensorElementType::REAL64,TensorShape{extent}); assert(success);
+ success = exatn::initTensor("A",1.0); assert(success);
+ success = exatn::initTensor("B",1.0); assert(success);
+ success = exatn::initTensor("C",1.0); assert(success);
+
+ //Boundary tensors of batch items:
+ const std::vector<double> values{1.0,2.0,3.0};
+ std::vector<std::vector<std::shared_ptr<Tensor>>> boundary_tensors;
+ for(std::size_t item = 0; item < values.size(); ++item){
+  const std::string name = "B" + std::to_string(item+1);
+  success = exatn::createTensor(name,TensorElementType::REAL64,TensorShape{extent}); assert(success);
+  success = exatn::initTensor(name,values[item]); assert(success);
+  boundary_tensors.emplace_back(std::vector<std::shared_ptr<Tensor>>{exatn::getTensor(name),exatn::getTensor("C")});
+ }
+
+ //Evaluate the batch Z(a,k) = A(a,i,j) * Bk(i) * C(j) = values[k] * extent^2:
+ TensorNetwork network("LargeTrunk","Z(a) = A(a,i,j) * B(i) * C(j)",
+                       std::map<std::string,std::shared_ptr<Tensor>>{
+                        {"Z",std::make_shared<Tensor>("Z",TensorShape{rows})},
+                        {"A",exatn::getTensor("A")},
+                        {"B",exatn::getTensor("B")},
+                        {"C",exatn::getTensor("C")}});
+ auto boundary_ids = network.getTensorIdsInNetwork("B"); assert(boundary_ids.size() == 1);
+ const auto c_ids = network.getTensorIdsInNetwork("C"); assert(c_ids.size() == 1);
+ boundary_ids.emplace_back(c_ids[0]);
+ success = exatn::evaluateBatchSync(network,boundary_ids,boundary_tensors,"Batch"); assert(success);
+
+ //Check the result:
+ double norm1 = 0.0;
+ success = exatn::computeNorm1Sync("Batch",norm1); assert(success);
+ const double reference = static_cast<double>(rows) * 6.0 * static_cast<double>(extent) * static_cast<double>(extent);
+ std::cout << " 1-norm of the batch result = " << norm1 << " (reference " << reference << ")" << std::endl;
+ assert(std::abs(norm1 - reference) <= 1e-12 * reference);
+
+ //Destroy tensors:
+ success = exatn::destroyTensor("Batch"); assert(success);
+ for(std::size_t item = 0; item < values.size(); ++item){
+  success = exatn::destroyTensor("B" + std::to_string(item+1)); assert(success);
+ }
+ success = exatn::destroyTensor("C"); assert(success);
+ success = exatn::destroyTensor("B"); assert(success);
+ success = exatn::destroyTensor("A"); assert(success);
+
+ //Synchronize:
+ success = exatn::sync(); assert(success);
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
+
+#ifdef EXATN_TEST2
+TEST(MemoryPressureTester, BoundedTrunkBatch) {
+ using exatn::TensorShape;
+ using exatn::TensorElementType;
+ using exatn::TensorNetwork;
+ using exatn::Tensor;
+
+ //exatn::resetLoggingLevel(2,2); //debug
+
+ bool success = true;
+
+ //The trunk without the boundary tensors B and C (E,D,A) keeps all legs of A open and does
+ //not fit in memory, thus A is moved to the branch, leaving the trunk E*D to be shared:
+ const exatn::DimExtent rows = 2, bond = 2, extent = 1536;
+ success = exatn::createTensor("E",TensorElementType::REAL64,TensorShape{rows,bond}); assert(success);
+ success = exatn::createTensor("D",TensorElementType::REAL64,TensorShape{bond,bond}); assert(success);
+ success = exatn::createTensor("A",TensorElementType::REAL64,TensorShape{bond,extent,extent}); assert(success);
+ success = exatn::createTensor("B",TensorElementType::REAL64,TensorShape{extent}); assert(success);
+ success = exatn::createTensor("C",TensorElementType::REAL64,TensorShape{extent}); assert(success);
+ success = exatn::initTensor("E",1.0); assert(success);
+ success = exatn::initTensor("D",1.0); assert(success);
+ success = exatn::initTensor("A",1.0); assert(success);
+ success = exatn::initTensor("B",1.0); assert(success);
+ success = exatn::initTensor("C",1.0); assert(success);
+
+ //Boundary tensors of batch items:
+ const std::vector<double> values{1.0,2.0,3.0};
+ std::vector<std::vector<std::shared_ptr<Tensor>>> boundary_tensors;
+ for(std::size_t item = 0; item < values.size(); ++item){
+  const std::string name = "B" + std::to_string(item+1);
+  success = exatn::createTensor(name,TensorElementType::REAL64,TensorShape{extent}); assert(success);
+  success = exatn::initTensor(name,values[item]); assert(success);
+  boundary_tensors.emplace_back(std::vector<std::shared_ptr<Tensor>>{exatn::getTensor(name),exatn::getTensor("C")});
+ }
+
+ //The shared trunk is E*D:
+ TensorNetwork network("BoundedTrunk","Z(a) = E(a,c) * D(c,b) * A(b,i,j) * B(i) * C(j)",
+                       std::map<std::string,std::shared_ptr<Tensor>>{
+                        {"Z",std::make_shared<Tensor>("Z",TensorShape{rows})},
+                        {"E",exatn::getTensor("E")},
+                        {"D",exatn::getTensor("D")},
+                        {"A",exatn::getTensor("A")},
+                        {"B",exatn::getTensor("B")},
+                        {"C",exatn::getTensor("C")}});
+ auto boundary_ids = network.getTensorIdsInNetwork("B"); assert(boundary_ids.size() == 1);
+ const auto c_ids = network.getTensorIdsInNetwork("C"); assert(c_ids.size() == 1);
+ boundary_ids.emplace_back(c_ids[0]);
+ std::vector<unsigned int> trunk_ids;
+ const double max_trunk_volume = static_cast<double>(exatn::getDefaultProcessGroup().getMemoryLimitPerProcess())
+                                 / (2.0 * sizeof(double));
+ const double trunk_volume = network.selectBatchTrunk(boundary_ids,max_trunk_volume,trunk_ids);
+ assert(trunk_ids.size() == 2 && trunk_volume == static_cast<double>(rows * bond));
+ assert(network.getTensor(trunk_ids[0])->getName() == "E" && network.getTensor(trunk_ids[1])->getName() == "D");
+
+ //Evaluate the batch Z(a,k) = E(a,c) * D(c,b) * A(b,i,j) * Bk(i) * C(j) = values[k] * bond^2 * extent^2:
+ success = exatn::evaluateBatchSync(network,boundary_ids,boundary_tensors,"Batch"); assert(success);
+
+ //Check the result:
+ double norm1 = 0.0;
+ success = exatn::computeNorm1Sync("Batch",norm1); assert(success);
+ const double reference = static_cast<double>(rows) * 6.0 * static_cast<double>(bond * bond)
+                        * static_cast<double>(extent) * static_cast<double>(extent);
+ std::cout << " 1-norm of the batch result = " << norm1 << " (reference " << reference << ")" << std::endl;
+ assert(std::abs(norm1 - reference) <= 1e-12 * reference);
+
+ //Destroy tensors:
+ success = exatn::destroyTensor("Batch"); assert(success);
+ for(std::size_t item = 0; item < values.size(); ++item){
+  success = exatn::destroyTensor("B" + std::to_string(item+1)); assert(success);
+ }
+ success = exatn::destroyTensor("C"); assert(success);
+ success = exatn::destroyTensor("B"); assert(success);
+ success = exatn::destroyTensor("A"); assert(success);
+ success = exatn::destroyTensor("D"); assert(success);
+ success = exatn::destroyTensor("E"); assert(success);
+
+ //Synchronize:
+ success = exatn::sync(); assert(success);
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
+
+int main(int argc, char **argv) {
+
+  exatn::ParamConf exatn_parameters;
+  //Set a small CPU Host RAM size to be used by ExaTN (no tensor spilling):
+  exatn_parameters.setParameter("host_memory_buffer_size",64L*1024L*1024L);
+#ifdef MPI_ENABLED
+  int thread_provided;
+  int mpi_error = MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &thread_provided);
+  assert(mpi_error == MPI_SUCCESS);
+  assert(thread_provided == MPI_THREAD_MULTIPLE);
+  exatn::initialize(exatn::MPICommProxy(MPI_COMM_WORLD),exatn_parameters,"lazy-dag-executor");
+#else
+  exatn::initialize(exatn_parameters,"lazy-dag-executor");
+#endif
+
+  ::testing::InitGoogleTest(&argc, argv);
+  auto ret = RUN_ALL_TESTS();
+
+  exatn::finalize();
+#ifdef MPI_ENABLED
+  mpi_error = MPI_Finalize(); assert(mpi_error == MPI_SUCCESS);
+#endif
+  return ret;
+}
@@ -10,6 +10,11 @@
 #include <iostream>
 #include <ios>
 #include <utility>
+#include <thread>
+#include <chrono>
+#include <tuple>
+#include <mutex>
+#include <limits>
 
 #include "errors.hpp"
 
@@ -38,6 +43,20 @@
 #define EXATN_TEST21
 #define EXATN_TEST22
 #define EXATN_TEST23
+#define EXATN_TEST24
+#define EXATN_TEST25
+#define EXATN_TEST26
+#define EXATN_TEST27
+#define EXATN_TEST28
+#define EXATN_TEST29
+#define EXATN_TEST30
+#define EXATN_TEST31
+#define EXATN_TEST32
+#define EXATN_TEST33
+#define EXATN_TEST34
+#define EXATN_TEST35
+#define EXATN_TEST36
+#define EXATN_TEST37
 
 
 #ifdef EXATN_TEST0
@@ -2526,6 +2545,1016 @@ TEST(NumServerTester, UserDefinedMethod) {
 }
 #endif
 
+#ifdef EXATN_TEST24
+TEST(NumServerTester, HandleBasedAPI) {
+ using exatn::TensorShape;
+ using exatn::Tensor;
+ using exatn::TensorElementType;
+
+ const auto TENS_ELEM_TYPE = TensorElementType::REAL64;
+
+ //exatn::resetLoggingLevel(2,2); //debug
+
+ bool success = true;
+
+ //Create tensors:
+ success = exatn::createTensor("A",TENS_ELEM_TYPE,TensorShape{2,3}); assert(success);
+ success = exatn::createTensor("B",TENS_ELEM_TYPE,TensorShape{3,4}); assert(success);
+ success = exatn::createTensor("C",TENS_ELEM_TYPE,TensorShape{2,4}); assert(success);
+
+ //Bind tensor handles once:
+ auto tensA = exatn::getTensor("A");
+ auto tensB = exatn::getTensor("B");
+ auto tensC = exatn::getTensor("C");
+
+ //Init tensors via handles:
+ success = exatn::initTensor(tensA,1.0); assert(success);
+ success = exatn::initTensor(tensB,1.0); assert(success);
+ success = exatn::initTensor(tensC,0.0); assert(success);
+
+ //Prepare a reusable tensor contraction template:
+ auto contraction = exatn::prepareTensorContraction("C(i,j)+=A(i,k)*B(k,j)");
+ assert(contraction);
+
+ //Resubmit the same template multiple times:
+ for(int i = 0; i < 10; ++i){
+  success = exatn::submitPrepared(*contraction,0.5); assert(success);
+ }
+ success = exatn::scaleTensorSync(tensC,2.0); assert(success);
+
+ //Check the result:
+ double norm1 = 0.0;
+ success = exatn::computeNorm1Sync("C",norm1); assert(success);
+ std::cout << " 1-norm of tensor C (should be 240) = " << norm1 << std::endl;
+ assert(std::abs(norm1 - 240.0) < 1e-7);
+
+ //Destroy tensors:
+ success = exatn::destroyTensor("C"); assert(success);
+ success = exatn::destroyTensor("B"); assert(success);
+ success = exatn::destroyTensor("A"); assert(success);
+
+ //Synchronize:
+ success = exatn::sync(); assert(success);
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
+#ifdef EXATN_TEST25
+TEST(NumServerTester, BatchedContractions) {
+ using exatn::TensorShape;
+ using exatn::Tensor;
+ using exatn::TensorOperation;
+ using exatn::TensorElementType;
+
+ const auto TENS_ELEM_TYPE = TensorElementType::REAL64;
+ const unsigned int batch_size = 16;
+
+ //exatn::resetLoggingLevel(2,2); //debug
+
+ bool success = true;
+
+ //Create tensors:
+ success = exatn::createTensor("A",TENS_ELEM_TYPE,TensorShape{4,4}); assert(success);
+ success = exatn::createTensor("B",TENS_ELEM_TYPE,TensorShape{4,4}); assert(success);
+ for(unsigned int i = 0; i < batch_size; ++i){
+  success = exatn::createTensor("C"+std::to_string(i),TENS_ELEM_TYPE,TensorShape{4,4}); assert(success);
+ }
+
+ //Init tensors:
+ success = exatn::initTensor("A",1.0); assert(success);
+ success = exatn::initTensor("B",1.0); assert(success);
+ for(unsigned int i = 0; i < batch_size; ++i){
+  success = exatn::initTensor("C"+std::to_string(i),((i % 4 == 3) ? 1.0 : 0.0)); assert(success);
+ }
+
+ //Prepare a batch of same-pattern tensor contractions with differently named tensors and index labels:
+ std::vector<std::shared_ptr<TensorOperation>> contractions;
+ for(unsigned int i = 0; i < batch_size; ++i){
+  const auto name = "C"+std::to_string(i);
+  auto op = exatn::prepareTensorContraction((i % 2 == 0) ? name+"(i,j)+=A(i,k)*B(k,j)" : name+"(a,b)+=A(a,c)*B(c,b)");
+  assert(op);
+  op->setScalar(0,static_cast<double>(i+1));
+  if(i % 4 == 3) op->setScalar(1,0.0); //beta = 0: overwrite the output tensor
+  contractions.emplace_back(op);
+ }
+ //A dependent tensor contraction (must be executed after C1 has been computed):
+ auto contraction = exatn::prepareTensorContraction("C0(i,j)+=C1(i,k)*B(k,j)");
+ assert(contraction);
+ contractions.emplace_back(contraction);
+
+ //Submit all tensor contractions as batches:
+ success = exatn::contractTensorsBatchSync(contractions); assert(success);
+
+ //Check the results:
+ for(unsigned int i = 1; i < batch_size; ++i){
+  double norm1 = 0.0;
+  success = exatn::computeNorm1Sync("C"+std::to_string(i),norm1); assert(success);
+  assert(std::abs(norm1 - 64.0*static_cast<double>(i+1)) < 1e-7);
+ }
+ double norm1 = 0.0;
+ success = exatn::computeNorm1Sync("C0",norm1); assert(success);
+ std::cout << " 1-norm of tensor C0 (should be 576) = " << norm1 << std::endl;
+ assert(std::abs(norm1 - 576.0) < 1e-7);
+
+ //Destroy tensors:
+ for(unsigned int i = 0; i < batch_size; ++i){
+  success = exatn::destroyTensor("C"+std::to_string(i)); assert(success);
+ }
+ success = exatn::destroyTensor("B"); assert(success);
+ success = exatn::destroyTensor("A"); assert(success);
+
+ //Synchronize:
+ success = exatn::sync(); assert(success);
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
+#ifdef EXATN_TEST26
+TEST(NumServerTester, MixedPrecision) {
+ using exatn::TensorShape;
+ using exatn::Tensor;
+ using exatn::TensorNetwork;
+ using exatn::TensorElementType;
+
+ const auto TENS_ELEM_TYPE = TensorElementType::COMPLEX64;
+
+ //exatn::resetLoggingLevel(2,2); //debug
+
+ bool success = true;
+
+ //Create tensors:
+ success = exatn::createTensor("Z",TENS_ELEM_TYPE,TensorShape{8,8}); assert(success);
+ success = exatn::createTensor("A",TENS_ELEM_TYPE,TensorShape{8,32}); assert(success);
+ success = exatn::createTensor("B",TENS_ELEM_TYPE,TensorShape{32,32}); assert(success);
+ success = exatn::createTensor("C",TENS_ELEM_TYPE,TensorShape{32,32}); assert(success);
+ success = exatn::createTensor("D",TENS_ELEM_TYPE,TensorShape{32,8}); assert(success);
+
+ //Init tensors:
+ success = exatn::initTensor("Z",0.0); assert(success);
+ success = exatn::initTensorRnd("A"); assert(success);
+ success = exatn::initTensorRnd("B"); assert(success);
+ success = exatn::initTensorRnd("C"); assert(success);
+ success = exatn::initTensorRnd("D"); assert(success);
+
+ //Build the tensor network:
+ std::map<std::string,std::shared_ptr<Tensor>> tensors;
+ for(const auto & name: {"Z","A","B","C","D"}) tensors.emplace(std::make_pair(name,exatn::getTensor(name)));
+ TensorNetwork network("Chain","Z(a,b)+=A(a,i)*B(i,j)*C(j,k)*D(k,b)",tensors);
+
+ //Evaluate the tensor network in full precision:
+ success = exatn::evaluateSync(network); assert(success);
+ double norm_full = 0.0;
+ success = exatn::computeNorm2Sync("Z",norm_full); assert(success);
+
+ //Evaluate the tensor network in mixed precision:
+ exatn::activateMixedPrecision();
+ success = exatn::evaluateSync(network); assert(success);
+ double norm_mixed = 0.0;
+ success = exatn::computeNorm2Sync("Z",norm_mixed); assert(success);
+ exatn::deactivateMixedPrecision();
+ std::cout << " 2-norm of tensor Z (full vs mixed precision) = " << norm_full << " vs " << norm_mixed << std::endl;
+ assert(std::abs(norm_mixed - norm_full) <= 1e-4 * norm_full);
+
+ //Error-controlled activation of the mixed-precision mode:
+ double rel_error = -1.0, speedup = 0.0;
+ success = exatn::calibrateMixedPrecisionSync(network,1e-4,&rel_error,&speedup); assert(success);
+ std::cout << " Mixed precision: Relative error = " << rel_error << "; Speedup = " << speedup << std::endl;
+ assert(rel_error >= 0.0 && rel_error <= 1e-4);
+ assert(exatn::mixedPrecisionIsActive(network.getName()));
+ assert(!exatn::mixedPrecisionIsActive()); //the decision only applies to this tensor network
+ success = exatn::calibrateMixedPrecisionSync(network,0.0,&rel_error,&speedup); assert(success);
+ if(rel_error > 0.0) assert(!exatn::mixedPrecisionIsActive(network.getName()));
+ exatn::deactivateMixedPrecision();
+
+ //Destroy tensors:
+ success = exatn::destroyTensor("D"); assert(success);
+ success = exatn::destroyTensor("C"); assert(success);
+ success = exatn::destroyTensor("B"); assert(success);
+ success = exatn::destroyTensor("A"); assert(success);
+ success = exatn::destroyTensor("Z"); assert(success);
+
+ //Synchronize:
+ success = exatn::sync(); assert(success);
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
+#ifdef EXATN_TEST27
+TEST(NumServerTester, HalfPrecision) {
+ using exatn::TensorShape;
+ using exatn::TensorElementType;
+
+ //exatn::resetLoggingLevel(2,2); //debug
+
+ bool success = true;
+
+ for(const auto elem_type: {TensorElementType::REAL16,TensorElementType::REALBF16,
+                            TensorElementType::COMPLEX16,TensorElementType::COMPLEXBF16}){
+  //Create tensors:
+  success = exatn::createTensor("A",elem_type,TensorShape{8,16}); assert(success);
+  success = exatn::createTensor("B",elem_type,TensorShape{16,8}); assert(success);
+  success = exatn::createTensor("C",elem_type,TensorShape{8,8}); assert(success);
+  assert(exatn::getTensor("C")->getSize() == 64 * exatn::numerics::tensor_element_type_size(elem_type));
+
+  //Init tensors:
+  success = exatn::initTensor("A",0.5); assert(success);
+  success = exatn::initTensor("B",0.25); assert(success);
+  success = exatn::initTensor("C",0.0); assert(success);
+
+  //Contract tensors (single-precision accumulation):
+  success = exatn::contractTensors("C(i,j)+=A(i,k)*B(k,j)",2.0); assert(success);
+  success = exatn::contractTensors("C(i,j)+=A(i,k)*B(k,j)",2.0); assert(success);
+
+  //Check the result:
+  double norm1 = 0.0;
+  success = exatn::computeNorm1Sync("C",norm1); assert(success);
+  std::cout << " 1-norm of tensor C (should be 512) = " << norm1 << std::endl;
+  assert(std::abs(norm1 - 512.0) < 1e-3);
+
+  //Destroy tensors:
+  success = exatn::destroyTensor("C"); assert(success);
+  success = exatn::destroyTensor("B"); assert(success);
+  success = exatn::destroyTensor("A"); assert(success);
+ }
+
+ //Synchronize:
+ success = exatn::sync(); assert(success);
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
+
+#ifdef EXATN_TEST28
+TEST(NumServerTester, BatchedAmplitudes) {
+ using exatn::TensorShape;
+ using exatn::TensorElementType;
+ using exatn::TensorNetwork;
+ using exatn::Tensor;
+
+ //exatn::resetLoggingLevel(2,2); //debug
+
+ bool success = true;
+
+ //Create tensors:
+ success = exatn::createTensor("Q0",TensorElementType::REAL64,TensorShape{2}); assert(success);
+ success = exatn::createTensor("H0",TensorElementType::REAL64,TensorShape{2,2}); assert(success);
+ success = exatn::createTensor("H1",TensorElementType::REAL64,TensorShape{2,2}); assert(success);
+ success = exatn::createTensor("P0",TensorElementType::REAL64,TensorShape{2}); assert(success);
+
+ //Init tensors:
+ success = exatn::initTensor("Q0",1.0); assert(success);
+ success = exatn::initTensor("H0",0.5); assert(success);
+ success = exatn::initTensor("H1",0.5); assert(success);
+ success = exatn::initTensor("P0",1.0); assert(success);
+
+ //Boundary tensors (projectors) of batch items:
+ const std::vector<double> values{1.0,2.0,3.0};
+ std::vector<std::vector<std::shared_ptr<Tensor>>> projectors;
+ for(std::size_t item = 0; item < values.size(); ++item){
+  const std::string name = "P" + std::to_string(item+1);
+  success = exatn::createTensor(name,TensorElementType::REAL64,TensorShape{2}); assert(success);
+  success = exatn::initTensor(name,values[item]); assert(success);
+  projectors.emplace_back(std::vector<std::shared_ptr<Tensor>>{exatn::getTensor(name)});
+ }
+
+ //Evaluate the batch of amplitudes Z0 = Q0(a)*H0(a,b)*H1(b,c)*Pk(c) = 2*values[k]:
+ TensorNetwork network("Amplitude","Z0() = Q0(a) * H0(a,b) * H1(b,c) * P0(c)",
+                       std::map<std::string,std::shared_ptr<Tensor>>{
+                        {"Z0",std::make_shared<Tensor>("Z0")},
+                        {"Q0",exatn::getTensor("Q0")},
+                        {"H0",exatn::getTensor("H0")},
+                        {"H1",exatn::getTensor("H1")},
+                        {"P0",exatn::getTensor("P0")}});
+ const auto boundary_ids = network.getTensorIdsInNetwork("P0"); assert(boundary_ids.size() == 1);
+ success = exatn::evaluateBatchSync(network,boundary_ids,projectors,"Amplitudes"); assert(success);
+
+ //Check the result:
+ double norm1 = 0.0, norm2 = 0.0;
+ success = exatn::computeNorm1Sync("Amplitudes",norm1); assert(success);
+ success = exatn::computeNorm2Sync("Amplitudes",norm2); assert(success);
+ std::cout << " 1-norm of batch amplitudes (should be 12) = " << norm1 << std::endl;
+ std::cout << " 2-norm of batch amplitudes (should be " << std::sqrt(56.0) << ") = " << norm2 << std::endl;
+ assert(std::abs(norm1 - 12.0) < 1e-7);
+ assert(std::abs(norm2 - std::sqrt(56.0)) < 1e-7);
+
+ //Destroy tensors:
+ success = exatn::destroyTensor("Amplitudes"); assert(success);
+ for(std::size_t item = 0; item < values.size(); ++item){
+  success = exatn::destroyTensor("P" + std::to_string(item+1)); assert(success);
+ }
+ success = exatn::destroyTensor("P0"); assert(success);
+ success = exatn::destroyTensor("H1"); assert(success);
+ success = exatn::destroyTensor("H0"); assert(success);
+ success = exatn::destroyTensor("Q0"); assert(success);
+
+ //Synchronize:
+ success = exatn::sync(); assert(success);
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
+
+#ifdef EXATN_TEST29
+TEST(NumServerTester, IntermediateCaching) {
+ using exatn::TensorShape;
+ using exatn::TensorElementType;
+ using exatn::TensorNetwork;
+ using exatn::Tensor;
+
+ //exatn::resetLoggingLevel(2,2); //debug
+
+ bool success = true;
+
+ //Create tensors:
+ success = exatn::createTensor("Q0",TensorElementType::REAL64,TensorShape{2}); assert(success);
+ success = exatn::createTensor("H0",TensorElementType::REAL64,TensorShape{2,2}); assert(success);
+ success = exatn::createTensor("H1",TensorElementType::REAL64,TensorShape{2,2}); assert(success);
+ success = exatn::createTensor("P0",TensorElementType::REAL64,TensorShape{2}); assert(success);
+
+ //Init tensors:
+ success = exatn::initTensor("Q0",1.0); assert(success);
+ success = exatn::initTensor("H0",0.5); assert(success);
+ success = exatn::initTensor("H1",0.5); assert(success);
+ success = exatn::initTensor("P0",1.0); assert(success);
+
+ //Activate caching of intermediate tensors:
+ exatn::activateIntermediateCaching(1024*1024);
+ assert(exatn::intermediateCachingIsActive());
+
+ //Z0 = Q0(a)*H0(a,b)*H1(b,c)*P0(c) = 2*Q0*P0:
+ TensorNetwork network("Amplitude","Z0() = Q0(a) * H0(a,b) * H1(b,c) * P0(c)",
+                       std::map<std::string,std::shared_ptr<Tensor>>{
+                        {"Z0",std::make_shared<Tensor>("Z0")},
+                        {"Q0",exatn::getTensor("Q0")},
+                        {"H0",exatn::getTensor("H0")},
+                        {"H1",exatn::getTensor("H1")},
+                        {"P0",exatn::getTensor("P0")}});
+
+ //Re-evaluate the tensor network after updating its input tensors one by one:
+ const std::vector<std::pair<std::string,double>> updates{{"P0",1.0},{"P0",3.0},{"Q0",2.0},{"H1",1.0}};
+ const std::vector<double> reference{2.0,6.0,12.0,24.0};
+ for(std::size_t i = 0; i < updates.size(); ++i){
+  success = exatn::initTensorSync(updates[i].first,updates[i].second); assert(success);
+  success = exatn::evaluateSync(network); assert(success);
+  double norm1 = 0.0;
+  success = exatn::computeNorm1Sync("Z0",norm1); assert(success);
+  std::cout << " Amplitude after update " << i << " (should be " << reference[i] << ") = " << norm1 << std::endl;
+  assert(std::abs(norm1 - reference[i]) < 1e-7);
+ }
+
+ //Deactivate caching of intermediate tensors:
+ exatn::deactivateIntermediateCaching();
+ assert(!exatn::intermediateCachingIsActive());
+
+ //Destroy tensors:
+ success = exatn::destroyTensor("P0"); assert(success);
+ success = exatn::destroyTensor("H1"); assert(success);
+ success = exatn::destroyTensor("H0"); assert(success);
+ success = exatn::destroyTensor("Q0"); assert(success);
+
+ //Synchronize:
+ success = exatn::sync(); assert(success);
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
+
+#ifdef EXATN_TEST30
+TEST(NumServerTester, ParallelExpansion) {
+ using exatn::TensorShape;
+ using exatn::TensorElementType;
+ using exatn::TensorNetwork;
+ using exatn::TensorOperator;
+ using exatn::TensorExpansion;
+ using exatn::Tensor;
+
+ //exatn::resetLoggingLevel(1,2); //debug
+
+ bool success = true;
+
+ //Declare MPS tensors:
+ auto q0 = std::make_shared<Tensor>("Q0",TensorShape{2,2});
+ auto q1 = std::make_shared<Tensor>("Q1",TensorShape{2,2,4});
+ auto q2 = std::make_shared<Tensor>("Q2",TensorShape{4,2,2});
+ auto q3 = std::make_shared<Tensor>("Q3",TensorShape{2,2});
+
+ //Declare Hamiltonian tensors:
+ auto h01 = std::make_shared<Tensor>("H01",TensorShape{2,2,2,2});
+ auto h12 = std::make_shared<Tensor>("H12",TensorShape{2,2,2,2});
+ auto h23 = std::make_shared<Tensor>("H23",TensorShape{2,2,2,2});
+ auto z0 = std::make_shared<Tensor>("Z0",TensorShape{2,2,2,2});
+
+ //Declare the Hamiltonian operator:
+ TensorOperator ham("Hamiltonian");
+ success = ham.appendComponent(h01,{{0,0},{1,1}},{{0,2},{1,3}},{1.0,0.0}); assert(success);
+ success = ham.appendComponent(h12,{{1,0},{2,1}},{{1,2},{2,3}},{1.0,0.0}); assert(success);
+ success = ham.appendComponent(h23,{{2,0},{3,1}},{{2,2},{3,3}},{1.0,0.0}); assert(success);
+
+ //Declare the closed product tensor expansion <MPS|H|MPS>:
+ auto mps_ket = std::make_shared<TensorNetwork>("MPS",
+                 "Z0(i0,i1,i2,i3)+=Q0(i0,j0)*Q1(j0,i1,j1)*Q2(j1,i2,j2)*Q3(j2,i3)",
+                 std::map<std::string,std::shared_ptr<Tensor>>{
+                  {"Z0",z0}, {"Q0",q0}, {"Q1",q1}, {"Q2",q2}, {"Q3",q3}});
+ TensorExpansion ket;
+ success = ket.appendComponent(mps_ket,{1.0,0.0}); assert(success);
+ ket.rename("MPSket");
+ TensorExpansion bra(ket);
+ bra.conjugate();
+ bra.rename("MPSbra");
+ TensorExpansion ham_ket(ket,ham);
+ ham_ket.rename("HamMPSket");
+ TensorExpansion closed_prod(ham_ket,bra);
+ closed_prod.rename("MPSbraHamMPSket");
+
+ {//Numerical evaluation:
+  //Create tensors:
+  success = exatn::createTensorSync(q0,TensorElementType::COMPLEX64); assert(success);
+  success = exatn::createTensorSync(q1,TensorElementType::COMPLEX64); assert(success);
+  success = exatn::createTensorSync(q2,TensorElementType::COMPLEX64); assert(success);
+  success = exatn::createTensorSync(q3,TensorElementType::COMPLEX64); assert(success);
+  success = exatn::createTensorSync(h01,TensorElementType::COMPLEX64); assert(success);
+  success = exatn::createTensorSync(h12,TensorElementType::COMPLEX64); assert(success);
+  success = exatn::createTensorSync(h23,TensorElementType::COMPLEX64); assert(success);
+  success = exatn::createTensorSync("AC0",TensorElementType::COMPLEX64,TensorShape{}); assert(success);
+  success = exatn::createTensorSync("AC1",TensorElementType::COMPLEX64,TensorShape{}); assert(success);
+
+  //Initialize tensors:
+  success = exatn::initTensorSync("Q0",0.5); assert(success);
+  success = exatn::initTensorSync("Q1",0.5); assert(success);
+  success = exatn::initTensorSync("Q2",0.5); assert(success);
+  success = exatn::initTensorSync("Q3",0.5); assert(success);
+  success = exatn::initTensorSync("H01",0.5); assert(success);
+  success = exatn::initTensorSync("H12",0.5); assert(success);
+  success = exatn::initTensorSync("H23",0.5); assert(success);
+  success = exatn::initTensorSync("AC0",0.0); assert(success);
+  success = exatn::initTensorSync("AC1",0.0); assert(success);
+
+  //Evaluate the expectation value by the whole process group:
+  auto time_start = exatn::Timer::timeInSecHR();
+  success = exatn::evaluateSync(closed_prod,exatn::getTensor("AC0")); assert(success);
+  auto duration = exatn::Timer::timeInSecHR(time_start);
+  std::cout << " Sequential evaluation of expansion components took " << duration << " s" << std::endl;
+
+  //Evaluate the expectation value by concurrent process subgroups (only with more than one MPI process):
+  const auto num_procs = exatn::getDefaultProcessGroup().getSize();
+  if(num_procs < 2) std::cout << " Single MPI process: Expansion components will be evaluated sequentially" << std::endl;
+  exatn::activateExpansionParallelism();
+  time_start = exatn::Timer::timeInSecHR();
+  success = exatn::evaluateSync(closed_prod,exatn::getTensor("AC1")); assert(success);
+  duration = exatn::Timer::timeInSecHR(time_start);
+  std::cout << " Concurrent evaluation of expansion components took " << duration << " s" << std::endl;
+  exatn::deactivateExpansionParallelism();
+
+  //Compare the results:
+  double norm0 = 0.0, norm1 = 0.0;
+  success = exatn::computeNorm1Sync("AC0",norm0); assert(success);
+  success = exatn::computeNorm1Sync("AC1",norm1); assert(success);
+  std::cout << " Expectation value magnitude: " << norm0 << " VS " << norm1 << std::endl;
+  assert(std::abs(norm0 - norm1) <= 1e-7 * norm0);
+  success = exatn::addTensorsSync("AC1()+=AC0()",-1.0); assert(success);
+  success = exatn::computeNorm1Sync("AC1",norm1); assert(success);
+  std::cout << " Difference between the sequential and concurrent values: " << norm1 << std::endl;
+  assert(norm1 <= 1e-7 * norm0);
+
+  //Destroy tensors:
+  success = exatn::destroyTensorSync("AC1"); assert(success);
+  success = exatn::destroyTensorSync("AC0"); assert(success);
+  success = exatn::destroyTensorSync("H23"); assert(success);
+  success = exatn::destroyTensorSync("H12"); assert(success);
+  success = exatn::destroyTensorSync("H01"); assert(success);
+  success = exatn::destroyTensorSync("Q3"); assert(success);
+  success = exatn::destroyTensorSync("Q2"); assert(success);
+  success = exatn::destroyTensorSync("Q1"); assert(success);
+  success = exatn::destroyTensorSync("Q0"); assert(success);
+ }
+
+ //Synchronize:
+ success = exatn::sync(); assert(success);
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
+
+#ifdef EXATN_TEST31
+TEST(NumServerTester, ConcurrentScopes) {
+ using exatn::TensorShape;
+ using exatn::TensorElementType;
+
+ //exatn::resetLoggingLevel(1,2); //debug
+
+ bool success = true;
+
+ //First workflow (executed in the background):
+ exatn::openScope("Job1");
+ success = exatn::createTensor("A1",TensorElementType::REAL64,TensorShape{64,64}); assert(success);
+ success = exatn::createTensor("B1",TensorElementType::REAL64,TensorShape{64,64}); assert(success);
+ success = exatn::createTensor("C1",TensorElementType::REAL64,TensorShape{64,64}); assert(success);
+ success = exatn::initTensor("A1",1e-1); assert(success);
+ success = exatn::initTensor("B1",1e-1); assert(success);
+ success = exatn::initTensor("C1",0.0); assert(success);
+ for(int i = 0; i < 8; ++i){
+  success = exatn::contractTensors("C1(a,b)+=A1(a,c)*B1(c,b)",1.0); assert(success);
+ }
+
+ //Second (independent) workflow with a higher priority:
+ exatn::openScope("Job2");
+ exatn::setScopePriority("Job2",2);
+ success = exatn::createTensor("A2",TensorElementType::REAL64,TensorShape{64,64}); assert(success);
+ success = exatn::createTensor("B2",TensorElementType::REAL64,TensorShape{64,64}); assert(success);
+ success = exatn::createTensor("C2",TensorElementType::REAL64,TensorShape{64,64}); assert(success);
+ success = exatn::initTensor("A2",1e-1); assert(success);
+ success = exatn::initTensor("B2",2e-1); assert(success);
+ success = exatn::initTensor("C2",0.0); assert(success);
+ for(int i = 0; i < 8; ++i){
+  success = exatn::contractTensors("C2(a,b)+=A2(a,c)*B2(c,b)",1.0); assert(success);
+ }
+
+ //Check the progress of both workflows:
+ exatn::ScopeProgress progress1, progress2;
+ success = exatn::getScopeProgress("Job1",progress1); assert(success);
+ success = exatn::getScopeProgress("Job2",progress2); assert(success);
+ std::cout << " Job1 progress: " << progress1.num_executed << " of " << progress1.num_submitted
+           << " tensor operations executed (" << progress1.throughput << " op/s)" << std::endl;
+ std::cout << " Job2 progress: " << progress2.num_executed << " of " << progress2.num_submitted
+           << " tensor operations executed (" << progress2.throughput << " op/s)" << std::endl;
+ assert(progress2.priority == 2);
+ assert(!exatn::getScopeProgress("Job3",progress1));
+
+ //Check the results of the second workflow:
+ double norm1 = 0.0;
+ success = exatn::computeNorm1Sync("C2",norm1); assert(success);
+ std::cout << " 1-norm of C2 (should be " << 8*64*64*64*2e-2 << ") = " << norm1 << std::endl;
+ assert(std::abs(norm1 - 8*64*64*64*2e-2) < 1e-6 * norm1);
+ success = exatn::destroyTensor("C2"); assert(success);
+ success = exatn::destroyTensor("B2"); assert(success);
+ success = exatn::destroyTensor("A2"); assert(success);
+ exatn::closeScope();
+
+ //Check the results of the first workflow:
+ success = exatn::getScopeProgress("Job1",progress1); assert(success);
+ success = exatn::computeNorm1Sync("C1",norm1); assert(success);
+ std::cout << " 1-norm of C1 (should be " << 8*64*64*64*1e-2 << ") = " << norm1 << std::endl;
+ assert(std::abs(norm1 - 8*64*64*64*1e-2) < 1e-6 * norm1);
+ success = exatn::destroyTensor("C1"); assert(success);
+ success = exatn::destroyTensor("B1"); assert(success);
+ success = exatn::destroyTensor("A1"); assert(success);
+ exatn::closeScope();
+
+ //Synchronize:
+ success = exatn::sync(); assert(success);
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
+#ifdef EXATN_TEST32
+TEST(NumServerTester, BlockSparseTensors) {
+ using exatn::TensorShape;
+ using exatn::TensorElementType;
+ using exatn::LegDirection;
+
+ //exatn::resetLoggingLevel(2,2); //debug
+
+ bool success = true;
+
+ //U(1)-symmetric vector spaces:
+ exatn::createVectorSpace("BondU1",6,{{0,1,-1},{2,3,0},{4,5,1}});
+ exatn::createVectorSpace("PhysU1",2,{{0,0,0},{1,1,1}});
+
+ //Block-sparse tensors:
+ success = exatn::createTensorBlockSparse("AS",TensorElementType::REAL64,{"BondU1","BondU1"},
+                                          {LegDirection::OUTWARD,LegDirection::INWARD}); assert(success);
+ success = exatn::createTensorBlockSparse("TS",TensorElementType::REAL64,{"BondU1","PhysU1","BondU1"},
+                                          {LegDirection::OUTWARD,LegDirection::OUTWARD,LegDirection::INWARD}); assert(success);
+ success = exatn::createTensorBlockSparse("DS",TensorElementType::REAL64,{"BondU1","PhysU1","BondU1"},
+                                          {LegDirection::OUTWARD,LegDirection::OUTWARD,LegDirection::INWARD}); assert(success);
+ assert(exatn::getTensorBlockSparse("TS")->getVolume() < exatn::getTensorBlockSparse("TS")->getDenseVolume());
+ success = exatn::initTensorRndBlockSparse("AS"); assert(success);
+ success = exatn::initTensorRndBlockSparse("TS"); assert(success);
+ success = exatn::initTensorBlockSparse("DS",0.0); assert(success);
+
+ //Dense copies of the block-sparse tensors:
+ success = exatn::createTensor("AD",TensorElementType::REAL64,TensorShape{6,6}); assert(success);
+ success = exatn::createTensor("TD",TensorElementType::REAL64,TensorShape{6,2,6}); assert(success);
+ success = exatn::createTensor("DD",TensorElementType::REAL64,TensorShape{6,2,6}); assert(success);
+ success = exatn::initTensor("AD",0.0); assert(success);
+ success = exatn::initTensor("TD",0.0); assert(success);
+ success = exatn::initTensor("DD",0.0); assert(success);
+ for(const auto & block: exatn::getTensorBlockSparse("AS")->getBlocks()){
+  success = exatn::insertTensorSlice("AD",block.tensor->getName()); assert(success);
+ }
+ for(const auto & block: exatn::getTensorBlockSparse("TS")->getBlocks()){
+  success = exatn::insertTensorSlice("TD",block.tensor->getName()); assert(success);
+ }
+
+ //Block-sparse versus dense tensor contraction:
+ success = exatn::contractTensorsBlockSparse("DS(a,s,b)+=AS(a,c)*TS(c,s,b)",1.0); assert(success);
+ success = exatn::contractTensors("DD(a,s,b)+=AD(a,c)*TD(c,s,b)",1.0); assert(success);
+ double norm_sparse = 0.0, norm_dense = 0.0;
+ success = exatn::computeNorm2BlockSparseSync("DS",norm_sparse); assert(success);
+ success = exatn::computeNorm2Sync("DD",norm_dense); assert(success);
+ std::cout << " 2-norm of the block-sparse result = " << norm_sparse
+           << " (dense result = " << norm_dense << ")" << std::endl;
+ assert(std::abs(norm_sparse - norm_dense) < 1e-9 * norm_dense);
+ //Overwrite TD with the block-sparse result (same block structure):
+ for(const auto & block: exatn::getTensorBlockSparse("DS")->getBlocks()){
+  success = exatn::insertTensorSlice("TD",block.tensor->getName()); assert(success);
+ }
+ success = exatn::addTensors("TD(a,s,b)+=DD(a,s,b)",-1.0); assert(success);
+ success = exatn::computeMaxAbsSync("TD",norm_dense); assert(success);
+ std::cout << " Max deviation of the block-sparse result = " << norm_dense << std::endl;
+ assert(norm_dense < 1e-12 * norm_sparse);
+
+ //Block tensors do not clash with client tensors named like them:
+ success = exatn::createTensor("XS_B0_0",TensorElementType::REAL64,TensorShape{2,2}); assert(success);
+ success = exatn::createTensorBlockSparse("XS",TensorElementType::REAL64,{"BondU1","BondU1"},
+                                          {LegDirection::OUTWARD,LegDirection::INWARD}); assert(success);
+ const auto block00 = exatn::getTensorBlockSparse("XS")->getBlocks()[0].tensor->getName();
+ assert(block00 != "XS_B0_0");
+ success = exatn::destroyTensorBlockSparse("XS"); assert(success);
+ //Creating a block-sparse tensor whose block names are taken by existing tensors fails:
+ success = exatn::createTensor(block00,TensorElementType::REAL64,TensorShape{2,2}); assert(success);
+ success = exatn::createTensorBlockSparse("XS",TensorElementType::REAL64,{"BondU1","BondU1"},
+                                          {LegDirection::OUTWARD,LegDirection::INWARD}); assert(!success);
+ assert(!exatn::getTensorBlockSparse("XS"));
+ success = exatn::destroyTensor(block00); assert(success);
+ success = exatn::destroyTensor("XS_B0_0"); assert(success);
+
+ //Destroy tensors:
+ success = exatn::destroyTensor("DD"); assert(success);
+ success = exatn::destroyTensor("TD"); assert(success);
+ success = exatn::destroyTensor("AD"); assert(success);
+ success = exatn::destroyTensorBlockSparse("DS"); assert(success);
+ success = exatn::destroyTensorBlockSparse("TS"); assert(success);
+ success = exatn::destroyTensorBlockSparse("AS"); assert(success);
+
+ //Synchronize:
+ success = exatn::sync(); assert(success);
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
+
+#ifdef EXATN_TEST33
+TEST(NumServerTester, TruncatedSVD) {
+ using exatn::TensorShape;
+ using exatn::TensorElementType;
+
+ //exatn::resetLoggingLevel(2,2); //debug
+
+ bool success = true;
+
+ //Tensor D(a,b,c,d) of rank 4 over the bipartition (a,b)|(c,d):
+ success = exatn::createTensor("X",TensorElementType::REAL64,TensorShape{8,8,4}); assert(success);
+ success = exatn::createTensor("Y",TensorElementType::REAL64,TensorShape{4,8,8}); assert(success);
+ success = exatn::createTensor("D",TensorElementType::REAL64,TensorShape{8,8,8,8}); assert(success);
+ success = exatn::createTensor("Z",TensorElementType::REAL64,TensorShape{8,8,8,8}); assert(success);
+ success = exatn::initTensorRnd("X"); assert(success);
+ success = exatn::initTensorRnd("Y"); assert(success);
+ success = exatn::initTensor("D",0.0); assert(success);
+ success = exatn::contractTensors("D(a,b,c,d)+=X(a,b,k)*Y(k,c,d)",1.0); assert(success);
+ double norm_d = 0.0;
+ success = exatn::computeNorm2Sync("D",norm_d); assert(success);
+
+ //Truncation by cutoff recovers the exact rank (the factors are created automatically):
+ double error = -1.0;
+ success = exatn::decomposeTensorSVDLRTruncSync("D(a,b,c,d)=L(a,b,i)*R(i,c,d)",16,1e-8*norm_d,&error); assert(success);
+ std::cout << " Retained rank = " << exatn::getTensor("L")->getDimExtent(2)
+           << "; Truncation error = " << error << std::endl;
+ assert(exatn::getTensor("L")->getDimExtent(2) == 4 && exatn::getTensor("R")->getDimExtent(0) == 4);
+ assert(error < 1e-6 * norm_d);
+ success = exatn::initTensor("Z",0.0); assert(success);
+ success = exatn::contractTensors("Z(a,b,c,d)+=L(a,b,i)*R(i,c,d)",1.0); assert(success);
+ success = exatn::addTensors("Z(a,b,c,d)+=D(a,b,c,d)",-1.0); assert(success);
+ double norm_z = 0.0;
+ success = exatn::computeNorm2Sync("Z",norm_z); assert(success);
+ assert(norm_z < 1e-9 * norm_d);
+
+ //Truncation by max rank reshapes the existing factors and reports the truncation error:
+ success = exatn::decomposeTensorSVDLTruncSync("D(a,b,c,d)=L(a,b,i)*R(i,c,d)",2,0.0,&error); assert(success);
+ assert(exatn::getTensor("L")->getDimExtent(2) == 2 && exatn::getTensor("R")->getDimExtent(0) == 2);
+ success = exatn::initTensor("Z",0.0); assert(success);
+ success = exatn::contractTensors("Z(a,b,c,d)+=L(a,b,i)*R(i,c,d)",1.0); assert(success);
+ success = exatn::addTensors("Z(a,b,c,d)+=D(a,b,c,d)",-1.0); assert(success);
+ success = exatn::computeNorm2Sync("Z",norm_z); assert(success);
+ std::cout << " Truncation error = " << error << " (actual = " << norm_z << ")" << std::endl;
+ assert(error > 0.0 && std::abs(error - norm_z) < 1e-9 * norm_d);
+
+ //Three-factor truncated SVD: The singular values account for the retained norm:
+ double error3 = 0.0, norm_s = 0.0;
+ success = exatn::decomposeTensorSVDTruncSync("D(a,b,c,d)=L(a,b,i)*S(i)*R(i,c,d)",2,0.0,&error3); assert(success);
+ success = exatn::computeNorm2Sync("S",norm_s); assert(success);
+ assert(std::abs(error3 - error) < 1e-9 * norm_d);
+ assert(std::abs(norm_s*norm_s + error3*error3 - norm_d*norm_d) < 1e-9 * norm_d*norm_d);
+
+ //Destroy tensors:
+ success = exatn::destroyTensor("S"); assert(success);
+ success = exatn::destroyTensor("R"); assert(success);
+ success = exatn::destroyTensor("L"); assert(success);
+ success = exatn::destroyTensor("Z"); assert(success);
+ success = exatn::destroyTensor("D"); assert(success);
+ success = exatn::destroyTensor("Y"); assert(success);
+ success = exatn::destroyTensor("X"); assert(success);
+
+ //Synchronize:
+ success = exatn::sync(); assert(success);
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
+#ifdef EXATN_TEST34
+TEST(NumServerTester, AsyncTransforms) {
+ using exatn::TensorShape;
+ using exatn::TensorElementType;
+
+ //exatn::resetLoggingLevel(2,2); //debug
+
+ bool success = true;
+
+ //Time intervals during which the tensor functors have been applied {start, finish, multithreaded}:
+ struct TransformLog{
+  std::mutex lock;
+  std::vector<std::tuple<double,double,bool>> intervals;
+ };
+ auto transform_log = std::make_shared<TransformLog>();
+
+ //Slow tensor functor initializing a tensor to a value:
+ class SlowInitVal: public exatn::TensorMethod, public exatn::TensorMethodConcurrencyTrait{
+ public:
+
+  SlowInitVal(double value,
+              exatn::TensorMethodConcurrency concurrency,
+              std::shared_ptr<TransformLog> log):
+   value_(value), concurrency_(concurrency), log_(log) {}
+
+  virtual const std::string name() const override {return "SlowInitVal";}
+
+  virtual const std::string description() const override {return "Slowly initializes a tensor to a value";}
+
+  virtual void pack(BytePacket & packet) override {return;}
+
+  virtual void unpack(BytePacket & packet) override {return;}
+
+  virtual int apply(talsh::Tensor & local_tensor) override {
+   double * body;
+   if(!local_tensor.getDataAccessHost(&body)) return 1;
+   const double start = exatn::Timer::timeInSecHR();
+   std::this_thread::sleep_for(std::chrono::milliseconds(100));
+   const auto volume = local_tensor.getVolume();
+   for(std::size_t i = 0; i < volume; ++i) body[i] = value_;
+   const double finish = exatn::Timer::timeInSecHR();
+   const std::lock_guard<std::mutex> lock(log_->lock);
+   log_->intervals.emplace_back(std::make_tuple(start,finish,
+                                concurrency_ == exatn::TensorMethodConcurrency::THREAD_PARALLEL));
+   return 0;
+  }
+
+  virtual exatn::TensorMethodConcurrency getConcurrency() const override {return concurrency_;}
+
+ private:
+
+  double value_;
+  exatn::TensorMethodConcurrency concurrency_;
+  std::shared_ptr<TransformLog> log_;
+ };
+
+ //Create tensors (the last two are initialized by multithreaded tensor functors):
+ const int num_tensors = 6, num_serial = 4;
+ for(int i = 0; i < num_tensors; ++i){
+  success = exatn::createTensor("T"+std::to_string(i),TensorElementType::REAL64,TensorShape{16,16}); assert(success);
+ }
+ success = exatn::createTensor("X",TensorElementType::REAL64,TensorShape{64,64}); assert(success);
+ success = exatn::createTensor("Y",TensorElementType::REAL64,TensorShape{64,64}); assert(success);
+ success = exatn::createTensor("Z",TensorElementType::REAL64,TensorShape{64,64}); assert(success);
+
+ //Slow tensor transformations overlap with independent tensor contractions:
+ const double time_start = exatn::Timer::timeInSecHR();
+ for(int i = 0; i < num_tensors; ++i){
+  const auto concurrency = ((i < num_serial) ? exatn::TensorMethodConcurrency::SERIAL
+                                             : exatn::TensorMethodConcurrency::THREAD_PARALLEL);
+  success = exatn::transformTensor("T"+std::to_string(i),
+                                   std::shared_ptr<exatn::TensorMethod>(new SlowInitVal(static_cast<double>(i+1),
+                                                                                        concurrency,transform_log)));
+  assert(success);
+ }
+ success = exatn::initTensor("X",1.0); assert(success);
+ success = exatn::initTensor("Y",1.0); assert(success);
+ success = exatn::initTensor("Z",0.0); assert(success);
+ success = exatn::contractTensors("Z(a,b)+=X(a,c)*Y(c,b)",1.0); assert(success);
+ success = exatn::sync("Z"); assert(success);
+ const double time_contracted = exatn::Timer::timeInSecHR();
+
+ //Check the results:
+ for(int i = 0; i < num_tensors; ++i){
+  double norm2 = 0.0;
+  success = exatn::computeNorm2Sync("T"+std::to_string(i),norm2); assert(success);
+  assert(std::abs(norm2 - static_cast<double>((i+1)*16)) < 1e-9);
+ }
+ double norm2 = 0.0;
+ success = exatn::computeNorm2Sync("Z",norm2); assert(success);
+ assert(std::abs(norm2 - 64.0*64.0*64.0) < 1e-6);
+
+ //Check the overlap (the default number of Host worker threads is 2):
+ assert(transform_log->intervals.size() == static_cast<std::size_t>(num_tensors));
+ double time_transformed = time_start;
+ int num_overlaps = 0;
+ for(std::size_t i = 0; i < transform_log->intervals.size(); ++i){
+  const auto & interval = transform_log->intervals[i];
+  time_transformed = std::max(time_transformed,std::get<1>(interval));
+  for(std::size_t j = i + 1; j < transform_log->intervals.size(); ++j){
+   const auto & other = transform_log->intervals[j];
+   if(std::get<0>(interval) < std::get<1>(other) && std::get<0>(other) < std::get<1>(interval)){
+    assert(!std::get<2>(interval) && !std::get<2>(other)); //multithreaded tensor functors are applied alone
+    ++num_overlaps;
+   }
+  }
+ }
+ std::cout << " Overlapping tensor transformations: " << num_overlaps << "; Tensor contraction completed after "
+           << (time_contracted - time_start) << " s, tensor transformations after " << (time_transformed - time_start)
+           << " s" << std::endl;
+ assert(num_overlaps > 0); //single-threaded tensor functors are applied concurrently
+ assert(time_contracted < time_transformed); //tensor contractions are not blocked by tensor transformations
+
+ //Destroy tensors:
+ success = exatn::destroyTensor("Z"); assert(success);
+ success = exatn::destroyTensor("Y"); assert(success);
+ success = exatn::destroyTensor("X"); assert(success);
+ for(int i = 0; i < num_tensors; ++i){
+  success = exatn::destroyTensor("T"+std::to_string(i)); assert(success);
+ }
+
+ //Synchronize:
+ success = exatn::sync(); assert(success);
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
+#ifdef EXATN_TEST35
+TEST(NumServerTester, FusedTransforms) {
+ using exatn::TensorShape;
+ using exatn::TensorElementType;
+
+ //exatn::resetLoggingLevel(2,2); //debug
+
+ bool success = true;
+
+ //Create tensors:
+ success = exatn::createTensor("A",TensorElementType::REAL64,TensorShape{8,8,8}); assert(success);
+ success = exatn::createTensor("B",TensorElementType::COMPLEX64,TensorShape{8,8,8}); assert(success);
+
+ //Consecutive initialization and scaling of the same tensor get fused into a single pass:
+ success = exatn::initTensor("A",0.5); assert(success);
+ success = exatn::scaleTensor("A",-2.0); assert(success);
+ success = exatn::initTensor("B",std::complex<double>{3.0,4.0}); assert(success);
+ success = exatn::scaleTensor("B",std::complex<double>{0.0,0.2}); assert(success);
+
+ //All norms computed in a single pass:
+ double norm1 = 0.0, norm2 = 0.0, maxabs = 0.0;
+ success = exatn::computeNormsSync("A",norm1,norm2,maxabs); assert(success);
+ std::cout << " Norms of A: " << norm1 << " " << norm2 << " " << maxabs << std::endl;
+ assert(std::abs(norm1 - 512.0) < 1e-9 && std::abs(norm2 - std::sqrt(512.0)) < 1e-9 && std::abs(maxabs - 1.0) < 1e-12);
+ success = exatn::computeNormsSync("B",norm1,norm2,maxabs); assert(success);
+ std::cout << " Norms of B: " << norm1 << " " << norm2 << " " << maxabs << std::endl;
+ assert(std::abs(norm1 - 512.0) < 1e-9 && std::abs(norm2 - std::sqrt(512.0)) < 1e-9 && std::abs(maxabs - 1.0) < 1e-12);
+
+ //Consistency with separately computed norms:
+ double norm = 0.0;
+ success = exatn::computeNorm1Sync("B",norm); assert(success);
+ assert(std::abs(norm - norm1) < 1e-9);
+ success = exatn::computeNorm2Sync("B",norm); assert(success);
+ assert(std::abs(norm - norm2) < 1e-9);
+ success = exatn::computeMaxAbsSync("B",norm); assert(success);
+ assert(std::abs(norm - maxabs) < 1e-12);
+
+ //Initialization fused with a norm never reads the previous tensor content:
+ success = exatn::createTensor("Z",TensorElementType::REAL64,TensorShape{8,8,8}); assert(success);
+ success = exatn::initTensor("Z",0.0); assert(success);
+ success = exatn::computeNorm2Sync("Z",norm); assert(success);
+ std::cout << " 2-norm of freshly created Z = " << norm << std::endl;
+ assert(norm == 0.0);
+ success = exatn::initTensorDataSync("Z",std::vector<double>(512,std::numeric_limits<double>::quiet_NaN())); assert(success);
+ success = exatn::initTensor("Z",0.5); assert(success);
+ success = exatn::scaleTensor("Z",2.0); assert(success);
+ success = exatn::computeNormsSync("Z",norm1,norm2,maxabs); assert(success);
+ std::cout << " Norms of re-initialized Z: " << norm1 << " " << norm2 << " " << maxabs << std::endl;
+ assert(std::abs(norm1 - 512.0) < 1e-9 && std::abs(norm2 - std::sqrt(512.0)) < 1e-9 && std::abs(maxabs - 1.0) < 1e-12);
+ success = exatn::destroyTensor("Z"); assert(success);
+
+ //Destroy tensors:
+ success = exatn::destroyTensor("B"); assert(success);
+ success = exatn::destroyTensor("A"); assert(success);
+
+ //Synchronize:
+ success = exatn::sync(); assert(success);
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
+#ifdef EXATN_TEST36
+TEST(NumServerTester, PausedScopeHazards) {
+ using exatn::TensorShape;
+ using exatn::TensorElementType;
+
+ //exatn::resetLoggingLevel(1,2); //debug
+
+ bool success = true;
+
+ //Parental scope writes tensor T and is paused before its tensor operations are executed:
+ exatn::openScope("Writer");
+ success = exatn::createTensor("A",TensorElementType::REAL64,TensorShape{64,64}); assert(success);
+ success = exatn::createTensor("T",TensorElementType::REAL64,TensorShape{64,64}); assert(success);
+ success = exatn::initTensor("A",1e-1); assert(success);
+ success = exatn::initTensor("T",0.0); assert(success);
+ for(int i = 0; i < 8; ++i){
+  success = exatn::contractTensors("T(a,b)+=A(a,c)*A(c,b)",1.0); assert(success);
+ }
+ exatn::pauseScope();
+
+ //Child scope reads tensor T (all outstanding writes of the paused scope on T must be executed first):
+ exatn::openScope("Reader");
+ success = exatn::createTensor("S",TensorElementType::REAL64,TensorShape{64,64}); assert(success);
+ success = exatn::initTensor("S",0.0); assert(success);
+ success = exatn::addTensors("S(a,b)+=T(a,b)",1.0); assert(success);
+ double norm1 = 0.0;
+ success = exatn::computeNorm1Sync("S",norm1); assert(success);
+ std::cout << " 1-norm of S (should be " << 8*64*64*64*1e-2 << ") = " << norm1 << std::endl;
+ assert(std::abs(norm1 - 8*64*64*64*1e-2) < 1e-6 * norm1);
+ //Tensor T is synchronized across all open scopes:
+ success = exatn::computeNorm1Sync("T",norm1); assert(success);
+ assert(std::abs(norm1 - 8*64*64*64*1e-2) < 1e-6 * norm1);
+ success = exatn::destroyTensor("S"); assert(success);
+ exatn::closeScope(); //resumes the parental scope
+
+ success = exatn::destroyTensor("T"); assert(success);
+ success = exatn::destroyTensor("A"); assert(success);
+ exatn::closeScope();
+
+ //Synchronize:
+ success = exatn::sync(); assert(success);
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
+
+#ifdef EXATN_TEST37
+TEST(NumServerTester, ProcessGroupPartitioning) {
+ using exatn::ProcessGroup;
+
+ //exatn::resetLoggingLevel(1,2); //debug
+
+ //Process group of 4 processes (partitioning does not communicate):
+ const std::size_t proc_memory = 1UL * 1024UL * 1024UL * 1024UL; //bytes
+ const ProcessGroup process_group(exatn::getDefaultProcessGroup().getMPICommProxy(),4U,proc_memory);
+ std::vector<unsigned int> component_groups;
+ std::vector<std::pair<unsigned int,unsigned int>> group_ranks;
+
+ //More components than processes: One process per subgroup, the most expensive component alone:
+ auto num_groups = exatn::numericalServer->partitionProcessGroup(process_group,{8.0,1.0,1.0,1.0,1.0},
+                                                                 {1e6,1e6,1e6,1e6,1e6},component_groups,group_ranks);
+ assert(num_groups == 4 && component_groups.size() == 5 && group_ranks.size() == 4);
+ for(unsigned int i = 0; i < num_groups; ++i) assert(group_ranks[i] == std::make_pair(i,i+1));
+ for(unsigned int i = 1; i < 5; ++i) assert(component_groups[i] != component_groups[0]);
+
+ //Fewer components than processes: The remaining processes follow the flop count:
+ num_groups = exatn::numericalServer->partitionProcessGroup(process_group,{3.0,1.0},
+                                                            {1e6,1e6},component_groups,group_ranks);
+ assert(num_groups == 2);
+ assert(component_groups[0] == 0 && component_groups[1] == 1);
+ assert(group_ranks[0] == std::make_pair(0U,3U) && group_ranks[1] == std::make_pair(3U,4U));
+
+ //Memory footprints: A component exceeding the memory limit per process gets enough processes:
+ num_groups = exatn::numericalServer->partitionProcessGroup(process_group,{1.0,1.0},
+                                                            {2.5*static_cast<double>(proc_memory),1e6},
+                                                            component_groups,group_ranks);
+ assert(num_groups == 2);
+ assert(group_ranks[component_groups[0]].second - group_ranks[component_groups[0]].first == 3);
+ assert(group_ranks[component_groups[1]].second - group_ranks[component_groups[1]].first == 1);
+
+ //Unsatisfiable memory footprints: One process per subgroup plus the flop-based distribution:
+ num_groups = exatn::numericalServer->partitionProcessGroup(process_group,{1.0,2.0},
+                                                            {3.5*static_cast<double>(proc_memory),
+                                                             3.5*static_cast<double>(proc_memory)},
+                                                            component_groups,group_ranks);
+ assert(num_groups == 2);
+ assert(group_ranks[0] == std::make_pair(0U,2U) && group_ranks[1] == std::make_pair(2U,4U));
+
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
 
 int main(int argc, char **argv) {
 
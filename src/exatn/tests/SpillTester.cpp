@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include "exatn.hpp"
+#include "talshxx.hpp"
+
+#ifdef MPI_ENABLED
+#include "mpi.h"
+#endif
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cmath>
+
+#include "errors.hpp"
+
+//Test activation:
+#define EXATN_TEST0
+
+
+#ifdef EXATN_TEST0
+TEST(SpillTester, OutOfCoreWorkingSet) {
+ using exatn::TensorShape;
+ using exatn::TensorElementType;
+
+ //exatn::resetLoggingLevel(2,2); //debug
+
+ bool success = true;
+
+ //The working set is three times larger than the memory buffer (16 MiB per tensor):
+ const exatn::DimExtent rows = 1024, cols = 2048;
+ const int num_tensors = 3 * (exatn::getMemoryBufferSize() / (rows * cols * sizeof(double)));
+ assert(num_tensors >= 12);
+
+ //Create and initialize tensors (even: constant, thus compressible; odd: random, thus spilled to disk):
+ std::vector<double> norms(num_tensors,0.0);
+ for(int i = 0; i < num_tensors; ++i){
+  const std::string name = "T" + std::to_string(i);
+  success = exatn::createTensor(name,TensorElementType::REAL64,TensorShape{rows,cols}); assert(success);
+  if(i % 2 == 0){
+   success = exatn::initTensor(name,static_cast<double>(i+1)); assert(success);
+  }else{
+   success = exatn::initTensorRnd(name); assert(success);
+  }
+  success = exatn::computeNorm1Sync(name,norms[i]); assert(success);
+ }
+
+ //Tensor contractions restoring spilled tensors:
+ success = exatn::createTensor("C",TensorElementType::REAL64,TensorShape{rows,rows}); assert(success);
+ success = exatn::initTensor("C",0.0); assert(success);
+ double reference = 0.0;
+ for(int i = 0; i + 2 < num_tensors; i += 2){
+  success = exatn::contractTensors("C(a,b)+=T" + std::to_string(i) + "(a,k)*T" + std::to_string(i+2) + "(b,k)",1.0);
+  assert(success);
+  reference += static_cast<double>((i+1)*(i+3)) * static_cast<double>(cols);
+ }
+ reference *= static_cast<double>(rows * rows);
+
+ //Check the results:
+ double norm1 = 0.0;
+ success = exatn::computeNorm1Sync("C",norm1); assert(success);
+ std::cout << " 1-norm of C = " << norm1 << " (reference " << reference << ")" << std::endl;
+ assert(std::abs(norm1 - reference) <= 1e-12 * reference);
+ for(int i = 0; i < num_tensors; ++i){
+  const std::string name = "T" + std::to_string(i);
+  success = exatn::computeNorm1Sync(name,norm1); assert(success);
+  assert(std::abs(norm1 - norms[i]) <= 1e-12 * norms[i]); //spilling is lossless
+  if(i % 2 == 0) assert(norms[i] == static_cast<double>(i+1) * static_cast<double>(rows * cols));
+ }
+ //Spilled tensors do not count against the memory buffer:
+ std::cout << " Peak memory usage = " << exatn::getPeakMemorySize() << " bytes" << std::endl;
+ assert(exatn::getPeakMemorySize() <= exatn::getMemoryBufferSize());
+
+ //Destroy tensors:
+ success = exatn::destroyTensor("C"); assert(success);
+ for(int i = num_tensors - 1; i >= 0; --i){
+  success = exatn::destroyTensor("T" + std::to_string(i)); assert(success);
+ }
+
+ //Synchronize:
+ success = exatn::sync(); assert(success);
+ exatn::resetLoggingLevel(0,0);
+ //Grab a beer!
+}
+#endif
+
+
+int main(int argc, char **argv) {
+
+  exatn::ParamConf exatn_parameters;
+  //Set a small CPU Host RAM size to be used by ExaTN:
+  exatn_parameters.setParameter("host_memory_buffer_size",128L*1024L*1024L);
+  //Spill idle tensors to disk (current directory), compressing them first:
+  exatn_parameters.setParameter("host_spill_directory",std::string("."));
+  exatn_parameters.setParameter("host_compression",1L);
+  exatn_parameters.setParameter("host_compression_min_bytes",1L*1024L*1024L);
+#ifdef MPI_ENABLED
+  int thread_provided;
+  int mpi_error = MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &thread_provided);
+  assert(mpi_error == MPI_SUCCESS);
+  assert(thread_provided == MPI_THREAD_MULTIPLE);
+  exatn::initialize(exatn::MPICommProxy(MPI_COMM_WORLD),exatn_parameters,"lazy-dag-executor");
+#else
+  exatn::initialize(exatn_parameters,"lazy-dag-executor");
+#endif
+
+  ::testing::InitGoogleTest(&argc, argv);
+  auto ret = RUN_ALL_TESTS();
+
+  exatn::finalize();
+#ifdef MPI_ENABLED
+  mpi_error = MPI_Finalize(); assert(mpi_error == MPI_SUCCESS);
+#endif
+  return ret;
+}
@@ -1,5 +1,5 @@
 /** ExaTN::Numerics: Tensor Functor: Computes partial 2-norms over a given tensor dimension
-REVISION: 2020/04/23
+REVISION: 2020/12/04
 
 Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
@@ -21,6 +21,7 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
 #include "tensor_shape.hpp"
 
 #include "tensor_method.hpp" //from TAL-SH
+#include "tensor_method_concurrency.hpp"
 
 #include <type_traits>
 #include <string>
@@ -33,7 +34,7 @@ namespace exatn{
 
 namespace numerics{
 
-class FunctorDiagRank: public talsh::TensorFunctor<Identifiable>{
+class FunctorDiagRank: public talsh::TensorFunctor<Identifiable>, public TensorMethodConcurrencyTrait{
 public:
 
  FunctorDiagRank(unsigned int tensor_dimension); //in: chosen tensor dimension
@@ -62,6 +63,12 @@ public:
      shape that both can be accessed by talsh::Tensor methods. **/
  virtual int apply(talsh::Tensor & local_tensor) override;
 
+ /** Single-threaded tensor functor. **/
+ virtual TensorMethodConcurrency getConcurrency() const override
+ {
+  return TensorMethodConcurrency::SERIAL;
+ }
+
  const std::vector<double> & getPartialNorms() const {return partial_norms_;}
 
 private:
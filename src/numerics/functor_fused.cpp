@@ -0,0 +1,248 @@
+/** ExaTN::Numerics: Tensor Functor: Fused elementwise transformations and reductions
+REVISION: 2020/12/14
+
+Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
+Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
+
+#include "functor_fused.hpp"
+
+#include "functor_init_val.hpp"
+#include "functor_scale.hpp"
+#include "functor_norm1.hpp"
+#include "functor_norm2.hpp"
+#include "functor_maxabs.hpp"
+
+#include "talshxx.hpp"
+
+#include <complex>
+#include <cmath>
+
+namespace exatn{
+
+namespace numerics{
+
+/** Converts a scalar value to the tensor element type (real types take the real part). **/
+template <typename NumericType>
+inline NumericType fused_scalar(const std::complex<double> & value)
+{
+ return static_cast<NumericType>(value.real());
+}
+
+template <>
+inline std::complex<float> fused_scalar<std::complex<float>>(const std::complex<double> & value)
+{
+ return std::complex<float>{static_cast<float>(value.real()),static_cast<float>(value.imag())};
+}
+
+template <>
+inline std::complex<double> fused_scalar<std::complex<double>>(const std::complex<double> & value)
+{
+ return value;
+}
+
+
+FunctorFused::StageKind FunctorFused::getStageKind(const talsh::TensorFunctor<Identifiable> & functor)
+{
+ if(dynamic_cast<const FunctorInitVal*>(&functor) != nullptr) return StageKind::INIT_VAL;
+ if(dynamic_cast<const FunctorScale*>(&functor) != nullptr) return StageKind::SCALE;
+ if(dynamic_cast<const FunctorNorm1*>(&functor) != nullptr) return StageKind::NORM1;
+ if(dynamic_cast<const FunctorNorm2*>(&functor) != nullptr) return StageKind::NORM2;
+ if(dynamic_cast<const FunctorMaxAbs*>(&functor) != nullptr) return StageKind::MAXABS;
+ return StageKind::NONE;
+}
+
+
+bool FunctorFused::isFusable(const talsh::TensorFunctor<Identifiable> & functor)
+{
+ if(dynamic_cast<const FunctorFused*>(&functor) != nullptr) return true;
+ return (getStageKind(functor) != StageKind::NONE);
+}
+
+
+bool FunctorFused::append(std::shared_ptr<talsh::TensorFunctor<Identifiable>> functor)
+{
+ if(!functor) return false;
+ const auto * fused = dynamic_cast<const FunctorFused*>(functor.get());
+ if(fused != nullptr){
+  kinds_.insert(kinds_.end(),fused->kinds_.cbegin(),fused->kinds_.cend());
+  stages_.insert(stages_.end(),fused->stages_.cbegin(),fused->stages_.cend());
+  return true;
+ }
+ const auto kind = getStageKind(*functor);
+ if(kind == StageKind::NONE) return false;
+ kinds_.emplace_back(kind);
+ stages_.emplace_back(functor);
+ return true;
+}
+
+
+void FunctorFused::pack(BytePacket & packet)
+{
+ const std::size_t num_stages = stages_.size();
+ appendToBytePacket(&packet,num_stages);
+ for(std::size_t i = 0; i < num_stages; ++i){
+  const int kind = static_cast<int>(kinds_[i]);
+  appendToBytePacket(&packet,kind);
+  stages_[i]->pack(packet);
+ }
+ return;
+}
+
+
+void FunctorFused::unpack(BytePacket & packet)
+{
+ kinds_.clear();
+ stages_.clear();
+ std::size_t num_stages = 0;
+ extractFromBytePacket(&packet,num_stages);
+ for(std::size_t i = 0; i < num_stages; ++i){
+  int kind = 0;
+  extractFromBytePacket(&packet,kind);
+  std::shared_ptr<talsh::TensorFunctor<Identifiable>> functor;
+  switch(static_cast<StageKind>(kind)){
+   case StageKind::INIT_VAL: functor = std::make_shared<FunctorInitVal>(); break;
+   case StageKind::SCALE: functor = std::make_shared<FunctorScale>(1.0); break;
+   case StageKind::NORM1: functor = std::make_shared<FunctorNorm1>(); break;
+   case StageKind::NORM2: functor = std::make_shared<FunctorNorm2>(); break;
+   case StageKind::MAXABS: functor = std::make_shared<FunctorMaxAbs>(); break;
+   default:
+    std::cout << "#ERROR(exatn::numerics::FunctorFused): Invalid fused tensor functor kind: " << kind << std::endl;
+    assert(false);
+  }
+  functor->unpack(packet);
+  kinds_.emplace_back(static_cast<StageKind>(kind));
+  stages_.emplace_back(functor);
+ }
+ return;
+}
+
+
+template <typename NumericType>
+void FunctorFused::applyFused(NumericType * tensor_body, std::size_t tensor_volume)
+{
+ //Compose the elementwise transformations into affine maps preceding each reduction:
+ struct Reduction{
+  StageKind kind;   //reduction kind
+  NumericType a, b; //affine map x -> a*x + b applied to the original tensor element
+  bool constant;    //whether the affine map is constant (x -> b), the original tensor element is ignored
+  std::size_t stage; //position of the reduction functor in the sequence
+ };
+ std::vector<Reduction> reductions;
+ NumericType a = fused_scalar<NumericType>(1.0), b = fused_scalar<NumericType>(0.0);
+ bool constant = false; //the original tensor element may be uninitialized garbage (NaN, Inf) after INIT_VAL
+ bool modified = false;
+ for(std::size_t i = 0; i < stages_.size(); ++i){
+  switch(kinds_[i]){
+   case StageKind::INIT_VAL:
+    a = fused_scalar<NumericType>(0.0);
+    b = fused_scalar<NumericType>(std::static_pointer_cast<FunctorInitVal>(stages_[i])->init_val_);
+    constant = true;
+    modified = true;
+    break;
+   case StageKind::SCALE:
+   {
+    const auto val = fused_scalar<NumericType>(std::static_pointer_cast<FunctorScale>(stages_[i])->scale_val_);
+    a *= val; b *= val;
+    modified = true;
+    break;
+   }
+   default:
+    reductions.emplace_back(Reduction{kinds_[i],a,b,constant,i});
+  }
+ }
+ const std::size_t num_reductions = reductions.size();
+ std::vector<double> results(num_reductions,0.0);
+
+ //Single pass over the tensor body:
+#pragma omp parallel shared(tensor_volume,tensor_body,reductions,results,a,b,constant,modified)
+ {
+  std::vector<double> partial(num_reductions,0.0);
+#pragma omp for schedule(guided)
+  for(std::size_t i = 0; i < tensor_volume; ++i){
+   const auto x = tensor_body[i];
+   for(std::size_t j = 0; j < num_reductions; ++j){
+    const auto & red = reductions[j];
+    const double absval = static_cast<double>(std::abs(red.constant ? red.b : red.a * x + red.b));
+    switch(red.kind){
+     case StageKind::NORM1: partial[j] += absval; break;
+     case StageKind::NORM2: partial[j] += absval * absval; break;
+     case StageKind::MAXABS: if(absval > partial[j]) partial[j] = absval; break;
+     default: break;
+    }
+   }
+   if(modified) tensor_body[i] = (constant ? b : a * x + b);
+  }
+#pragma omp critical
+  {
+   for(std::size_t j = 0; j < num_reductions; ++j){
+    if(reductions[j].kind == StageKind::MAXABS){
+     if(partial[j] > results[j]) results[j] = partial[j];
+    }else{
+     results[j] += partial[j];
+    }
+   }
+  }
+ }
+
+ //Deliver the results into the original reduction functors:
+ for(std::size_t j = 0; j < num_reductions; ++j){
+  const auto & stage = stages_[reductions[j].stage];
+  switch(reductions[j].kind){
+   case StageKind::NORM1: std::static_pointer_cast<FunctorNorm1>(stage)->norm_ = results[j]; break;
+   case StageKind::NORM2: std::static_pointer_cast<FunctorNorm2>(stage)->norm_ = std::sqrt(results[j]); break;
+   case StageKind::MAXABS: std::static_pointer_cast<FunctorMaxAbs>(stage)->norm_ = results[j]; break;
+   default: break;
+  }
+ }
+ return;
+}
+
+
+int FunctorFused::apply(talsh::Tensor & local_tensor)
+{
+ const auto tensor_volume = local_tensor.getVolume();
+ auto access_granted = false;
+
+ {//Try REAL32:
+  float * body;
+  access_granted = local_tensor.getDataAccessHost(&body);
+  if(access_granted){
+   applyFused(body,tensor_volume);
+   return 0;
+  }
+ }
+
+ {//Try REAL64:
+  double * body;
+  access_granted = local_tensor.getDataAccessHost(&body);
+  if(access_granted){
+   applyFused(body,tensor_volume);
+   return 0;
+  }
+ }
+
+ {//Try COMPLEX32:
+  std::complex<float> * body;
+  access_granted = local_tensor.getDataAccessHost(&body);
+  if(access_granted){
+   applyFused(body,tensor_volume);
+   return 0;
+  }
+ }
+
+ {//Try COMPLEX64:
+  std::complex<double> * body;
+  access_granted = local_tensor.getDataAccessHost(&body);
+  if(access_granted){
+   applyFused(body,tensor_volume);
+   return 0;
+  }
+ }
+
+ std::cout << "#ERROR(exatn::numerics::FunctorFused): Unknown data kind in talsh::Tensor!" << std::endl;
+ return 1;
+}
+
+} //namespace numerics
+
+} //namespace exatn
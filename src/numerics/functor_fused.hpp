@@ -0,0 +1,109 @@
+/** ExaTN::Numerics: Tensor Functor: Fused elementwise transformations and reductions
+REVISION: 2020/12/14
+
+Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
+Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
+
+/** Rationale:
+ (A) This tensor functor (method) applies an ordered sequence of fusable
+     tensor functors to a tensor in a single pass over the tensor body:
+     Elementwise transformations (FunctorInitVal, FunctorScale) and
+     reductions (FunctorNorm1, FunctorNorm2, FunctorMaxAbs).
+ (B) A sequence of elementwise transformations composes into an affine
+     elementwise map x -> a*x + b, thus each reduction is computed on the
+     affine image of the original tensor element at its position in the
+     sequence, and the tensor body is only written if the sequence contains
+     at least one elementwise transformation. An initialization makes the map
+     constant (x -> b), in which case the original tensor element, which may be
+     uninitialized garbage, is not used at all. The results of the reductions
+     are delivered into the original reduction functors, such that each of
+     them can be queried as if it was applied separately.
+ (C) Fused tensor functors can be appended to other fused tensor functors,
+     in which case their sequences are concatenated.
+**/
+
+#ifndef EXATN_NUMERICS_FUNCTOR_FUSED_HPP_
+#define EXATN_NUMERICS_FUNCTOR_FUSED_HPP_
+
+#include "Identifiable.hpp"
+
+#include "tensor_basic.hpp"
+
+#include "tensor_method.hpp" //from TAL-SH
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "errors.hpp"
+
+namespace exatn{
+
+namespace numerics{
+
+class FunctorFused: public talsh::TensorFunctor<Identifiable>{
+public:
+
+ /** Kinds of fusable tensor functors. **/
+ enum class StageKind{
+  NONE,     //not fusable
+  INIT_VAL, //FunctorInitVal
+  SCALE,    //FunctorScale
+  NORM1,    //FunctorNorm1
+  NORM2,    //FunctorNorm2
+  MAXABS    //FunctorMaxAbs
+ };
+
+ FunctorFused() = default;
+
+ virtual ~FunctorFused() = default;
+
+ virtual const std::string name() const override
+ {
+  return "TensorFunctorFused";
+ }
+
+ virtual const std::string description() const override
+ {
+  return "Applies a sequence of elementwise transformations and reductions in a single pass";
+ }
+
+ /** Packs data members into a byte packet. **/
+ virtual void pack(BytePacket & packet) override;
+
+ /** Unpacks data members from a byte packet. **/
+ virtual void unpack(BytePacket & packet) override;
+
+ /** Applies the sequence of fused tensor functors to the local tensor slice.
+     Returns zero on success, or an error code otherwise.
+     The talsh::Tensor slice is identified by its signature and
+     shape that both can be accessed by talsh::Tensor methods. **/
+ virtual int apply(talsh::Tensor & local_tensor) override;
+
+ /** Appends a tensor functor to the sequence of fused tensor functors.
+     Returns FALSE if the tensor functor cannot be fused. **/
+ bool append(std::shared_ptr<talsh::TensorFunctor<Identifiable>> functor);
+
+ /** Returns the number of fused tensor functors. **/
+ std::size_t getNumStages() const {return stages_.size();}
+
+ /** Returns the kind of a fusable tensor functor, or NONE if not fusable. **/
+ static StageKind getStageKind(const talsh::TensorFunctor<Identifiable> & functor);
+
+ /** Returns TRUE if the tensor functor can be fused. **/
+ static bool isFusable(const talsh::TensorFunctor<Identifiable> & functor);
+
+private:
+
+ template <typename NumericType>
+ void applyFused(NumericType * tensor_body, std::size_t tensor_volume);
+
+ std::vector<StageKind> kinds_;                                          //kinds of fused tensor functors
+ std::vector<std::shared_ptr<talsh::TensorFunctor<Identifiable>>> stages_; //fused tensor functors (in order)
+};
+
+} //namespace numerics
+
+} //namespace exatn
+
+#endif //EXATN_NUMERICS_FUNCTOR_FUSED_HPP_
@@ -1,5 +1,5 @@
 /** ExaTN::Numerics: Tensor Functor: Initialization to a given external data
-REVISION: 2019/12/08
+REVISION: 2020/12/04
 
 Copyright (C) 2018-2019 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2019 Oak Ridge National Laboratory (UT-Battelle) **/
@@ -22,6 +22,7 @@ Copyright (C) 2018-2019 Oak Ridge National Laboratory (UT-Battelle) **/
 #include "tensor_shape.hpp"
 
 #include "tensor_method.hpp" //from TAL-SH
+#include "tensor_method_concurrency.hpp"
 
 #include <type_traits>
 #include <string>
@@ -34,7 +35,7 @@ namespace exatn{
 
 namespace numerics{
 
-class FunctorInitDat: public talsh::TensorFunctor<Identifiable>{
+class FunctorInitDat: public talsh::TensorFunctor<Identifiable>, public TensorMethodConcurrencyTrait{
 public:
 
  /** TensorShape object must specify the shape of the full tensor and
@@ -68,6 +69,12 @@ public:
      shape that both can be accessed by talsh::Tensor methods. **/
  virtual int apply(talsh::Tensor & local_tensor) override;
 
+ /** Single-threaded tensor functor. **/
+ virtual TensorMethodConcurrency getConcurrency() const override
+ {
+  return TensorMethodConcurrency::SERIAL;
+ }
+
 private:
 
  TensorShape shape_;                      //shape of the full tensor
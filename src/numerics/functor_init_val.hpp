@@ -1,8 +1,8 @@
 /** ExaTN::Numerics: Tensor Functor: Initialization to a scalar value
-REVISION: 2019/11/21
+REVISION: 2020/12/05
 
-Copyright (C) 2018-2019 Dmitry I. Lyakh (Liakh)
-Copyright (C) 2018-2019 Oak Ridge National Laboratory (UT-Battelle) **/
+Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
+Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
 
 /** Rationale:
  (A) This tensor functor (method) is used to initialize a Tensor to a scalar value,
@@ -73,6 +73,8 @@ public:
 
 private:
 
+ friend class FunctorFused; //fused single-pass execution
+
  std::complex<double> init_val_; //scalar initialization value
 };
 
@@ -1,5 +1,5 @@
 /** ExaTN::Numerics: Tensor Functor: Computes max-abs norm of a tensor
-REVISION: 2020/11/11
+REVISION: 2020/12/05
 
 Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
@@ -69,6 +69,8 @@ public:
 
 private:
 
+ friend class FunctorFused; //fused single-pass execution
+
  double norm_; //computed norm
 };
 
@@ -1,5 +1,5 @@
 /** ExaTN::Numerics: Tensor Functor: Computes 2-norm of a tensor
-REVISION: 2020/05/02
+REVISION: 2020/12/05
 
 Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
@@ -68,6 +68,8 @@ public:
 
 private:
 
+ friend class FunctorFused; //fused single-pass execution
+
  double norm_; //computed norm
 };
 
@@ -1,8 +1,8 @@
 /** ExaTN::Numerics: Tensor Functor: Scaling a tensor by a scalar
-REVISION: 2019/11/21
+REVISION: 2020/12/05
 
-Copyright (C) 2018-2019 Dmitry I. Lyakh (Liakh)
-Copyright (C) 2018-2019 Oak Ridge National Laboratory (UT-Battelle) **/
+Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
+Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
 
 /** Rationale:
  (A) This tensor functor (method) is used to scale a tensor by a scalar.
@@ -70,6 +70,8 @@ public:
 
 private:
 
+ friend class FunctorFused; //fused single-pass execution
+
  std::complex<double> scale_val_; //scalar scaling value
 };
 
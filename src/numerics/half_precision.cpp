@@ -0,0 +1,61 @@
+/** ExaTN::Numerics: Half-precision (16-bit) floating point element types
+REVISION: 2020/11/21
+
+Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
+Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
+
+#include "half_precision.hpp"
+
+#if defined(__F16C__) && defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+namespace exatn{
+
+void convertFloat16ToFloat(const Float16 * source,
+                           float * destination,
+                           std::size_t count)
+{
+ std::size_t i = 0;
+#if defined(__F16C__) && defined(__AVX__)
+ for(; i + 8 <= count; i += 8){
+  const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&(source[i].bits)));
+  _mm256_storeu_ps(&(destination[i]),_mm256_cvtph_ps(packed));
+ }
+#endif
+ for(; i < count; ++i) destination[i] = source[i].toFloat();
+ return;
+}
+
+void convertFloatToFloat16(const float * source,
+                           Float16 * destination,
+                           std::size_t count)
+{
+ std::size_t i = 0;
+#if defined(__F16C__) && defined(__AVX__)
+ for(; i + 8 <= count; i += 8){
+  const __m128i packed = _mm256_cvtps_ph(_mm256_loadu_ps(&(source[i])),_MM_FROUND_TO_NEAREST_INT);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(&(destination[i].bits)),packed);
+ }
+#endif
+ for(; i < count; ++i) destination[i] = Float16::fromFloat(source[i]);
+ return;
+}
+
+void convertBFloat16ToFloat(const BFloat16 * source,
+                            float * destination,
+                            std::size_t count)
+{
+ for(std::size_t i = 0; i < count; ++i) destination[i] = source[i].toFloat(); //auto-vectorizable
+ return;
+}
+
+void convertFloatToBFloat16(const float * source,
+                            BFloat16 * destination,
+                            std::size_t count)
+{
+ for(std::size_t i = 0; i < count; ++i) destination[i] = BFloat16::fromFloat(source[i]); //auto-vectorizable
+ return;
+}
+
+} //namespace exatn
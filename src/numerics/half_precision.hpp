@@ -0,0 +1,154 @@
+/** ExaTN::Numerics: Half-precision (16-bit) floating point element types
+REVISION: 2020/11/21
+
+Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
+Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
+
+/** Rationale:
+ (a) Float16 is the IEEE 754 binary16 floating point format (1:5:10) whereas
+     BFloat16 is the brain floating point format (1:8:7), that is, a truncated
+     IEEE 754 binary32 format with the same exponent range. Both are storage
+     types only: All arithmetic is performed in single precision (float)
+     after conversion, with round-to-nearest-even on the way back.
+ (b) Complex16<Real16> stores the real and imaginary parts contiguously,
+     thus an array of complex elements is an array of pairs of 16-bit words.
+ (c) Bulk conversion routines convert contiguous arrays between the 16-bit
+     formats and single precision. The Float16 conversion uses the F16C
+     instruction set extension when it is enabled at compile time.
+**/
+
+#ifndef EXATN_NUMERICS_HALF_PRECISION_HPP_
+#define EXATN_NUMERICS_HALF_PRECISION_HPP_
+
+#include <complex>
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+namespace exatn{
+
+//IEEE 754 binary16 floating point number:
+struct Float16{
+ std::uint16_t bits;
+
+ static Float16 fromFloat(float value);
+ float toFloat() const;
+};
+
+//Brain floating point number (bfloat16):
+struct BFloat16{
+ std::uint16_t bits;
+
+ static BFloat16 fromFloat(float value);
+ float toFloat() const;
+};
+
+//Complex number with 16-bit real and imaginary parts:
+template <typename Real16>
+struct Complex16{
+ Real16 real;
+ Real16 imag;
+
+ static Complex16 fromComplex(const std::complex<float> & value){
+  return Complex16{Real16::fromFloat(value.real()),Real16::fromFloat(value.imag())};
+ }
+ std::complex<float> toComplex() const{
+  return std::complex<float>{real.toFloat(),imag.toFloat()};
+ }
+};
+
+using ComplexFloat16 = Complex16<Float16>;
+using ComplexBFloat16 = Complex16<BFloat16>;
+
+
+/** Converts an array of Float16 numbers into single precision. **/
+void convertFloat16ToFloat(const Float16 * source, //in: source array
+                           float * destination,    //out: destination array
+                           std::size_t count);     //in: number of elements
+
+/** Converts an array of single-precision numbers into Float16. **/
+void convertFloatToFloat16(const float * source,   //in: source array
+                           Float16 * destination,  //out: destination array
+                           std::size_t count);     //in: number of elements
+
+/** Converts an array of BFloat16 numbers into single precision. **/
+void convertBFloat16ToFloat(const BFloat16 * source, //in: source array
+                            float * destination,     //out: destination array
+                            std::size_t count);      //in: number of elements
+
+/** Converts an array of single-precision numbers into BFloat16. **/
+void convertFloatToBFloat16(const float * source,    //in: source array
+                            BFloat16 * destination,  //out: destination array
+                            std::size_t count);      //in: number of elements
+
+
+//INLINES:
+inline Float16 Float16::fromFloat(float value)
+{
+ std::uint32_t x;
+ std::memcpy(&x,&value,sizeof(x));
+ const std::uint32_t sign = (x >> 16) & 0x8000u;
+ const std::uint32_t abs = x & 0x7FFFFFFFu;
+ std::uint32_t h = 0;
+ if(abs >= 0x7F800000u){ //infinity or NaN
+  h = (abs > 0x7F800000u) ? 0x7E00u : 0x7C00u;
+ }else if(abs >= 0x477FF000u){ //overflow: rounds to infinity
+  h = 0x7C00u;
+ }else if(abs >= 0x38800000u){ //normal number: rebias exponent and round to nearest even
+  const std::uint32_t r = abs - 0x38000000u;
+  h = (r + 0x0FFFu + ((r >> 13) & 1u)) >> 13;
+ }else if(abs >= 0x33000000u){ //subnormal number
+  const std::uint32_t exponent = abs >> 23;
+  const std::uint32_t mantissa = (abs & 0x007FFFFFu) | 0x00800000u;
+  const std::uint32_t shift = 126u - exponent;
+  const std::uint32_t remainder = mantissa & ((1u << shift) - 1u);
+  const std::uint32_t halfway = 1u << (shift - 1u);
+  h = mantissa >> shift;
+  if(remainder > halfway || (remainder == halfway && (h & 1u) != 0)) ++h;
+ }
+ return Float16{static_cast<std::uint16_t>(sign | h)};
+}
+
+inline float Float16::toFloat() const
+{
+ const std::uint32_t sign = (static_cast<std::uint32_t>(bits) & 0x8000u) << 16;
+ const std::uint32_t exponent = (static_cast<std::uint32_t>(bits) >> 10) & 0x1Fu;
+ std::uint32_t mantissa = static_cast<std::uint32_t>(bits) & 0x03FFu;
+ std::uint32_t x = sign;
+ if(exponent == 0x1Fu){ //infinity or NaN
+  x |= 0x7F800000u | (mantissa << 13);
+ }else if(exponent != 0){ //normal number
+  x |= ((exponent + 112u) << 23) | (mantissa << 13);
+ }else if(mantissa != 0){ //subnormal number: normalize
+  std::uint32_t exp32 = 113u;
+  while((mantissa & 0x0400u) == 0){
+   mantissa <<= 1;
+   --exp32;
+  }
+  x |= (exp32 << 23) | ((mantissa & 0x03FFu) << 13);
+ }
+ float value;
+ std::memcpy(&value,&x,sizeof(value));
+ return value;
+}
+
+inline BFloat16 BFloat16::fromFloat(float value)
+{
+ std::uint32_t x;
+ std::memcpy(&x,&value,sizeof(x));
+ if((x & 0x7FFFFFFFu) > 0x7F800000u) return BFloat16{static_cast<std::uint16_t>((x >> 16) | 0x0040u)}; //quiet NaN
+ return BFloat16{static_cast<std::uint16_t>((x + 0x7FFFu + ((x >> 16) & 1u)) >> 16)};
+}
+
+inline float BFloat16::toFloat() const
+{
+ const std::uint32_t x = static_cast<std::uint32_t>(bits) << 16;
+ float value;
+ std::memcpy(&value,&x,sizeof(value));
+ return value;
+}
+
+} //namespace exatn
+
+#endif //EXATN_NUMERICS_HALF_PRECISION_HPP_
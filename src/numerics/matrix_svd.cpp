@@ -0,0 +1,282 @@
+/** ExaTN::Numerics: Truncated SVD of a dense matrix on Host
+REVISION: 2020/12/03
+
+Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
+Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
+
+#include "matrix_svd.hpp"
+
+#include <random>
+#include <numeric>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+namespace exatn{
+
+namespace numerics{
+
+namespace{
+
+template<typename T> struct RealPart{using type = T;};
+template<typename T> struct RealPart<std::complex<T>>{using type = T;};
+
+inline double absSquared(float x){return static_cast<double>(x)*static_cast<double>(x);}
+inline double absSquared(double x){return x*x;}
+template<typename R> inline double absSquared(const std::complex<R> & x){return static_cast<double>(std::norm(x));}
+
+/** Unit phase of a scalar (sign for real scalars). **/
+inline float unitPhase(float x, double){return (x < 0.0f ? -1.0f : 1.0f);}
+inline double unitPhase(double x, double){return (x < 0.0 ? -1.0 : 1.0);}
+template<typename R> inline std::complex<R> unitPhase(const std::complex<R> & x, double abs_x){
+ return std::complex<R>(static_cast<R>(x.real()/abs_x),static_cast<R>(x.imag()/abs_x));
+}
+
+inline void randomValue(std::mt19937_64 & gen, std::normal_distribution<double> & distr, float & x){
+ x = static_cast<float>(distr(gen));
+}
+inline void randomValue(std::mt19937_64 & gen, std::normal_distribution<double> & distr, double & x){
+ x = distr(gen);
+}
+template<typename R> inline void randomValue(std::mt19937_64 & gen, std::normal_distribution<double> & distr,
+                                             std::complex<R> & x){
+ const double re = distr(gen);
+ const double im = distr(gen);
+ x = std::complex<R>(static_cast<R>(re),static_cast<R>(im));
+}
+
+/** C(m,l) = A(m,n) * B(n,l) **/
+template<typename T>
+void multiply(std::size_t m, std::size_t n, std::size_t l, const T * a, const T * b, T * c)
+{
+ std::fill(c,c+m*l,T{0});
+ for(std::size_t j = 0; j < l; ++j){
+  for(std::size_t p = 0; p < n; ++p){
+   const T bpj = b[p+j*n];
+   if(bpj == T{0}) continue;
+   const T * ap = &(a[p*m]);
+   T * cj = &(c[j*m]);
+   for(std::size_t i = 0; i < m; ++i) cj[i] += ap[i] * bpj;
+  }
+ }
+ return;
+}
+
+/** C(n,l) = A(m,n)^H * B(m,l) **/
+template<typename T>
+void multiplyAdjoint(std::size_t m, std::size_t n, std::size_t l, const T * a, const T * b, T * c)
+{
+ for(std::size_t j = 0; j < l; ++j){
+  const T * bj = &(b[j*m]);
+  for(std::size_t p = 0; p < n; ++p){
+   const T * ap = &(a[p*m]);
+   T dot{0};
+   for(std::size_t i = 0; i < m; ++i) dot += conjugated(ap[i]) * bj[i];
+   c[p+j*n] = dot;
+  }
+ }
+ return;
+}
+
+/** Orthonormalizes the columns of Y(m,l) in place via the modified Gram-Schmidt
+    procedure with reorthogonalization. Linearly dependent columns are zeroed. **/
+template<typename T>
+void orthonormalize(std::size_t m, std::size_t l, T * y)
+{
+ using R = typename RealPart<T>::type;
+ const double eps = static_cast<double>(std::numeric_limits<R>::epsilon());
+ for(std::size_t j = 0; j < l; ++j){
+  T * yj = &(y[j*m]);
+  double orig_norm = 0.0;
+  for(std::size_t i = 0; i < m; ++i) orig_norm += absSquared(yj[i]);
+  orig_norm = std::sqrt(orig_norm);
+  for(int pass = 0; pass < 2; ++pass){
+   for(std::size_t k = 0; k < j; ++k){
+    const T * yk = &(y[k*m]);
+    T dot{0};
+    for(std::size_t i = 0; i < m; ++i) dot += conjugated(yk[i]) * yj[i];
+    for(std::size_t i = 0; i < m; ++i) yj[i] -= yk[i] * dot;
+   }
+  }
+  double norm = 0.0;
+  for(std::size_t i = 0; i < m; ++i) norm += absSquared(yj[i]);
+  norm = std::sqrt(norm);
+  if(norm > eps * 1e1 * orig_norm && norm > 0.0){
+   const R scale = static_cast<R>(1.0/norm);
+   for(std::size_t i = 0; i < m; ++i) yj[i] *= scale;
+  }else{
+   std::fill(yj,yj+m,T{0});
+  }
+ }
+ return;
+}
+
+/** One-sided Jacobi SVD of W(p,q), p >= q, in place: On exit, the columns of W
+    are the left singular vectors scaled by the singular values and V(q,q)
+    contains the right singular vectors, such that W(in) = W(out) * V^H. **/
+template<typename T>
+void jacobiSVD(std::size_t p, std::size_t q, T * w, std::vector<T> & v)
+{
+ using R = typename RealPart<T>::type;
+ const double eps = static_cast<double>(std::numeric_limits<R>::epsilon());
+ const int max_sweeps = 60;
+ v.assign(q*q,T{0});
+ for(std::size_t j = 0; j < q; ++j) v[j+j*q] = T{1};
+ bool converged = false;
+ for(int sweep = 0; sweep < max_sweeps && !converged; ++sweep){
+  converged = true;
+  for(std::size_t j = 0; j + 1 < q; ++j){
+   for(std::size_t k = j + 1; k < q; ++k){
+    T * x = &(w[j*p]);
+    T * y = &(w[k*p]);
+    double alpha = 0.0, beta = 0.0;
+    T gamma{0};
+    for(std::size_t i = 0; i < p; ++i){
+     alpha += absSquared(x[i]);
+     beta += absSquared(y[i]);
+     gamma += conjugated(x[i]) * y[i];
+    }
+    const double abs_gamma = std::sqrt(absSquared(gamma));
+    if(abs_gamma == 0.0 || abs_gamma <= eps * std::sqrt(alpha * beta)) continue;
+    converged = false;
+    //Real Jacobi rotation of the columns (x, y*conj(phase)), then y gets its phase back:
+    const double zeta = (beta - alpha) / (2.0 * abs_gamma);
+    const double t = (zeta >= 0.0 ? 1.0 : -1.0) / (std::abs(zeta) + std::sqrt(1.0 + zeta*zeta));
+    const double c = 1.0 / std::sqrt(1.0 + t*t);
+    const double s = c * t;
+    const T phase = unitPhase(gamma,abs_gamma);
+    const T s_phase = phase * static_cast<R>(s);
+    const T s_phase_conj = conjugated(phase) * static_cast<R>(s);
+    const R cr = static_cast<R>(c);
+    for(std::size_t i = 0; i < p; ++i){
+     const T xi = x[i], yi = y[i];
+     x[i] = cr * xi - s_phase_conj * yi;
+     y[i] = s_phase * xi + cr * yi;
+    }
+    T * vx = &(v[j*q]);
+    T * vy = &(v[k*q]);
+    for(std::size_t i = 0; i < q; ++i){
+     const T xi = vx[i], yi = vy[i];
+     vx[i] = cr * xi - s_phase_conj * yi;
+     vy[i] = s_phase * xi + cr * yi;
+    }
+   }
+  }
+ }
+ return;
+}
+
+} //namespace
+
+
+template<typename T>
+double computeTruncatedSVD(std::size_t m,
+                           std::size_t n,
+                           const T * a,
+                           std::size_t max_rank,
+                           double cutoff,
+                           std::vector<T> & u,
+                           std::vector<double> & s,
+                           std::vector<T> & v,
+                           unsigned int num_power_iters,
+                           std::size_t oversampling)
+{
+ using R = typename RealPart<T>::type;
+ u.clear(); s.clear(); v.clear();
+ const std::size_t full_rank = std::min(m,n);
+ if(full_rank == 0) return 0.0;
+ const std::size_t rank = ((max_rank > 0) ? std::min(max_rank,full_rank) : full_rank);
+ double frob_norm_sq = 0.0;
+ for(std::size_t i = 0; i < m*n; ++i) frob_norm_sq += absSquared(a[i]);
+ //Compute a (partial) SVD: A ~ left * diag(sv) * right^H:
+ std::vector<T> left, right, w, vw;
+ std::size_t num_sv = 0; //number of computed singular triplets
+ const std::size_t range_dim = std::min(full_rank,rank + oversampling);
+ if(range_dim * 2 < full_rank){ //randomized range finder with power iterations
+  std::mt19937_64 generator(0x5EED); //fixed seed for reproducibility across processes
+  std::normal_distribution<double> distribution(0.0,1.0);
+  std::vector<T> omega(n*range_dim);
+  for(auto & elem: omega) randomValue(generator,distribution,elem);
+  std::vector<T> q(m*range_dim);
+  multiply(m,n,range_dim,a,omega.data(),q.data()); //Y = A * Omega
+  orthonormalize(m,range_dim,q.data());
+  std::vector<T> z(n*range_dim);
+  for(unsigned int iter = 0; iter < num_power_iters; ++iter){
+   multiplyAdjoint(m,n,range_dim,a,q.data(),z.data()); //Z = A^H * Q
+   orthonormalize(n,range_dim,z.data());
+   multiply(m,n,range_dim,a,z.data(),q.data()); //Y = A * Z
+   orthonormalize(m,range_dim,q.data());
+  }
+  //Dense SVD of B^H = A^H * Q (n,l): B^H = Uw * S * Vw^H --> A ~ Q * B = (Q * Vw) * S * Uw^H:
+  w.resize(n*range_dim);
+  multiplyAdjoint(m,n,range_dim,a,q.data(),w.data());
+  jacobiSVD(n,range_dim,w.data(),vw);
+  num_sv = range_dim;
+  left.resize(m*num_sv);
+  multiply(m,range_dim,num_sv,q.data(),vw.data(),left.data());
+  right.swap(w);
+ }else if(m >= n){ //dense SVD of A (m,n): A = Uw * S * Vw^H
+  w.assign(a,a+m*n);
+  jacobiSVD(m,n,w.data(),vw);
+  num_sv = n;
+  left.swap(w);
+  right.swap(vw);
+ }else{ //dense SVD of A^H (n,m): A^H = Uw * S * Vw^H --> A = Vw * S * Uw^H
+  w.resize(n*m);
+  for(std::size_t j = 0; j < n; ++j){
+   for(std::size_t i = 0; i < m; ++i) w[j+i*n] = conjugated(a[i+j*m]);
+  }
+  jacobiSVD(n,m,w.data(),vw);
+  num_sv = m;
+  left.swap(vw);
+  right.swap(w);
+ }
+ //Extract the singular values (norms of the columns of the scaled singular vectors):
+ const bool left_scaled = (range_dim * 2 < full_rank || m < n) ? false : true; //which factor carries the singular values
+ const std::size_t scaled_rows = (left_scaled ? m : n);
+ auto & scaled = (left_scaled ? left : right);
+ std::vector<double> sv(num_sv);
+ for(std::size_t j = 0; j < num_sv; ++j){
+  double norm = 0.0;
+  for(std::size_t i = 0; i < scaled_rows; ++i) norm += absSquared(scaled[i+j*scaled_rows]);
+  sv[j] = std::sqrt(norm);
+  if(sv[j] > 0.0){
+   const R scale = static_cast<R>(1.0/sv[j]);
+   for(std::size_t i = 0; i < scaled_rows; ++i) scaled[i+j*scaled_rows] *= scale;
+  }
+ }
+ //Sort the singular values in the descending order and truncate:
+ std::vector<std::size_t> order(num_sv);
+ std::iota(order.begin(),order.end(),0);
+ std::stable_sort(order.begin(),order.end(),[&sv](std::size_t i, std::size_t j){return sv[i] > sv[j];});
+ std::size_t retained = 1;
+ while(retained < std::min(rank,num_sv) && sv[order[retained]] > cutoff) ++retained;
+ double retained_norm_sq = 0.0;
+ u.resize(m*retained); s.resize(retained); v.resize(n*retained);
+ for(std::size_t j = 0; j < retained; ++j){
+  const auto col = order[j];
+  s[j] = sv[col];
+  retained_norm_sq += sv[col] * sv[col];
+  std::copy(&(left[col*m]),&(left[col*m])+m,&(u[j*m]));
+  std::copy(&(right[col*n]),&(right[col*n])+n,&(v[j*n]));
+ }
+ return std::sqrt(std::max(0.0,frob_norm_sq - retained_norm_sq));
+}
+
+
+template double computeTruncatedSVD<float>(std::size_t,std::size_t,const float*,std::size_t,double,
+                                           std::vector<float>&,std::vector<double>&,std::vector<float>&,
+                                           unsigned int,std::size_t);
+template double computeTruncatedSVD<double>(std::size_t,std::size_t,const double*,std::size_t,double,
+                                            std::vector<double>&,std::vector<double>&,std::vector<double>&,
+                                            unsigned int,std::size_t);
+template double computeTruncatedSVD<std::complex<float>>(std::size_t,std::size_t,const std::complex<float>*,std::size_t,double,
+                                                         std::vector<std::complex<float>>&,std::vector<double>&,
+                                                         std::vector<std::complex<float>>&,unsigned int,std::size_t);
+template double computeTruncatedSVD<std::complex<double>>(std::size_t,std::size_t,const std::complex<double>*,std::size_t,double,
+                                                          std::vector<std::complex<double>>&,std::vector<double>&,
+                                                          std::vector<std::complex<double>>&,unsigned int,std::size_t);
+
+} //namespace numerics
+
+} //namespace exatn
@@ -0,0 +1,59 @@
+/** ExaTN::Numerics: Truncated SVD of a dense matrix on Host
+REVISION: 2020/12/03
+
+Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
+Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
+
+/** Rationale:
+ (a) Computes the truncated singular value decomposition of a dense matrix
+     A(m,n) stored column-wise: A ~ U * diag(S) * V^H, where U(m,r) and V(n,r)
+     have orthonormal columns and the singular values S(r) are sorted in
+     the descending order. The retained rank r is limited by the max rank
+     and by the singular value cutoff (singular values not exceeding the
+     cutoff are discarded), but at least one singular triplet is retained.
+ (b) If the requested rank (plus oversampling) is small compared to the
+     smaller matrix dimension, the randomized range finder with power
+     iterations is used: A gets projected onto an orthonormal basis Q(m,l)
+     approximating its range, followed by a dense SVD of the small matrix
+     Q^H * A. Otherwise, the dense SVD is computed directly. The dense SVD
+     is computed by the one-sided Jacobi method.
+ (c) The truncation error is the Frobenius norm of the discarded part:
+     sqrt(||A||^2 - sum(S^2)), where S are the retained singular values.
+**/
+
+#ifndef EXATN_NUMERICS_MATRIX_SVD_HPP_
+#define EXATN_NUMERICS_MATRIX_SVD_HPP_
+
+#include <vector>
+#include <complex>
+
+#include <cstddef>
+
+namespace exatn{
+
+namespace numerics{
+
+/** Complex conjugation preserving the (real or complex) element type. **/
+template<typename T> inline T conjugated(const T & x){return x;}
+template<typename T> inline std::complex<T> conjugated(const std::complex<T> & x){return std::conj(x);}
+
+/** Computes the truncated SVD of a dense matrix A(m,n) stored column-wise.
+    Returns the truncation error (Frobenius norm of the discarded part).
+    Supported element types: float, double, std::complex<float>, std::complex<double>. **/
+template<typename T>
+double computeTruncatedSVD(std::size_t m,                      //in: number of rows
+                           std::size_t n,                      //in: number of columns
+                           const T * a,                        //in: matrix A(m,n) stored column-wise
+                           std::size_t max_rank,               //in: max retained rank (0: no limit)
+                           double cutoff,                      //in: singular value cutoff (0.0: no cutoff)
+                           std::vector<T> & u,                 //out: left singular vectors U(m,r) stored column-wise
+                           std::vector<double> & s,            //out: retained singular values S(r)
+                           std::vector<T> & v,                 //out: right singular vectors V(n,r) stored column-wise
+                           unsigned int num_power_iters = 2,   //in: number of power iterations in the range finder
+                           std::size_t oversampling = 8);      //in: oversampling of the range finder
+
+} //namespace numerics
+
+} //namespace exatn
+
+#endif //EXATN_NUMERICS_MATRIX_SVD_HPP_
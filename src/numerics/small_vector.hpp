@@ -0,0 +1,346 @@
+/** ExaTN::Numerics: Vector with inline storage for a small number of elements
+REVISION: 2020/12/06
+
+Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
+Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
+
+/** Rationale:
+ (a) SmallVector<T,N> is a drop-in replacement for std::vector<T> which stores
+     up to N elements inline (inside the object itself), thus avoiding heap
+     allocations for tensor metadata of typical tensor ranks (tensor shapes,
+     signatures, tensor legs, tensor operands). Only if the number of elements
+     exceeds N, the elements are moved to heap storage.
+ (b) SmallVector implicitly converts from and to std::vector<T> for interoperability
+     with interfaces expecting std::vector<T> (the conversion copies the elements).
+ (c) Iterators are raw pointers which are invalidated by any operation changing
+     the capacity, as well as by the move of a SmallVector storing its elements inline.
+**/
+
+#ifndef EXATN_NUMERICS_SMALL_VECTOR_HPP_
+#define EXATN_NUMERICS_SMALL_VECTOR_HPP_
+
+#include <initializer_list>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <new>
+
+#include <cstddef>
+
+#include "errors.hpp"
+
+namespace exatn{
+
+namespace numerics{
+
+template <typename T, std::size_t N>
+class SmallVector{
+public:
+
+ static_assert(N > 0,"#FATAL(exatn::numerics::SmallVector): Inline capacity must be positive!");
+
+ using value_type = T;
+ using size_type = std::size_t;
+ using difference_type = std::ptrdiff_t;
+ using reference = T &;
+ using const_reference = const T &;
+ using pointer = T *;
+ using const_pointer = const T *;
+ using iterator = T *;
+ using const_iterator = const T *;
+ using reverse_iterator = std::reverse_iterator<iterator>;
+ using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+ SmallVector() noexcept: data_(inlineData()), size_(0), capacity_(N) {}
+
+ explicit SmallVector(size_type count): SmallVector() {resize(count);}
+
+ SmallVector(size_type count, const T & value): SmallVector() {assign(count,value);}
+
+ template <typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+ SmallVector(InputIt first, InputIt last): SmallVector() {assign(first,last);}
+
+ SmallVector(std::initializer_list<T> elems): SmallVector() {assign(elems.begin(),elems.end());}
+
+ SmallVector(const std::vector<T> & another): SmallVector() {assign(another.cbegin(),another.cend());}
+
+ SmallVector(const SmallVector & another): SmallVector() {assign(another.cbegin(),another.cend());}
+
+ SmallVector(SmallVector && another) noexcept: SmallVector() {steal(std::move(another));}
+
+ SmallVector & operator=(const SmallVector & another){
+  if(this != &another) assign(another.cbegin(),another.cend());
+  return *this;
+ }
+
+ SmallVector & operator=(SmallVector && another) noexcept{
+  if(this != &another){
+   clear();
+   release();
+   steal(std::move(another));
+  }
+  return *this;
+ }
+
+ SmallVector & operator=(std::initializer_list<T> elems){
+  assign(elems.begin(),elems.end());
+  return *this;
+ }
+
+ ~SmallVector(){
+  clear();
+  release();
+ }
+
+ /** Copies the elements into a std::vector. **/
+ operator std::vector<T>() const {return std::vector<T>(cbegin(),cend());}
+
+ size_type size() const noexcept {return size_;}
+ bool empty() const noexcept {return (size_ == 0);}
+ size_type capacity() const noexcept {return capacity_;}
+ /** Returns TRUE if the elements are stored inline (no heap storage). **/
+ bool isInline() const noexcept {return (data_ == inlineData());}
+
+ T * data() noexcept {return data_;}
+ const T * data() const noexcept {return data_;}
+
+ iterator begin() noexcept {return data_;}
+ const_iterator begin() const noexcept {return data_;}
+ const_iterator cbegin() const noexcept {return data_;}
+ iterator end() noexcept {return data_ + size_;}
+ const_iterator end() const noexcept {return data_ + size_;}
+ const_iterator cend() const noexcept {return data_ + size_;}
+ reverse_iterator rbegin() noexcept {return reverse_iterator(end());}
+ const_reverse_iterator rbegin() const noexcept {return const_reverse_iterator(end());}
+ const_reverse_iterator crbegin() const noexcept {return const_reverse_iterator(cend());}
+ reverse_iterator rend() noexcept {return reverse_iterator(begin());}
+ const_reverse_iterator rend() const noexcept {return const_reverse_iterator(begin());}
+ const_reverse_iterator crend() const noexcept {return const_reverse_iterator(cbegin());}
+
+ T & operator[](size_type pos) {return data_[pos];}
+ const T & operator[](size_type pos) const {return data_[pos];}
+
+ T & at(size_type pos) {assert(pos < size_); return data_[pos];}
+ const T & at(size_type pos) const {assert(pos < size_); return data_[pos];}
+
+ T & front() {return data_[0];}
+ const T & front() const {return data_[0];}
+ T & back() {return data_[size_-1];}
+ const T & back() const {return data_[size_-1];}
+
+ void reserve(size_type new_capacity){
+  if(new_capacity > capacity_) reallocate(new_capacity);
+  return;
+ }
+
+ void shrink_to_fit(){
+  if(!isInline() && size_ < capacity_) reallocate(size_);
+  return;
+ }
+
+ void clear() noexcept{
+  destroy(data_,data_+size_);
+  size_ = 0;
+  return;
+ }
+
+ void resize(size_type count){
+  if(count > size_){
+   reserve(count);
+   for(size_type i = size_; i < count; ++i) new(data_+i) T();
+  }else{
+   destroy(data_+count,data_+size_);
+  }
+  size_ = count;
+  return;
+ }
+
+ void resize(size_type count, const T & value){
+  if(count > size_){
+   if(count > capacity_){
+    T tmp(value); //value may alias an element
+    reserve(count);
+    for(size_type i = size_; i < count; ++i) new(data_+i) T(tmp);
+   }else{
+    for(size_type i = size_; i < count; ++i) new(data_+i) T(value);
+   }
+  }else{
+   destroy(data_+count,data_+size_);
+  }
+  size_ = count;
+  return;
+ }
+
+ void assign(size_type count, const T & value){
+  T tmp(value); //value may alias an element
+  clear();
+  reserve(count);
+  for(size_type i = 0; i < count; ++i) new(data_+i) T(tmp);
+  size_ = count;
+  return;
+ }
+
+ template <typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+ void assign(InputIt first, InputIt last){
+  clear();
+  for(; first != last; ++first) emplace_back(*first);
+  return;
+ }
+
+ void push_back(const T & value) {emplace_back(value);}
+
+ void push_back(T && value) {emplace_back(std::move(value));}
+
+ template <typename... Args>
+ T & emplace_back(Args&&... args){
+  if(size_ == capacity_){
+   T tmp(std::forward<Args>(args)...); //arguments may alias an element
+   reallocate(capacity_ * 2);
+   new(data_+size_) T(std::move(tmp));
+  }else{
+   new(data_+size_) T(std::forward<Args>(args)...);
+  }
+  return data_[size_++];
+ }
+
+ void pop_back(){
+  data_[--size_].~T();
+  return;
+ }
+
+ iterator insert(const_iterator pos, const T & value) {return emplace(pos,value);}
+
+ iterator insert(const_iterator pos, T && value) {return emplace(pos,std::move(value));}
+
+ template <typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+ iterator insert(const_iterator pos, InputIt first, InputIt last){
+  const size_type offset = pos - cbegin();
+  assert(offset <= size_);
+  SmallVector tmp(first,last); //range may alias the elements
+  reserve(size_ + tmp.size());
+  const size_type old_size = size_;
+  for(auto & elem: tmp) emplace_back(std::move(elem));
+  std::rotate(data_+offset,data_+old_size,data_+size_);
+  return data_ + offset;
+ }
+
+ template <typename... Args>
+ iterator emplace(const_iterator pos, Args&&... args){
+  const size_type offset = pos - cbegin();
+  assert(offset <= size_);
+  T tmp(std::forward<Args>(args)...); //arguments may alias an element
+  if(offset == size_){
+   emplace_back(std::move(tmp));
+  }else{
+   emplace_back(std::move(back()));
+   std::move_backward(data_+offset,data_+size_-2,data_+size_-1);
+   data_[offset] = std::move(tmp);
+  }
+  return data_ + offset;
+ }
+
+ iterator erase(const_iterator pos) {return erase(pos,pos+1);}
+
+ iterator erase(const_iterator first, const_iterator last){
+  const size_type offset = first - cbegin();
+  const size_type count = last - first;
+  assert(offset + count <= size_);
+  if(count > 0){
+   std::move(data_+offset+count,data_+size_,data_+offset);
+   destroy(data_+size_-count,data_+size_);
+   size_ -= count;
+  }
+  return data_ + offset;
+ }
+
+ void swap(SmallVector & another){
+  SmallVector tmp(std::move(another));
+  another = std::move(*this);
+  *this = std::move(tmp);
+  return;
+ }
+
+private:
+
+ using Storage = typename std::aligned_storage<sizeof(T),alignof(T)>::type;
+
+ T * inlineData() noexcept {return reinterpret_cast<T*>(&inline_[0]);}
+ const T * inlineData() const noexcept {return reinterpret_cast<const T*>(&inline_[0]);}
+
+ static void destroy(T * first, T * last) noexcept{
+  for(; first != last; ++first) first->~T();
+  return;
+ }
+
+ /** Frees heap storage (the vector must be empty), switching back to inline storage. **/
+ void release() noexcept{
+  if(!isInline()){
+   ::operator delete(static_cast<void*>(data_));
+   data_ = inlineData();
+   capacity_ = N;
+  }
+  return;
+ }
+
+ /** Moves the elements into a new storage of the given capacity (not less than size). **/
+ void reallocate(size_type new_capacity){
+  if(new_capacity < size_) new_capacity = size_;
+  T * new_data = inlineData();
+  if(new_capacity > N){
+   new_data = static_cast<T*>(::operator new(new_capacity * sizeof(T)));
+  }else{
+   new_capacity = N;
+  }
+  if(new_data != data_){
+   for(size_type i = 0; i < size_; ++i) new(new_data+i) T(std::move(data_[i]));
+   destroy(data_,data_+size_);
+   if(!isInline()) ::operator delete(static_cast<void*>(data_));
+   data_ = new_data;
+  }
+  capacity_ = new_capacity;
+  return;
+ }
+
+ /** Takes over the elements of another vector (this vector must be empty and inline). **/
+ void steal(SmallVector && another) noexcept{
+  if(another.isInline()){
+   for(size_type i = 0; i < another.size_; ++i) new(data_+i) T(std::move(another.data_[i]));
+   size_ = another.size_;
+   another.clear();
+  }else{
+   data_ = another.data_;
+   size_ = another.size_;
+   capacity_ = another.capacity_;
+   another.data_ = another.inlineData();
+   another.size_ = 0;
+   another.capacity_ = N;
+  }
+  return;
+ }
+
+ Storage inline_[N]; //inline storage
+ T * data_;          //pointer to the elements (either inline or heap storage)
+ size_type size_;    //number of elements
+ size_type capacity_; //current capacity
+};
+
+
+template <typename T, std::size_t N>
+inline bool operator==(const SmallVector<T,N> & lhs, const SmallVector<T,N> & rhs)
+{
+ return (lhs.size() == rhs.size() && std::equal(lhs.cbegin(),lhs.cend(),rhs.cbegin()));
+}
+
+template <typename T, std::size_t N>
+inline bool operator!=(const SmallVector<T,N> & lhs, const SmallVector<T,N> & rhs)
+{
+ return !(lhs == rhs);
+}
+
+} //namespace numerics
+
+} //namespace exatn
+
+#endif //EXATN_NUMERICS_SMALL_VECTOR_HPP_
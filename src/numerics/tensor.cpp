@@ -1,5 +1,5 @@
 /** ExaTN::Numerics: Tensor
-REVISION: 2020/06/30
+REVISION: 2020/12/06
 
 Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
@@ -37,7 +37,7 @@ name_(name), element_type_(TensorElementType::VOID)
 Tensor::Tensor(const std::string & name,                    //tensor name
                const Tensor & left_tensor,                  //left tensor
                const Tensor & right_tensor,                 //right tensor
-               const std::vector<TensorLeg> & contraction): //tensor contraction pattern
+               const TensorLegVector & contraction):      //tensor contraction pattern
 name_(name), element_type_(TensorElementType::VOID)
 {
  //Import shape/signature of the input tensors:
@@ -227,7 +227,7 @@ DimExtent Tensor::getDimExtent(unsigned int dim_id) const
  return shape_.getDimExtent(dim_id);
 }
 
-const std::vector<DimExtent> & Tensor::getDimExtents() const
+const DimExtentVector & Tensor::getDimExtents() const
 {
  return shape_.getDimExtents();
 }
@@ -1,5 +1,5 @@
 /** ExaTN::Numerics: Abstract Tensor
-REVISION: 2020/06/30
+REVISION: 2020/12/06
 
 Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
@@ -103,7 +103,7 @@ public:
  Tensor(const std::string & name,                    //tensor name
         const Tensor & left_tensor,                  //left tensor
         const Tensor & right_tensor,                 //right tensor
-        const std::vector<TensorLeg> & contraction); //tensor contraction pattern
+        const TensorLegVector & contraction);      //tensor contraction pattern
  /** Create a tensor from a byte packet. **/
  Tensor(BytePacket & byte_packet);
 
@@ -151,7 +151,7 @@ public:
  DimExtent getDimExtent(unsigned int dim_id) const;
 
  /** Get the extents of all tensor dimensions. **/
- const std::vector<DimExtent> & getDimExtents() const;
+ const DimExtentVector & getDimExtents() const;
 
  /** Get the strides for all tensor dimensions.
      Column-major tensor storage layout is assumed. **/
@@ -231,6 +231,8 @@ inline std::size_t tensor_element_type_size(TensorElementType tensor_element_typ
   case(TensorElementType::COMPLEX16): return TensorElementTypeSize<TensorElementType::COMPLEX16>();
   case(TensorElementType::COMPLEX32): return TensorElementTypeSize<TensorElementType::COMPLEX32>();
   case(TensorElementType::COMPLEX64): return TensorElementTypeSize<TensorElementType::COMPLEX64>();
+  case(TensorElementType::REALBF16): return TensorElementTypeSize<TensorElementType::REALBF16>();
+  case(TensorElementType::COMPLEXBF16): return TensorElementTypeSize<TensorElementType::COMPLEXBF16>();
  }
  return TensorElementTypeSize<TensorElementType::VOID>();
 }
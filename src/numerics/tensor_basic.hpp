@@ -1,5 +1,5 @@
 /** ExaTN: Tensor basic types and parameters
-REVISION: 2020/06/25
+REVISION: 2020/12/06
 
 Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
@@ -7,9 +7,12 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
 #ifndef EXATN_NUMERICS_TENSOR_BASIC_HPP_
 #define EXATN_NUMERICS_TENSOR_BASIC_HPP_
 
+#include "half_precision.hpp"
+
 #include <complex>
 
 #include <cstdint>
+#include <cstddef>
 
 namespace exatn{
 
@@ -26,6 +29,8 @@ using DimOffset = unsigned long long int;  //dimension base offset type
 
 using ScopeId = unsigned int; //TAProL scope ID type
 
+constexpr std::size_t INLINE_TENSOR_RANK = 8; //max tensor rank for which tensor metadata is stored inline (no heap allocation)
+
 constexpr DimExtent MAX_SPACE_DIM = 0xFFFFFFFFFFFFFFFF; //max dimension of unregistered (anonymous) spaces
 constexpr SpaceId SOME_SPACE = 0; //any unregistered (anonymous) space (all registered spaces will have SpaceId > 0)
 constexpr SubspaceId FULL_SUBSPACE = 0; //every space has its trivial (full) subspace automatically registered as subspace 0
@@ -51,7 +56,8 @@ enum class TensorOpCode{
  ORTHOGONALIZE_SVD, //tensor orthogonalization via SVD
  ORTHOGONALIZE_MGS, //tensor orthogonalization via Modified Gram-Schmidt
  BROADCAST,         //tensor broadcast (parallel execution only)
- ALLREDUCE          //tensor allreduce (parallel execution only)
+ ALLREDUCE,         //tensor allreduce (parallel execution only)
+ CONTRACT_BATCH     //batch of tensor contractions with an identical index pattern
 };
 
 enum class TensorElementType{
@@ -61,7 +67,9 @@ enum class TensorElementType{
  REAL64,
  COMPLEX16,
  COMPLEX32,
- COMPLEX64
+ COMPLEX64,
+ REALBF16,
+ COMPLEXBF16
 };
 
 //TensorElementTypeSize<enum TensorElementType>() --> Size in bytes:
@@ -73,11 +81,37 @@ template <> constexpr std::size_t TensorElementTypeSize<TensorElementType::REAL6
 template <> constexpr std::size_t TensorElementTypeSize<TensorElementType::COMPLEX16>(){return 4;} //4 bytes
 template <> constexpr std::size_t TensorElementTypeSize<TensorElementType::COMPLEX32>(){return 8;} //8 bytes
 template <> constexpr std::size_t TensorElementTypeSize<TensorElementType::COMPLEX64>(){return 16;} //16 bytes
+template <> constexpr std::size_t TensorElementTypeSize<TensorElementType::REALBF16>(){return 2;} //2 bytes
+template <> constexpr std::size_t TensorElementTypeSize<TensorElementType::COMPLEXBF16>(){return 4;} //4 bytes
 
 //TensorDataType<enum TensorElementType>::value --> C++ type:
 template <TensorElementType> struct TensorDataType{
  using value = void;
 };
+template <> struct TensorDataType<TensorElementType::REAL16>{
+ using value = Float16;
+ static constexpr const value ZERO {0x0000};
+ static constexpr const value UNITY {0x3C00};
+ static constexpr std::size_t size() {return sizeof(value);}
+};
+template <> struct TensorDataType<TensorElementType::REALBF16>{
+ using value = BFloat16;
+ static constexpr const value ZERO {0x0000};
+ static constexpr const value UNITY {0x3F80};
+ static constexpr std::size_t size() {return sizeof(value);}
+};
+template <> struct TensorDataType<TensorElementType::COMPLEX16>{
+ using value = ComplexFloat16;
+ static constexpr const value ZERO {{0x0000},{0x0000}};
+ static constexpr const value UNITY {{0x3C00},{0x0000}};
+ static constexpr std::size_t size() {return sizeof(value);}
+};
+template <> struct TensorDataType<TensorElementType::COMPLEXBF16>{
+ using value = ComplexBFloat16;
+ static constexpr const value ZERO {{0x0000},{0x0000}};
+ static constexpr const value UNITY {{0x3F80},{0x0000}};
+ static constexpr std::size_t size() {return sizeof(value);}
+};
 template <> struct TensorDataType<TensorElementType::REAL32>{
  using value = float;
  static constexpr const value ZERO {0.0f};
@@ -107,6 +141,30 @@ template <> struct TensorDataType<TensorElementType::COMPLEX64>{
 template <typename T> struct TensorDataKind{
  static constexpr const TensorElementType value = TensorElementType::VOID;
 };
+template <> struct TensorDataKind<Float16>{
+ static constexpr const TensorElementType value = TensorElementType::REAL16;
+ static constexpr const Float16 ZERO {0x0000};
+ static constexpr const Float16 UNITY {0x3C00};
+ static constexpr std::size_t size() {return sizeof(Float16);}
+};
+template <> struct TensorDataKind<BFloat16>{
+ static constexpr const TensorElementType value = TensorElementType::REALBF16;
+ static constexpr const BFloat16 ZERO {0x0000};
+ static constexpr const BFloat16 UNITY {0x3F80};
+ static constexpr std::size_t size() {return sizeof(BFloat16);}
+};
+template <> struct TensorDataKind<ComplexFloat16>{
+ static constexpr const TensorElementType value = TensorElementType::COMPLEX16;
+ static constexpr const ComplexFloat16 ZERO {{0x0000},{0x0000}};
+ static constexpr const ComplexFloat16 UNITY {{0x3C00},{0x0000}};
+ static constexpr std::size_t size() {return sizeof(ComplexFloat16);}
+};
+template <> struct TensorDataKind<ComplexBFloat16>{
+ static constexpr const TensorElementType value = TensorElementType::COMPLEXBF16;
+ static constexpr const ComplexBFloat16 ZERO {{0x0000},{0x0000}};
+ static constexpr const ComplexBFloat16 UNITY {{0x3F80},{0x0000}};
+ static constexpr std::size_t size() {return sizeof(ComplexBFloat16);}
+};
 template <> struct TensorDataKind<float>{
  static constexpr const TensorElementType value = TensorElementType::REAL32;
  static constexpr const float ZERO {0.0f};
@@ -132,6 +190,37 @@ template <> struct TensorDataKind<std::complex<double>>{
  static constexpr std::size_t size() {return sizeof(std::complex<std::complex<double>>);}
 };
 
+//Lower-precision counterpart of a tensor element type (mixed-precision evaluation):
+inline TensorElementType getLowerPrecisionElementType(TensorElementType element_type)
+{
+ switch(element_type){
+  case TensorElementType::REAL64: return TensorElementType::REAL32;
+  case TensorElementType::COMPLEX64: return TensorElementType::COMPLEX32;
+  default: break;
+ }
+ return element_type;
+}
+
+//Whether a tensor element type is a 16-bit storage type (computed in single precision):
+inline bool isHalfPrecisionElementType(TensorElementType element_type)
+{
+ return (element_type == TensorElementType::REAL16 || element_type == TensorElementType::REALBF16 ||
+         element_type == TensorElementType::COMPLEX16 || element_type == TensorElementType::COMPLEXBF16);
+}
+
+//Single-precision compute counterpart of a 16-bit storage tensor element type:
+inline TensorElementType getComputeElementType(TensorElementType element_type)
+{
+ switch(element_type){
+  case TensorElementType::REAL16: return TensorElementType::REAL32;
+  case TensorElementType::REALBF16: return TensorElementType::REAL32;
+  case TensorElementType::COMPLEX16: return TensorElementType::COMPLEX32;
+  case TensorElementType::COMPLEXBF16: return TensorElementType::COMPLEX32;
+  default: break;
+ }
+ return element_type;
+}
+
 } //namespace exatn
 
 #endif //EXATN_NUMERICS_TENSOR_BASIC_HPP_
@@ -0,0 +1,273 @@
+/** ExaTN::Numerics: Symmetry-aware block-sparse tensor
+REVISION: 2020/12/14
+
+Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
+Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
+
+#include "tensor_block_sparse.hpp"
+
+#include <iostream>
+#include <algorithm>
+#include <utility>
+
+namespace exatn{
+
+namespace numerics{
+
+BlockSparseTensor::BlockSparseTensor(const std::string & name,
+                                     const std::vector<const VectorSpace*> & spaces,
+                                     const std::vector<LegDirection> & directions,
+                                     SymmetryId total_symmetry,
+                                     SymmetryId modulus):
+ name_(name), directions_(directions), total_symmetry_(total_symmetry), modulus_(modulus)
+{
+ make_sure(spaces.size() == directions.size(),
+           "#ERROR(exatn::numerics::BlockSparseTensor): Mismatch in the number of tensor dimensions!");
+ make_sure(modulus >= 0,"#ERROR(exatn::numerics::BlockSparseTensor): Negative symmetry modulus!");
+ const unsigned int rank = spaces.size();
+ //Dense tensor declaration:
+ std::vector<DimExtent> extents(rank);
+ std::vector<std::pair<SpaceId,SubspaceId>> signature(rank);
+ for(unsigned int i = 0; i < rank; ++i){
+  assert(spaces[i] != nullptr);
+  extents[i] = spaces[i]->getDimension();
+  signature[i] = std::make_pair(spaces[i]->getRegisteredId(),SubspaceId{0});
+ }
+ tensor_ = std::make_shared<Tensor>(name,extents,signature);
+ //Symmetry subranges of each tensor dimension (ordered, non-overlapping):
+ subranges_.resize(rank);
+ for(unsigned int i = 0; i < rank; ++i){
+  auto & subranges = subranges_[i];
+  subranges = spaces[i]->getSymmetrySubranges();
+  if(subranges.empty()) subranges.emplace_back(SymmetryRange{0,extents[i]-1,0});
+  std::sort(subranges.begin(),subranges.end(),
+            [](const SymmetryRange & a, const SymmetryRange & b){return a.lower < b.lower;});
+  for(std::size_t j = 1; j < subranges.size(); ++j){
+   make_sure(subranges[j].lower > subranges[j-1].upper,
+             "#ERROR(exatn::numerics::BlockSparseTensor): Overlapping symmetry subranges in vector space "
+             + spaces[i]->getName());
+  }
+ }
+ //Enumerate symmetry-allowed blocks:
+ std::vector<unsigned int> block(rank,0);
+ bool done = false;
+ while(!done){
+  if(blockIsAllowed(block)){
+   std::vector<DimExtent> block_extents(rank);
+   std::vector<std::pair<SpaceId,SubspaceId>> block_signature(rank);
+   for(unsigned int i = 0; i < rank; ++i){
+    const auto & subrange = subranges_[i][block[i]];
+    block_extents[i] = subrange.upper - subrange.lower + 1;
+    block_signature[i] = std::make_pair(SOME_SPACE,SubspaceId{subrange.lower});
+   }
+   block_map_.emplace(std::make_pair(block,blocks_.size()));
+   blocks_.emplace_back(TensorBlock{block,
+                        std::make_shared<Tensor>(generateBlockName(block),block_extents,block_signature)});
+  }
+  done = true;
+  for(unsigned int i = 0; i < rank; ++i){
+   if(++block[i] < subranges_[i].size()){done = false; break;}
+   block[i] = 0;
+  }
+ }
+}
+
+
+void BlockSparseTensor::printIt() const
+{
+ std::cout << "BlockSparseTensor{" << name_ << ": Total symmetry = " << total_symmetry_;
+ if(modulus_ > 0) std::cout << " mod " << modulus_;
+ std::cout << "; Stored blocks = " << blocks_.size() << "; Volume = " << getVolume()
+           << " of " << getDenseVolume() << "}" << std::endl;
+ for(const auto & block: blocks_){
+  std::cout << " ";
+  block.tensor->printIt();
+  std::cout << std::endl;
+ }
+ return;
+}
+
+
+const std::string & BlockSparseTensor::getName() const
+{
+ return name_;
+}
+
+
+unsigned int BlockSparseTensor::getRank() const
+{
+ return subranges_.size();
+}
+
+
+std::shared_ptr<Tensor> BlockSparseTensor::getTensor() const
+{
+ return tensor_;
+}
+
+
+const std::vector<SymmetryRange> & BlockSparseTensor::getDimSubranges(unsigned int dim_id) const
+{
+ assert(dim_id < subranges_.size());
+ return subranges_[dim_id];
+}
+
+
+std::size_t BlockSparseTensor::getNumBlocks() const
+{
+ return blocks_.size();
+}
+
+
+const std::vector<BlockSparseTensor::TensorBlock> & BlockSparseTensor::getBlocks() const
+{
+ return blocks_;
+}
+
+
+std::shared_ptr<Tensor> BlockSparseTensor::getBlock(const std::vector<unsigned int> & subranges) const
+{
+ auto iter = block_map_.find(subranges);
+ if(iter == block_map_.end()) return std::shared_ptr<Tensor>(nullptr);
+ return blocks_[iter->second].tensor;
+}
+
+
+bool BlockSparseTensor::blockIsAllowed(const std::vector<unsigned int> & subranges) const
+{
+ if(subranges.size() != subranges_.size()) return false;
+ SymmetryId charge = 0;
+ for(unsigned int i = 0; i < subranges.size(); ++i){
+  if(subranges[i] >= subranges_[i].size()) return false;
+  const auto symm_id = subranges_[i][subranges[i]].symm_id;
+  if(directions_[i] == LegDirection::INWARD){
+   charge -= symm_id;
+  }else{
+   charge += symm_id;
+  }
+ }
+ if(modulus_ > 0) return ((charge - total_symmetry_) % modulus_ == 0);
+ return (charge == total_symmetry_);
+}
+
+
+std::size_t BlockSparseTensor::getVolume() const
+{
+ std::size_t volume = 0;
+ for(const auto & block: blocks_) volume += block.tensor->getVolume();
+ return volume;
+}
+
+
+std::size_t BlockSparseTensor::getDenseVolume() const
+{
+ return tensor_->getVolume();
+}
+
+
+std::string BlockSparseTensor::generateBlockName(const std::vector<unsigned int> & subranges) const
+{
+ std::string block_name("_" + name_ + "_B");
+ for(unsigned int i = 0; i < subranges.size(); ++i){
+  if(i > 0) block_name += "_";
+  block_name += std::to_string(subranges[i]);
+ }
+ return block_name;
+}
+
+
+bool BlockSparseTensor::matchBlocks(const BlockSparseTensor & output,
+                                    const std::vector<std::string> & output_labels,
+                                    const BlockSparseTensor & left,
+                                    const std::vector<std::string> & left_labels,
+                                    const BlockSparseTensor * right,
+                                    const std::vector<std::string> & right_labels,
+                                    std::vector<std::vector<std::size_t>> & matches)
+{
+ matches.clear();
+ if(output_labels.size() != output.getRank() || left_labels.size() != left.getRank()) return false;
+ if(right != nullptr){
+  if(right_labels.size() != right->getRank()) return false;
+ }
+ //Check congruence of symmetry subranges for each index label:
+ std::map<std::string,const std::vector<SymmetryRange>*> label_subranges;
+ auto congruent = [&label_subranges](const std::string & label, const std::vector<SymmetryRange> & subranges){
+  auto res = label_subranges.emplace(std::make_pair(label,&subranges));
+  if(res.second) return true;
+  const auto & other = *(res.first->second);
+  if(other.size() != subranges.size()) return false;
+  for(std::size_t i = 0; i < subranges.size(); ++i){
+   if(other[i].lower != subranges[i].lower || other[i].upper != subranges[i].upper ||
+      other[i].symm_id != subranges[i].symm_id) return false;
+  }
+  return true;
+ };
+ for(unsigned int i = 0; i < left_labels.size(); ++i){
+  if(!congruent(left_labels[i],left.getDimSubranges(i))) return false;
+ }
+ if(right != nullptr){
+  for(unsigned int i = 0; i < right_labels.size(); ++i){
+   if(!congruent(right_labels[i],right->getDimSubranges(i))) return false;
+  }
+ }
+ for(unsigned int i = 0; i < output_labels.size(); ++i){
+  if(label_subranges.find(output_labels[i]) == label_subranges.end()) return false; //label does not appear in input tensors
+  if(!congruent(output_labels[i],output.getDimSubranges(i))) return false;
+ }
+ //Binds the index labels of a tensor to the subranges of its block:
+ auto bind = [](const std::vector<std::string> & labels, const std::vector<unsigned int> & subranges,
+                std::map<std::string,unsigned int> & bound){
+  for(unsigned int i = 0; i < labels.size(); ++i){
+   auto res = bound.emplace(std::make_pair(labels[i],subranges[i]));
+   if(!res.second && res.first->second != subranges[i]) return false;
+  }
+  return true;
+ };
+ //Group the blocks of the right tensor by the subranges of the shared index labels:
+ std::vector<std::string> shared_labels;
+ std::map<std::vector<unsigned int>,std::vector<std::size_t>> right_groups;
+ if(right != nullptr){
+  for(const auto & label: right_labels){
+   if(std::find(left_labels.cbegin(),left_labels.cend(),label) != left_labels.cend() &&
+      std::find(shared_labels.cbegin(),shared_labels.cend(),label) == shared_labels.cend())
+    shared_labels.emplace_back(label);
+  }
+  const auto & right_blocks = right->getBlocks();
+  for(std::size_t j = 0; j < right_blocks.size(); ++j){
+   std::map<std::string,unsigned int> bound;
+   if(!bind(right_labels,right_blocks[j].subranges,bound)) continue;
+   std::vector<unsigned int> key(shared_labels.size());
+   for(std::size_t k = 0; k < shared_labels.size(); ++k) key[k] = bound[shared_labels[k]];
+   right_groups[key].emplace_back(j);
+  }
+ }
+ //Enumerate compatible block combinations:
+ std::vector<unsigned int> output_block(output_labels.size());
+ const auto & left_blocks = left.getBlocks();
+ for(std::size_t i = 0; i < left_blocks.size(); ++i){
+  std::map<std::string,unsigned int> left_bound;
+  if(!bind(left_labels,left_blocks[i].subranges,left_bound)) continue;
+  if(right == nullptr){
+   for(std::size_t k = 0; k < output_labels.size(); ++k) output_block[k] = left_bound[output_labels[k]];
+   auto iter = output.block_map_.find(output_block);
+   if(iter != output.block_map_.end()) matches.emplace_back(std::vector<std::size_t>{iter->second,i});
+  }else{
+   std::vector<unsigned int> key(shared_labels.size());
+   for(std::size_t k = 0; k < shared_labels.size(); ++k) key[k] = left_bound[shared_labels[k]];
+   auto group = right_groups.find(key);
+   if(group == right_groups.end()) continue;
+   for(const auto & j: group->second){
+    auto bound = left_bound;
+    if(!bind(right_labels,right->getBlocks()[j].subranges,bound)) continue;
+    for(std::size_t k = 0; k < output_labels.size(); ++k) output_block[k] = bound[output_labels[k]];
+    auto iter = output.block_map_.find(output_block);
+    if(iter != output.block_map_.end()) matches.emplace_back(std::vector<std::size_t>{iter->second,i,j});
+   }
+  }
+ }
+ return true;
+}
+
+} //namespace numerics
+
+} //namespace exatn
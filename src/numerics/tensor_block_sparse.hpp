@@ -0,0 +1,135 @@
+/** ExaTN::Numerics: Symmetry-aware block-sparse tensor
+REVISION: 2020/12/14
+
+Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
+Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
+
+/** Rationale:
+ (a) A block-sparse tensor is a tensor defined over vector spaces with symmetry
+     subranges (see VectorSpace). Its blocks are direct products of the symmetry
+     subranges of all tensor dimensions. Only symmetry-allowed blocks are stored,
+     each as a separate dense tensor, all other blocks are zero by symmetry.
+ (b) A block is symmetry-allowed if the symmetry ids of its subranges, signed by
+     the tensor dimension directions (INWARD: -, OUTWARD/UNDIRECT: +), add up to
+     the total symmetry id of the tensor (abelian U(1) symmetry), or are congruent
+     with it modulo a given modulus (abelian Z(n) symmetry).
+ (c) Basis vectors not covered by any symmetry subrange do not belong to any block,
+     thus the tensor is zero over them. A vector space without symmetry subranges
+     is treated as a single subrange with symmetry id 0 spanning the whole space.
+ (d) Each block tensor has an anonymous signature whose base offsets are the lower
+     bounds of its subranges, such that it is a slice of the dense tensor.
+ (e) A tensor operation on block-sparse tensors given symbolically enumerates only
+     compatible block combinations: Block combinations in which each index label
+     refers to the same symmetry subrange in all tensors and which produce a stored
+     block of the output tensor. All other block combinations vanish by symmetry.
+**/
+
+#ifndef EXATN_NUMERICS_TENSOR_BLOCK_SPARSE_HPP_
+#define EXATN_NUMERICS_TENSOR_BLOCK_SPARSE_HPP_
+
+#include "tensor_basic.hpp"
+#include "spaces.hpp"
+#include "tensor.hpp"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+
+#include "errors.hpp"
+
+namespace exatn{
+
+namespace numerics{
+
+class BlockSparseTensor{
+public:
+
+ //Stored tensor block:
+ struct TensorBlock{
+  std::vector<unsigned int> subranges; //symmetry subrange (position) for each tensor dimension
+  std::shared_ptr<Tensor> tensor;      //dense tensor storing the block
+ };
+
+ /** Creates a block-sparse tensor over given vector spaces with symmetry subranges. **/
+ BlockSparseTensor(const std::string & name,                         //in: tensor name
+                   const std::vector<const VectorSpace*> & spaces,   //in: vector space for each tensor dimension
+                   const std::vector<LegDirection> & directions,     //in: direction of each tensor dimension
+                   SymmetryId total_symmetry = 0,                    //in: total symmetry id of the tensor
+                   SymmetryId modulus = 0);                          //in: symmetry modulus (0: U(1) symmetry)
+
+ BlockSparseTensor(const BlockSparseTensor &) = delete;
+ BlockSparseTensor & operator=(const BlockSparseTensor &) = delete;
+ BlockSparseTensor(BlockSparseTensor &&) noexcept = default;
+ BlockSparseTensor & operator=(BlockSparseTensor &&) noexcept = default;
+ virtual ~BlockSparseTensor() = default;
+
+ /** Prints. **/
+ void printIt() const;
+
+ /** Returns the tensor name. **/
+ const std::string & getName() const;
+
+ /** Returns the tensor rank. **/
+ unsigned int getRank() const;
+
+ /** Returns the dense tensor (declaration only, it is never created). **/
+ std::shared_ptr<Tensor> getTensor() const;
+
+ /** Returns the symmetry subranges of a given tensor dimension. **/
+ const std::vector<SymmetryRange> & getDimSubranges(unsigned int dim_id) const;
+
+ /** Returns the number of stored (symmetry-allowed) blocks. **/
+ std::size_t getNumBlocks() const;
+
+ /** Returns all stored blocks. **/
+ const std::vector<TensorBlock> & getBlocks() const;
+
+ /** Returns the tensor storing a given block, or nullptr if the block is not stored. **/
+ std::shared_ptr<Tensor> getBlock(const std::vector<unsigned int> & subranges) const;
+
+ /** Returns TRUE if a given block is symmetry-allowed. **/
+ bool blockIsAllowed(const std::vector<unsigned int> & subranges) const;
+
+ /** Returns the number of stored tensor elements. **/
+ std::size_t getVolume() const;
+
+ /** Returns the number of tensor elements of the dense tensor. **/
+ std::size_t getDenseVolume() const;
+
+ /** Enumerates all compatible block combinations of a symbolic tensor operation on
+     block-sparse tensors, given the index labels of the output tensor and of one
+     (addition) or two (contraction) input tensors: Each match contains the block
+     positions in the output tensor, the left input tensor and, for a contraction,
+     the right input tensor. Returns FALSE if the operation is invalid: An index label
+     does not appear in any input tensor or refers to incongruent symmetry subranges. **/
+ static bool matchBlocks(const BlockSparseTensor & output,
+                         const std::vector<std::string> & output_labels,
+                         const BlockSparseTensor & left,
+                         const std::vector<std::string> & left_labels,
+                         const BlockSparseTensor * right,
+                         const std::vector<std::string> & right_labels,
+                         std::vector<std::vector<std::size_t>> & matches);
+
+private:
+
+ /** Generates the name of the tensor storing a given block: _<name>_B<subrange>_<subrange>...
+     The leading underscore places block tensors in the namespace reserved for the implicit
+     tensors of the runtime, thus they do not clash with the tensors named by the client. **/
+ std::string generateBlockName(const std::vector<unsigned int> & subranges) const;
+
+ std::string name_;                                    //tensor name
+ std::shared_ptr<Tensor> tensor_;                      //dense tensor (declaration only)
+ std::vector<std::vector<SymmetryRange>> subranges_;   //symmetry subranges for each tensor dimension
+ std::vector<LegDirection> directions_;                //direction of each tensor dimension
+ SymmetryId total_symmetry_;                           //total symmetry id of the tensor
+ SymmetryId modulus_;                                  //symmetry modulus (0: U(1) symmetry)
+ std::vector<TensorBlock> blocks_;                     //stored (symmetry-allowed) blocks
+ std::map<std::vector<unsigned int>,std::size_t> block_map_; //block subranges --> block position
+};
+
+} //namespace numerics
+
+} //namespace exatn
+
+#endif //EXATN_NUMERICS_TENSOR_BLOCK_SPARSE_HPP_
@@ -1,5 +1,5 @@
 /** ExaTN::Numerics: Tensor connected to other tensors inside a tensor network
-REVISION: 2020/10/09
+REVISION: 2020/12/06
 
 Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
@@ -15,7 +15,7 @@ namespace numerics{
 
 TensorConn::TensorConn(std::shared_ptr<Tensor> tensor,
                        unsigned int id,
-                       const std::vector<TensorLeg> & legs,
+                       const TensorLegVector & legs,
                        bool conjugated):
  tensor_(tensor), id_(id), legs_(legs), conjugated_(conjugated), optimizable_(false)
 {
@@ -98,12 +98,12 @@ const TensorLeg & TensorConn::getTensorLeg(unsigned int leg_id) const
  return legs_[leg_id];
 }
 
-const std::vector<TensorLeg> & TensorConn::getTensorLegs() const
+const TensorLegVector & TensorConn::getTensorLegs() const
 {
  return legs_;
 }
 
-const std::vector<DimExtent> & TensorConn::getDimExtents() const
+const DimExtentVector & TensorConn::getDimExtents() const
 {
  return tensor_->getDimExtents();
 }
@@ -1,5 +1,5 @@
 /** ExaTN::Numerics: Tensor connected to other tensors in a tensor network
-REVISION: 2020/10/09
+REVISION: 2020/12/06
 
 Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
@@ -41,7 +41,7 @@ public:
  /** Constructs a connected tensor inside a tensor network. **/
  TensorConn(std::shared_ptr<Tensor> tensor,      //in: co-owned pointer to the tensor
             unsigned int id,                     //in: tensor id in the tensor network
-            const std::vector<TensorLeg> & legs, //in: tensor legs: Connections to other tensors in the tensor network
+            const TensorLegVector & legs,        //in: tensor legs: Connections to other tensors in the tensor network
             bool conjugated = false);            //in: whether or not the tensor enters a tensor network as complex conjugated
 
  TensorConn(const TensorConn &) = default;
@@ -84,10 +84,10 @@ public:
  const TensorLeg & getTensorLeg(unsigned int leg_id) const;
 
  /** Returns all tensor legs. **/
- const std::vector<TensorLeg> & getTensorLegs() const;
+ const TensorLegVector & getTensorLegs() const;
 
  /** Returns the tensor dimension extents. **/
- const std::vector<DimExtent> & getDimExtents() const;
+ const DimExtentVector & getDimExtents() const;
 
  /** Returns the dimension extent of a specific tensor leg. **/
  DimExtent getDimExtent(unsigned int dim_id) const;
@@ -144,7 +144,7 @@ private:
 
  std::shared_ptr<Tensor> tensor_; //co-owned pointer to the tensor
  unsigned int id_;                //tensor id in the tensor network
- std::vector<TensorLeg> legs_;    //tensor legs: Connections to other tensors
+ TensorLegVector legs_;           //tensor legs: Connections to other tensors
  bool conjugated_;                //complex conjugation flag
  bool optimizable_;               //whether or not the tensor is subject to optimization as part of the optimized tensor network
 };
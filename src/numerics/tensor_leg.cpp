@@ -1,8 +1,8 @@
 /** ExaTN::Numerics: Tensor leg (connection)
-REVISION: 2020/10/09
+REVISION: 2020/12/06
 
-Copyright (C) 2018-2019 Dmitry I. Lyakh (Liakh)
-Copyright (C) 2018-2019 Oak Ridge National Laboratory (UT-Battelle) **/
+Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
+Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
 
 #include "tensor_leg.hpp"
 
@@ -95,8 +95,8 @@ void TensorLeg::reverseDirection()
  return;
 }
 
-bool tensorLegsAreCongruent(const std::vector<TensorLeg> * legs0,
-                            const std::vector<TensorLeg> * legs1)
+bool tensorLegsAreCongruent(const TensorLegVector * legs0,
+                            const TensorLegVector * legs1)
 {
  if(legs0->size() != legs1->size()) return false;
  auto iter1 = legs1->cbegin();
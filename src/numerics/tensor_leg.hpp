@@ -1,8 +1,8 @@
 /** ExaTN::Numerics: Tensor leg (connection)
-REVISION: 2020/10/09
+REVISION: 2020/12/06
 
-Copyright (C) 2018-2019 Dmitry I. Lyakh (Liakh)
-Copyright (C) 2018-2019 Oak Ridge National Laboratory (UT-Battelle) **/
+Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
+Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
 
 /** Rationale:
  (a) A tensor leg associates a tensor mode with a mode in another tensor
@@ -14,6 +14,7 @@ Copyright (C) 2018-2019 Oak Ridge National Laboratory (UT-Battelle) **/
 #define EXATN_NUMERICS_TENSOR_LEG_HPP_
 
 #include "tensor_basic.hpp"
+#include "small_vector.hpp"
 
 #include <iostream>
 #include <fstream>
@@ -87,10 +88,14 @@ private:
 };
 
 
+/** Tensor legs of a tensor (stored inline for tensor ranks up to INLINE_TENSOR_RANK). **/
+using TensorLegVector = SmallVector<TensorLeg,INLINE_TENSOR_RANK>;
+
+
 /** Returns true if two vectors of tensor legs are congruent, that is,
     they have the same size and direction of each tensor leg. **/
-bool tensorLegsAreCongruent(const std::vector<TensorLeg> * legs0,
-                            const std::vector<TensorLeg> * legs1);
+bool tensorLegsAreCongruent(const TensorLegVector * legs0,
+                            const TensorLegVector * legs1);
 
 } //namespace numerics
 
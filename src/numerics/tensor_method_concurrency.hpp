@@ -0,0 +1,46 @@
+/** ExaTN::Numerics: Tensor functor concurrency declaration
+REVISION: 2020/12/04
+
+Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
+Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
+
+/** Rationale:
+ (a) Tensor functors (exatn::TensorMethod) are applied by TRANSFORM operations
+     on Host worker threads asynchronously with respect to other tensor operations.
+     A tensor functor may inherit from TensorMethodConcurrencyTrait in addition
+     to talsh::TensorFunctor<Identifiable> in order to declare how it can share Host:
+     - THREAD_PARALLEL: The tensor functor is multithreaded itself (e.g., OpenMP),
+       thus it is applied exclusively, one at a time (default for tensor functors
+       not declaring their concurrency);
+     - SERIAL: The tensor functor is single-threaded, thus multiple such tensor
+       functors can be applied concurrently by different Host worker threads.
+**/
+
+#ifndef EXATN_NUMERICS_TENSOR_METHOD_CONCURRENCY_HPP_
+#define EXATN_NUMERICS_TENSOR_METHOD_CONCURRENCY_HPP_
+
+namespace exatn{
+
+namespace numerics{
+
+enum class TensorMethodConcurrency{
+ THREAD_PARALLEL, //multithreaded tensor functor: Applied exclusively
+ SERIAL           //single-threaded tensor functor: Applied concurrently with other serial tensor functors
+};
+
+
+class TensorMethodConcurrencyTrait{
+public:
+
+ virtual ~TensorMethodConcurrencyTrait() = default;
+
+ /** Returns the concurrency kind of the tensor functor. **/
+ virtual TensorMethodConcurrency getConcurrency() const = 0;
+
+};
+
+} //namespace numerics
+
+} //namespace exatn
+
+#endif //EXATN_NUMERICS_TENSOR_METHOD_CONCURRENCY_HPP_
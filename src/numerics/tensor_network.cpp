@@ -1,5 +1,5 @@
 /** ExaTN::Numerics: Tensor network
-REVISION: 2020/10/15
+REVISION: 2020/12/07
 
 Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
@@ -7,7 +7,6 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
 #include "tensor_network.hpp"
 #include "tensor_symbol.hpp"
 #include "contraction_seq_optimizer_factory.hpp"
-#include "functor_init_val.hpp"
 
 #include "metis_graph.hpp"
 
@@ -18,6 +17,8 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
 #include <map>
 #include <memory>
 #include <algorithm>
+#include <set>
+#include <functional>
 
 namespace exatn{
 
@@ -67,7 +68,7 @@ bool tensorNameIsIntermediate(const Tensor & tensor,
 
 //Main:
 TensorNetwork::TensorNetwork():
- explicit_output_(0), finalized_(1), max_tensor_id_(0),
+ explicit_output_(0), finalized_(1),
  contraction_seq_flops_(0.0), max_intermediate_presence_volume_(0.0),
  max_intermediate_volume_(0.0), max_intermediate_rank_(0), universal_indexing_(false)
 {
@@ -82,7 +83,7 @@ TensorNetwork::TensorNetwork():
 
 
 TensorNetwork::TensorNetwork(const std::string & name):
- explicit_output_(0), finalized_(1), name_(name), max_tensor_id_(0),
+ explicit_output_(0), finalized_(1), name_(name),
  contraction_seq_flops_(0.0), max_intermediate_presence_volume_(0.0),
  max_intermediate_volume_(0.0), max_intermediate_rank_(0), universal_indexing_(false)
 {
@@ -99,7 +100,7 @@ TensorNetwork::TensorNetwork(const std::string & name):
 TensorNetwork::TensorNetwork(const std::string & name,
                              std::shared_ptr<Tensor> output_tensor,
                              const std::vector<TensorLeg> & output_legs):
- explicit_output_(1), finalized_(0), name_(name), max_tensor_id_(0),
+ explicit_output_(1), finalized_(0), name_(name),
  contraction_seq_flops_(0.0), max_intermediate_presence_volume_(0.0),
  max_intermediate_volume_(0.0), max_intermediate_rank_(0), universal_indexing_(false)
 {
@@ -116,7 +117,7 @@ TensorNetwork::TensorNetwork(const std::string & name,
 TensorNetwork::TensorNetwork(const std::string & name,
                              const std::string & tensor_network,
                              const std::map<std::string,std::shared_ptr<Tensor>> & tensors):
- explicit_output_(1), finalized_(0), name_(name), max_tensor_id_(0),
+ explicit_output_(1), finalized_(0), name_(name),
  contraction_seq_flops_(0.0), max_intermediate_presence_volume_(0.0),
  max_intermediate_volume_(0.0), max_intermediate_rank_(0), universal_indexing_(false)
 {
@@ -198,7 +199,7 @@ TensorNetwork::TensorNetwork(const std::string & name,
 TensorNetwork::TensorNetwork(const std::string & name,
                              std::shared_ptr<Tensor> output_tensor,
                              NetworkBuilder & builder):
- explicit_output_(1), finalized_(0), name_(name), max_tensor_id_(0),
+ explicit_output_(1), finalized_(0), name_(name),
  contraction_seq_flops_(0.0), max_intermediate_presence_volume_(0.0),
  max_intermediate_volume_(0.0), max_intermediate_rank_(0), universal_indexing_(false)
 {
@@ -293,26 +294,39 @@ unsigned int TensorNetwork::getNumTensors() const
 
 unsigned int TensorNetwork::getMaxTensorId()
 {
- if(max_tensor_id_ == 0){
-  for(const auto & kv: tensors_) max_tensor_id_ = std::max(max_tensor_id_,kv.first);
+ //Prune the ids of removed tensors from the top of the tensor id heap:
+ while(!tensor_id_heap_.empty()){
+  const auto tensor_id = tensor_id_heap_.front();
+  if(tensors_.find(tensor_id) != tensors_.end()) return tensor_id;
+  std::pop_heap(tensor_id_heap_.begin(),tensor_id_heap_.end());
+  tensor_id_heap_.pop_back();
  }
- return max_tensor_id_;
+ return 0;
 }
 
 
 void TensorNetwork::updateMaxTensorIdOnAppend(unsigned int tensor_id)
 {
- auto curr_max_id = getMaxTensorId();
- max_tensor_id_ = std::max(curr_max_id,tensor_id);
+ if(tensor_id != 0){
+  //Rebuild the tensor id heap if it is dominated by the ids of removed tensors:
+  if(tensor_id_heap_.size() >= 2 * tensors_.size() + 64){
+   invalidateMaxTensorId();
+  }else{
+   tensor_id_heap_.emplace_back(tensor_id);
+   std::push_heap(tensor_id_heap_.begin(),tensor_id_heap_.end());
+  }
+ }
  return;
 }
 
 
 void TensorNetwork::updateMaxTensorIdOnRemove(unsigned int tensor_id)
 {
- if(tensor_id != 0 && tensor_id == max_tensor_id_){
-  max_tensor_id_ = 0; //reset max tensor id to Undefined
-  //auto refresh_max_tensor_id = getMaxTensorId();
+ if(tensor_id != 0 && !tensor_id_heap_.empty()){
+  if(tensor_id == tensor_id_heap_.front()){
+   std::pop_heap(tensor_id_heap_.begin(),tensor_id_heap_.end());
+   tensor_id_heap_.pop_back();
+  }
  }
  return;
 }
@@ -382,7 +396,7 @@ std::shared_ptr<Tensor> TensorNetwork::getTensor(unsigned int tensor_id, bool *
 }
 
 
-const std::vector<TensorLeg> * TensorNetwork::getTensorConnections(unsigned int tensor_id) const
+const TensorLegVector * TensorNetwork::getTensorConnections(unsigned int tensor_id) const
 {
  auto it = tensors_.find(tensor_id);
  if(it == tensors_.end()) return nullptr;
@@ -490,7 +504,12 @@ void TensorNetwork::updateConnectionsFromInputTensors()
 
 void TensorNetwork::invalidateMaxTensorId()
 {
- max_tensor_id_ = 0;
+ tensor_id_heap_.clear();
+ tensor_id_heap_.reserve(tensors_.size());
+ for(const auto & kv: tensors_){
+  if(kv.first != 0) tensor_id_heap_.emplace_back(kv.first);
+ }
+ std::make_heap(tensor_id_heap_.begin(),tensor_id_heap_.end());
  return;
 }
 
@@ -514,9 +533,31 @@ double TensorNetwork::determineContractionSequence(ContractionSeqOptimizer & con
 {
  assert(finalized_ != 0); //tensor network must be in finalized state
  if(contraction_seq_.empty()){
-  auto intermediate_num_begin = this->getMaxTensorId() + 1;
-  auto intermediate_num_generator = [intermediate_num_begin]() mutable {return intermediate_num_begin++;};
-  contraction_seq_flops_ = contr_seq_optimizer.determineContractionSequence(*this,contraction_seq_,intermediate_num_generator);
+  const auto intermediate_num_begin = this->getMaxTensorId() + 1;
+  auto intermediate_num = intermediate_num_begin; //shared by all copies of the generator
+  auto intermediate_num_generator = [&intermediate_num](){return intermediate_num++;};
+  if(this->getNumTensors() > 2){ //simplify the tensor network first
+   TensorNetwork simplified(*this);
+   contraction_seq_flops_ = simplified.absorbLowRankTensors(contraction_seq_,intermediate_num_generator);
+   std::list<ContrTriple> contr_seq;
+   contraction_seq_flops_ += contr_seq_optimizer.determineContractionSequence(simplified,contr_seq,intermediate_num_generator);
+   contraction_seq_.splice(contraction_seq_.end(),contr_seq);
+   //Greedy absorption may occasionally worsen the optimizer's result, compare with the greedy sequence on the original network:
+   if(simplified.getNumTensors() < this->getNumTensors()){
+    auto greedy_optimizer = ContractionSeqOptimizerFactory::get()->createContractionSeqOptimizer("greed");
+    assert(greedy_optimizer);
+    auto original_num = intermediate_num_begin;
+    std::list<ContrTriple> original_seq;
+    double original_flops = greedy_optimizer->determineContractionSequence(*this,original_seq,
+                             [&original_num](){return original_num++;});
+    if(original_flops < contraction_seq_flops_){
+     contraction_seq_ = std::move(original_seq);
+     contraction_seq_flops_ = original_flops;
+    }
+   }
+  }else{
+   contraction_seq_flops_ = contr_seq_optimizer.determineContractionSequence(*this,contraction_seq_,intermediate_num_generator);
+  }
   max_intermediate_presence_volume_ = 0.0;
   max_intermediate_volume_ = 0.0;
   max_intermediate_rank_ = 0;
@@ -843,7 +884,7 @@ bool TensorNetwork::appendTensor(unsigned int tensor_id,
  }
  //Pair legs of the new tensor with the input tensors of the tensor network:
  if(tensor_rank > 0){ //true tensor
-  std::vector<TensorLeg> new_tensor_legs(tensor_rank,TensorLeg(0,0)); //placeholders for legs
+  TensorLegVector new_tensor_legs(tensor_rank,TensorLeg(0,0)); //placeholders for legs
   if(pairing.size() > 0){
    std::vector<unsigned int> matched_output_legs(pairing.size(),0);
    unsigned int mode = 0;
@@ -949,22 +990,15 @@ bool TensorNetwork::appendTensorGate(unsigned int tensor_id,
   std::cout << "#ERROR(TensorNetwork::appendTensorGate): Invalid argument: Tensor network does not have enough open legs!" << std::endl;
   return false;
  }
- if(output_rank > 0){
-  char inds[output_rank] = {0};
-  for(const auto & leg_id: pairing){
-   if(leg_id >= output_rank){
-    std::cout << "#ERROR(TensorNetwork::appendTensorGate): Invalid argument: Invalid content of the pairing vector!" << std::endl;
-    return false;
-   }
-   if(inds[leg_id]++ != 0){
-    std::cout << "#ERROR(TensorNetwork::appendTensorGate): Invalid argument: Invalid content of the pairing vector!" << std::endl;
-    return false;
-   }
+ for(auto iter = pairing.cbegin(); iter != pairing.cend(); ++iter){ //cost is independent of the output rank
+  if(*iter >= output_rank || std::find(pairing.cbegin(),iter,*iter) != iter){
+   std::cout << "#ERROR(TensorNetwork::appendTensorGate): Invalid argument: Invalid content of the pairing vector!" << std::endl;
+   return false;
   }
  }
  //Pair legs of the new tensor with the input tensors of the tensor network:
  if(tensor_rank > 0){
-  std::vector<TensorLeg> new_tensor_legs(tensor_rank,TensorLeg(0,0)); //placeholders for legs
+  TensorLegVector new_tensor_legs(tensor_rank,TensorLeg(0,0)); //placeholders for legs
   unsigned int paired_leg_id = 0;
   unsigned int unpaired_leg_id = tensor_rank / 2;
   if(conjugated) std::swap(paired_leg_id,unpaired_leg_id);
@@ -1368,8 +1402,8 @@ bool TensorNetwork::mergeTensors(unsigned int left_id, unsigned int right_id, un
  for(const auto & leg: left_legs){if(leg.getTensorId() == right_id) ++num_contracted;}
  unsigned int num_uncontracted = (left_legs.size() + right_legs.size()) - num_contracted*2;
  //Create the resulting legs and contraction pattern:
- std::vector<TensorLeg> result_legs(num_uncontracted,TensorLeg(0,0)); //placeholders for result-tensor legs
- std::vector<TensorLeg> pattern(left_legs.size()+right_legs.size(),TensorLeg(0,0)); //tensor contraction pattern (placeholder)
+ TensorLegVector result_legs(num_uncontracted,TensorLeg(0,0)); //placeholders for result-tensor legs
+ TensorLegVector pattern(left_legs.size()+right_legs.size(),TensorLeg(0,0)); //tensor contraction pattern (placeholder)
  unsigned int mode = 0;
  unsigned int res_mode = 0;
  for(const auto & leg: left_legs){
@@ -1462,8 +1496,8 @@ bool TensorNetwork::splitTensor(unsigned int tensor_id,
  assert(left_tensor);
  auto right_tensor = tensor->getTensor()->createSubtensor(right_tensor_name,right_dims,1);
  assert(right_tensor);
- std::vector<TensorLeg> left_legs(left_rank,TensorLeg(0,0));
- std::vector<TensorLeg> right_legs(right_rank,TensorLeg(0,0));
+ TensorLegVector left_legs(left_rank,TensorLeg(0,0));
+ TensorLegVector right_legs(right_rank,TensorLeg(0,0));
  for(unsigned int l = 0, r = 0, i = 0; i < tensor_rank; ++i){
   (right_dims[i] == 0) ? left_legs[l++] = tensor->getTensorLeg(i):
                          right_legs[r++] = tensor->getTensorLeg(i);
@@ -1649,6 +1683,61 @@ bool TensorNetwork::collapseIsometries()
 }
 
 
+double TensorNetwork::absorbLowRankTensors(std::list<ContrTriple> & contr_seq,
+                                           std::function<unsigned int ()> intermediate_num_generator,
+                                           unsigned int max_absorbed_rank)
+{
+ assert(finalized_ != 0); //tensor network must be in finalized state
+ double flops = 0.0;
+ //Candidate tensors to be absorbed, lower rank first:
+ std::set<std::pair<unsigned int, unsigned int>> candidates; //{tensor rank, tensor id}
+ for(auto iter = this->begin(); iter != this->end(); ++iter){
+  if(iter->first != 0){ //output tensor is not an input tensor
+   const auto tensor_rank = iter->second.getRank();
+   if(tensor_rank > 0 && tensor_rank <= max_absorbed_rank) candidates.emplace(std::make_pair(tensor_rank,iter->first));
+  }
+ }
+ //Absorb candidate tensors into their neighbors as long as the merged tensor is not larger:
+ while(!candidates.empty() && this->getNumTensors() > 2){ //the final tensor contraction is left to the optimizer
+  const auto tensor_id = candidates.begin()->second;
+  candidates.erase(candidates.begin());
+  const auto * tensor_conn = this->getTensorConn(tensor_id);
+  if(tensor_conn == nullptr) continue; //tensor has already been absorbed
+  const double tensor_volume = static_cast<double>(tensor_conn->getTensor()->getVolume());
+  unsigned int best_id = 0;
+  double best_volume = 0.0;
+  const auto neighbors = this->getAdjacentTensors(tensor_id);
+  for(const auto & neighbor_id: neighbors){
+   const double neighbor_volume = static_cast<double>(this->getTensorConn(neighbor_id)->getTensor()->getVolume());
+   double diff_volume = 0.0;
+   this->getContractionCost(neighbor_id,tensor_id,nullptr,&diff_volume);
+   const double merged_volume = diff_volume + neighbor_volume + tensor_volume;
+   if(merged_volume <= std::max(neighbor_volume,tensor_volume)){
+    if(best_id == 0 || merged_volume < best_volume){
+     best_id = neighbor_id;
+     best_volume = merged_volume;
+    }
+   }
+  }
+  if(best_id != 0){
+   const auto result_id = intermediate_num_generator();
+   flops += this->getContractionCost(best_id,tensor_id);
+   auto merged = this->mergeTensors(best_id,tensor_id,result_id); assert(merged);
+   contr_seq.emplace_back(ContrTriple{result_id,best_id,tensor_id});
+   //The merged tensor and its low-rank neighbors may now be absorbed further:
+   const auto result_rank = this->getTensorConn(result_id)->getRank();
+   if(result_rank > 0 && result_rank <= max_absorbed_rank) candidates.emplace(std::make_pair(result_rank,result_id));
+   const auto new_neighbors = this->getAdjacentTensors(result_id);
+   for(const auto & neighbor_id: new_neighbors){
+    const auto neighbor_rank = this->getTensorConn(neighbor_id)->getRank();
+    if(neighbor_rank <= max_absorbed_rank) candidates.emplace(std::make_pair(neighbor_rank,neighbor_id));
+   }
+  }
+ }
+ return flops;
+}
+
+
 bool TensorNetwork::decomposeTensors()
 {
  if(finalized_ == 0){
@@ -1785,6 +1874,69 @@ double TensorNetwork::getContractionCost(unsigned int left_id, unsigned int righ
 }
 
 
+double TensorNetwork::reorderContractionSequence()
+{
+ if(contraction_seq_.size() < 3) return 0.0; //nothing to reorder
+ //Determine the volumes of all intermediate tensors:
+ std::unordered_map<unsigned int,const ContrTriple*> producers; //tensor id --> tensor contraction producing it
+ std::unordered_map<unsigned int,std::size_t> positions; //tensor id --> position of its producing contraction in the sequence
+ std::unordered_map<unsigned int,double> volumes; //intermediate tensor id --> its volume
+ TensorNetwork net(*this);
+ for(const auto & contr: contraction_seq_){
+  positions.emplace(std::make_pair(contr.result_id,producers.size()));
+  producers.emplace(std::make_pair(contr.result_id,&contr));
+  if(contr.result_id != 0){
+   auto merged = net.mergeTensors(contr.left_id,contr.right_id,contr.result_id); assert(merged);
+   volumes.emplace(std::make_pair(contr.result_id,static_cast<double>(net.getTensor(contr.result_id)->getVolume())));
+  }
+ }
+ if(producers.find(0) == producers.end()) return 0.0; //the output tensor is not produced by a contraction
+ auto volume = [&volumes](unsigned int tensor_id){
+  auto iter = volumes.find(tensor_id);
+  return (iter != volumes.end()) ? iter->second : 0.0; //input tensors do not count
+ };
+ auto position = [&positions](unsigned int tensor_id){
+  auto iter = positions.find(tensor_id);
+  return (iter != positions.end()) ? iter->second : 0;
+ };
+ //Determine the peak volume of intermediates for each contraction subtree (bottom-up):
+ // Evaluating the left subtree first: max(Peak(left), Vol(left) + Peak(right), Vol(left) + Vol(right) + Vol(result)),
+ // evaluating the right subtree first: max(Peak(right), Vol(right) + Peak(left), Vol(left) + Vol(right) + Vol(result)).
+ std::unordered_map<unsigned int,std::pair<double,bool>> schedule; //tensor id --> {peak volume of its subtree, right subtree goes first}
+ std::function<double (unsigned int)> peak = [&](unsigned int tensor_id){
+  auto producer = producers.find(tensor_id);
+  if(producer == producers.end()) return 0.0; //input tensor
+  const auto & contr = *(producer->second);
+  const double left_peak = peak(contr.left_id);
+  const double right_peak = peak(contr.right_id);
+  const double contr_volume = volume(contr.left_id) + volume(contr.right_id) + volume(tensor_id);
+  const double left_first = std::max({left_peak,volume(contr.left_id) + right_peak,contr_volume});
+  const double right_first = std::max({right_peak,volume(contr.right_id) + left_peak,contr_volume});
+  const bool swap = (right_first < left_first) ||
+                    (right_first == left_first && position(contr.right_id) < position(contr.left_id)); //keep the original order on ties
+  schedule[tensor_id] = std::make_pair(std::min(left_first,right_first),swap);
+  return schedule[tensor_id].first;
+ };
+ const double max_presence_volume = peak(0);
+ //Generate the reordered contraction sequence (post-order traversal of the contraction tree):
+ std::list<ContrTriple> contr_seq;
+ std::function<void (unsigned int)> emit = [&](unsigned int tensor_id){
+  auto producer = producers.find(tensor_id);
+  if(producer == producers.end()) return; //input tensor
+  const auto & contr = *(producer->second);
+  if(schedule[tensor_id].second){
+   emit(contr.right_id); emit(contr.left_id);
+  }else{
+   emit(contr.left_id); emit(contr.right_id);
+  }
+  contr_seq.emplace_back(contr);
+ };
+ emit(0);
+ if(contr_seq.size() == contraction_seq_.size()) contraction_seq_ = std::move(contr_seq);
+ return max_presence_volume;
+}
+
+
 std::list<std::shared_ptr<TensorOperation>> & TensorNetwork::getOperationList(const std::string & contr_seq_opt_name,
                                                                               bool universal_indices)
 {
@@ -1794,6 +1946,8 @@ std::list<std::shared_ptr<TensorOperation>> & TensorNetwork::getOperationList(co
   max_intermediate_volume_ = 0.0;
   max_intermediate_rank_ = 0;
   double flops = determineContractionSequence();
+  //Order independent tensor contractions to minimize the peak volume of intermediates:
+  reorderContractionSequence();
   //Generate the list of operations (tensor contractions):
   std::size_t intermediates_vol = 0;
   auto & tensor_op_factory = *(TensorOpFactory::get());
@@ -1817,7 +1971,7 @@ std::list<std::shared_ptr<TensorOperation>> & TensorNetwork::getOperationList(co
      assert(tensor1_legs != nullptr);
      const auto * tensor2_legs = net.getTensorConnections(contr->right_id);
      assert(tensor2_legs != nullptr);
-     std::vector<TensorLeg> pattern(*tensor1_legs);
+     TensorLegVector pattern(*tensor1_legs);
      pattern.insert(pattern.end(),tensor2_legs->begin(),tensor2_legs->end());
      auto generated = generate_contraction_pattern(pattern,tensor1_legs->size(),tensor2_legs->size(),
                                                    contr_pattern,conj1,conj2);
@@ -1835,11 +1989,6 @@ std::list<std::shared_ptr<TensorOperation>> & TensorNetwork::getOperationList(co
       std::dynamic_pointer_cast<TensorOpCreate>(op_create)->resetTensorElementType(tensor0->getElementType());
      operations_.emplace_back(op_create);
      intermediates.emplace_back(contr->result_id);
-     std::shared_ptr<TensorOperation> op_init(std::move(tensor_op_factory.createTensorOp(TensorOpCode::TRANSFORM))); //init intermediate to zero
-     op_init->setTensorOperand(tensor0);
-     std::dynamic_pointer_cast<TensorOpTransform>(op_init)->
-          resetFunctor(std::shared_ptr<talsh::TensorFunctor<Identifiable>>(new FunctorInitVal(0.0)));
-     operations_.emplace_back(op_init);
     }else{ //make sure the output tensor has its type set
      if(tensor0->getElementType() == TensorElementType::VOID) tensor0->setElementType(tensor1->getElementType());
     }
@@ -1848,6 +1997,7 @@ std::list<std::shared_ptr<TensorOperation>> & TensorNetwork::getOperationList(co
     op->setTensorOperand(tensor1,conj1);
     op->setTensorOperand(tensor2,conj2);
     op->setIndexPattern(contr_pattern);
+    if(contr->result_id != 0) op->setScalar(1,std::complex<double>{0.0,0.0}); //intermediate tensor is overwritten (no zero initialization)
     assert(op->isSet());
     operations_.emplace_back(std::shared_ptr<TensorOperation>(std::move(op)));
     auto left_intermediate = std::find(intermediates.begin(),intermediates.end(),contr->left_id);
@@ -2261,6 +2411,60 @@ double TensorNetwork::getMaxIntermediateVolume(unsigned int * intermediate_rank)
 }
 
 
+double TensorNetwork::selectBatchTrunk(const std::vector<unsigned int> & boundary_ids,
+                                       double max_trunk_volume,
+                                       std::vector<unsigned int> & trunk_ids) const
+{
+ assert(finalized_ != 0); //tensor network must be in finalized state
+ std::set<unsigned int> trunk;
+ for(auto iter = this->cbegin(); iter != this->cend(); ++iter){
+  if(iter->first != 0 && std::find(boundary_ids.cbegin(),boundary_ids.cend(),iter->first) == boundary_ids.cend())
+   trunk.emplace(iter->first);
+ }
+ //Volumes of the legs of a trunk tensor connected inside/outside the trunk:
+ auto leg_volumes = [this,&trunk](unsigned int tensor_id, double & inside, double & outside){
+  inside = 1.0; outside = 1.0;
+  const auto & tensor = tensors_.at(tensor_id);
+  const auto num_legs = tensor.getNumLegs();
+  for(unsigned int i = 0; i < num_legs; ++i){
+   const double extent = static_cast<double>(tensor.getDimExtent(i));
+   if(trunk.find(tensor.getTensorLeg(i).getTensorId()) != trunk.end()){
+    inside *= extent;
+   }else{
+    outside *= extent;
+   }
+  }
+  return;
+ };
+ double trunk_volume = 1.0;
+ for(const auto & tensor_id: trunk){
+  double inside, outside;
+  leg_volumes(tensor_id,inside,outside);
+  trunk_volume *= outside;
+ }
+ //Greedily move tensors from the trunk to the branch until the trunk output fits:
+ while(trunk_volume > max_trunk_volume && trunk.size() > 1){
+  auto best_tensor = trunk.cend();
+  double best_volume = 0.0;
+  for(auto iter = trunk.cbegin(); iter != trunk.cend(); ++iter){
+   double inside, outside;
+   leg_volumes(*iter,inside,outside);
+   const double volume = trunk_volume / outside * inside;
+   if(best_tensor == trunk.cend() || volume < best_volume){
+    best_tensor = iter;
+    best_volume = volume;
+   }
+  }
+  trunk.erase(best_tensor);
+  trunk_volume = best_volume;
+ }
+ trunk_ids.clear();
+ if(trunk_volume > max_trunk_volume || trunk.size() < 2) return 0.0;
+ trunk_ids.assign(trunk.cbegin(),trunk.cend());
+ return trunk_volume;
+}
+
+
 bool TensorNetwork::printTensorNetwork(std::string & network)
 {
  network.clear();
@@ -1,5 +1,5 @@
 /** ExaTN::Numerics: Tensor network
-REVISION: 2020/10/22
+REVISION: 2020/12/07
 
 Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
@@ -47,6 +47,22 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
  (e) The modes of the output tensor of a tensor network can be examined and reordered.
  (f) Any tensor except the output tensor can be deleted from the tensor network.
  (g) Any two tensors, excluding the output tensor, can be merged by tensor contraction.
+ (h) The tensor operation list evaluating a tensor network creates each intermediate
+     tensor right before the tensor contraction producing it and destroys it right
+     after the tensor contraction consuming it (its last use). Independent tensor
+     contractions from the contraction sequence are reordered to minimize the max
+     cumulative volume of intermediate tensors present at a time, which is then
+     the actual peak volume of intermediates during the evaluation. The tensor
+     contraction producing an intermediate tensor overwrites it (beta = 0),
+     thus intermediate tensors do not need to be initialized to zero.
+ (i) Tensor connectivity is indexed explicitly: Each tensor leg stores the handle
+     of its partner leg (tensor id, dimension id), and tensors are indexed by their
+     ids in a hash map, thus appending, deleting, merging and splitting tensors
+     only touches the legs of the participating tensors and their neighbors. The
+     max tensor id is maintained in an incrementally updated max-heap of tensor ids,
+     which is pruned lazily when tensors are removed, instead of being recomputed
+     by scanning all tensors, thus building a tensor network and searching for
+     its tensor contraction sequence scale linearly with the number of tensors.
 **/
 
 #ifndef EXATN_NUMERICS_TENSOR_NETWORK_HPP_
@@ -64,6 +80,7 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
 #include <unordered_map>
 #include <map>
 #include <vector>
+#include <algorithm>
 #include <list>
 #include <tuple>
 #include <string>
@@ -167,7 +184,7 @@ public:
                                    bool * conjugated = nullptr) const;
 
  /** Returns tensor connections. **/
- const std::vector<TensorLeg> * getTensorConnections(unsigned int tensor_id) const;
+ const TensorLegVector * getTensorConnections(unsigned int tensor_id) const;
 
  /** Returns a list of the tensors adjacent to a given tensor by their Ids. **/
  std::list<unsigned int> getAdjacentTensors(unsigned int tensor_id) const;
@@ -300,6 +317,17 @@ public:
      of the output tensor it should be able to handle spectators (orphaned tensor legs). **/
  bool collapseIsometries();
 
+ /** Simplifies the tensor network by absorbing low-rank tensors (rank-1 qubit tensors,
+     single-qubit gates, two-qubit gates) into their neighbors, provided that the merged tensor
+     is not larger than the larger of the two. This also fuses chains of gates acting on the
+     same wires. The performed tensor contractions are appended to the provided contraction
+     sequence, with the intermediate tensor ids produced by the provided generator. At least
+     two input tensors are always left in the tensor network. Returns the FMA flop count
+     of the performed tensor contractions. **/
+ double absorbLowRankTensors(std::list<ContrTriple> & contr_seq,                          //inout: tensor contraction sequence
+                             std::function<unsigned int ()> intermediate_num_generator,   //in: intermediate tensor id generator
+                             unsigned int max_absorbed_rank = 4);                         //in: max rank of an absorbed tensor
+
  /** Decomposes all tensors in the tensor network to restrict the highest tensor order to 3. **/
  bool decomposeTensors();
 
@@ -337,7 +365,12 @@ public:
      The tensor network must contain at least two input tensors in order to generate a single contraction.
      No contraction sequence is generated for tensor networks consisting of a single input tensor.
      If the tensor network already has its contraction sequence determined, does nothing. Note that
-     the FMA flop count neither includes the FMA factor of 2.0 nor the factor of 4.0 for complex numbers.**/
+     the FMA flop count neither includes the FMA factor of 2.0 nor the factor of 4.0 for complex numbers.
+     The contraction sequence starts with the tensor contractions simplifying the tensor network
+     (see absorbLowRankTensors), followed by the ones determined by the optimizer, unless
+     the greedy contraction sequence for the original tensor network is cheaper. Note that
+     the simplification only reduces the size of the optimization problem: Each absorption
+     still becomes a separate pairwise tensor contraction when the tensor network is executed.**/
  double determineContractionSequence(const std::string & contr_seq_opt_name = "metis");
 
  /** Imports and caches an externally provided tensor contraction sequence. **/
@@ -393,6 +426,18 @@ public:
      the tensor network (if getOperationList has already been invoked). **/
  double getMaxIntermediateVolume(unsigned int * intermediate_rank = nullptr) const;
 
+ /** Selects the trunk of the tensor network for a batched evaluation in which the given
+     boundary input tensors are substituted: A subset of non-boundary input tensors whose
+     output tensor (all legs connecting the trunk to the rest of the tensor network, including
+     the output tensor) does not exceed the given volume. Starting from all non-boundary input
+     tensors, the trunk tensor whose removal results in the smallest trunk output volume is
+     greedily moved to the branch until the volume bound is satisfied. Returns the volume of
+     the trunk output tensor, or zero if no trunk of at least two tensors satisfies the bound
+     (trunk_ids is empty then). **/
+ double selectBatchTrunk(const std::vector<unsigned int> & boundary_ids, //in: ids of the boundary input tensors
+                         double max_trunk_volume,                        //in: max volume of the trunk output tensor
+                         std::vector<unsigned int> & trunk_ids) const;   //out: ids of the trunk input tensors
+
  /** Returns the entire tensor network printed in a symbolic form.
      The tensor network must already have its operation list generated. **/
  bool printTensorNetwork(std::string & network);
@@ -441,7 +486,7 @@ protected:
      This is used for updating the output tensor legs. **/
  void updateConnectionsFromInputTensors();
 
- /** Invalidate the cached max tensor id. **/
+ /** Invalidate the cached max tensor id (rebuilds the tensor id index). **/
  void invalidateMaxTensorId();
 
  /** Invalidates cached tensor contraction sequence. **/
@@ -471,6 +516,12 @@ private:
  void resetOutputTensor(const std::vector<unsigned int> & order, //in: new order of dimensions (N2O)
                         const std::string & name = ""); //in: new name of the output tensor (if empty, will be generated automatically)
 
+ /** Reorders independent tensor contractions in the tensor contraction sequence (a binary
+     contraction tree) such that the max cumulative volume of intermediate tensors present
+     at a time is minimized, given that each intermediate tensor is destroyed right after
+     its last use. Returns the minimized max cumulative volume of intermediates. **/
+ double reorderContractionSequence();
+
  /** Updates the max tensor id used in the tensor network when a tensor
      is either appended to or removed from the tensor network.  **/
  void updateMaxTensorIdOnAppend(unsigned int tensor_id);
@@ -483,7 +534,7 @@ private:
  std::unordered_map<unsigned int, TensorConn> tensors_; //tensors connected to each other via legs (tensor connections)
                                                         //map: Non-negative tensor id --> Connected tensor
  /** Data members: Tensor id management: **/
- unsigned int max_tensor_id_; //cached max tensor id used so far (0:undefined)
+ std::vector<unsigned int> tensor_id_heap_; //max-heap of tensor ids (may contain ids of removed tensors which are pruned lazily)
 
  /** Data members: Contraction sequence: **/
  double contraction_seq_flops_; //flop estimate for the determined tensor contraction sequence
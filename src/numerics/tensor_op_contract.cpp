@@ -1,5 +1,5 @@
 /** ExaTN::Numerics: Tensor operation: Contracts two tensors and accumulates the result into another tensor
-REVISION: 2020/08/11
+REVISION: 2020/12/12
 
 Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
@@ -45,6 +45,49 @@ double TensorOpContract::getFlopEstimate() const
  return 0.0;
 }
 
+void TensorOpContract::printIt() const
+{
+ std::cout << "TensorOperation(opcode=" << static_cast<int>(opcode_) << ")[id=" << id_ << "]{" << std::endl;
+ if(pattern_.length() > 0) std::cout << " " << pattern_ << std::endl;
+ for(const auto & operand: operands_){
+  const auto & tensor = std::get<0>(operand);
+  std::cout << " ";
+  tensor->printIt();
+  std::cout << std::endl;
+ }
+ for(const auto & scalar: scalars_){
+  std::cout << " " << scalar;
+ }
+ if(scalars_.size() > 0) std::cout << std::endl;
+ std::cout << " GFlop estimate = " << std::scientific << this->getFlopEstimate()/1e9 << std::endl;
+ std::cout << " GWord estimate = " << std::scientific << this->getWordEstimate()/1e9 << std::endl;
+ if(kernel_.length() > 0) std::cout << " Kernel = " << kernel_ << std::endl;
+ std::cout << "}" << std::endl << std::flush;
+ return;
+}
+
+void TensorOpContract::printItFile(std::ofstream & output_file) const
+{
+ output_file << "TensorOperation(opcode=" << static_cast<int>(opcode_) << ")[id=" << id_ << "]{" << std::endl;
+ if(pattern_.length() > 0) output_file << " " << pattern_ << std::endl;
+ for(const auto & operand: operands_){
+  const auto & tensor = std::get<0>(operand);
+  output_file << " ";
+  tensor->printItFile(output_file);
+  output_file << std::endl;
+ }
+ for(const auto & scalar: scalars_){
+  output_file << " " << scalar;
+ }
+ if(scalars_.size() > 0) output_file << std::endl;
+ output_file << " GFlop estimate = " << std::scientific << this->getFlopEstimate()/1e9 << std::endl;
+ output_file << " GWord estimate = " << std::scientific << this->getWordEstimate()/1e9 << std::endl;
+ if(kernel_.length() > 0) output_file << " Kernel = " << kernel_ << std::endl;
+ output_file << "}" << std::endl;
+ //output_file.flush();
+ return;
+}
+
 std::unique_ptr<TensorOperation> TensorOpContract::createNew()
 {
  return std::unique_ptr<TensorOperation>(new TensorOpContract());
@@ -1,5 +1,5 @@
 /** ExaTN::Numerics: Tensor operation: Contracts two tensors and accumulates the result into another tensor
-REVISION: 2020/06/06
+REVISION: 2020/12/14
 
 Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
@@ -8,6 +8,13 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
  (a) Contracts two tensors and accumulates the result into another tensor
      inside the processing backend:
      Operand 0 += Operand 1 * Operand 2 * prefactor
+ (b) Scalar 0 is the alpha prefactor, scalar 1 is the beta prefactor of the output
+     tensor: Beta = 1 (default) accumulates, beta = 0 overwrites the output tensor:
+     Operand 0 = Operand 1 * Operand 2 * prefactor
+     such that the output tensor does not need to be initialized to zero beforehand.
+     Other beta values are not supported by the tensor runtime.
+ (c) The node executor records the name of the tensor contraction kernel
+     it has executed the tensor contraction with (profiling output).
 **/
 
 #ifndef EXATN_NUMERICS_TENSOR_OP_CONTRACT_HPP_
@@ -16,6 +23,8 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
 #include "tensor_basic.hpp"
 #include "tensor_operation.hpp"
 
+#include <string>
+
 namespace exatn{
 
 namespace numerics{
@@ -45,11 +54,28 @@ public:
  /** Returns the flop estimate for the tensor operation. **/
  virtual double getFlopEstimate() const override;
 
+ /** Prints. **/
+ virtual void printIt() const override;
+ virtual void printItFile(std::ofstream & output_file) const override;
+
+ /** Records the name of the tensor contraction kernel used by the node executor. **/
+ inline void setKernel(const std::string & kernel_name){
+  kernel_ = kernel_name;
+ }
+
+ /** Returns the name of the tensor contraction kernel used by the node executor
+     (empty string if the tensor contraction has not been executed yet). **/
+ inline const std::string & getKernel() const{
+  return kernel_;
+ }
+
  /** Create a new polymorphic instance of this subclass. **/
  static std::unique_ptr<TensorOperation> createNew();
 
 private:
 
+ std::string kernel_; //name of the executed tensor contraction kernel
+
 };
 
 } //namespace numerics
@@ -0,0 +1,177 @@
+/** ExaTN::Numerics: Tensor operation: Batch of tensor contractions with an identical index pattern
+REVISION: 2020/12/14
+
+Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
+Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
+
+#include "exatn_service.hpp"
+
+#include "tensor_op_contract_batch.hpp"
+#include "tensor_op_contract.hpp"
+
+#include "tensor_node_executor.hpp"
+
+#include "tensor_symbol.hpp"
+
+#include <unordered_map>
+
+#include <cmath>
+
+namespace exatn{
+
+namespace numerics{
+
+/** Returns the index pattern of a tensor contraction with the tensors renamed to D, L, R
+    and the index labels renamed in the order of their first appearance. **/
+static std::string get_canonical_pattern(const std::string & pattern)
+{
+ std::string canonical;
+ std::vector<std::string> tensors;
+ if(parse_tensor_network(pattern,tensors)){
+  const std::string tensor_names[] = {"D","L","R"};
+  if(tensors.size() != 3) return canonical;
+  std::unordered_map<std::string,std::string> labels;
+  for(unsigned int i = 0; i < 3; ++i){
+   std::string tensor_name;
+   std::vector<IndexLabel> indices;
+   bool conj;
+   if(!parse_tensor(tensors[i],tensor_name,indices,conj)) return std::string();
+   for(auto & index: indices){
+    auto res = labels.emplace(std::make_pair(index.label,"i"+std::to_string(labels.size())));
+    index.label = res.first->second;
+   }
+   tensors[i] = assemble_symbolic_tensor(tensor_names[i],indices,conj);
+  }
+  canonical = assemble_symbolic_tensor_network(tensors);
+ }
+ return canonical;
+}
+
+
+TensorOpContractBatch::TensorOpContractBatch():
+ TensorOperation(TensorOpCode::CONTRACT_BATCH,0,0,0,{0,1,2}),
+ num_executed_(0)
+{
+}
+
+bool TensorOpContractBatch::isSet() const
+{
+ return (this->getNumOperands() > 0 &&
+         this->getNumOperandsSet() == this->getNumOperands() &&
+         this->getIndexPattern().length() > 0);
+}
+
+int TensorOpContractBatch::accept(runtime::TensorNodeExecutor & node_executor,
+                                  runtime::TensorOpExecHandle * exec_handle)
+{
+ return node_executor.execute(*this,exec_handle);
+}
+
+double TensorOpContractBatch::getFlopEstimate() const
+{
+ double flops = 0.0;
+ if(this->isSet()){
+  const auto batch_size = this->getBatchSize();
+  for(unsigned int i = 0; i < batch_size; ++i){
+   double vol0 = static_cast<double>(this->getTensorOperand(i*3+0)->getVolume());
+   double vol1 = static_cast<double>(this->getTensorOperand(i*3+1)->getVolume());
+   double vol2 = static_cast<double>(this->getTensorOperand(i*3+2)->getVolume());
+   flops += std::sqrt(vol0*vol1*vol2); //FMA flops (without FMA factor)
+  }
+ }
+ return flops;
+}
+
+bool TensorOpContractBatch::appendContraction(const TensorOperation & contraction)
+{
+ if(contraction.getOpcode() != TensorOpCode::CONTRACT || !(contraction.isSet())) return false;
+ if(num_executed_ > 0) return false; //batch is already being executed
+ const auto beta = contraction.getScalar(1);
+ if(beta != std::complex<double>{0.0,0.0} && beta != std::complex<double>{1.0,0.0}) return false;
+ const auto canonical_pattern = get_canonical_pattern(contraction.getIndexPattern());
+ if(canonical_pattern.length() == 0) return false;
+ if(operands_.size() > 0){ //check compatibility with the first member of the batch
+  if(canonical_pattern != canonical_pattern_) return false;
+  for(unsigned int i = 0; i < 3; ++i){
+   bool conj;
+   const auto & tensor = *(contraction.getTensorOperand(i,&conj));
+   const auto & batch_tensor = *(std::get<0>(operands_[i]));
+   if(conj != std::get<1>(operands_[i])) return false;
+   if(tensor.getElementType() != batch_tensor.getElementType()) return false;
+   if(!(tensor.getShape().isCongruentTo(batch_tensor.getShape()))) return false;
+  }
+ }
+ num_operands_ += 3;
+ for(unsigned int i = 0; i < 3; ++i){
+  bool conj, mut;
+  auto tensor = contraction.getTensorOperand(i,&conj,&mut);
+  this->setTensorOperand(tensor,conj,mut);
+ }
+ prefactors_.emplace_back(contraction.getScalar(0));
+ accumulative_.emplace_back(beta != std::complex<double>{0.0,0.0});
+ if(pattern_.length() == 0){
+  this->setIndexPattern(contraction.getIndexPattern());
+  canonical_pattern_ = canonical_pattern;
+ }
+ return true;
+}
+
+bool TensorOpContractBatch::referencesTensor(const Tensor & tensor) const
+{
+ const auto tensor_hash = tensor.getTensorHash();
+ for(const auto & operand: operands_){
+  if(std::get<0>(operand)->getTensorHash() == tensor_hash) return true;
+ }
+ return false;
+}
+
+unsigned int TensorOpContractBatch::getBatchSize() const
+{
+ return static_cast<unsigned int>(prefactors_.size());
+}
+
+std::complex<double> TensorOpContractBatch::getMemberPrefactor(unsigned int member) const
+{
+ assert(member < prefactors_.size());
+ return prefactors_[member];
+}
+
+bool TensorOpContractBatch::isMemberAccumulative(unsigned int member) const
+{
+ assert(member < accumulative_.size());
+ return accumulative_[member];
+}
+
+std::string TensorOpContractBatch::getMemberIndexPatternReduced() const
+{
+ assert(this->isSet());
+ TensorOpContract contraction; //all members of the batch have congruent tensor operands
+ for(unsigned int i = 0; i < 3; ++i){
+  bool conj;
+  auto tensor = this->getTensorOperand(i,&conj);
+  contraction.setTensorOperand(tensor,conj);
+ }
+ contraction.setIndexPattern(pattern_);
+ return contraction.getIndexPatternReduced();
+}
+
+unsigned int TensorOpContractBatch::getNumMembersExecuted() const
+{
+ return num_executed_;
+}
+
+void TensorOpContractBatch::registerMemberExecuted()
+{
+ assert(num_executed_ < prefactors_.size());
+ ++num_executed_;
+ return;
+}
+
+std::unique_ptr<TensorOperation> TensorOpContractBatch::createNew()
+{
+ return std::unique_ptr<TensorOperation>(new TensorOpContractBatch());
+}
+
+} //namespace numerics
+
+} //namespace exatn
@@ -0,0 +1,108 @@
+/** ExaTN::Numerics: Tensor operation: Batch of tensor contractions with an identical index pattern
+REVISION: 2020/12/14
+
+Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
+Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
+
+/** Rationale:
+ (a) Groups a number of tensor contractions sharing the same symbolic index pattern
+     and having congruent tensor operands into a single tensor operation
+     which is processed by the runtime as a single DAG node/task:
+     Operand 3*i+0 += Operand 3*i+1 * Operand 3*i+2 * prefactor(i), i = 0..N-1
+ (b) The tensor contractions constituting the batch (members) are executed in
+     the order they have been appended to the batch, thus members may depend
+     on each other. The number of already executed members is tracked inside
+     the tensor operation such that a deferred (TRY_LATER) execution resumes
+     from the first unexecuted member.
+ (c) Tensor contractions are compatible with the batch if their index patterns coincide
+     up to the names of the tensors and index labels (canonical index pattern),
+     for example, C1(i,j)+=A(i,k)*B(k,j) and C2(a,b)+=E(a,c)*F(c,b).
+     Each member keeps its own alpha and beta prefactors (beta = 0 overwrites
+     the output tensor, beta = 1 accumulates into it).
+**/
+
+#ifndef EXATN_NUMERICS_TENSOR_OP_CONTRACT_BATCH_HPP_
+#define EXATN_NUMERICS_TENSOR_OP_CONTRACT_BATCH_HPP_
+
+#include "tensor_basic.hpp"
+#include "tensor_operation.hpp"
+
+#include <vector>
+#include <string>
+#include <complex>
+
+namespace exatn{
+
+namespace numerics{
+
+class TensorOpContractBatch: public TensorOperation{
+public:
+
+ TensorOpContractBatch();
+
+ TensorOpContractBatch(const TensorOpContractBatch &) = default;
+ TensorOpContractBatch & operator=(const TensorOpContractBatch &) = default;
+ TensorOpContractBatch(TensorOpContractBatch &&) noexcept = default;
+ TensorOpContractBatch & operator=(TensorOpContractBatch &&) noexcept = default;
+ virtual ~TensorOpContractBatch() = default;
+
+ virtual std::unique_ptr<TensorOperation> clone() const override{
+  return std::unique_ptr<TensorOperation>(new TensorOpContractBatch(*this));
+ }
+
+ /** Returns TRUE iff the tensor operation is fully set. **/
+ virtual bool isSet() const override;
+
+ /** Accepts tensor node executor which will execute this tensor operation. **/
+ virtual int accept(runtime::TensorNodeExecutor & node_executor,
+                    runtime::TensorOpExecHandle * exec_handle) override;
+
+ /** Returns the flop estimate for the tensor operation. **/
+ virtual double getFlopEstimate() const override;
+
+ /** Appends a fully set tensor contraction (TensorOpContract) to the batch.
+     Returns FALSE if the tensor contraction is incompatible with the batch,
+     that is, its canonical index pattern, tensor operand shapes, element types
+     or complex conjugation flags differ from those of the batch, or if its
+     beta prefactor is neither 0 nor 1. **/
+ bool appendContraction(const TensorOperation & contraction); //in: tensor contraction
+
+ /** Returns TRUE if a given tensor is referenced by any member of the batch. **/
+ bool referencesTensor(const Tensor & tensor) const;
+
+ /** Returns the number of tensor contractions in the batch. **/
+ unsigned int getBatchSize() const;
+
+ /** Returns the prefactor of a specific tensor contraction from the batch. **/
+ std::complex<double> getMemberPrefactor(unsigned int member) const;
+
+ /** Returns TRUE if a specific tensor contraction from the batch accumulates
+     into its output tensor (beta = 1), FALSE if it overwrites it (beta = 0). **/
+ bool isMemberAccumulative(unsigned int member) const;
+
+ /** Returns the reduced symbolic index pattern shared by all tensor contractions
+     from the batch (see TensorOperation::getIndexPatternReduced). **/
+ std::string getMemberIndexPatternReduced() const;
+
+ /** Returns the number of tensor contractions from the batch executed so far. **/
+ unsigned int getNumMembersExecuted() const;
+
+ /** Registers the execution of the next tensor contraction from the batch. **/
+ void registerMemberExecuted();
+
+ /** Create a new polymorphic instance of this subclass. **/
+ static std::unique_ptr<TensorOperation> createNew();
+
+private:
+
+ std::vector<std::complex<double>> prefactors_; //prefactors of individual tensor contractions
+ std::vector<bool> accumulative_; //accumulative (beta = 1) or overwriting (beta = 0) individual tensor contractions
+ std::string canonical_pattern_; //canonical index pattern shared by all tensor contractions
+ unsigned int num_executed_; //number of tensor contractions already executed
+};
+
+} //namespace numerics
+
+} //namespace exatn
+
+#endif //EXATN_NUMERICS_TENSOR_OP_CONTRACT_BATCH_HPP_
@@ -1,5 +1,5 @@
 /** ExaTN::Numerics: Tensor operation factory
-REVISION: 2020/04/13
+REVISION: 2020/11/19
 
 Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
@@ -25,6 +25,7 @@ TensorOpFactory::TensorOpFactory()
  registerTensorOp(TensorOpCode::ORTHOGONALIZE_MGS,&TensorOpOrthogonalizeMGS::createNew);
  registerTensorOp(TensorOpCode::BROADCAST,&TensorOpBroadcast::createNew);
  registerTensorOp(TensorOpCode::ALLREDUCE,&TensorOpAllreduce::createNew);
+ registerTensorOp(TensorOpCode::CONTRACT_BATCH,&TensorOpContractBatch::createNew);
 }
 
 void TensorOpFactory::registerTensorOp(TensorOpCode opcode, createTensorOpFn creator)
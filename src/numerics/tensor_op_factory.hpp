@@ -1,5 +1,5 @@
 /** ExaTN::Numerics: Tensor operation factory
-REVISION: 2020/04/13
+REVISION: 2020/11/19
 
 Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
@@ -26,6 +26,7 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
 #include "tensor_op_orthogonalize_mgs.hpp"
 #include "tensor_op_broadcast.hpp"
 #include "tensor_op_allreduce.hpp"
+#include "tensor_op_contract_batch.hpp"
 
 #include <memory>
 #include <map>
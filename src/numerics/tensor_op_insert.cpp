@@ -1,5 +1,5 @@
 /** ExaTN::Numerics: Tensor operation: Inserts a slice into a tensor
-REVISION: 2020/06/25
+REVISION: 2020/12/02
 
 Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
@@ -15,8 +15,9 @@ namespace exatn{
 namespace numerics{
 
 TensorOpInsert::TensorOpInsert():
- TensorOperation(TensorOpCode::INSERT,2,0,1+0*2,{0,1})
+ TensorOperation(TensorOpCode::INSERT,2,1,1+0*2,{0,1})
 {
+ this->setScalar(0,std::complex<double>{0.0,0.0}); //default beta prefactor (overwrite)
 }
 
 bool TensorOpInsert::isSet() const
@@ -1,5 +1,5 @@
 /** ExaTN::Numerics: Tensor operation: Inserts a slice into a tensor
-REVISION: 2020/05/22
+REVISION: 2020/12/02
 
 Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
@@ -7,6 +7,9 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
 /** Rationale:
  (a) Inserts a slice into a tensor inside the processing backend:
      Operand 0 <= Operand 1 (slice)
+ (b) Scalar 0 is the beta prefactor of the overwritten tensor region:
+     Beta = 0 (default) overwrites, beta = 1 accumulates the slice:
+     Operand 0 += Operand 1 (slice)
 **/
 
 #ifndef EXATN_NUMERICS_TENSOR_OP_INSERT_HPP_
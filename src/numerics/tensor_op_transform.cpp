@@ -1,5 +1,5 @@
 /** ExaTN::Numerics: Tensor operation: Transforms/initializes a tensor
-REVISION: 2020/06/25
+REVISION: 2020/12/05
 
 Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
@@ -8,6 +8,8 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
 
 #include "tensor_op_transform.hpp"
 
+#include "functor_fused.hpp"
+
 #include "tensor_node_executor.hpp"
 
 namespace exatn{
@@ -36,6 +38,21 @@ std::unique_ptr<TensorOperation> TensorOpTransform::createNew()
  return std::unique_ptr<TensorOperation>(new TensorOpTransform());
 }
 
+std::unique_ptr<TensorOperation> TensorOpTransform::fuse(const TensorOpTransform & next) const
+{
+ if(!(this->isSet() && next.isSet())) return std::unique_ptr<TensorOperation>(nullptr);
+ if(this->getTensorOperandHash(0) != next.getTensorOperandHash(0)) return std::unique_ptr<TensorOperation>(nullptr);
+ if(!(functor_ && next.functor_)) return std::unique_ptr<TensorOperation>(nullptr);
+ if(!(FunctorFused::isFusable(*functor_) && FunctorFused::isFusable(*(next.functor_))))
+  return std::unique_ptr<TensorOperation>(nullptr);
+ auto fused_functor = std::make_shared<FunctorFused>();
+ bool fused = fused_functor->append(functor_); assert(fused);
+ fused = fused_functor->append(next.functor_); assert(fused);
+ auto fused_op = this->clone();
+ static_cast<TensorOpTransform*>(fused_op.get())->resetFunctor(fused_functor);
+ return fused_op;
+}
+
 } //namespace numerics
 
 } //namespace exatn
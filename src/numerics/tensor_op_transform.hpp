@@ -1,5 +1,5 @@
 /** ExaTN::Numerics: Tensor operation: Transforms/initializes a tensor
-REVISION: 2020/05/22
+REVISION: 2020/12/05
 
 Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
@@ -8,6 +8,12 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
  (a) Transforms/initializes a tensor inside the processing backend.
      Requires a user-provided talsh::TensorFunctor object to concretize
      the transformation/initilization operation.
+ (b) The tensor functor is applied asynchronously by a Host worker thread.
+     Its concurrency kind (see tensor_method_concurrency.hpp) determines
+     whether it can share Host with other concurrently applied tensor functors.
+ (c) Two consecutive tensor transformations of the same tensor with fusable
+     tensor functors (see functor_fused.hpp) can be fused into a single
+     tensor transformation performing a single pass over the tensor body.
 **/
 
 #ifndef EXATN_NUMERICS_TENSOR_OP_TRANSFORM_HPP_
@@ -19,6 +25,7 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
 #include "tensor_operation.hpp"
 
 #include "tensor_method.hpp"
+#include "tensor_method_concurrency.hpp"
 
 namespace exatn{
 
@@ -59,6 +66,24 @@ public:
   return 0;
  }
 
+ /** Returns the tensor functor (method). **/
+ std::shared_ptr<talsh::TensorFunctor<Identifiable>> getFunctor() const{
+  return functor_;
+ }
+
+ /** Returns the concurrency kind of the tensor functor (THREAD_PARALLEL if not declared). **/
+ TensorMethodConcurrency getFunctorConcurrency() const{
+  const auto * trait = dynamic_cast<const TensorMethodConcurrencyTrait*>(functor_.get());
+  if(trait != nullptr) return trait->getConcurrency();
+  return TensorMethodConcurrency::THREAD_PARALLEL;
+ }
+
+ /** Returns a new tensor transformation which applies the tensor functor of this
+     tensor transformation followed by the tensor functor of the next tensor
+     transformation of the same tensor in a single pass, or nullptr if fusion
+     is impossible. Neither of the two tensor transformations is modified. **/
+ std::unique_ptr<TensorOperation> fuse(const TensorOpTransform & next) const;
+
 private:
 
  std::shared_ptr<talsh::TensorFunctor<Identifiable>> functor_; //tensor functor (method)
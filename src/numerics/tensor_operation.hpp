@@ -1,5 +1,5 @@
 /** ExaTN::Numerics: Tensor operation
-REVISION: 2020/09/29
+REVISION: 2020/12/06
 
 Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
@@ -8,6 +8,8 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
  (a) A tensor operation is a formal numerical operation on one or more tensors.
  (b) A tensor operation may have mutable (output) and immutable (input) tensor operands.
      The mutable tensor operands must always precede immutable tensor operands!
+ (c) Tensor operands and scalars are stored inline for the typical number
+     of them (no heap allocation), thus cloning a tensor operation is cheap.
 **/
 
 #ifndef EXATN_NUMERICS_TENSOR_OPERATION_HPP_
@@ -15,6 +17,7 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
 
 #include "tensor_basic.hpp"
 #include "tensor.hpp"
+#include "small_vector.hpp"
 #include "timers.hpp"
 
 #include <initializer_list>
@@ -182,19 +185,20 @@ public:
   return timer_.getFinishTime();
  }
 
-private:
+protected:
 
  /** Sets the next tensor operand with its mutability status. **/
  void setTensorOperand(std::shared_ptr<Tensor> tensor, //in: tensor
                        bool conjugated,                //in: complex conjugation status
                        bool mutated);                  //in: mutability status
 
-protected:
+ static constexpr std::size_t INLINE_OPERANDS = 4; //number of tensor operands (and symbolic positions) stored inline
+ static constexpr std::size_t INLINE_SCALARS = 2;  //number of scalars stored inline
 
  std::string pattern_; //symbolic index pattern
- const std::vector<int> symb_pos_; //symb_pos_[operand_position] --> operand position in the symbolic index pattern;
- std::vector<std::tuple<std::shared_ptr<Tensor>,bool,bool>> operands_; //tensor operands <operand,conjugation,mutation>
- std::vector<std::complex<double>> scalars_; //additional scalars (prefactors)
+ const SmallVector<int,INLINE_OPERANDS> symb_pos_; //symb_pos_[operand_position] --> operand position in the symbolic index pattern;
+ SmallVector<std::tuple<std::shared_ptr<Tensor>,bool,bool>,INLINE_OPERANDS> operands_; //tensor operands <operand,conjugation,mutation>
+ SmallVector<std::complex<double>,INLINE_SCALARS> scalars_; //additional scalars (prefactors)
  unsigned int num_operands_; //number of required tensor operands
  unsigned int num_scalars_; //number of required scalar arguments
  std::size_t mutation_; //default operand mutability bits: Bit X --> Operand #X
@@ -1,5 +1,5 @@
 /** ExaTN::Numerics: Tensor shape
-REVISION: 2020/06/25
+REVISION: 2020/12/06
 
 Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
@@ -89,7 +89,7 @@ DimExtent TensorShape::getDimExtent(unsigned int dim_id) const
  return extents_[dim_id];
 }
 
-const std::vector<DimExtent> & TensorShape::getDimExtents() const
+const DimExtentVector & TensorShape::getDimExtents() const
 {
  return extents_;
 }
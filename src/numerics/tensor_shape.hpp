@@ -1,5 +1,5 @@
 /** ExaTN::Numerics: Tensor shape
-REVISION: 2020/06/25
+REVISION: 2020/12/06
 
 Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
@@ -7,6 +7,8 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
 /** Rationale:
  (a) Tensor shape is an ordered set of tensor dimension extents.
      A scalar tensor (rank-0 tensor) has an empty shape.
+ (b) Tensor dimension extents are stored inline for tensor ranks
+     up to INLINE_TENSOR_RANK (no heap allocation).
 **/
 
 #ifndef EXATN_NUMERICS_TENSOR_SHAPE_HPP_
@@ -14,6 +16,7 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
 
 #include "tensor_basic.hpp"
 #include "packable.hpp"
+#include "small_vector.hpp"
 
 #include <iostream>
 #include <fstream>
@@ -27,6 +30,8 @@ namespace exatn{
 
 namespace numerics{
 
+using DimExtentVector = SmallVector<DimExtent,INLINE_TENSOR_RANK>;
+
 class TensorShape: public Packable {
 public:
 
@@ -66,7 +71,7 @@ public:
  DimExtent getDimExtent(unsigned int dim_id) const;
 
  /** Get the extents of all tensor dimensions. **/
- const std::vector<DimExtent> & getDimExtents() const;
+ const DimExtentVector & getDimExtents() const;
 
  /** Get the strides for all tensor dimensions.
      Column-major storage layout is assumed. **/
@@ -86,7 +91,7 @@ public:
 
 private:
 
- std::vector<DimExtent> extents_; //tensor dimension extents
+ DimExtentVector extents_; //tensor dimension extents
 };
 
 
@@ -1,5 +1,5 @@
 /** ExaTN::Numerics: Tensor signature
-REVISION: 2020/06/25
+REVISION: 2020/12/06
 
 Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
@@ -109,7 +109,7 @@ std::pair<SpaceId,SubspaceId> TensorSignature::getDimSpaceAttr(unsigned int dim_
  return subspaces_[dim_id];
 }
 
-const std::vector<std::pair<SpaceId,SubspaceId>> & TensorSignature::getDimSpaceAttrs() const
+const DimSpaceAttrVector & TensorSignature::getDimSpaceAttrs() const
 {
  return subspaces_;
 }
@@ -1,5 +1,5 @@
 /** ExaTN::Numerics: Tensor signature
-REVISION: 2020/06/25
+REVISION: 2020/12/06
 
 Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
@@ -13,6 +13,8 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
  (c) Anonymous signature: Tensor dimension specifier consists of
      the Space Id = SOME_SPACE, while the Subspace Id specifies
      the offset (first basis vector) in SOME_SPACE.
+ (d) Tensor dimension specifiers are stored inline for tensor ranks
+     up to INLINE_TENSOR_RANK (no heap allocation).
 **/
 
 #ifndef EXATN_NUMERICS_TENSOR_SIGNATURE_HPP_
@@ -21,6 +23,7 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
 #include "tensor_basic.hpp"
 #include "packable.hpp"
 #include "spaces.hpp"
+#include "small_vector.hpp"
 
 #include <utility>
 #include <initializer_list>
@@ -35,6 +38,8 @@ namespace exatn{
 
 namespace numerics{
 
+using DimSpaceAttrVector = SmallVector<std::pair<SpaceId,SubspaceId>,INLINE_TENSOR_RANK>;
+
 class TensorSignature: public Packable {
 public:
 
@@ -76,7 +81,7 @@ public:
  std::pair<SpaceId,SubspaceId> getDimSpaceAttr(unsigned int dim_id) const;
 
  /** Get the attributes of all tensor dimensions. **/
- const std::vector<std::pair<SpaceId,SubspaceId>> & getDimSpaceAttrs() const;
+ const DimSpaceAttrVector & getDimSpaceAttrs() const;
 
  /** Returns TRUE if the tensor signature coincides with another tensor signature. **/
  bool isCongruentTo(const TensorSignature & another) const;
@@ -92,7 +97,7 @@ public:
 
 private:
 
- std::vector<std::pair<SpaceId,SubspaceId>> subspaces_; //tensor signature
+ DimSpaceAttrVector subspaces_; //tensor signature
 };
 
 } //namespace numerics
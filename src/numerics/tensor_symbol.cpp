@@ -1,5 +1,5 @@
 /** ExaTN: Numerics: Symbolic tensor processing
-REVISION: 2020/06/25
+REVISION: 2020/12/06
 
 Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
@@ -164,7 +164,7 @@ std::string assemble_symbolic_tensor_network(const std::vector<std::string> & te
 }
 
 
-bool generate_contraction_pattern(const std::vector<numerics::TensorLeg> & pattern,
+bool generate_contraction_pattern(const numerics::TensorLegVector & pattern,
                                   unsigned int left_tensor_rank,
                                   unsigned int right_tensor_rank,
                                   std::string & symb_pattern,
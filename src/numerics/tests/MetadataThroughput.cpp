@@ -0,0 +1,47 @@
+#include "exatn.hpp"
+
+#include <iostream>
+#include <chrono>
+
+#include "errors.hpp"
+
+using namespace exatn;
+using namespace exatn::numerics;
+
+int main(int argc, char ** argv)
+{
+ //Z(e,f) = A(a,b) * B(b,c) * C(a,c,g) * D(g,h,e) * E(h,f)
+ TensorNetwork network("Metadata",
+                       "Z(e,f) = A(a,b) * B(b,c) * C(a,c,g) * D(g,h,e) * E(h,f)",
+                       std::map<std::string,std::shared_ptr<Tensor>>{
+                        {"Z",std::make_shared<Tensor>("Z",TensorShape{16,16})},
+                        {"A",std::make_shared<Tensor>("A",TensorShape{32,2})},
+                        {"B",std::make_shared<Tensor>("B",TensorShape{2,32})},
+                        {"C",std::make_shared<Tensor>("C",TensorShape{32,32,2})},
+                        {"D",std::make_shared<Tensor>("D",TensorShape{2,16,16})},
+                        {"E",std::make_shared<Tensor>("E",TensorShape{16,16})}
+                       }
+                      );
+ const unsigned int num_repeats = 10000;
+ //Tensor network copy throughput:
+ auto time_start = std::chrono::high_resolution_clock::now();
+ for(unsigned int i = 0; i < num_repeats; ++i){
+  TensorNetwork network_copy(network);
+  assert(network_copy.getNumTensors() == network.getNumTensors());
+ }
+ auto time_end = std::chrono::high_resolution_clock::now();
+ double duration = std::chrono::duration_cast<std::chrono::duration<double>>(time_end - time_start).count();
+ std::cout << "Tensor network copy throughput (copies/s): " << static_cast<double>(num_repeats) / duration << std::endl;
+ //Tensor merging throughput:
+ time_start = std::chrono::high_resolution_clock::now();
+ for(unsigned int i = 0; i < num_repeats; ++i){
+  TensorNetwork network_copy(network);
+  std::string contr_pattern;
+  auto merged = network_copy.mergeTensors(1,2,6,&contr_pattern);
+  assert(merged && network_copy.getTensor(6)->getRank() == 2);
+ }
+ time_end = std::chrono::high_resolution_clock::now();
+ duration = std::chrono::duration_cast<std::chrono::duration<double>>(time_end - time_start).count();
+ std::cout << "Tensor network copy+merge throughput (merges/s): " << static_cast<double>(num_repeats) / duration << std::endl;
+ return 0;
+}
@@ -1,8 +1,11 @@
 #include <gtest/gtest.h>
 #include "exatn.hpp"
+#include "contraction_seq_optimizer_factory.hpp"
 
 #include <iostream>
 #include <utility>
+#include <set>
+#include <chrono>
 
 #include "errors.hpp"
 
@@ -195,6 +198,354 @@ TEST(NumericsTester, checkTensorExpansion)
 }
 
 
+TEST(NumericsTester, checkTensorNetworkSimplification)
+{
+ //Quantum circuit: Qubits, Hadamard gates, pairs of CNOT gates on the same wires:
+ const unsigned int num_qubits = 4;
+ auto qubit = std::make_shared<Tensor>("Q",TensorShape{2});
+ auto hadamard = std::make_shared<Tensor>("H",TensorShape{2,2});
+ auto cnot = std::make_shared<Tensor>("CNOT",TensorShape{2,2,2,2});
+ TensorNetwork circuit("QuantumCircuit");
+ unsigned int tensor_id = 0;
+ for(unsigned int i = 0; i < num_qubits; ++i){
+  bool appended = circuit.appendTensor(++tensor_id,qubit,{}); assert(appended);
+ }
+ for(unsigned int i = 0; i < num_qubits; ++i){
+  bool appended = circuit.appendTensorGate(++tensor_id,hadamard,{i}); assert(appended);
+ }
+ for(unsigned int i = 0; i < (num_qubits - 1); ++i){
+  bool appended = circuit.appendTensorGate(++tensor_id,cnot,{i,i+1}); assert(appended);
+  appended = circuit.appendTensorGate(++tensor_id,cnot,{i,i+1}); assert(appended);
+ }
+ bool finalized = circuit.finalize(true); assert(finalized);
+ //Simplification absorbs all but two tensors:
+ TensorNetwork simplified(circuit);
+ std::list<ContrTriple> contr_seq;
+ unsigned int intermediate_id = simplified.getMaxTensorId();
+ double flops = simplified.absorbLowRankTensors(contr_seq,[&intermediate_id](){return ++intermediate_id;});
+ assert(simplified.getNumTensors() == 2);
+ assert(contr_seq.size() == (circuit.getNumTensors() - 2));
+ assert(flops > 0.0);
+ //The full contraction sequence starts with the simplifying contractions:
+ flops = circuit.determineContractionSequence("greed");
+ const auto & full_seq = circuit.exportContractionSequence();
+ assert(full_seq.size() == (circuit.getNumTensors() - 1));
+ assert(full_seq.back().result_id == 0);
+ auto & operations = circuit.getOperationList("greed");
+ assert(!operations.empty());
+}
+
+TEST(NumericsTester, checkBatchTrunkSelection)
+{
+ //Quantum circuit amplitudes: Qubits, Hadamard and CNOT gates, output projectors as boundary tensors:
+ const unsigned int num_qubits = 8;
+ const unsigned int num_layers = 4;
+ auto qubit = std::make_shared<Tensor>("Q",TensorShape{2});
+ auto hadamard = std::make_shared<Tensor>("H",TensorShape{2,2});
+ auto cnot = std::make_shared<Tensor>("CNOT",TensorShape{2,2,2,2});
+ TensorNetwork circuit("QuantumCircuit");
+ unsigned int tensor_id = 0;
+ for(unsigned int i = 0; i < num_qubits; ++i){
+  bool appended = circuit.appendTensor(++tensor_id,qubit,{}); assert(appended);
+ }
+ for(unsigned int i = 0; i < num_qubits; ++i){
+  bool appended = circuit.appendTensorGate(++tensor_id,hadamard,{i}); assert(appended);
+ }
+ for(unsigned int layer = 0; layer < num_layers; ++layer){
+  for(unsigned int i = (layer % 2); (i + 1) < num_qubits; i += 2){
+   bool appended = circuit.appendTensorGate(++tensor_id,cnot,{i,i+1}); assert(appended);
+  }
+  for(unsigned int i = 0; i < num_qubits; ++i){
+   bool appended = circuit.appendTensorGate(++tensor_id,hadamard,{i}); assert(appended);
+  }
+ }
+ std::vector<unsigned int> boundary_ids;
+ for(unsigned int i = 0; i < num_qubits; ++i){
+  bool appended = circuit.appendTensor(++tensor_id,qubit,{{0,0}}); assert(appended);
+  boundary_ids.emplace_back(tensor_id);
+ }
+ bool finalized = circuit.finalize(true); assert(finalized);
+ const auto num_trunk_tensors = circuit.getNumTensors() - num_qubits;
+ //Without a volume bound, the trunk is the whole circuit with the entire state vector as its output:
+ std::vector<unsigned int> trunk_ids;
+ double trunk_volume = circuit.selectBatchTrunk(boundary_ids,1e9,trunk_ids);
+ assert(trunk_ids.size() == num_trunk_tensors && trunk_volume == 256.0);
+ //With a volume bound, part of the circuit is moved to the branch, but a trunk is still shared:
+ trunk_volume = circuit.selectBatchTrunk(boundary_ids,16.0,trunk_ids);
+ std::cout << "Trunk tensors: " << trunk_ids.size() << " out of " << num_trunk_tensors
+           << " with output volume " << trunk_volume << std::endl;
+ assert(trunk_ids.size() >= 2 && trunk_ids.size() < num_trunk_tensors);
+ assert(trunk_volume > 0.0 && trunk_volume <= 16.0);
+ //No trunk satisfies a unit volume bound:
+ trunk_volume = circuit.selectBatchTrunk(boundary_ids,1.0,trunk_ids);
+ assert(trunk_ids.empty() && trunk_volume == 0.0);
+}
+
+
+TEST(NumericsTester, checkSimplificationCost)
+{
+ //Quantum circuit: Qubits, layers of Hadamard gates interleaved with layers of CNOT gates:
+ const unsigned int num_qubits = 8;
+ const unsigned int num_layers = 6;
+ auto qubit = std::make_shared<Tensor>("Q",TensorShape{2});
+ auto hadamard = std::make_shared<Tensor>("H",TensorShape{2,2});
+ auto cnot = std::make_shared<Tensor>("CNOT",TensorShape{2,2,2,2});
+ TensorNetwork circuit("QuantumCircuit");
+ unsigned int tensor_id = 0;
+ for(unsigned int i = 0; i < num_qubits; ++i){
+  bool appended = circuit.appendTensor(++tensor_id,qubit,{}); assert(appended);
+ }
+ for(unsigned int i = 0; i < num_qubits; ++i){
+  bool appended = circuit.appendTensorGate(++tensor_id,hadamard,{i}); assert(appended);
+ }
+ for(unsigned int layer = 0; layer < num_layers; ++layer){
+  for(unsigned int i = (layer % 2); (i + 1) < num_qubits; i += 2){
+   bool appended = circuit.appendTensorGate(++tensor_id,cnot,{i,i+1}); assert(appended);
+  }
+  for(unsigned int i = 0; i < num_qubits; ++i){
+   bool appended = circuit.appendTensorGate(++tensor_id,hadamard,{i}); assert(appended);
+  }
+ }
+ bool finalized = circuit.finalize(true); assert(finalized);
+ //Greedy contraction sequence without the simplification:
+ TensorNetwork original(circuit);
+ auto greedy_optimizer = ContractionSeqOptimizerFactory::get()->createContractionSeqOptimizer("greed");
+ unsigned int intermediate_id = original.getMaxTensorId();
+ std::list<ContrTriple> original_seq;
+ double original_flops = greedy_optimizer->determineContractionSequence(original,original_seq,
+                          [&intermediate_id](){return ++intermediate_id;});
+ original.importContractionSequence(original_seq,original_flops);
+ //The simplification reduces the number of tensors seen by the optimizer:
+ TensorNetwork simplified(circuit);
+ std::list<ContrTriple> contr_seq;
+ intermediate_id = simplified.getMaxTensorId();
+ simplified.absorbLowRankTensors(contr_seq,[&intermediate_id](){return ++intermediate_id;});
+ std::cout << "Tensors seen by the optimizer: " << circuit.getNumTensors()
+           << " -> " << simplified.getNumTensors() << std::endl;
+ assert(simplified.getNumTensors() < circuit.getNumTensors());
+ //Greedy contraction sequence with the simplification is never more expensive:
+ double flops = circuit.determineContractionSequence("greed");
+ std::cout << "FMA flops without/with simplification: " << original_flops << " / " << flops << std::endl;
+ assert(flops <= original_flops);
+ //Intermediate tensors are unique in the full contraction sequence:
+ const auto & full_seq = circuit.exportContractionSequence();
+ std::set<unsigned int> intermediates;
+ for(const auto & triple: full_seq){
+  if(triple.result_id != 0){
+   bool unique = intermediates.emplace(triple.result_id).second; assert(unique);
+  }
+ }
+ //The number of pairwise tensor contractions executed at runtime does not change:
+ assert(full_seq.size() == original_seq.size());
+ auto & operations = circuit.getOperationList("greed");
+ auto & original_operations = original.getOperationList("greed");
+ std::cout << "Runtime operations without/with simplification: " << original_operations.size()
+           << " / " << operations.size() << std::endl;
+ assert(operations.size() == original_operations.size());
+}
+
+
+TEST(NumericsTester, checkIntermediatePresence)
+{
+ //Z(e,f) = A(a,b) * B(b,c) * C(a,c,g) * D(g,h,e) * E(h,f)
+ // 0       1         2         3          4          5   <-- tensor id
+ TensorNetwork network("Presence",
+                       "Z(e,f) = A(a,b) * B(b,c) * C(a,c,g) * D(g,h,e) * E(h,f)",
+                       std::map<std::string,std::shared_ptr<Tensor>>{
+                        {"Z",std::make_shared<Tensor>("Z",TensorShape{16,16})},
+                        {"A",std::make_shared<Tensor>("A",TensorShape{32,2})},
+                        {"B",std::make_shared<Tensor>("B",TensorShape{2,32})},
+                        {"C",std::make_shared<Tensor>("C",TensorShape{32,32,2})},
+                        {"D",std::make_shared<Tensor>("D",TensorShape{2,16,16})},
+                        {"E",std::make_shared<Tensor>("E",TensorShape{16,16})}
+                       }
+                      );
+ //Contraction sequence computing the large intermediate X6(a,c) while X8(g,e,f) is alive:
+ // X8(g,e,f) = D*E; X6(a,c) = A*B; X7(g) = X6*C; Z = X7*X8
+ network.importContractionSequence(std::list<ContrTriple>{{8,4,5},{6,1,2},{7,6,3},{0,7,8}});
+ const auto & operations = network.getOperationList();
+ //Independent contractions are reordered such that X8 is only computed after X6 has been destroyed:
+ assert(network.exportContractionSequence().front().result_id == 6);
+ assert(network.getMaxIntermediatePresenceVolume() == 1024.0 + 2.0);
+ //Each intermediate is created right before its producing contraction and destroyed right after its last use:
+ unsigned int num_created = 0, num_destroyed = 0;
+ for(const auto & op: operations){
+  if(op->getOpcode() == TensorOpCode::CREATE) ++num_created;
+  if(op->getOpcode() == TensorOpCode::DESTROY) ++num_destroyed;
+  //Intermediates are overwritten by their producing contractions instead of being initialized to zero:
+  assert(op->getOpcode() != TensorOpCode::TRANSFORM);
+  if(op->getOpcode() == TensorOpCode::CONTRACT){
+   const bool output = (op->getTensorOperand(0) == network.getTensor(0));
+   assert(op->getScalar(1) == (output ? std::complex<double>{1.0,0.0} : std::complex<double>{0.0,0.0}));
+  }
+ }
+ assert(num_created == 3 && num_destroyed == 3);
+}
+
+
+TEST(NumericsTester, checkHalfPrecision)
+{
+ //Exactly representable values:
+ const std::vector<float> exact{0.0f,1.0f,-2.5f,0.15625f,1024.0f,-49152.0f};
+ for(const auto & val: exact){
+  assert(Float16::fromFloat(val).toFloat() == val);
+  assert(BFloat16::fromFloat(val).toFloat() == val);
+ }
+ //Special values and rounding:
+ assert(Float16::fromFloat(1.0f).bits == 0x3C00);
+ assert(BFloat16::fromFloat(1.0f).bits == 0x3F80);
+ assert(Float16::fromFloat(70000.0f).bits == 0x7C00); //overflow to infinity
+ assert(Float16::fromFloat(5.9604645e-8f).bits == 0x0001); //smallest subnormal
+ assert(Float16::fromFloat(1.0f + 1.0f/2048.0f).bits == 0x3C00); //tie rounds to even
+ assert(Float16::fromFloat(1.0f + 3.0f/2048.0f).bits == 0x3C02); //tie rounds to even
+ //Bulk conversion:
+ std::vector<float> values(100);
+ for(std::size_t i = 0; i < values.size(); ++i) values[i] = 0.01f * static_cast<float>(i) - 0.5f;
+ std::vector<Float16> packed(values.size());
+ std::vector<BFloat16> packed_bf(values.size());
+ std::vector<float> unpacked(values.size());
+ convertFloatToFloat16(values.data(),packed.data(),values.size());
+ convertFloat16ToFloat(packed.data(),unpacked.data(),values.size());
+ for(std::size_t i = 0; i < values.size(); ++i) assert(std::abs(unpacked[i] - values[i]) <= 1e-3f);
+ convertFloatToBFloat16(values.data(),packed_bf.data(),values.size());
+ convertBFloat16ToFloat(packed_bf.data(),unpacked.data(),values.size());
+ for(std::size_t i = 0; i < values.size(); ++i) assert(std::abs(unpacked[i] - values[i]) <= 4e-3f);
+}
+
+
+TEST(NumericsTester, checkBlockSparseTensor)
+{
+ //U(1)-symmetric vector spaces:
+ VectorSpace bond(6,"bond",{{0,1,-1},{2,3,0},{4,5,1}});
+ VectorSpace phys(2,"phys",{{0,0,0},{1,1,1}});
+ //Symmetry-conserving matrix has only diagonal blocks:
+ BlockSparseTensor matrix("A",{&bond,&bond},{LegDirection::OUTWARD,LegDirection::INWARD});
+ assert(matrix.getNumBlocks() == 3);
+ assert(matrix.getVolume() == 12 && matrix.getDenseVolume() == 36);
+ assert(matrix.getBlock({1,1}) && !matrix.getBlock({0,1}));
+ assert(matrix.getBlock({2,2})->getDimExtent(0) == 2);
+ assert(matrix.getBlock({2,2})->getDimSubspaceId(0) == 4);
+ //MPS tensor: q(a) + q(s) - q(b) = 0:
+ BlockSparseTensor mps("T",{&bond,&phys,&bond},{LegDirection::OUTWARD,LegDirection::OUTWARD,LegDirection::INWARD});
+ assert(mps.getNumBlocks() == 5);
+ assert(mps.blockIsAllowed({0,1,1}) && !mps.blockIsAllowed({0,1,0}));
+ //Z(2) symmetry:
+ BlockSparseTensor z2("Z",{&bond,&bond},{LegDirection::OUTWARD,LegDirection::OUTWARD},0,2);
+ assert(z2.getNumBlocks() == 5);
+ //Compatible block combinations of D(a,s,b) += A(a,c) * T(c,s,b):
+ BlockSparseTensor result("D",{&bond,&phys,&bond},{LegDirection::OUTWARD,LegDirection::OUTWARD,LegDirection::INWARD});
+ std::vector<std::vector<std::size_t>> matches;
+ bool matched = BlockSparseTensor::matchBlocks(result,{"a","s","b"},matrix,{"a","c"},&mps,{"c","s","b"},matches);
+ assert(matched && matches.size() == 5);
+ for(const auto & match: matches){
+  const auto & out = result.getBlocks()[match[0]].subranges;
+  const auto & left = matrix.getBlocks()[match[1]].subranges;
+  const auto & right = mps.getBlocks()[match[2]].subranges;
+  assert(out[0] == left[0] && left[1] == right[0] && out[1] == right[1] && out[2] == right[2]);
+ }
+ //Incongruent symmetry subranges:
+ matched = BlockSparseTensor::matchBlocks(result,{"a","s","b"},matrix,{"a","s"},&mps,{"c","s","b"},matches);
+ assert(!matched);
+}
+
+
+TEST(NumericsTester, checkContractionBatch)
+{
+ auto make_contraction = [](const std::string & pattern, const std::vector<std::string> & names,
+                            const std::vector<TensorShape> & shapes, double beta){
+  std::shared_ptr<TensorOperation> op = TensorOpFactory::get()->createTensorOp(TensorOpCode::CONTRACT);
+  for(unsigned int i = 0; i < 3; ++i) op->setTensorOperand(std::make_shared<Tensor>(names[i],shapes[i]));
+  op->setIndexPattern(pattern);
+  op->setScalar(1,beta);
+  return op;
+ };
+ auto batch = std::dynamic_pointer_cast<TensorOpContractBatch>(
+  std::shared_ptr<TensorOperation>(TensorOpFactory::get()->createTensorOp(TensorOpCode::CONTRACT_BATCH)));
+ assert(batch);
+ //Tensor contractions with differently named tensors and index labels are batched together:
+ assert(batch->appendContraction(*make_contraction("C1(i,j)+=A1(i,k)*B1(k,j)",{"C1","A1","B1"},{{4,6},{4,5},{5,6}},1.0)));
+ assert(batch->appendContraction(*make_contraction("C2(a,b)+=E(a,c)*F(c,b)",{"C2","E","F"},{{4,6},{4,5},{5,6}},0.0)));
+ assert(batch->getBatchSize() == 2);
+ assert(batch->isMemberAccumulative(0) && !batch->isMemberAccumulative(1));
+ //Different index patterns, incongruent tensor operands or unsupported beta prefactors are rejected:
+ assert(!batch->appendContraction(*make_contraction("C3(i,j)+=A3(k,i)*B3(k,j)",{"C3","A3","B3"},{{4,6},{5,4},{5,6}},1.0)));
+ assert(!batch->appendContraction(*make_contraction("C4(i,j)+=A4(i,k)*B4(k,j)",{"C4","A4","B4"},{{4,6},{4,3},{3,6}},1.0)));
+ assert(!batch->appendContraction(*make_contraction("C5(i,j)+=A5(i,k)*B5(k,j)",{"C5","A5","B5"},{{4,6},{4,5},{5,6}},0.5)));
+ assert(batch->getBatchSize() == 2);
+}
+
+
+TEST(NumericsTester, checkMetadataStorage)
+{
+ //Tensor metadata of typical ranks is stored inline (no heap allocations):
+ TensorShape shape{2,3,4,5,6,7,8,9};
+ assert(shape.getDimExtents().isInline());
+ shape.appendDimension(10);
+ assert(!shape.getDimExtents().isInline() && shape.getRank() == 9 && shape.getDimExtent(8) == 10);
+ //Z(e,f) = A(a,b) * B(b,c) * C(a,c,g) * D(g,h,e) * E(h,f)
+ TensorNetwork network("Metadata",
+                       "Z(e,f) = A(a,b) * B(b,c) * C(a,c,g) * D(g,h,e) * E(h,f)",
+                       std::map<std::string,std::shared_ptr<Tensor>>{
+                        {"Z",std::make_shared<Tensor>("Z",TensorShape{16,16})},
+                        {"A",std::make_shared<Tensor>("A",TensorShape{32,2})},
+                        {"B",std::make_shared<Tensor>("B",TensorShape{2,32})},
+                        {"C",std::make_shared<Tensor>("C",TensorShape{32,32,2})},
+                        {"D",std::make_shared<Tensor>("D",TensorShape{2,16,16})},
+                        {"E",std::make_shared<Tensor>("E",TensorShape{16,16})}
+                       }
+                      );
+ //Merging tensors in a tensor network copy leaves the original tensor network intact:
+ TensorNetwork network_copy(network);
+ assert(network_copy.getNumTensors() == network.getNumTensors());
+ std::string contr_pattern;
+ auto merged = network_copy.mergeTensors(1,2,6,&contr_pattern);
+ assert(merged && network_copy.getTensor(6)->getRank() == 2);
+ assert(network_copy.getNumTensors() == network.getNumTensors() - 1);
+ assert(network.getTensor(1)->getRank() == 2 && network.getTensor(6) == nullptr);
+}
+
+
+TEST(NumericsTester, checkLargeTensorNetwork)
+{
+ //Brickwork quantum circuit with about 10000 two-qubit gates:
+ const unsigned int num_qubits = 16;
+ const unsigned int num_layers = 1334;
+ auto qubit = std::make_shared<Tensor>("Q",TensorShape{2});
+ auto gate = std::make_shared<Tensor>("G",TensorShape{2,2,2,2});
+ auto time_start = std::chrono::high_resolution_clock::now();
+ TensorNetwork circuit("LargeCircuit");
+ unsigned int tensor_id = 0;
+ for(unsigned int i = 0; i < num_qubits; ++i){
+  bool appended = circuit.appendTensor(++tensor_id,qubit,{}); assert(appended);
+ }
+ for(unsigned int layer = 0; layer < num_layers; ++layer){
+  for(unsigned int i = (layer % 2); i + 1 < num_qubits; i += 2){
+   bool appended = circuit.appendTensorGate(++tensor_id,gate,{i,i+1}); assert(appended);
+  }
+ }
+ auto time_end = std::chrono::high_resolution_clock::now();
+ double duration = std::chrono::duration_cast<std::chrono::duration<double>>(time_end - time_start).count();
+ std::cout << "Built a tensor network with " << circuit.getNumTensors() << " tensors in " << duration << " s" << std::endl;
+ assert(circuit.getNumTensors() == tensor_id && circuit.getMaxTensorId() == tensor_id);
+ assert(circuit.getRank() == num_qubits && circuit.isValid());
+ //Merge low-rank tensors (each merge removes the previous max tensor id):
+ time_start = std::chrono::high_resolution_clock::now();
+ std::list<ContrTriple> contr_seq;
+ circuit.absorbLowRankTensors(contr_seq,[&tensor_id](){return ++tensor_id;});
+ time_end = std::chrono::high_resolution_clock::now();
+ duration = std::chrono::duration_cast<std::chrono::duration<double>>(time_end - time_start).count();
+ std::cout << "Performed " << contr_seq.size() << " tensor merges in " << duration << " s" << std::endl;
+ unsigned int max_tensor_id = 0;
+ for(auto iter = circuit.cbegin(); iter != circuit.cend(); ++iter) max_tensor_id = std::max(max_tensor_id,iter->first);
+ assert(circuit.getMaxTensorId() == max_tensor_id && circuit.isValid());
+ //Deleting the max-id tensor exposes the next largest tensor id:
+ bool deleted = circuit.deleteTensor(max_tensor_id); assert(deleted);
+ unsigned int next_max_tensor_id = 0;
+ for(auto iter = circuit.cbegin(); iter != circuit.cend(); ++iter) next_max_tensor_id = std::max(next_max_tensor_id,iter->first);
+ assert(next_max_tensor_id < max_tensor_id && circuit.getMaxTensorId() == next_max_tensor_id);
+}
+
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -2,6 +2,9 @@
 
 #include "TAProLLexer.h"
 #include "TAProLListenerCPPImpl.hpp"
+#include "TAProLListenerProgramImpl.hpp"
+
+#include <functional>
 
 using namespace antlr4;
 using namespace taprol;
@@ -41,6 +44,53 @@ void TAProLInterpreter::interpret(const std::string &src, std::ostream &output,
   tree::ParseTreeWalker::DEFAULT.walk(&listener, tree);
 }
 
+std::shared_ptr<TAProLProgram>
+TAProLInterpreter::compile(const std::string &src) {
+
+  // Look up the program cache first
+  const auto src_hash = std::hash<std::string>{}(src);
+  auto cached = programs.find(src_hash);
+  if (cached != programs.end()) {
+    if (cached->second->getSource() == src)
+      return cached->second;
+  }
+
+  // Setup the Antlr Parser
+  ANTLRInputStream input(src);
+  TAProLLexer lexer(&input);
+  lexer.removeErrorListeners();
+  lexer.addErrorListener(new TAProLErrorListener());
+
+  CommonTokenStream tokens(&lexer);
+  TAProLParser parser(&tokens);
+  parser.removeErrorListeners();
+  parser.addErrorListener(new TAProLErrorListener());
+
+  // Walk the Parse Tree
+  tree::ParseTree *tree = parser.taprolsrc();
+  if (parser.getNumberOfSyntaxErrors() > 0)
+    return std::shared_ptr<TAProLProgram>(nullptr);
+
+  auto program = std::make_shared<TAProLProgram>(src);
+  TAProLListenerProgramImpl listener(subspaces, *program);
+  tree::ParseTreeWalker::DEFAULT.walk(&listener, tree);
+  if (!listener.succeeded())
+    return std::shared_ptr<TAProLProgram>(nullptr);
+
+  // Cache the program (a colliding hash replaces the cached program)
+  programs[src_hash] = program;
+  return program;
+}
+
+bool TAProLInterpreter::execute(
+    const std::string &src,
+    std::vector<std::pair<std::string, std::complex<double>>> &results) {
+  auto program = compile(src);
+  if (!program)
+    return false;
+  return program->execute(results);
+}
+
 } // namespace parser
 
 } // namespace exatn
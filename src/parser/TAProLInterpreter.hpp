@@ -3,6 +3,15 @@
 
 #include "antlr4-runtime.h"
 #include "num_server.hpp"
+#include "TAProLProgram.hpp"
+
+#include <complex>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace exatn {
 
@@ -29,6 +38,28 @@ public:
   void interpret(const std::string &src);
   void interpret(const std::string &src, std::ostream &output,
                  std::map<std::string, std::string> &args);
+
+  /** Lowers TAProL source into a reusable program executed directly via
+      the numerical server (nullptr on failure). Programs are cached by
+      the hash of their source, thus compiling the same source again
+      skips lexing, parsing and lowering entirely. **/
+  std::shared_ptr<TAProLProgram> compile(const std::string &src);
+
+  /** Executes TAProL source directly via the numerical server (compiling it
+      if not cached yet) and appends the values of the saved scalar tensors
+      to results (tag, value). Returns FALSE if the source could not be executed. **/
+  bool execute(const std::string &src,
+               std::vector<std::pair<std::string, std::complex<double>>> &results);
+
+  /** Returns the number of cached programs. **/
+  std::size_t getNumCachedPrograms() const { return programs.size(); }
+
+  /** Clears the cache of compiled programs. **/
+  void clearProgramCache() { programs.clear(); }
+
+protected:
+  std::map<std::string, TAProLSubspace> subspaces; // (sub)spaces registered by compiled sources
+  std::unordered_map<std::size_t, std::shared_ptr<TAProLProgram>> programs; // source hash --> compiled program
 };
 
 } // namespace parser
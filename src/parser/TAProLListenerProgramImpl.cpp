@@ -0,0 +1,355 @@
+/** ExaTN: TAProL parser
+REVISION: 2020/11/29
+
+Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh), Alex McCaskey
+Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
+
+#include "TAProLListenerProgramImpl.hpp"
+
+#include <algorithm>
+
+namespace exatn {
+
+namespace parser {
+
+namespace {
+
+std::string unquote(const std::string &str) {
+  if (str.length() >= 2 && str.front() == '"' && str.back() == '"')
+    return str.substr(1, str.length() - 2);
+  return str;
+}
+
+TAProLInstruction makeInstruction(TAProLOpCode opcode, const std::string &name,
+                                  const std::string &spec = "") {
+  TAProLInstruction instruction;
+  instruction.opcode = opcode;
+  instruction.name = name;
+  instruction.spec = spec;
+  return instruction;
+}
+
+} // namespace
+
+void TAProLListenerProgramImpl::fail(const std::string &statement) {
+  std::cout << "#ERROR(exatn::parser::program): Failed to lower TAProL statement: "
+            << statement << std::endl;
+  failed = true;
+  return;
+}
+
+bool TAProLListenerProgramImpl::getBound(TAProLParser::LowerboundContext *ctx,
+                                         DimOffset &bound) {
+  if (ctx->INT() != nullptr) {
+    bound = std::stoull(ctx->INT()->getText());
+    return true;
+  }
+  auto packet = exatn::getExternalData(ctx->id()->getText());
+  if (!packet) return false;
+  resetBytePacket(packet.get());
+  extractFromBytePacket(packet.get(), bound);
+  resetBytePacket(packet.get());
+  return true;
+}
+
+bool TAProLListenerProgramImpl::getBound(TAProLParser::UpperboundContext *ctx,
+                                         DimOffset &bound) {
+  if (ctx->INT() != nullptr) {
+    bound = std::stoull(ctx->INT()->getText());
+    return true;
+  }
+  auto packet = exatn::getExternalData(ctx->id()->getText());
+  if (!packet) return false;
+  resetBytePacket(packet.get());
+  extractFromBytePacket(packet.get(), bound);
+  resetBytePacket(packet.get());
+  return true;
+}
+
+bool TAProLListenerProgramImpl::setPrefactor(TAProLParser::PrefactorContext *ctx,
+                                             TAProLInstruction &instruction) {
+  instruction.value = std::complex<double>{1.0, 0.0};
+  if (ctx == nullptr) return true;
+  if (ctx->complex() != nullptr) {
+    instruction.value = std::complex<double>{std::stod(ctx->complex()->real(0)->getText()),
+                                             std::stod(ctx->complex()->real(1)->getText())};
+  } else if (ctx->real() != nullptr) {
+    instruction.value = std::complex<double>{std::stod(ctx->real()->getText()), 0.0};
+  } else {
+    instruction.prefactor = ctx->id()->getText(); // resolved during execution
+  }
+  return true;
+}
+
+std::string TAProLListenerProgramImpl::stripPrefactor(
+    antlr4::ParserRuleContext *ctx, TAProLParser::PrefactorContext *prefactor) {
+  auto spec = ctx->getText();
+  if (prefactor != nullptr) {
+    const auto suffix = "*" + prefactor->getText();
+    if (spec.length() > suffix.length() &&
+        spec.compare(spec.length() - suffix.length(), suffix.length(), suffix) == 0)
+      spec.erase(spec.length() - suffix.length());
+  }
+  return spec;
+}
+
+bool TAProLListenerProgramImpl::declareTensor(TAProLParser::TensorContext *ctx,
+                                              TensorElementType element_type) {
+  auto instruction = makeInstruction(TAProLOpCode::CREATE, ctx->tensorname()->getText());
+  instruction.element_type = element_type;
+  if (ctx->indexlist() == nullptr) {
+    instruction.tensor = std::make_shared<Tensor>(instruction.name);
+  } else {
+    std::vector<DimExtent> extents;
+    std::vector<std::pair<SpaceId, SubspaceId>> signature;
+    for (auto indx : ctx->indexlist()->indexname()) {
+      auto iter = indices.find(indx->getText());
+      if (iter == indices.end()) return false;
+      const auto &subspace = subspaces.at(iter->second);
+      extents.emplace_back(subspace.extent);
+      signature.emplace_back(std::make_pair(subspace.space_id, subspace.subspace_id));
+    }
+    instruction.tensor = std::make_shared<Tensor>(instruction.name, extents, signature);
+  }
+  program.append(std::move(instruction));
+  return true;
+}
+
+void TAProLListenerProgramImpl::enterScope(TAProLParser::ScopeContext *ctx) {
+  if (failed) return;
+  program.append(makeInstruction(TAProLOpCode::OPEN_SCOPE, ctx->scopename(0)->getText()));
+  return;
+}
+
+void TAProLListenerProgramImpl::exitScope(TAProLParser::ScopeContext *ctx) {
+  if (failed) return;
+  program.append(makeInstruction(TAProLOpCode::CLOSE_SCOPE, ctx->scopename(0)->getText()));
+  return;
+}
+
+void TAProLListenerProgramImpl::enterSpace(TAProLParser::SpaceContext *ctx) {
+  if (failed) return;
+  for (auto space : ctx->spacedeflist()->spacedef()) {
+    const auto space_name = space->spacename()->getText();
+    DimOffset lower, upper;
+    if (!getBound(space->range()->lowerbound(), lower) ||
+        !getBound(space->range()->upperbound(), upper) || upper < lower) {
+      fail(ctx->getText());
+      return;
+    }
+    const DimExtent extent = upper - lower + 1;
+    auto iter = subspaces.find(space_name);
+    if (iter != subspaces.end()) {
+      if (iter->second.extent != extent) {
+        fail(ctx->getText());
+        return;
+      }
+    } else {
+      SpaceId space_id;
+      const auto *vector_space = exatn::getVectorSpace(space_name);
+      if (vector_space != nullptr) {
+        space_id = vector_space->getRegisteredId();
+      } else {
+        space_id = exatn::createVectorSpace(space_name, extent);
+      }
+      subspaces.emplace(std::make_pair(space_name,
+                        TAProLSubspace{space_id, FULL_SUBSPACE, extent}));
+    }
+  }
+  return;
+}
+
+void TAProLListenerProgramImpl::enterSubspace(TAProLParser::SubspaceContext *ctx) {
+  if (failed) return;
+  for (auto subspace : ctx->spacedeflist()->spacedef()) {
+    const auto subspace_name = subspace->spacename()->getText();
+    DimOffset lower, upper;
+    if (!getBound(subspace->range()->lowerbound(), lower) ||
+        !getBound(subspace->range()->upperbound(), upper) || upper < lower) {
+      fail(ctx->getText());
+      return;
+    }
+    const DimExtent extent = upper - lower + 1;
+    auto iter = subspaces.find(subspace_name);
+    if (iter != subspaces.end()) {
+      if (iter->second.extent != extent) {
+        fail(ctx->getText());
+        return;
+      }
+    } else if (ctx->spacename() == nullptr) { // subspace of the anonymous space
+      subspaces.emplace(std::make_pair(subspace_name,
+                        TAProLSubspace{SOME_SPACE, lower, extent}));
+    } else {
+      const auto space_name = ctx->spacename()->getText();
+      const auto *vector_space = exatn::getVectorSpace(space_name);
+      if (vector_space == nullptr) {
+        fail(ctx->getText());
+        return;
+      }
+      auto subspace_id = exatn::createSubspace(subspace_name, space_name,
+                                               std::make_pair(lower, upper));
+      subspaces.emplace(std::make_pair(subspace_name,
+                        TAProLSubspace{vector_space->getRegisteredId(), subspace_id, extent}));
+    }
+  }
+  return;
+}
+
+void TAProLListenerProgramImpl::enterIndex(TAProLParser::IndexContext *ctx) {
+  if (failed) return;
+  const auto space_name = ctx->spacename()->getText();
+  if (subspaces.find(space_name) == subspaces.end()) {
+    fail(ctx->getText());
+    return;
+  }
+  for (auto indx : ctx->indexlist()->indexname()) {
+    indices[indx->getText()] = space_name;
+  }
+  return;
+}
+
+void TAProLListenerProgramImpl::enterAssign(TAProLParser::AssignContext *ctx) {
+  if (failed) return;
+  const auto tensor_name = ctx->tensor()->tensorname()->getText();
+  bool success = true;
+  if (ctx->methodname() != nullptr) {
+    const bool transform_only = (ctx->getText().find("=>") != std::string::npos);
+    if (!transform_only)
+      success = declareTensor(ctx->tensor(), exatn::TensorElementType::REAL64);
+    if (success)
+      program.append(makeInstruction(TAProLOpCode::TRANSFORM, tensor_name,
+                                     unquote(ctx->methodname()->getText())));
+  } else if (ctx->datacontainer() != nullptr) {
+    success = false; // initialization from client data containers is not supported
+  } else if (ctx->complex() != nullptr) {
+    success = declareTensor(ctx->tensor(), exatn::TensorElementType::COMPLEX64);
+    if (success) {
+      auto instruction = makeInstruction(TAProLOpCode::INIT, tensor_name);
+      instruction.value = std::complex<double>{std::stod(ctx->complex()->real(0)->getText()),
+                                               std::stod(ctx->complex()->real(1)->getText())};
+      instruction.complex_value = true;
+      program.append(std::move(instruction));
+    }
+  } else if (ctx->real() != nullptr) {
+    success = declareTensor(ctx->tensor(), exatn::TensorElementType::REAL64);
+    if (success) {
+      auto instruction = makeInstruction(TAProLOpCode::INIT, tensor_name);
+      instruction.value = std::complex<double>{std::stod(ctx->real()->getText()), 0.0};
+      program.append(std::move(instruction));
+    }
+  } else { // undefined value
+    success = declareTensor(ctx->tensor(), exatn::TensorElementType::REAL64);
+  }
+  if (!success) fail(ctx->getText());
+  return;
+}
+
+void TAProLListenerProgramImpl::enterSave(TAProLParser::SaveContext *ctx) {
+  if (failed) return;
+  const auto tensor_name = (ctx->tensor() != nullptr)
+                         ? ctx->tensor()->tensorname()->getText()
+                         : ctx->tensorname()->getText();
+  program.append(makeInstruction(TAProLOpCode::SAVE, tensor_name,
+                                 unquote(ctx->tagname()->getText())));
+  return;
+}
+
+void TAProLListenerProgramImpl::enterDestroy(TAProLParser::DestroyContext *ctx) {
+  if (failed) return;
+  if (ctx->tensorlist() != nullptr) {
+    for (auto tens : ctx->tensorlist()->tensor())
+      program.append(makeInstruction(TAProLOpCode::DESTROY, tens->tensorname()->getText()));
+    for (auto tens : ctx->tensorlist()->tensorname())
+      program.append(makeInstruction(TAProLOpCode::DESTROY, tens->getText()));
+  } else if (ctx->tensor() != nullptr) {
+    program.append(makeInstruction(TAProLOpCode::DESTROY, ctx->tensor()->tensorname()->getText()));
+  } else if (ctx->tensorname() != nullptr) {
+    program.append(makeInstruction(TAProLOpCode::DESTROY, ctx->tensorname()->getText()));
+  }
+  return;
+}
+
+void TAProLListenerProgramImpl::enterNorm1(TAProLParser::Norm1Context *ctx) {
+  if (failed) return;
+  const auto tensor_name = (ctx->tensor() != nullptr)
+                         ? ctx->tensor()->tensorname()->getText()
+                         : ctx->tensorname()->getText();
+  program.append(makeInstruction(TAProLOpCode::NORM1, tensor_name, ctx->scalar()->getText()));
+  return;
+}
+
+void TAProLListenerProgramImpl::enterNorm2(TAProLParser::Norm2Context *ctx) {
+  if (failed) return;
+  const auto tensor_name = (ctx->tensor() != nullptr)
+                         ? ctx->tensor()->tensorname()->getText()
+                         : ctx->tensorname()->getText();
+  program.append(makeInstruction(TAProLOpCode::NORM2, tensor_name, ctx->scalar()->getText()));
+  return;
+}
+
+void TAProLListenerProgramImpl::enterMaxabs(TAProLParser::MaxabsContext *ctx) {
+  if (failed) return;
+  const auto tensor_name = (ctx->tensor() != nullptr)
+                         ? ctx->tensor()->tensorname()->getText()
+                         : ctx->tensorname()->getText();
+  program.append(makeInstruction(TAProLOpCode::MAXABS, tensor_name, ctx->scalar()->getText()));
+  return;
+}
+
+void TAProLListenerProgramImpl::enterScale(TAProLParser::ScaleContext *ctx) {
+  if (failed) return;
+  auto instruction = makeInstruction(TAProLOpCode::SCALE, ctx->tensor()->tensorname()->getText());
+  if (!setPrefactor(ctx->prefactor(), instruction)) {
+    fail(ctx->getText());
+    return;
+  }
+  program.append(std::move(instruction));
+  return;
+}
+
+void TAProLListenerProgramImpl::enterAddition(TAProLParser::AdditionContext *ctx) {
+  if (failed) return;
+  auto instruction = makeInstruction(TAProLOpCode::ADD, ctx->tensor(0)->tensorname()->getText(),
+                                     stripPrefactor(ctx, ctx->prefactor()));
+  if (!setPrefactor(ctx->prefactor(), instruction)) {
+    fail(ctx->getText());
+    return;
+  }
+  program.append(std::move(instruction));
+  return;
+}
+
+void TAProLListenerProgramImpl::enterContraction(TAProLParser::ContractionContext *ctx) {
+  if (failed) return;
+  auto instruction = makeInstruction(TAProLOpCode::CONTRACT, ctx->tensor(0)->tensorname()->getText(),
+                                     stripPrefactor(ctx, ctx->prefactor()));
+  if (!setPrefactor(ctx->prefactor(), instruction)) {
+    fail(ctx->getText());
+    return;
+  }
+  program.append(std::move(instruction));
+  return;
+}
+
+void TAProLListenerProgramImpl::enterCompositeproduct(TAProLParser::CompositeproductContext *ctx) {
+  if (failed) return;
+  // Symbolic tensor network specifications do not carry prefactors:
+  if (ctx->prefactor() != nullptr) {
+    fail(ctx->getText());
+    return;
+  }
+  auto instruction = makeInstruction(TAProLOpCode::EVALUATE, "_SmokyTN", ctx->getText());
+  for (auto tens : ctx->tensor())
+    instruction.operands.emplace_back(tens->tensorname()->getText());
+  for (auto tens : ctx->conjtensor())
+    instruction.operands.emplace_back(tens->tensorname()->getText());
+  std::sort(instruction.operands.begin(), instruction.operands.end());
+  instruction.operands.erase(std::unique(instruction.operands.begin(), instruction.operands.end()),
+                             instruction.operands.end());
+  program.append(std::move(instruction));
+  return;
+}
+
+} // namespace parser
+
+} // namespace exatn
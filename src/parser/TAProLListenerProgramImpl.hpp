@@ -0,0 +1,101 @@
+/** ExaTN: TAProL parser
+REVISION: 2020/11/29
+
+Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh), Alex McCaskey
+Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
+
+/** Rationale:
+ (a) Unlike TAProLListenerCPPImpl, which translates TAProL into C++ source,
+     this listener lowers TAProL into a reusable TAProLProgram executed
+     directly via the ExaTN numerical server (see TAProLProgram).
+ (b) Vector spaces and subspaces are registered with the numerical server
+     during lowering, only once: They are remembered in a persistent registry
+     owned by the interpreter. Index labels are resolved during lowering,
+     thus tensor declarations are fully specified in the lowered program.
+ (c) Range bounds given by identifiers refer to external data registered
+     with the numerical server, whose leading item must be a DimOffset.
+ (d) Once a statement cannot be lowered, the lowering fails.
+**/
+
+#ifndef EXATN_TAPROLLISTENERPROGRAMIMPL_HPP_
+#define EXATN_TAPROLLISTENERPROGRAMIMPL_HPP_
+
+#include "TAProLBaseListener.h"
+#include "TAProLParser.h"
+
+#include "TAProLProgram.hpp"
+
+#include <iostream>
+#include <map>
+#include <string>
+
+using namespace taprol;
+
+namespace exatn {
+
+namespace parser {
+
+class TAProLListenerProgramImpl : public TAProLBaseListener {
+
+public:
+  TAProLListenerProgramImpl(std::map<std::string, TAProLSubspace> &_subspaces,
+                            TAProLProgram &_program)
+      : subspaces(_subspaces), program(_program), failed(false) {}
+
+  virtual void enterScope(TAProLParser::ScopeContext *ctx) override;
+  virtual void exitScope(TAProLParser::ScopeContext *ctx) override;
+
+  virtual void enterSpace(TAProLParser::SpaceContext *ctx) override;
+
+  virtual void enterSubspace(TAProLParser::SubspaceContext *ctx) override;
+
+  virtual void enterIndex(TAProLParser::IndexContext *ctx) override;
+
+  virtual void enterAssign(TAProLParser::AssignContext *ctx) override;
+
+  virtual void enterSave(TAProLParser::SaveContext *ctx) override;
+
+  virtual void enterDestroy(TAProLParser::DestroyContext *ctx) override;
+
+  virtual void enterNorm1(TAProLParser::Norm1Context *ctx) override;
+
+  virtual void enterNorm2(TAProLParser::Norm2Context *ctx) override;
+
+  virtual void enterMaxabs(TAProLParser::MaxabsContext *ctx) override;
+
+  virtual void enterScale(TAProLParser::ScaleContext *ctx) override;
+
+  virtual void enterAddition(TAProLParser::AdditionContext *ctx) override;
+
+  virtual void enterContraction(TAProLParser::ContractionContext *ctx) override;
+
+  virtual void
+  enterCompositeproduct(TAProLParser::CompositeproductContext *ctx) override;
+
+  // Returns TRUE if all TAProL statements have been lowered.
+  bool succeeded() const { return !failed; }
+
+  virtual ~TAProLListenerProgramImpl() {}
+
+protected:
+  void fail(const std::string &statement);
+  bool getBound(TAProLParser::LowerboundContext *ctx, DimOffset &bound);
+  bool getBound(TAProLParser::UpperboundContext *ctx, DimOffset &bound);
+  bool setPrefactor(TAProLParser::PrefactorContext *ctx,
+                    TAProLInstruction &instruction);
+  bool declareTensor(TAProLParser::TensorContext *ctx,
+                     TensorElementType element_type);
+  std::string stripPrefactor(antlr4::ParserRuleContext *ctx,
+                             TAProLParser::PrefactorContext *prefactor);
+
+  std::map<std::string, TAProLSubspace> &subspaces; // persistent registry of (sub)spaces
+  TAProLProgram &program;                           // lowered program
+  std::map<std::string, std::string> indices;       // index label --> (sub)space name
+  bool failed;
+};
+
+} // namespace parser
+
+} // namespace exatn
+
+#endif // EXATN_TAPROLLISTENERPROGRAMIMPL_HPP_
@@ -0,0 +1,172 @@
+/** ExaTN: TAProL parser
+REVISION: 2020/11/29
+
+Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh), Alex McCaskey
+Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
+
+#include "TAProLProgram.hpp"
+
+#include "talshxx.hpp"
+
+namespace exatn {
+
+namespace parser {
+
+namespace {
+
+// Returns TRUE if all operands of a prepared tensor operation are still
+// the tensors currently registered under their names.
+bool operandsAreBound(const TensorOperation &op) {
+  for (unsigned int i = 0; i < op.getNumOperands(); ++i) {
+    auto operand = op.getTensorOperand(i);
+    const auto &tensor_name = operand->getName();
+    if (!exatn::tensorAllocated(tensor_name)) return false;
+    if (exatn::getTensor(tensor_name) != operand) return false;
+  }
+  return true;
+}
+
+} // namespace
+
+void TAProLProgram::append(TAProLInstruction &&instruction) {
+  instructions_.emplace_back(std::move(instruction));
+  return;
+}
+
+bool TAProLProgram::execute(
+    std::vector<std::pair<std::string, std::complex<double>>> &results) {
+  std::map<std::string, double> scalars; // scalar variable --> value
+  unsigned int num_open_scopes = 0;
+  bool success = true;
+  for (auto &instruction : instructions_) {
+    success = executeInstruction(instruction, scalars, num_open_scopes, results);
+    if (!success) {
+      std::cout << "#ERROR(exatn::parser::TAProLProgram): Failed to execute TAProL instruction #"
+                << static_cast<int>(instruction.opcode) << " on " << instruction.name << ": "
+                << instruction.spec << std::endl;
+      break;
+    }
+  }
+  while (num_open_scopes > 0) {
+    exatn::closeScope();
+    --num_open_scopes;
+  }
+  return success;
+}
+
+bool TAProLProgram::executeInstruction(
+    TAProLInstruction &instruction, std::map<std::string, double> &scalars,
+    unsigned int &num_open_scopes,
+    std::vector<std::pair<std::string, std::complex<double>>> &results) {
+
+  // Resolve the prefactor:
+  std::complex<double> prefactor = instruction.value;
+  if (!instruction.prefactor.empty()) {
+    auto iter = scalars.find(instruction.prefactor);
+    if (iter == scalars.end()) return false;
+    prefactor = std::complex<double>{iter->second, 0.0};
+  }
+
+  switch (instruction.opcode) {
+
+  case TAProLOpCode::OPEN_SCOPE:
+    exatn::openScope(instruction.name);
+    ++num_open_scopes;
+    return true;
+
+  case TAProLOpCode::CLOSE_SCOPE:
+    if (num_open_scopes == 0) return false;
+    exatn::closeScope();
+    --num_open_scopes;
+    return true;
+
+  case TAProLOpCode::CREATE:
+    if (exatn::tensorAllocated(instruction.name)) return true;
+    return exatn::createTensor(instruction.tensor, instruction.element_type);
+
+  case TAProLOpCode::INIT:
+    if (instruction.complex_value)
+      return exatn::initTensor(instruction.name, instruction.value);
+    return exatn::initTensor(instruction.name, std::real(instruction.value));
+
+  case TAProLOpCode::TRANSFORM:
+    return exatn::transformTensor(instruction.name, instruction.spec);
+
+  case TAProLOpCode::SAVE: {
+    if (!exatn::sync(instruction.name)) return false;
+    auto local_tensor = exatn::getLocalTensor(instruction.name);
+    if (!local_tensor || local_tensor->getVolume() != 1) return false;
+    std::complex<double> value;
+    const std::complex<double> *body_c64;
+    const std::complex<float> *body_c32;
+    const double *body_r64;
+    const float *body_r32;
+    if (local_tensor->getDataAccessHostConst(&body_c64)) {
+      value = body_c64[0];
+    } else if (local_tensor->getDataAccessHostConst(&body_r64)) {
+      value = std::complex<double>{body_r64[0], 0.0};
+    } else if (local_tensor->getDataAccessHostConst(&body_c32)) {
+      value = std::complex<double>{body_c32[0].real(), body_c32[0].imag()};
+    } else if (local_tensor->getDataAccessHostConst(&body_r32)) {
+      value = std::complex<double>{body_r32[0], 0.0};
+    } else {
+      return false;
+    }
+    results.emplace_back(std::make_pair(instruction.spec, value));
+    return true;
+  }
+
+  case TAProLOpCode::DESTROY:
+    return exatn::destroyTensor(instruction.name);
+
+  case TAProLOpCode::NORM1:
+    return exatn::computeNorm1Sync(instruction.name, scalars[instruction.spec]);
+
+  case TAProLOpCode::NORM2:
+    return exatn::computeNorm2Sync(instruction.name, scalars[instruction.spec]);
+
+  case TAProLOpCode::MAXABS:
+    return exatn::computeMaxAbsSync(instruction.name, scalars[instruction.spec]);
+
+  case TAProLOpCode::SCALE:
+    return exatn::scaleTensor(instruction.name, prefactor);
+
+  case TAProLOpCode::ADD:
+  case TAProLOpCode::CONTRACT:
+    // Pre-parse the specification once, re-bind only if the operands have been replaced:
+    if (!instruction.prepared || !operandsAreBound(*(instruction.prepared))) {
+      instruction.prepared = (instruction.opcode == TAProLOpCode::ADD)
+                           ? exatn::prepareTensorAddition(instruction.spec)
+                           : exatn::prepareTensorContraction(instruction.spec);
+      if (!instruction.prepared) return false;
+    }
+    return exatn::submitPrepared(*(instruction.prepared), prefactor);
+
+  case TAProLOpCode::EVALUATE: {
+    // Build the tensor network once, rebuild only if its tensors have been replaced:
+    std::map<std::string, std::shared_ptr<Tensor>> tensors;
+    for (const auto &tensor_name : instruction.operands) {
+      if (!exatn::tensorAllocated(tensor_name)) return false;
+      tensors.emplace(std::make_pair(tensor_name, exatn::getTensor(tensor_name)));
+    }
+    bool bound = (instruction.network != nullptr);
+    for (auto iter = tensors.cbegin(); bound && iter != tensors.cend(); ++iter) {
+      bound = false;
+      for (auto tens = instruction.network->cbegin(); tens != instruction.network->cend(); ++tens) {
+        if (tens->second.getTensor() == iter->second) {
+          bound = true;
+          break;
+        }
+      }
+    }
+    if (!bound)
+      instruction.network = std::make_shared<TensorNetwork>(instruction.name, instruction.spec, tensors);
+    return exatn::evaluate(*(instruction.network));
+  }
+  }
+  return false;
+}
+
+} // namespace parser
+
+} // namespace exatn
@@ -0,0 +1,119 @@
+/** ExaTN: TAProL parser
+REVISION: 2020/11/29
+
+Copyright (C) 2018-2020 Dmitry I. Lyakh (Liakh), Alex McCaskey
+Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle) **/
+
+/** Rationale:
+ (a) A TAProL program is a TAProL source lowered into a linear sequence of
+     instructions which are executed directly via the ExaTN numerical server.
+     A program is compiled once and can be executed many times, without
+     lexing, parsing or walking the parse tree again (see TAProLInterpreter).
+ (b) Tensors declared by the program are bound to tensor handles at compile
+     time, which are re-created by each execution of the program.
+ (c) Tensor additions and contractions are pre-parsed into prepared tensor
+     operation templates and tensor network evaluations into tensor networks
+     upon their first execution. These are reused by subsequent executions
+     as long as the tensors they refer to are still the same tensor objects.
+ (d) TAProL scopes are mapped onto the numerical server scopes. Each "save"
+     statement synchronizes the saved scalar (order-0) tensor and records
+     its value under the corresponding tag, such that the value survives the
+     subsequent destruction of the tensor.
+ (e) Once an instruction fails, the execution stops and the scopes opened
+     by the program are closed.
+**/
+
+#ifndef EXATN_TAPROLPROGRAM_HPP_
+#define EXATN_TAPROLPROGRAM_HPP_
+
+#include "exatn_numerics.hpp"
+
+#include <complex>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace exatn {
+
+namespace parser {
+
+/** Registered TAProL (sub)space an index label can refer to. **/
+struct TAProLSubspace {
+  SpaceId space_id;       // registered vector space id (SOME_SPACE for anonymous)
+  SubspaceId subspace_id; // registered subspace id (base offset for anonymous)
+  DimExtent extent;       // subspace dimension
+};
+
+/** TAProL instruction opcode. **/
+enum class TAProLOpCode {
+  OPEN_SCOPE,  // open a scope
+  CLOSE_SCOPE, // close the current scope
+  CREATE,      // create a declared tensor (unless it already exists)
+  INIT,        // initialize a tensor to a scalar value
+  TRANSFORM,   // transform a tensor by a registered tensor method
+  SAVE,        // record the value of a scalar tensor
+  DESTROY,     // destroy a tensor
+  NORM1,       // compute 1-norm of a tensor into a scalar variable
+  NORM2,       // compute 2-norm of a tensor into a scalar variable
+  MAXABS,      // compute max-abs norm of a tensor into a scalar variable
+  SCALE,       // scale a tensor
+  ADD,         // tensor addition
+  CONTRACT,    // tensor contraction
+  EVALUATE     // tensor network evaluation
+};
+
+/** TAProL instruction. **/
+struct TAProLInstruction {
+  TAProLOpCode opcode;
+  std::string name;      // scope name, tensor name, or tensor network name
+  std::string spec;      // symbolic specification (ADD, CONTRACT, EVALUATE), method name (TRANSFORM),
+                         // tag (SAVE), or scalar variable name (NORM1, NORM2, MAXABS)
+  std::vector<std::string> operands;        // names of the tensors in a tensor network (EVALUATE)
+  std::shared_ptr<Tensor> tensor;           // declared tensor handle (CREATE)
+  TensorElementType element_type = TensorElementType::VOID; // tensor element type (CREATE)
+  std::complex<double> value{1.0, 0.0};     // scalar value (INIT) or constant prefactor
+  bool complex_value = false;               // whether the scalar value is complex (INIT)
+  std::string prefactor;                    // scalar variable used as a prefactor (empty: constant)
+  std::shared_ptr<TensorOperation> prepared; // prepared tensor operation (ADD, CONTRACT)
+  std::shared_ptr<TensorNetwork> network;    // prepared tensor network (EVALUATE)
+};
+
+class TAProLProgram {
+
+public:
+  TAProLProgram(const std::string &source) : source_(source) {}
+
+  TAProLProgram(const TAProLProgram &) = delete;
+  TAProLProgram &operator=(const TAProLProgram &) = delete;
+  virtual ~TAProLProgram() = default;
+
+  /** Appends an instruction to the program. **/
+  void append(TAProLInstruction &&instruction);
+
+  /** Executes the program and appends the values of the saved scalar
+      tensors to results (tag, value). Returns FALSE on failure. **/
+  bool execute(std::vector<std::pair<std::string, std::complex<double>>> &results);
+
+  /** Returns the TAProL source the program was compiled from. **/
+  const std::string &getSource() const { return source_; }
+
+  /** Returns the number of instructions in the program. **/
+  std::size_t getNumInstructions() const { return instructions_.size(); }
+
+protected:
+  bool executeInstruction(TAProLInstruction &instruction,
+                          std::map<std::string, double> &scalars,
+                          unsigned int &num_open_scopes,
+                          std::vector<std::pair<std::string, std::complex<double>>> &results);
+
+  std::string source_;                         // TAProL source
+  std::vector<TAProLInstruction> instructions_; // lowered instructions
+};
+
+} // namespace parser
+
+} // namespace exatn
+
+#endif // EXATN_TAPROLPROGRAM_HPP_
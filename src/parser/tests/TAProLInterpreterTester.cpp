@@ -39,6 +39,43 @@ TEST(TAProLInterpreterTester, checkSimple) {
   interpreter.interpret(src);
 }
 
+TEST(TAProLInterpreterTester, checkCachedProgram) {
+
+  TAProLInterpreter interpreter;
+
+  const std::string src = R"src(
+  entry: main
+  scope main group()
+   subspace(): q0=[0:7]
+   index(q0): a,b,c,d,i,j
+   T2(a,b,c,d) = {0.5,0.0}
+   Z2(a,b,c,d) = {0.0,0.0}
+   Z2(a,b,c,d) += T2(i,j,a,b) * T2(c,d,i,j)
+   Z2(a,b,c,d) += T2(a,b,c,d) * 2.0
+   X2() = {0.0,0.0}
+   X2() += Z2+(a,b,c,d) * Z2(a,b,c,d)
+   save X2: tag("Z2_norm2")
+   destroy X2,Z2,T2
+  end scope main
+  )src";
+
+  // The source is lowered only once
+  auto program = interpreter.compile(src);
+  ASSERT_TRUE(program);
+  EXPECT_EQ(program, interpreter.compile(src));
+  EXPECT_EQ(1, interpreter.getNumCachedPrograms());
+
+  // Repeated executions reuse the cached program: Z2 = 8*8*0.25 + 2*0.5 = 17
+  for (int i = 0; i < 3; ++i) {
+    std::vector<std::pair<std::string, std::complex<double>>> results;
+    ASSERT_TRUE(interpreter.execute(src, results));
+    ASSERT_EQ(1, results.size());
+    EXPECT_EQ("Z2_norm2", results[0].first);
+    EXPECT_NEAR(4096.0 * 289.0, std::real(results[0].second), 1e-6);
+  }
+  EXPECT_EQ(1, interpreter.getNumCachedPrograms());
+}
+
 int main(int argc, char **argv) {
   exatn::initialize();
 
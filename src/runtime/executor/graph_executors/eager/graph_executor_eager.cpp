@@ -1,5 +1,5 @@
 /** ExaTN:: Tensor Runtime: Tensor graph executor: Eager
-REVISION: 2020/09/02
+REVISION: 2020/12/05
 
 Copyright (C) 2018-2020 Tiffany Mintz, Dmitry Lyakh, Alex McCaskey
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle)
@@ -18,14 +18,19 @@ namespace exatn {
 namespace runtime {
 
 void EagerGraphExecutor::execute(TensorGraph & dag) {
+  const auto issue_quota = this->getIssueQuota();
+  std::size_t num_issued = 0; //number of tensor operations issued in this invocation
   auto num_nodes = dag.getNumNodes();
   auto current = dag.getFrontNode();
   while(current < num_nodes){
+    if(issue_quota > 0 && num_issued++ >= issue_quota) break; //yield to other DAGs
     TensorOpExecHandle exec_handle;
     auto & dag_node = dag.getNodeProperties(current);
     if(!(dag_node.isExecuted())){
+      dag_node.lock(); //idle DAG nodes may be updated by the main thread (transform fusion)
       dag.setNodeExecuting(current);
       auto op = dag_node.getOperation();
+      dag_node.unlock();
       if(logging_.load() != 0){
         logfile_ << "[" << std::fixed << std::setprecision(6) << exatn::Timer::timeInSecHR(getTimeStampStart())
                  << "](EagerGraphExecutor)[EXEC_THREAD]: Submitting tensor operation "
@@ -1,5 +1,5 @@
 /** ExaTN:: Tensor Runtime: Tensor graph executor: Lazy
-REVISION: 2020/10/22
+REVISION: 2020/12/14
 
 Copyright (C) 2018-2020 Dmitry Lyakh
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle)
@@ -19,6 +19,138 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle)
 namespace exatn {
 namespace runtime {
 
+/** Returns the log entry naming the kernel a completed tensor contraction has been executed with. **/
+inline std::string executed_kernel_info(const numerics::TensorOperation & op)
+{
+  if(op.getOpcode() == TensorOpCode::CONTRACT){
+    const auto & kernel = static_cast<const numerics::TensorOpContract&>(op).getKernel();
+    if(kernel.length() > 0) return (": Kernel = " + kernel);
+  }
+  return std::string();
+}
+
+
+LazyGraphExecutor::~LazyGraphExecutor()
+{
+#ifdef DEBUG
+  const bool debugging = true;
+#else
+  const bool debugging = false;
+#endif
+  if((debugging || logging_.load() != 0) && node_executor_ && peak_live_bytes_.load() > 0) printMemoryStatistics();
+}
+
+
+void LazyGraphExecutor::printMemoryStatistics() const
+{
+  const auto buffer_size = getMemoryBufferSize();
+  const std::size_t peak_bytes = peak_live_bytes_.load();
+  std::cout << "#MSG(exatn::runtime::LazyGraphExecutor): Peak memory usage: " << peak_bytes
+            << " bytes out of " << buffer_size << " bytes of the memory buffer ("
+            << (peak_bytes * 100 / buffer_size) << "%); Currently live: " << live_bytes_
+            << " bytes in " << live_tensors_.size() << " tensors (" << getResidentMemorySize()
+            << " bytes resident)" << std::endl;
+  return;
+}
+
+
+std::size_t LazyGraphExecutor::getResidentMemorySize() const
+{
+  const auto spilled_bytes = node_executor_->getSpilledMemorySize();
+  const auto auxiliary_bytes = node_executor_->getAuxiliaryMemorySize();
+  return ((live_bytes_ > spilled_bytes) ? (live_bytes_ - spilled_bytes) : 0) + auxiliary_bytes;
+}
+
+
+bool LazyGraphExecutor::underMemoryPressure() const
+{
+  if(allocation_blocked_) return true;
+  return (getResidentMemorySize() >= (getMemoryBufferSize() / 100) * MEMORY_PRESSURE_PERCENT);
+}
+
+
+std::size_t LazyGraphExecutor::getAllocationSize(const numerics::TensorOperation & op) const
+{
+  std::size_t size = 0;
+  if(op.getOpcode() == TensorOpCode::CREATE){
+    const auto & create_op = static_cast<const numerics::TensorOpCreate &>(op);
+    const auto tensor = op.getTensorOperand(0);
+    if(tensor) size = tensor->getVolume() * numerics::tensor_element_type_size(create_op.getTensorElementType());
+  }
+  return size;
+}
+
+
+void LazyGraphExecutor::updateLiveMemory(const numerics::TensorOperation & op)
+{
+  const auto opcode = op.getOpcode();
+  if(opcode == TensorOpCode::CREATE){
+    const auto size = getAllocationSize(op);
+    auto res = live_tensors_.emplace(std::make_pair(op.getTensorOperandHash(0),size));
+    if(res.second){
+      live_bytes_ += size;
+      const auto resident_bytes = getResidentMemorySize();
+      if(resident_bytes > peak_live_bytes_.load()) peak_live_bytes_.store(resident_bytes);
+    }
+    allocation_blocked_ = false; //allocation succeeded
+  }else if(opcode == TensorOpCode::DESTROY){
+    auto iter = live_tensors_.find(op.getTensorOperandHash(0));
+    if(iter != live_tensors_.end()){
+      live_bytes_ -= iter->second;
+      live_tensors_.erase(iter);
+    }
+    allocation_blocked_ = false; //memory released
+  }
+  return;
+}
+
+
+bool LazyGraphExecutor::selectReadyNode(TensorGraph & dag, VertexIdType * node)
+{
+  const auto buffer_size = getMemoryBufferSize();
+  const auto resident_bytes = getResidentMemorySize();
+  if(!underMemoryPressure()){ //regular order of dependency-free DAG nodes
+    if(!dag.extractDependencyFreeNode(node)) return false;
+    auto & dag_node = dag.getNodeProperties(*node);
+    dag_node.lock(); //idle DAG nodes may be updated by the main thread (transform fusion)
+    auto op = dag_node.getOperation();
+    dag_node.unlock();
+    if(resident_bytes + getAllocationSize(*op) <= buffer_size) return true;
+    auto registered = dag.registerDependencyFreeNode(*node); assert(registered); //does not fit: reconsider below
+  }
+  //Memory pressure: Prefer DAG nodes releasing memory, postpone new allocations:
+  const auto free_nodes = dag.getDependencyFreeNodes();
+  if(free_nodes.empty()) return false;
+  int best_priority = 3; //0: releases memory; 1: does not allocate memory; 2: allocation fits; 3: not admitted
+  for(const auto & free_node: free_nodes){
+    auto & dag_node = dag.getNodeProperties(free_node);
+    dag_node.lock(); //idle DAG nodes may be updated by the main thread (transform fusion)
+    auto op = dag_node.getOperation();
+    dag_node.unlock();
+    int priority = 1;
+    if(op->getOpcode() == TensorOpCode::DESTROY){
+      priority = 0;
+    }else{
+      const auto alloc_size = getAllocationSize(*op);
+      if(alloc_size > 0) priority = (!allocation_blocked_ && resident_bytes + alloc_size <= buffer_size) ? 2 : 3;
+    }
+    if(priority < best_priority){
+      *node = free_node;
+      best_priority = priority;
+      if(priority == 0) break;
+    }
+  }
+  if(best_priority == 3){ //all dependency-free DAG nodes allocate memory which is not available
+    if(dag.executingNodesBegin() != dag.executingNodesEnd()) return false; //wait for memory release
+    *node = free_nodes.front(); //nothing in flight could release memory: retry allocation
+  }
+  if(logging_.load() > 1) logfile_ << "DAG node selected under memory pressure: " << *node
+                                   << " with priority " << best_priority << std::endl;
+  auto extracted = dag.extractDependencyFreeNode(*node); assert(extracted);
+  return extracted;
+}
+
+
 void LazyGraphExecutor::execute(TensorGraph & dag) {
 
   struct Progress {
@@ -68,7 +200,9 @@ void LazyGraphExecutor::execute(TensorGraph & dag) {
           if(registered && logging_.load() > 1) logfile_ << "DAG node detected with all dependencies resolved: " << progress.current << std::endl;
         }else{ //node still has unresolved dependencies, try prefetching
           if(progress.current < (progress.front + this->getPrefetchDepth())){
+            dag_node.lock(); //idle DAG nodes may be updated by the main thread (transform fusion)
             auto prefetching = this->node_executor_->prefetch(*(dag_node.getOperation()));
+            dag_node.unlock();
             if(logging_.load() != 0 && prefetching){
               logfile_ << "[" << std::fixed << std::setprecision(6) << exatn::Timer::timeInSecHR(getTimeStampStart())
                        << "](LazyGraphExecutor)[EXEC_THREAD]: Initiated prefetch for tensor operation "
@@ -92,10 +226,13 @@ void LazyGraphExecutor::execute(TensorGraph & dag) {
       logfile_ << std::endl;
     }
     VertexIdType node;
-    bool issued = dag.extractDependencyFreeNode(&node);
+    bool issued = this->selectReadyNode(dag,&node);
     if(issued){
       auto & dag_node = dag.getNodeProperties(node);
+      dag_node.lock(); //idle DAG nodes may be updated by the main thread (transform fusion)
+      dag.setNodeExecuting(node);
       auto op = dag_node.getOperation();
+      dag_node.unlock();
       if(logging_.load() != 0){
         logfile_ << "[" << std::fixed << std::setprecision(6) << exatn::Timer::timeInSecHR(getTimeStampStart())
                  << "](LazyGraphExecutor)[EXEC_THREAD]: Submitting tensor operation "
@@ -108,12 +245,12 @@ void LazyGraphExecutor::execute(TensorGraph & dag) {
         logfile_.flush();
 #endif
       }
-      dag.setNodeExecuting(node);
       op->recordStartTime();
       TensorOpExecHandle exec_handle;
       auto error_code = op->accept(*(this->node_executor_),&exec_handle);
       if(logging_.load() != 0) logfile_ << ": Status = " << error_code;
       if(error_code == 0){ //tensor operation submitted for execution successfully
+        this->updateLiveMemory(*op);
         if(logging_.load() != 0) logfile_ << ": Syncing ... ";
         auto synced = this->node_executor_->sync(exec_handle,&error_code,false);
         if(synced){ //tensor operation has completed immediately
@@ -122,7 +259,8 @@ void LazyGraphExecutor::execute(TensorGraph & dag) {
           if(error_code == 0){
             if(logging_.load() != 0){
               logfile_ << "Success [" << std::fixed << std::setprecision(6)
-                       << exatn::Timer::timeInSecHR(getTimeStampStart()) << "]" << std::endl;
+                       << exatn::Timer::timeInSecHR(getTimeStampStart()) << "]"
+                       << executed_kernel_info(*op) << std::endl;
 #ifdef DEBUG
               logfile_.flush();
 #endif
@@ -160,7 +298,9 @@ void LazyGraphExecutor::execute(TensorGraph & dag) {
         auto registered = dag.registerDependencyFreeNode(node); assert(registered);
         issued = false;
         if(error_code == TRY_LATER){ //temporary shortage of resources
-          if(logging_.load() != 0) logfile_ << ": Postponed" << std::endl;
+          allocation_blocked_ = true; //postpone new allocations until memory has been released
+          if(logging_.load() != 0) logfile_ << ": Postponed: Resident memory = " << getResidentMemorySize()
+                                            << " bytes" << std::endl;
         }else{ //fatal error
           if(logging_.load() != 0) logfile_.flush();
           std::cout << "#ERROR(exatn::TensorRuntime::GraphExecutorLazy): Failed to submit tensor operation "
@@ -185,11 +325,13 @@ void LazyGraphExecutor::execute(TensorGraph & dag) {
         auto op = dag_node.getOperation();
         op->recordFinishTime();
         dag.setNodeExecuted(node,error_code);
+        allocation_blocked_ = false; //completed tensor operation may have released temporary memory
         if(error_code == 0){
           if(logging_.load() != 0){
             logfile_ << "[" << std::fixed << std::setprecision(6) << exatn::Timer::timeInSecHR(getTimeStampStart())
                      << "](LazyGraphExecutor)[EXEC_THREAD]: Synced tensor operation "
-                     << node << ": Opcode = " << static_cast<int>(op->getOpcode()) << std::endl;
+                     << node << ": Opcode = " << static_cast<int>(op->getOpcode())
+                     << executed_kernel_info(*op) << std::endl;
 #ifdef DEBUG
             logfile_.flush();
 #endif
@@ -231,16 +373,25 @@ void LazyGraphExecutor::execute(TensorGraph & dag) {
     for(const auto & node: free_nodes) logfile_ << " " << node;
     logfile_ << std::endl << std::flush;
   }
+  const auto issue_quota = this->getIssueQuota();
+  std::size_t num_issued = 0; //number of tensor operations issued in this invocation
+  std::size_t num_sweeps = 0; //number of DAG sweeps in this invocation
   bool not_done = (progress.front < progress.num_nodes);
   while(not_done){
     //Try to issue all idle DAG nodes that are ready for execution:
-    while(issue_ready_node());
+    while(issue_ready_node()){
+      if(issue_quota > 0 && ++num_issued >= issue_quota) break;
+    }
     //Inspect whether the current node can be issued:
     auto node_ready = inspect_node_dependencies();
     //Test the currently executing DAG nodes for completion:
     test_nodes_for_completion();
     //Find the next idle DAG node:
     not_done = find_next_idle_node() || (progress.front < progress.num_nodes);
+    //Yield to other DAGs once the issue quota is exhausted or the pipeline window has been swept:
+    if(issue_quota > 0 && not_done){
+      if(num_issued >= issue_quota || ++num_sweeps >= this->getPipelineDepth()) break;
+    }
   }
   return;
 }
@@ -1,11 +1,28 @@
 /** ExaTN:: Tensor Runtime: Tensor graph executor: Lazy
-REVISION: 2020/06/22
+REVISION: 2020/12/14
 
 Copyright (C) 2018-2020 Dmitry Lyakh, Alex McCaskey
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle)
 
 Rationale:
-
+ (a) The lazy graph executor keeps track of the live bytes of all tensors
+     it has created (per tensor) and admits a dependency-free DAG node for
+     execution only if its working set fits into the memory buffer of the
+     node executor (currently only tensor creation allocates persistent memory).
+ (b) Once the node executor fails to allocate memory (TRY_LATER), or the live
+     bytes exceed the memory pressure threshold, the executor prefers DAG nodes
+     freeing memory (tensor destruction), followed by DAG nodes not allocating
+     new tensors (e.g., final contractions of intermediates, which enable their
+     subsequent destruction). New tensor allocations are postponed until memory
+     has been released, instead of being retried in a spin, unless there are
+     no other DAG nodes in flight which could release memory.
+ (c) The peak of the resident bytes is reported against the memory buffer size
+     upon destruction of the executor (when debugging or logging).
+ (d) Live tensors spilled out of the memory buffer by the node executor do not
+     count against it: Admission and memory pressure are based on the resident
+     bytes (live bytes minus the spilled bytes reported by the node executor).
+     Auxiliary data held by the node executor in the memory buffer (e.g., temporary
+     single-precision copies of 16-bit tensors) adds to the resident bytes.
 **/
 
 #ifndef EXATN_RUNTIME_LAZY_GRAPH_EXECUTOR_HPP_
@@ -13,6 +30,9 @@ Rationale:
 
 #include "tensor_graph_executor.hpp"
 
+#include <unordered_map>
+#include <atomic>
+
 namespace exatn {
 namespace runtime {
 
@@ -22,11 +42,14 @@ public:
 
   static constexpr const unsigned int DEFAULT_PIPELINE_DEPTH = 16;
   static constexpr const unsigned int DEFAULT_PREFETCH_DEPTH = 4;
+  static constexpr const unsigned int MEMORY_PRESSURE_PERCENT = 90; //memory pressure threshold (% of the memory buffer)
 
   LazyGraphExecutor(): pipeline_depth_(DEFAULT_PIPELINE_DEPTH),
-                       prefetch_depth_(DEFAULT_PREFETCH_DEPTH) {}
+                       prefetch_depth_(DEFAULT_PREFETCH_DEPTH),
+                       live_bytes_(0), peak_live_bytes_(0),
+                       allocation_blocked_(false) {}
 
-  virtual ~LazyGraphExecutor() = default;
+  virtual ~LazyGraphExecutor();
 
   /** Traverses the DAG and executes all its nodes. **/
   virtual void execute(TensorGraph & dag) override;
@@ -40,14 +63,44 @@ public:
   /** Returns the current pipeline depth. **/
   inline unsigned int getPipelineDepth() const {return pipeline_depth_;}
 
+  /** Returns the total size of the live tensors created by this executor (bytes). **/
+  inline std::size_t getLiveMemorySize() const {return live_bytes_;}
+
+  /** Returns the total size of the live tensors and auxiliary data residing in the memory buffer (bytes), see Rationale (d). **/
+  std::size_t getResidentMemorySize() const;
+
+  /** Returns the peak total size of the live tensors residing in the memory buffer (bytes). **/
+  std::size_t getPeakMemorySize() const override {return peak_live_bytes_.load();}
+
+  /** Prints the peak memory usage against the memory buffer size. **/
+  void printMemoryStatistics() const;
+
   const std::string name() const override {return "lazy-dag-executor";}
   const std::string description() const override {return "Lazy tensor graph executor";}
   std::shared_ptr<TensorGraphExecutor> clone() override {return std::make_shared<LazyGraphExecutor>();}
 
 protected:
 
+  /** Returns TRUE if the executor is under memory pressure, see Rationale (b). **/
+  bool underMemoryPressure() const;
+
+  /** Returns the number of bytes a tensor operation will allocate (tensor creation). **/
+  std::size_t getAllocationSize(const numerics::TensorOperation & op) const;
+
+  /** Selects a dependency-free DAG node for execution and extracts it from the list
+      of dependency-free nodes, see Rationale (a,b,d). Returns FALSE if no DAG node
+      can currently be admitted for execution. **/
+  bool selectReadyNode(TensorGraph & dag, VertexIdType * node);
+
+  /** Updates the live bytes upon a successful submission of a tensor operation. **/
+  void updateLiveMemory(const numerics::TensorOperation & op);
+
  unsigned int pipeline_depth_; //max number of active tensor operations in flight
  unsigned int prefetch_depth_; //max number of tensor operations with active prefetch
+ std::unordered_map<numerics::TensorHashType,std::size_t> live_tensors_; //live tensors created by this executor: tensor hash --> size in bytes
+ std::size_t live_bytes_;      //total size of the live tensors in bytes
+ std::atomic<std::size_t> peak_live_bytes_; //peak total size of the resident live tensors in bytes (read by the main thread)
+ bool allocation_blocked_;     //TRUE after a failed memory allocation until memory has been released
 };
 
 } //namespace runtime
@@ -1,5 +1,5 @@
 /** ExaTN:: Tensor Runtime: Tensor graph node executor: Exatensor
-REVISION: 2020/08/11
+REVISION: 2020/11/19
 
 Copyright (C) 2018-2020 Dmitry Lyakh, Tiffany Mintz, Alex McCaskey
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle)
@@ -130,6 +130,14 @@ int ExatensorNodeExecutor::execute(numerics::TensorOpAllreduce & op,
 }
 
 
+int ExatensorNodeExecutor::execute(numerics::TensorOpContractBatch & op,
+                                   TensorOpExecHandle * exec_handle)
+{
+ //`Implement
+ return 0;
+}
+
+
 bool ExatensorNodeExecutor::sync(TensorOpExecHandle op_handle,
                                  int * error_code,
                                  bool wait)
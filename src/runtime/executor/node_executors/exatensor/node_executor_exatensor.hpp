@@ -1,5 +1,5 @@
 /** ExaTN:: Tensor Runtime: Tensor graph node executor: Exatensor
-REVISION: 2020/08/11
+REVISION: 2020/11/19
 
 Copyright (C) 2018-2020 Dmitry Lyakh, Tiffany Mintz, Alex McCaskey
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle)
@@ -61,6 +61,8 @@ public:
               TensorOpExecHandle * exec_handle) override;
   int execute(numerics::TensorOpAllreduce & op,
               TensorOpExecHandle * exec_handle) override;
+  int execute(numerics::TensorOpContractBatch & op,
+              TensorOpExecHandle * exec_handle) override;
 
   bool sync(TensorOpExecHandle op_handle,
             int * error_code,
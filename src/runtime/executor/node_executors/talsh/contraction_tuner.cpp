@@ -0,0 +1,369 @@
+/** ExaTN:: Tensor Runtime: Tensor graph node executor: Tensor contraction kernel autotuning
+REVISION: 2020/12/14
+
+Copyright (C) 2018-2020 Dmitry Lyakh, Tiffany Mintz, Alex McCaskey
+Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle)
+**/
+
+#include "contraction_tuner.hpp"
+
+#include "tensor_symbol.hpp"
+
+#include "talshxx.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+#include <cmath>
+#include <cstdint>
+
+#include "errors.hpp"
+
+namespace exatn {
+namespace runtime {
+
+const char * get_contraction_kernel_name(ContractionKernel kernel)
+{
+ switch(kernel){
+  case ContractionKernel::TALSH: return "talsh";
+  case ContractionKernel::DIRECT: return "direct";
+ }
+ return "unknown";
+}
+
+
+/** Parses a tensor contraction kernel name. Returns FALSE on an unknown name. **/
+inline bool parse_contraction_kernel_name(const std::string & kernel_name, ContractionKernel * kernel)
+{
+ if(kernel_name == get_contraction_kernel_name(ContractionKernel::TALSH)){
+  *kernel = ContractionKernel::TALSH; return true;
+ }
+ if(kernel_name == get_contraction_kernel_name(ContractionKernel::DIRECT)){
+  *kernel = ContractionKernel::DIRECT; return true;
+ }
+ return false;
+}
+
+
+std::string get_contraction_signature(const std::string & pattern,
+                                      const std::vector<std::vector<int>> & dims,
+                                      int data_kind)
+{
+ std::string signature;
+ for(const auto & ch: pattern) if(ch != ' ') signature.push_back(ch);
+ signature.push_back('|');
+ for(std::size_t i = 0; i < dims.size(); ++i){
+  if(i > 0) signature.push_back(';');
+  for(std::size_t j = 0; j < dims[i].size(); ++j){
+   if(j > 0) signature.push_back(',');
+   signature += std::to_string(dims[i][j]);
+  }
+ }
+ signature.push_back('|');
+ signature += std::to_string(data_kind);
+ return signature;
+}
+
+
+bool plan_direct_contraction(const std::string & pattern,
+                             const std::vector<std::vector<int>> & dims,
+                             DirectContraction & plan)
+{
+ struct IndexInfo {std::size_t extent; std::size_t stride[3]; bool present[3];};
+ if(dims.size() != 3) return false;
+ std::vector<std::string> tensors;
+ if(!parse_tensor_network(pattern,tensors)) return false;
+ if(tensors.size() != 3) return false;
+ std::unordered_map<std::string,IndexInfo> index_info;
+ std::vector<IndexLabel> indices[3];
+ bool conjugated[3];
+ for(unsigned int i = 0; i < 3; ++i){
+  std::string tensor_name;
+  if(!parse_tensor(tensors[i],tensor_name,indices[i],conjugated[i])) return false;
+  if(indices[i].size() != dims[i].size()) return false;
+  std::size_t stride = 1;
+  for(std::size_t j = 0; j < indices[i].size(); ++j){
+   if(dims[i][j] <= 0) return false;
+   const auto extent = static_cast<std::size_t>(dims[i][j]);
+   auto res = index_info.emplace(std::make_pair(indices[i][j].label,IndexInfo{extent,{0,0,0},{false,false,false}}));
+   auto & info = res.first->second;
+   if(info.present[i] || info.extent != extent) return false; //repeated index or extent mismatch
+   info.stride[i] = stride;
+   info.present[i] = true;
+   stride *= extent;
+  }
+ }
+ if(conjugated[0]) return false;
+ plan.conj_left = conjugated[1];
+ plan.conj_right = conjugated[2];
+ //Output indices must appear in exactly one input tensor (no hyper-indices):
+ plan.out_extents.clear(); plan.out_lstrides.clear(); plan.out_rstrides.clear();
+ plan.out_volume = 1;
+ for(const auto & index: indices[0]){
+  const auto & info = index_info[index.label];
+  if(info.present[1] == info.present[2]) return false;
+  plan.out_extents.emplace_back(info.extent);
+  plan.out_lstrides.emplace_back(info.stride[1]);
+  plan.out_rstrides.emplace_back(info.stride[2]);
+  plan.out_volume *= info.extent;
+ }
+ //Contracted indices must appear in both input tensors:
+ plan.contr_extents.clear(); plan.contr_lstrides.clear(); plan.contr_rstrides.clear();
+ plan.contr_volume = 1;
+ for(unsigned int i = 1; i < 3; ++i){
+  for(const auto & index: indices[i]){
+   const auto & info = index_info[index.label];
+   if(info.present[0]) continue;
+   if(!(info.present[1] && info.present[2])) return false;
+   if(i == 1){
+    plan.contr_extents.emplace_back(info.extent);
+    plan.contr_lstrides.emplace_back(info.stride[1]);
+    plan.contr_rstrides.emplace_back(info.stride[2]);
+    plan.contr_volume *= info.extent;
+   }
+  }
+ }
+ return true;
+}
+
+
+template<typename T>
+inline T conjugate(const T & value)
+{
+ return value;
+}
+
+template<typename T>
+inline std::complex<T> conjugate(const std::complex<T> & value)
+{
+ return std::conj(value);
+}
+
+
+template<typename T>
+struct ScalarCast {
+ static T get(const std::complex<double> & scalar){return static_cast<T>(scalar.real());}
+};
+
+template<typename T>
+struct ScalarCast<std::complex<T>> {
+ static std::complex<T> get(const std::complex<double> & scalar){
+  return std::complex<T>{static_cast<T>(scalar.real()),static_cast<T>(scalar.imag())};
+ }
+};
+
+
+template<typename T, bool CONJ_LEFT, bool CONJ_RIGHT>
+void contract_direct_body(const DirectContraction & plan,
+                          const std::vector<DirectContractionOperands> & batch)
+{
+ const std::size_t out_rank = plan.out_extents.size();
+ const std::size_t contr_rank = plan.contr_extents.size();
+ const std::int64_t batch_volume = static_cast<std::int64_t>(plan.out_volume * batch.size());
+#pragma omp parallel
+ {
+  std::vector<std::size_t> counter(contr_rank);
+  //Single loop over the output tensor elements of all tensor contractions from the batch:
+#pragma omp for schedule(static)
+  for(std::int64_t bd = 0; bd < batch_volume; ++bd){
+   const auto & member = batch[static_cast<std::size_t>(bd) / plan.out_volume];
+   const std::size_t d = static_cast<std::size_t>(bd) % plan.out_volume;
+   auto * dbody = static_cast<T*>(member.dbody);
+   const auto * lbody = static_cast<const T*>(member.lbody);
+   const auto * rbody = static_cast<const T*>(member.rbody);
+   //Output multi-index --> offsets in the input tensors:
+   std::size_t loff = 0, roff = 0, rem = d;
+   for(std::size_t k = 0; k < out_rank; ++k){
+    const std::size_t idx = rem % plan.out_extents[k];
+    rem /= plan.out_extents[k];
+    loff += idx * plan.out_lstrides[k];
+    roff += idx * plan.out_rstrides[k];
+   }
+   //Sum over the contracted multi-index (odometer):
+   std::fill(counter.begin(),counter.end(),0);
+   T sum = T(0);
+   for(std::size_t c = 0; c < plan.contr_volume; ++c){
+    const T lval = (CONJ_LEFT ? conjugate(lbody[loff]) : lbody[loff]);
+    const T rval = (CONJ_RIGHT ? conjugate(rbody[roff]) : rbody[roff]);
+    sum += lval * rval;
+    for(std::size_t k = 0; k < contr_rank; ++k){
+     loff += plan.contr_lstrides[k];
+     roff += plan.contr_rstrides[k];
+     if(++counter[k] < plan.contr_extents[k]) break;
+     loff -= plan.contr_lstrides[k] * plan.contr_extents[k];
+     roff -= plan.contr_rstrides[k] * plan.contr_extents[k];
+     counter[k] = 0;
+    }
+   }
+   const T alpha = ScalarCast<T>::get(member.alpha);
+   dbody[d] = (member.accumulative ? dbody[d] + sum * alpha : sum * alpha);
+  }
+ }
+ return;
+}
+
+
+template<typename T>
+void contract_direct_typed(const DirectContraction & plan,
+                           const std::vector<DirectContractionOperands> & batch)
+{
+ if(plan.conj_left){
+  if(plan.conj_right){
+   contract_direct_body<T,true,true>(plan,batch);
+  }else{
+   contract_direct_body<T,true,false>(plan,batch);
+  }
+ }else{
+  if(plan.conj_right){
+   contract_direct_body<T,false,true>(plan,batch);
+  }else{
+   contract_direct_body<T,false,false>(plan,batch);
+  }
+ }
+ return;
+}
+
+
+bool contract_direct(const DirectContraction & plan,
+                     int data_kind,
+                     void * dbody,
+                     const void * lbody,
+                     const void * rbody,
+                     std::complex<double> alpha,
+                     bool accumulative)
+{
+ return contract_direct_batch(plan,data_kind,
+  std::vector<DirectContractionOperands>{DirectContractionOperands{dbody,lbody,rbody,alpha,accumulative}});
+}
+
+
+bool contract_direct_batch(const DirectContraction & plan,
+                           int data_kind,
+                           const std::vector<DirectContractionOperands> & batch)
+{
+ switch(data_kind){
+  case(talsh::REAL32):
+   contract_direct_typed<float>(plan,batch); break;
+  case(talsh::REAL64):
+   contract_direct_typed<double>(plan,batch); break;
+  case(talsh::COMPLEX32):
+   contract_direct_typed<std::complex<float>>(plan,batch); break;
+  case(talsh::COMPLEX64):
+   contract_direct_typed<std::complex<double>>(plan,batch); break;
+  default:
+   return false;
+ }
+ return true;
+}
+
+
+template<typename T>
+bool compare_bodies(const void * body, const void * ref, std::size_t volume, double tolerance)
+{
+ const auto * ptr = static_cast<const T*>(body);
+ const auto * ref_ptr = static_cast<const T*>(ref);
+ double max_diff = 0.0, max_ref = 0.0;
+ for(std::size_t i = 0; i < volume; ++i){
+  max_diff = std::max(max_diff,static_cast<double>(std::abs(ptr[i] - ref_ptr[i])));
+  max_ref = std::max(max_ref,static_cast<double>(std::abs(ref_ptr[i])));
+ }
+ return (max_diff <= tolerance * max_ref); //NaN differences fail
+}
+
+
+bool compare_tensor_bodies(int data_kind,
+                           const void * body,
+                           const void * ref,
+                           std::size_t volume)
+{
+ switch(data_kind){
+  case(talsh::REAL32): return compare_bodies<float>(body,ref,volume,1e-4);
+  case(talsh::REAL64): return compare_bodies<double>(body,ref,volume,1e-10);
+  case(talsh::COMPLEX32): return compare_bodies<std::complex<float>>(body,ref,volume,1e-4);
+  case(talsh::COMPLEX64): return compare_bodies<std::complex<double>>(body,ref,volume,1e-10);
+ }
+ return false;
+}
+
+
+ContractionTuner::ContractionTuner(const std::string & database_file):
+ database_file_(database_file), num_loaded_(0), num_tuned_(0), num_hits_(0), tuning_time_(0.0),
+ num_executed_{0,0}
+{
+ if(!database_file_.empty()){
+  std::ifstream database(database_file_);
+  if(database.is_open()){
+   std::string line;
+   while(std::getline(database,line)){
+    std::istringstream entry(line);
+    std::string signature, kernel_name;
+    ContractionKernel kernel;
+    if(entry >> signature >> kernel_name){
+     if(parse_contraction_kernel_name(kernel_name,&kernel)){
+      kernels_[signature] = kernel; //the last entry wins
+      ++num_loaded_;
+     }
+    }
+   }
+  }
+ }
+}
+
+
+bool ContractionTuner::findKernel(const std::string & signature,
+                                  ContractionKernel * kernel)
+{
+ auto iter = kernels_.find(signature);
+ if(iter == kernels_.end()) return false;
+ *kernel = iter->second;
+ ++num_hits_;
+ return true;
+}
+
+
+void ContractionTuner::recordKernel(const std::string & signature,
+                                    ContractionKernel kernel,
+                                    double talsh_time,
+                                    double direct_time,
+                                    double tuning_time)
+{
+ kernels_[signature] = kernel;
+ ++num_tuned_;
+ tuning_time_ += tuning_time;
+ if(!database_file_.empty()){
+  std::ostringstream entry; //a single write per entry keeps concurrent appends by multiple processes intact
+  entry << signature << " " << get_contraction_kernel_name(kernel) << " "
+        << std::scientific << talsh_time << " " << direct_time << std::endl;
+  std::ofstream database(database_file_,std::ios::out|std::ios::app);
+  if(database.is_open()){
+   database << entry.str() << std::flush;
+  }else{
+   std::cout << "#ERROR(exatn::runtime::ContractionTuner): Unable to append to the tuning database file "
+             << database_file_ << std::endl;
+  }
+ }
+ return;
+}
+
+
+void ContractionTuner::countExecution(ContractionKernel kernel)
+{
+ ++num_executed_[static_cast<int>(kernel)];
+ return;
+}
+
+
+void ContractionTuner::printStatistics() const
+{
+ std::cout << "#MSG(exatn::runtime::ContractionTuner): Tensor contraction kernels: "
+           << get_contraction_kernel_name(ContractionKernel::TALSH) << " " << num_executed_[0] << ", "
+           << get_contraction_kernel_name(ContractionKernel::DIRECT) << " " << num_executed_[1]
+           << "; Signatures: " << num_loaded_ << " loaded, " << num_hits_ << " reused, "
+           << num_tuned_ << " tuned in " << tuning_time_ << " sec" << std::endl;
+ return;
+}
+
+} //namespace runtime
+} //namespace exatn
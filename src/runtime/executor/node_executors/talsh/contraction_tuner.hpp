@@ -0,0 +1,153 @@
+/** ExaTN:: Tensor Runtime: Tensor graph node executor: Tensor contraction kernel autotuning
+REVISION: 2020/12/14
+
+Copyright (C) 2018-2020 Dmitry Lyakh, Tiffany Mintz, Alex McCaskey
+Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle)
+
+Rationale:
+ (a) The fastest kernel executing a tensor contraction depends on its index pattern,
+     tensor shapes and tensor element type. Candidate kernels: TAL-SH (tensor transposes
+     followed by GEMM, any device) and direct loops over the output and contracted indices
+     on Host (no tensor transposes, no temporary memory), which is often faster for small
+     tensor contractions and tensor contractions with short or strided contracted indices.
+ (b) ContractionTuner keeps the winning kernel for each tensor contraction signature
+     (reduced index pattern, reduced tensor extents, tensor element type). The tuning
+     database can be backed by a text file which is loaded upon construction and
+     appended to (one line per signature) whenever a new signature has been tuned,
+     thus tuning results are reused across runs and shared by MPI processes.
+     Signatures tuned concurrently by multiple MPI processes are harmless duplicates
+     (the last entry wins upon loading).
+ (c) A batch of tensor contractions sharing the same loop nest (congruent tensor operands)
+     can be executed by the direct kernel in a single multithreaded loop over the output
+     tensor elements of all batch members, which amortizes the per-contraction overhead
+     and keeps all threads busy even when individual tensor contractions are tiny.
+**/
+
+#ifndef EXATN_RUNTIME_CONTRACTION_TUNER_HPP_
+#define EXATN_RUNTIME_CONTRACTION_TUNER_HPP_
+
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <complex>
+
+#include <cstddef>
+
+namespace exatn {
+namespace runtime {
+
+enum class ContractionKernel {
+  TALSH,  //TAL-SH tensor contraction (transpose + GEMM)
+  DIRECT  //direct loops on Host
+};
+
+/** Returns the name of a tensor contraction kernel. **/
+const char * get_contraction_kernel_name(ContractionKernel kernel);
+
+/** Loop nest of a direct tensor contraction (column-major tensor layout). **/
+struct DirectContraction {
+  std::vector<std::size_t> out_extents;    //extents of the output indices (output dimension order)
+  std::vector<std::size_t> out_lstrides;   //strides of the output indices in the left tensor (0: absent)
+  std::vector<std::size_t> out_rstrides;   //strides of the output indices in the right tensor (0: absent)
+  std::vector<std::size_t> contr_extents;  //extents of the contracted indices (left dimension order)
+  std::vector<std::size_t> contr_lstrides; //strides of the contracted indices in the left tensor
+  std::vector<std::size_t> contr_rstrides; //strides of the contracted indices in the right tensor
+  std::size_t out_volume;                  //output tensor volume
+  std::size_t contr_volume;                //volume of the contracted index space
+  bool conj_left;                          //complex conjugation of the left tensor
+  bool conj_right;                         //complex conjugation of the right tensor
+};
+
+/** Tensor operands and prefactor of a single tensor contraction from a batch of direct tensor contractions. **/
+struct DirectContractionOperands {
+  void * dbody;               //output tensor body
+  const void * lbody;         //left tensor body
+  const void * rbody;         //right tensor body
+  std::complex<double> alpha; //alpha prefactor
+  bool accumulative;          //accumulate into (TRUE) or overwrite (FALSE) the output tensor
+};
+
+/** Returns the tensor contraction signature (autotuning key). **/
+std::string get_contraction_signature(const std::string & pattern,                //in: reduced tensor contraction pattern
+                                      const std::vector<std::vector<int>> & dims, //in: reduced extents of all tensor operands
+                                      int data_kind);                             //in: TAL-SH data kind
+
+/** Prepares the loop nest of a direct tensor contraction. Returns FALSE if the
+    tensor contraction pattern is not supported by the direct kernel. **/
+bool plan_direct_contraction(const std::string & pattern,                //in: reduced tensor contraction pattern
+                             const std::vector<std::vector<int>> & dims, //in: reduced extents of all tensor operands
+                             DirectContraction & plan);                  //out: loop nest
+
+/** Executes a direct tensor contraction on Host (multithreaded): D += L * R * alpha.
+    Returns FALSE if the data kind is not supported. **/
+bool contract_direct(const DirectContraction & plan, //in: loop nest
+                     int data_kind,                  //in: TAL-SH data kind of all tensor operands
+                     void * dbody,                   //inout: output tensor body
+                     const void * lbody,             //in: left tensor body
+                     const void * rbody,             //in: right tensor body
+                     std::complex<double> alpha,     //in: alpha prefactor
+                     bool accumulative);             //in: accumulate into (TRUE) or overwrite (FALSE) the output tensor
+
+/** Executes a batch of direct tensor contractions sharing the same loop nest on Host
+    (multithreaded across all batch members): D[i] += L[i] * R[i] * alpha[i].
+    The batch members must not write into tensors referenced by other batch members.
+    Returns FALSE if the data kind is not supported. **/
+bool contract_direct_batch(const DirectContraction & plan,                       //in: loop nest shared by all batch members
+                           int data_kind,                                        //in: TAL-SH data kind of all tensor operands
+                           const std::vector<DirectContractionOperands> & batch); //in: batch members
+
+/** Returns TRUE if two tensor bodies coincide within the rounding error tolerance of their data kind. **/
+bool compare_tensor_bodies(int data_kind,        //in: TAL-SH data kind
+                           const void * body,    //in: tensor body
+                           const void * ref,     //in: reference tensor body
+                           std::size_t volume);  //in: tensor volume
+
+
+class ContractionTuner {
+
+public:
+
+  /** Creates a tensor contraction autotuner backed by a tuning database
+      file (loaded if it exists), or an in-memory one (empty file name). **/
+  ContractionTuner(const std::string & database_file);
+
+  ContractionTuner(const ContractionTuner &) = delete;
+  ContractionTuner & operator=(const ContractionTuner &) = delete;
+  ContractionTuner(ContractionTuner &&) noexcept = delete;
+  ContractionTuner & operator=(ContractionTuner &&) noexcept = delete;
+  ~ContractionTuner() = default;
+
+  /** Looks up the winning kernel for a tensor contraction signature.
+      Returns FALSE if the signature has not been tuned yet. **/
+  bool findKernel(const std::string & signature, //in: tensor contraction signature
+                  ContractionKernel * kernel);   //out: winning kernel
+
+  /** Records the winning kernel for a newly tuned tensor contraction signature
+      (appended to the tuning database file). **/
+  void recordKernel(const std::string & signature, //in: tensor contraction signature
+                    ContractionKernel kernel,      //in: winning kernel
+                    double talsh_time,             //in: benchmarked time of the TAL-SH kernel (sec)
+                    double direct_time,            //in: benchmarked time of the direct kernel (sec, negative: not applicable)
+                    double tuning_time);           //in: total time spent on tuning (sec)
+
+  /** Counts an executed tensor contraction. **/
+  void countExecution(ContractionKernel kernel);
+
+  /** Prints the autotuning statistics. **/
+  void printStatistics() const;
+
+private:
+
+  std::string database_file_; //tuning database file (empty: in-memory)
+  std::unordered_map<std::string,ContractionKernel> kernels_; //tensor contraction signature --> winning kernel
+  std::size_t num_loaded_;    //number of signatures loaded from the tuning database file
+  std::size_t num_tuned_;     //number of signatures tuned by this process
+  std::size_t num_hits_;      //number of signature lookups satisfied by the tuning database
+  double tuning_time_;        //total time spent on tuning (sec)
+  std::size_t num_executed_[2]; //number of executed tensor contractions per kernel
+};
+
+} //namespace runtime
+} //namespace exatn
+
+#endif //EXATN_RUNTIME_CONTRACTION_TUNER_HPP_
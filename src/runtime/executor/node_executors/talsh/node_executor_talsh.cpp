@@ -1,5 +1,5 @@
 /** ExaTN:: Tensor Runtime: Tensor graph node executor: Talsh
-REVISION: 2020/10/22
+REVISION: 2020/12/14
 
 Copyright (C) 2018-2020 Dmitry Lyakh, Tiffany Mintz, Alex McCaskey
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle)
@@ -11,11 +11,20 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle)
 #include "mpi.h"
 #endif
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <complex>
 #include <limits>
 #include <mutex>
+#include <algorithm>
+#include <chrono>
+#include <unordered_set>
+#include <iomanip>
 
 #include <cstdlib>
+#include <cstring>
 
 #include "errors.hpp"
 
@@ -50,6 +59,240 @@ inline MPI_Datatype get_mpi_tensor_element_kind(int talsh_data_kind)
 #endif
 
 
+/** Copies the body of a TAL-SH tensor into the body of another TAL-SH tensor
+    of the same shape but different data kind, converting each element. **/
+template <typename SrcType, typename DstType>
+inline bool convert_tensor_body(const talsh::Tensor & src_tensor, //in: source TAL-SH tensor
+                                talsh::Tensor & dst_tensor)       //inout: destination TAL-SH tensor
+{
+ const SrcType * src_body = nullptr;
+ DstType * dst_body = nullptr;
+ bool access_granted = src_tensor.getDataAccessHostConst(&src_body) && dst_tensor.getDataAccessHost(&dst_body);
+ if(access_granted){
+  const auto volume = src_tensor.getVolume();
+  for(std::size_t i = 0; i < volume; ++i) dst_body[i] = static_cast<DstType>(src_body[i]);
+ }
+ return access_granted;
+}
+
+
+/** Returns the Host body of a TAL-SH tensor together with its size in bytes,
+    or nullptr if the tensor body is not accessible on Host. **/
+inline const void * get_talsh_tensor_body_host(const talsh::Tensor & talsh_tens, //in: TAL-SH tensor
+                                               std::size_t * body_size)          //out: tensor body size in bytes
+{
+ const void * body = nullptr;
+ std::size_t elem_size = 0;
+ bool access_granted = false;
+ switch(talsh_tens.getElementType()){
+  case(talsh::REAL32):
+  {
+   const float * tens_body = nullptr;
+   access_granted = talsh_tens.getDataAccessHostConst(&tens_body);
+   body = tens_body; elem_size = sizeof(float); break;
+  }
+  case(talsh::REAL64):
+  {
+   const double * tens_body = nullptr;
+   access_granted = talsh_tens.getDataAccessHostConst(&tens_body);
+   body = tens_body; elem_size = sizeof(double); break;
+  }
+  case(talsh::COMPLEX32):
+  {
+   const std::complex<float> * tens_body = nullptr;
+   access_granted = talsh_tens.getDataAccessHostConst(&tens_body);
+   body = tens_body; elem_size = sizeof(std::complex<float>); break;
+  }
+  case(talsh::COMPLEX64):
+  {
+   const std::complex<double> * tens_body = nullptr;
+   access_granted = talsh_tens.getDataAccessHostConst(&tens_body);
+   body = tens_body; elem_size = sizeof(std::complex<double>); break;
+  }
+ }
+ if(!access_granted) return nullptr;
+ *body_size = talsh_tens.getVolume() * elem_size;
+ return body;
+}
+
+
+/** Returns the Host body of a TAL-SH tensor for writing together with its size in bytes,
+    or nullptr if the tensor body is not accessible on Host. **/
+inline void * get_talsh_tensor_body_host(talsh::Tensor & talsh_tens, //in: TAL-SH tensor
+                                         std::size_t * body_size)    //out: tensor body size in bytes
+{
+ void * body = nullptr;
+ std::size_t elem_size = 0;
+ bool access_granted = false;
+ switch(talsh_tens.getElementType()){
+  case(talsh::REAL32):
+  {
+   float * tens_body = nullptr;
+   access_granted = talsh_tens.getDataAccessHost(&tens_body);
+   body = tens_body; elem_size = sizeof(float); break;
+  }
+  case(talsh::REAL64):
+  {
+   double * tens_body = nullptr;
+   access_granted = talsh_tens.getDataAccessHost(&tens_body);
+   body = tens_body; elem_size = sizeof(double); break;
+  }
+  case(talsh::COMPLEX32):
+  {
+   std::complex<float> * tens_body = nullptr;
+   access_granted = talsh_tens.getDataAccessHost(&tens_body);
+   body = tens_body; elem_size = sizeof(std::complex<float>); break;
+  }
+  case(talsh::COMPLEX64):
+  {
+   std::complex<double> * tens_body = nullptr;
+   access_granted = talsh_tens.getDataAccessHost(&tens_body);
+   body = tens_body; elem_size = sizeof(std::complex<double>); break;
+  }
+ }
+ if(!access_granted) return nullptr;
+ *body_size = talsh_tens.getVolume() * elem_size;
+ return body;
+}
+
+
+/** Returns the (reduced) dimension extents of a TAL-SH tensor. **/
+inline std::vector<int> get_talsh_tensor_dims(const talsh::Tensor & talsh_tens)
+{
+ unsigned int num_dims = 0;
+ const int * extents = talsh_tens.getDimExtents(num_dims);
+ return std::vector<int>(extents,extents+num_dims);
+}
+
+
+/** Copies a slice of a tensor body into the body of the slice tensor (column-major layout).
+    The slice offsets are relative to the beginning of the tensor body. Only accesses
+    raw memory, thus it can be executed by a Host worker thread. **/
+template <typename ElementType>
+inline void copy_tensor_slice(const ElementType * tens_body,          //in: tensor body
+                              const std::vector<int> & tens_extents,  //in: tensor dimension extents
+                              ElementType * slice_body,               //out: slice body
+                              const std::vector<int> & slice_extents, //in: slice dimension extents
+                              const std::vector<int> & offsets)       //in: slice offsets
+{
+ const auto rank = slice_extents.size();
+ if(rank == 0){
+  slice_body[0] = tens_body[0];
+  return;
+ }
+ std::vector<std::size_t> strides(rank);
+ std::size_t stride = 1;
+ for(std::size_t i = 0; i < rank; ++i){
+  strides[i] = stride;
+  stride *= static_cast<std::size_t>(tens_extents[i]);
+ }
+ const std::size_t segment = static_cast<std::size_t>(slice_extents[0]); //contiguous segment length
+ std::size_t slice_volume = 1;
+ for(const auto & extent: slice_extents) slice_volume *= static_cast<std::size_t>(extent);
+ std::vector<int> mlndx(rank,0); //multi-index of the current segment inside the slice
+ for(std::size_t slice_pos = 0; slice_pos < slice_volume; slice_pos += segment){
+  std::size_t tens_pos = 0;
+  for(std::size_t i = 0; i < rank; ++i) tens_pos += static_cast<std::size_t>(offsets[i] + mlndx[i]) * strides[i];
+  std::memcpy((void*)(&(slice_body[slice_pos])),(const void*)(&(tens_body[tens_pos])),segment*sizeof(ElementType));
+  for(std::size_t i = 1; i < rank; ++i){ //next segment
+   if(++mlndx[i] < slice_extents[i]) break;
+   mlndx[i] = 0;
+  }
+ }
+ return;
+}
+
+
+/** Returns a Host slice extraction job to be executed by a Host worker thread.
+    Returns an empty job if Host access to the tensor bodies is denied. **/
+template <typename ElementType>
+inline std::function<int()> make_host_slice_extraction(const talsh::Tensor & tensor, //in: tensor (Host resident)
+                                                       talsh::Tensor & slice,        //inout: slice tensor (Host resident)
+                                                       const std::vector<int> & offsets) //in: slice offsets
+{
+ const ElementType * tens_body = nullptr;
+ ElementType * slice_body = nullptr;
+ bool access_granted = tensor.getDataAccessHostConst(&tens_body) && slice.getDataAccessHost(&slice_body);
+ if(!access_granted) return std::function<int()>();
+ unsigned int num_dims = 0;
+ const int * dims = tensor.getDimExtents(num_dims);
+ std::vector<int> tens_extents(dims,dims+num_dims);
+ dims = slice.getDimExtents(num_dims);
+ std::vector<int> slice_extents(dims,dims+num_dims);
+ if(slice_extents.size() != tens_extents.size() || offsets.size() != slice_extents.size()) return std::function<int()>();
+ for(unsigned int i = 0; i < num_dims; ++i){
+  if(offsets[i] < 0 || offsets[i] + slice_extents[i] > tens_extents[i]) return std::function<int()>();
+ }
+ return [tens_body,tens_extents,slice_body,slice_extents,offsets] () {
+  copy_tensor_slice(tens_body,tens_extents,slice_body,slice_extents,offsets);
+  return 0;
+ };
+}
+
+
+TalshNodeExecutor::HostWorkerPool::HostWorkerPool(unsigned int num_workers,
+                                                  const NumaTopology * numa):
+ stopping_(false)
+{
+ assert(num_workers > 0);
+ for(unsigned int i = 0; i < num_workers; ++i){
+  const int domain = ((numa != nullptr) ? static_cast<int>(i % numa->getNumDomains()) : -1);
+  workers_.emplace_back(&HostWorkerPool::run,this,numa,domain);
+ }
+}
+
+
+TalshNodeExecutor::HostWorkerPool::~HostWorkerPool()
+{
+ {
+  std::lock_guard<std::mutex> lock(jobs_lock_);
+  stopping_ = true;
+ }
+ jobs_cv_.notify_all();
+ for(auto & worker: workers_) worker.join();
+}
+
+
+std::future<int> TalshNodeExecutor::HostWorkerPool::submit(std::function<int()> job)
+{
+ std::packaged_task<int()> task(std::move(job));
+ auto status = task.get_future();
+ {
+  std::lock_guard<std::mutex> lock(jobs_lock_);
+  jobs_.emplace_back(std::move(task));
+ }
+ jobs_cv_.notify_one();
+ return status;
+}
+
+
+void TalshNodeExecutor::HostWorkerPool::run(const NumaTopology * numa, int domain)
+{
+ if(numa != nullptr && domain >= 0){
+  numa->bindThread(domain);
+ }
+ while(true){
+  std::packaged_task<int()> task;
+  {
+   std::unique_lock<std::mutex> lock(jobs_lock_);
+   jobs_cv_.wait(lock,[this]{return (stopping_ || !jobs_.empty());});
+   if(jobs_.empty()) return; //stopping with no jobs left
+   task = std::move(jobs_.front());
+   jobs_.pop_front();
+  }
+  task();
+ }
+}
+
+
+TalshNodeExecutor::HostWorkerPool & TalshNodeExecutor::getHostWorkers()
+{
+ //Enough Host worker threads for all asynchronous tensor transformations and slicing tasks in flight:
+ if(!host_workers_) host_workers_.reset(new HostWorkerPool(host_transform_threads_ + host_prefetch_depth_,numa_.get()));
+ return *host_workers_;
+}
+
+
 void TalshNodeExecutor::initialize(const ParamConf & parameters)
 {
 #ifdef DEBUG
@@ -76,6 +319,58 @@ void TalshNodeExecutor::initialize(const ParamConf & parameters)
  }
  ++talsh_node_exec_count_;
  talsh_init_lock.unlock();
+ int64_t host_prefetch_depth = 0;
+ if(parameters.getParameter("host_prefetch_depth",&host_prefetch_depth))
+  host_prefetch_depth_ = static_cast<unsigned int>(std::max(host_prefetch_depth,int64_t{0}));
+ int64_t host_transform_threads = 0;
+ if(parameters.getParameter("host_transform_threads",&host_transform_threads))
+  host_transform_threads_ = static_cast<unsigned int>(std::max(host_transform_threads,int64_t{0}));
+#ifdef _OPENMP
+ host_max_threads_ = omp_get_max_threads();
+#endif
+ int64_t host_numa_binding = 0;
+ if(parameters.getParameter("host_numa_binding",&host_numa_binding))
+  numa_binding_ = (host_numa_binding != 0);
+ int64_t host_numa_min_bytes = 0;
+ if(parameters.getParameter("host_numa_min_bytes",&host_numa_min_bytes))
+  numa_min_bytes_ = static_cast<std::size_t>(std::max(host_numa_min_bytes,int64_t{0}));
+ parameters.getParameter("host_spill_directory",spill_directory_);
+ int64_t host_spill_min_bytes = 0;
+ if(parameters.getParameter("host_spill_min_bytes",&host_spill_min_bytes))
+  spill_min_bytes_ = static_cast<std::size_t>(std::max(host_spill_min_bytes,int64_t{0}));
+ int64_t host_compression = 0;
+ if(parameters.getParameter("host_compression",&host_compression))
+  compression_mode_ = static_cast<unsigned int>(std::min(std::max(host_compression,int64_t{0}),int64_t{2}));
+ int64_t host_compression_min_bytes = 0;
+ if(parameters.getParameter("host_compression_min_bytes",&host_compression_min_bytes))
+  compression_min_bytes_ = static_cast<std::size_t>(std::max(host_compression_min_bytes,int64_t{0}));
+ double host_compression_error_bound = 0.0;
+ if(parameters.getParameter("host_compression_error_bound",&host_compression_error_bound))
+  compression_error_bound_ = std::max(host_compression_error_bound,0.0);
+ parameters.getParameter("host_compression_lossy_prefix",compression_lossy_prefix_);
+ int64_t contraction_autotuning = 0;
+ if(parameters.getParameter("contraction_autotuning",&contraction_autotuning)){
+  if(contraction_autotuning != 0 && !tuner_){
+   std::string tuning_database;
+   parameters.getParameter("contraction_tuning_database",tuning_database);
+   tuner_.reset(new ContractionTuner(tuning_database));
+  }
+ }
+ int64_t contraction_direct_max_bytes = 0;
+ if(parameters.getParameter("contraction_direct_max_bytes",&contraction_direct_max_bytes))
+  direct_max_bytes_ = static_cast<std::size_t>(std::max(contraction_direct_max_bytes,int64_t{0}));
+ if(numa_binding_){
+  numa_.reset(new NumaTopology());
+  numa_domain_bytes_.assign(numa_->getNumDomains(),0);
+  numa_domain_usage_.assign(numa_->getNumDomains(),std::make_pair(std::size_t{0},0.0));
+#ifdef _OPENMP
+  numa_default_threads_ = omp_get_max_threads();
+#endif
+  if(debugging) std::cout << "#DEBUG(exatn::runtime::TalshNodeExecutor): NUMA-aware Host execution with "
+                          << numa_->getNumDomains() << " NUMA domains" << std::endl << std::flush; //debug
+ }
+ if(debugging && !spill_directory_.empty()) std::cout << "#DEBUG(exatn::runtime::TalshNodeExecutor): Spilling tensors to "
+                                                      << spill_directory_ << std::endl << std::flush; //debug
  return;
 }
 
@@ -88,6 +383,18 @@ std::size_t TalshNodeExecutor::getMemoryBufferSize() const
 }
 
 
+std::size_t TalshNodeExecutor::getSpilledMemorySize() const
+{
+ return released_bytes_;
+}
+
+
+std::size_t TalshNodeExecutor::getAuxiliaryMemorySize() const
+{
+ return auxiliary_bytes_;
+}
+
+
 TalshNodeExecutor::~TalshNodeExecutor()
 {
 #ifdef DEBUG
@@ -96,11 +403,22 @@ TalshNodeExecutor::~TalshNodeExecutor()
   const bool debugging = false;
 #endif
  auto synced = sync(); assert(synced);
+ if(numa_){
+  bindHostThreads(-1);
+  printNumaStatistics();
+ }
+ if(num_spills_ > 0 || num_compressions_ > 0) printSpillStatistics();
+ if(tuner_) tuner_->printStatistics();
+ spilled_tensors_.clear();
  talsh_init_lock.lock();
  --talsh_node_exec_count_;
  if(talsh_initialized_ && talsh_node_exec_count_ == 0){
+  host_tasks_.clear();
   tasks_.clear();
+  converted_.clear();
+  unpacked_.clear();
   tensors_.clear();
+  packed_tensors_.clear();
   talsh::printStatistics();
   auto error_code = talsh::shutdown();
   if(error_code == TALSH_SUCCESS){
@@ -257,6 +575,30 @@ int TalshNodeExecutor::execute(numerics::TensorOpCreate & op,
    bases[tensor_rank++] = offsets[i];
   }
  }
+ //16-bit tensors are stored packed outside TAL-SH (unpacked into single precision on demand):
+ if(isHalfPrecisionElementType(op.getTensorElementType())){
+  std::size_t volume = 1;
+  for(const auto & extent: extents) volume *= static_cast<std::size_t>(extent);
+  if(op.getTensorElementType() == TensorElementType::COMPLEX16 ||
+     op.getTensorElementType() == TensorElementType::COMPLEXBF16) volume *= 2; //two 16-bit words per complex element
+  auto res = packed_tensors_.emplace(std::make_pair(tensor_hash,PackedTensor()));
+  if(res.second){
+   auto & packed_tensor = res.first->second;
+   packed_tensor.element_type = op.getTensorElementType();
+   packed_tensor.full_offsets = offsets;
+   packed_tensor.full_extents = dim_extents;
+   packed_tensor.reduced_offsets = bases;
+   packed_tensor.reduced_extents = extents;
+   packed_tensor.body.assign(volume,0); //zero bit pattern is zero in both 16-bit formats
+   packed_tensor.num_users = 0;
+  }else{
+   std::cout << "#ERROR(exatn::runtime::node_executor_talsh): CREATE: Attempt to create the same tensor twice: " << std::endl;
+   tensor.printIt();
+   assert(false);
+  }
+  *exec_handle = op.getId();
+  return 0;
+ }
  //Get tensor data kind:
  auto data_kind = get_talsh_tensor_element_kind(op.getTensorElementType());
  //Construct the TAL-SH tensor implementation:
@@ -264,8 +606,20 @@ int TalshNodeExecutor::execute(numerics::TensorOpCreate & op,
  if(res.second){
   if(res.first->second.talsh_tensor->isEmpty()){ //tensor has not been allocated memory due to its temporary shortage
    tensors_.erase(res.first);
-   return TRY_LATER;
+   //Spill idle tensors to disk to make room (if spilling is on) and try again:
+   const auto tensor_size = tensor.getVolume() * numerics::tensor_element_type_size(op.getTensorElementType());
+   if(spillIdleTensors(tensor_size) == 0) return TRY_LATER;
+   res = tensors_.emplace(std::make_pair(tensor_hash,TensorImpl(offsets,dim_extents,bases,extents,data_kind)));
+   assert(res.second);
+   if(res.first->second.talsh_tensor->isEmpty()){
+    tensors_.erase(res.first);
+    return TRY_LATER;
+   }
   }
+  host_usage_[tensor_hash] = CachedAttr{exatn::Timer::timeInSecHR()};
+  if(compression_mode_ > 1 && tensor.getName().compare(0,compression_lossy_prefix_.size(),compression_lossy_prefix_) == 0)
+   lossy_tensors_.emplace(tensor_hash);
+  if(numa_) placeTensorOnNumaDomain(tensor_hash,*(res.first->second.talsh_tensor));
   //std::cout << "#DEBUG(exatn::runtime::node_executor_talsh): New tensor " << tensor.getName()
   //          << " emplaced with hash " << tensor_hash << std::endl;
  }else{
@@ -286,6 +640,32 @@ int TalshNodeExecutor::execute(numerics::TensorOpDestroy & op,
 
  const auto & tensor = *(op.getTensorOperand(0));
  const auto tensor_hash = tensor.getTensorHash();
+ auto packed = packed_tensors_.find(tensor_hash);
+ if(packed != packed_tensors_.end()){ //packed 16-bit tensor
+  if(packed->second.num_users > 0){
+   std::cout << "#ERROR(exatn::runtime::node_executor_talsh): DESTROY: Attempt to destroy an active tensor:" << std::endl;
+   tensor.printIt();
+   assert(false);
+  }
+  packed_tensors_.erase(packed);
+  *exec_handle = op.getId();
+  return 0;
+ }
+ auto spilled = spilled_tensors_.find(tensor_hash);
+ if(spilled != spilled_tensors_.end()){ //tensor spilled to disk
+  if(spilled->second.staging.valid()) spilled->second.staging.wait();
+  if(!(spilled->second.staged)) released_bytes_ -= spilled->second.size;
+  if(spilled->second.compressed){
+   compressed_bytes_ -= spilled->second.compressed->getCompressedSize();
+  }else{
+   spilled_bytes_ -= spilled->second.size;
+  }
+  spilled_tensors_.erase(spilled);
+  lossy_tensors_.erase(tensor_hash);
+  incompressible_tensors_.erase(tensor_hash);
+  *exec_handle = op.getId();
+  return 0;
+ }
  auto iter = tensors_.find(tensor_hash);
  if(iter != tensors_.end()){
   //Complete an active tensor image eviction, if any:
@@ -307,6 +687,14 @@ int TalshNodeExecutor::execute(numerics::TensorOpDestroy & op,
    //Destroy the tensor:
    iter->second.resetTensorShapeToReduced();
    tensors_.erase(iter);
+   host_usage_.erase(tensor_hash);
+   lossy_tensors_.erase(tensor_hash);
+   incompressible_tensors_.erase(tensor_hash);
+   auto placement = numa_placement_.find(tensor_hash);
+   if(placement != numa_placement_.end()){
+    numa_domain_bytes_[placement->second.first] -= placement->second.second;
+    numa_placement_.erase(placement);
+   }
    //std::cout << "#DEBUG(exatn::runtime::node_executor_talsh): Tensor " << tensor.getName()
    //          << " erased with hash " << tensor_hash << std::endl;
   }else{
@@ -329,6 +717,7 @@ int TalshNodeExecutor::execute(numerics::TensorOpTransform & op,
 {
  assert(op.isSet());
  if(!finishPrefetching(op)) return TRY_LATER;
+ if(!unpackTensorOperands(op,exec_handle)) return TRY_LATER;
 
  const auto & tensor = *(op.getTensorOperand(0));
  const auto tensor_hash = tensor.getTensorHash();
@@ -340,9 +729,41 @@ int TalshNodeExecutor::execute(numerics::TensorOpTransform & op,
  }
  tens_pos->second.resetTensorShapeToFull();
  auto & tens = *(tens_pos->second.talsh_tensor);
+ *exec_handle = op.getId();
+
+ //Asynchronous tensor transformation by a Host worker thread (overlaps with subsequent tensor operations):
+ auto functor = op.getFunctor();
+ if(host_transform_threads_ > 0 && functor && !tensorIsCurrentlyInUse(&tens)){
+  const bool exclusive = (op.getFunctorConcurrency() == numerics::TensorMethodConcurrency::THREAD_PARALLEL);
+  unsigned int num_transforms = 0;
+  for(const auto & task: host_tasks_){
+   if(task.second.transform){
+    if(exclusive || task.second.exclusive) return TRY_LATER; //multithreaded tensor functors are applied exclusively
+    ++num_transforms;
+   }
+  }
+  if(num_transforms >= host_transform_threads_) return TRY_LATER; //all Host worker threads are busy
+  auto synced = tens.sync(DEV_HOST,0,nullptr,true); assert(synced);
+  auto * talsh_tens = &tens;
+  const int num_threads = getTransformThreads(exclusive);
+  std::future<int> status = getHostWorkers().submit([functor,talsh_tens,num_threads] () {
+#ifdef _OPENMP
+                                                   omp_set_num_threads(num_threads); //share of the Host threads
+#endif
+                                                   return functor->apply(*talsh_tens);
+                                                  });
+  auto host_res = host_tasks_.emplace(std::make_pair(*exec_handle,HostTask{std::move(status),{&tens},true,exclusive}));
+  if(!host_res.second){
+   std::cout << "#ERROR(exatn::runtime::node_executor_talsh): TRANSFORM: Attempt to execute the same operation twice: " << std::endl;
+   op.printIt();
+   assert(false);
+  }
+  return 0;
+ }
+
+ //Synchronous tensor transformation:
  auto synced = tens.sync(DEV_HOST,0,nullptr,true); assert(synced);
  int error_code = op.apply(tens); //synchronous user-defined Host operation
- *exec_handle = op.getId();
  return error_code;
 }
 
@@ -352,6 +773,7 @@ int TalshNodeExecutor::execute(numerics::TensorOpSlice & op,
 {
  assert(op.isSet());
  if(!finishPrefetching(op)) return TRY_LATER;
+ if(!unpackTensorOperands(op,exec_handle)) return TRY_LATER;
 
  const auto & tensor0 = *(op.getTensorOperand(0));
  const auto tensor0_hash = tensor0.getTensorHash();
@@ -376,13 +798,6 @@ int TalshNodeExecutor::execute(numerics::TensorOpSlice & op,
  auto & tens1 = *(tens1_pos->second.talsh_tensor);
 
  *exec_handle = op.getId();
- auto task_res = tasks_.emplace(std::make_pair(*exec_handle,
-                                std::make_shared<talsh::TensorTask>()));
- if(!task_res.second){
-  std::cout << "#ERROR(exatn::runtime::node_executor_talsh): SLICE: Attempt to execute the same operation twice: " << std::endl;
-  op.printIt();
-  assert(false);
- }
 
  const auto & slice_signature = tensor0.getSignature();
  const auto slice_rank = slice_signature.getRank();
@@ -407,6 +822,45 @@ int TalshNodeExecutor::execute(numerics::TensorOpSlice & op,
   }
  }
 
+ //Asynchronous Host slice extraction (overlaps with subsequent tensor operations):
+ const auto num_host_slices = std::count_if(host_tasks_.cbegin(),host_tasks_.cend(),
+                                            [](const std::pair<const TensorOpExecHandle,HostTask> & task){
+                                             return !(task.second.transform);
+                                            });
+ if(static_cast<unsigned int>(num_host_slices) < host_prefetch_depth_ && tens0.getElementType() == tens1.getElementType()){
+  int dev_kind;
+  talshKindDevId(talsh::determineOptimalDevice(tens0,tens1),&dev_kind);
+  if(dev_kind == DEV_HOST && !tensorIsCurrentlyInUse(&tens0) && !tensorIsCurrentlyInUse(&tens1,false)){
+   auto synced = tens1.sync(DEV_HOST,0,nullptr,false); assert(synced);
+   synced = tens0.sync(DEV_HOST,0,nullptr,true); assert(synced);
+   std::function<int()> job;
+   switch(tens0.getElementType()){
+    case(talsh::REAL32): job = make_host_slice_extraction<float>(tens1,tens0,offsets); break;
+    case(talsh::REAL64): job = make_host_slice_extraction<double>(tens1,tens0,offsets); break;
+    case(talsh::COMPLEX32): job = make_host_slice_extraction<std::complex<float>>(tens1,tens0,offsets); break;
+    case(talsh::COMPLEX64): job = make_host_slice_extraction<std::complex<double>>(tens1,tens0,offsets); break;
+   }
+   if(job){
+    std::future<int> status = getHostWorkers().submit(std::move(job));
+    auto host_res = host_tasks_.emplace(std::make_pair(*exec_handle,HostTask{std::move(status),{&tens0,&tens1},false,false}));
+    if(!host_res.second){
+     std::cout << "#ERROR(exatn::runtime::node_executor_talsh): SLICE: Attempt to execute the same operation twice: " << std::endl;
+     op.printIt();
+     assert(false);
+    }
+    return 0;
+   }
+  }
+ }
+
+ //Synchronous slice extraction by TAL-SH:
+ auto task_res = tasks_.emplace(std::make_pair(*exec_handle,
+                                std::make_shared<talsh::TensorTask>()));
+ if(!task_res.second){
+  std::cout << "#ERROR(exatn::runtime::node_executor_talsh): SLICE: Attempt to execute the same operation twice: " << std::endl;
+  op.printIt();
+  assert(false);
+ }
  auto error_code = tens1.extractSlice((task_res.first)->second.get(),
                                       tens0,
                                       offsets,
@@ -421,6 +875,7 @@ int TalshNodeExecutor::execute(numerics::TensorOpInsert & op,
 {
  assert(op.isSet());
  if(!finishPrefetching(op)) return TRY_LATER;
+ if(!unpackTensorOperands(op,exec_handle)) return TRY_LATER;
 
  const auto & tensor0 = *(op.getTensorOperand(0));
  const auto tensor0_hash = tensor0.getTensorHash();
@@ -479,7 +934,8 @@ int TalshNodeExecutor::execute(numerics::TensorOpInsert & op,
  auto error_code = tens0.insertSlice((task_res.first)->second.get(),
                                      tens1,
                                      offsets,
-                                     DEV_HOST,0);
+                                     DEV_HOST,0,
+                                     op.getScalar(0) != std::complex<double>{0.0,0.0}); //beta = 1: accumulate
 
  return error_code;
 }
@@ -490,6 +946,7 @@ int TalshNodeExecutor::execute(numerics::TensorOpAdd & op,
 {
  assert(op.isSet());
  if(!finishPrefetching(op)) return TRY_LATER;
+ if(!unpackTensorOperands(op,exec_handle)) return TRY_LATER;
 
  const auto & tensor0 = *(op.getTensorOperand(0));
  const auto tensor0_hash = tensor0.getTensorHash();
@@ -511,7 +968,15 @@ int TalshNodeExecutor::execute(numerics::TensorOpAdd & op,
   assert(false);
  }
  tens1_pos->second.resetTensorShapeToReduced();
- auto & tens1 = *(tens1_pos->second.talsh_tensor);
+ auto & tens1_orig = *(tens1_pos->second.talsh_tensor);
+
+ //Mixed precision: Convert the input tensor operand to the data kind of the output tensor operand:
+ std::shared_ptr<talsh::Tensor> tens1_conv;
+ if(tens1_orig.getElementType() != tens0.getElementType()){
+  tens1_conv = convertTensorDataKind(tens1_orig,tens0.getElementType());
+  if(!tens1_conv) return TRY_LATER;
+ }
+ auto & tens1 = (tens1_conv ? *tens1_conv : tens1_orig);
 
  *exec_handle = op.getId();
  auto task_res = tasks_.emplace(std::make_pair(*exec_handle,
@@ -540,6 +1005,7 @@ int TalshNodeExecutor::execute(numerics::TensorOpAdd & op,
  }else if(error_code == TALSH_SUCCESS){
   prefetch_enabled_ = true;
  }
+ if(error_code == TALSH_SUCCESS && tens1_conv) converted_[*exec_handle].emplace_back(tens1_conv);
  return error_code;
 }
 
@@ -549,6 +1015,7 @@ int TalshNodeExecutor::execute(numerics::TensorOpContract & op,
 {
  assert(op.isSet());
  if(!finishPrefetching(op)) return TRY_LATER;
+ if(!unpackTensorOperands(op,exec_handle)) return TRY_LATER;
 
  const auto & tensor0 = *(op.getTensorOperand(0));
  const auto tensor0_hash = tensor0.getTensorHash();
@@ -570,7 +1037,7 @@ int TalshNodeExecutor::execute(numerics::TensorOpContract & op,
   assert(false);
  }
  tens1_pos->second.resetTensorShapeToReduced();
- auto & tens1 = *(tens1_pos->second.talsh_tensor);
+ auto & tens1_orig = *(tens1_pos->second.talsh_tensor);
 
  const auto & tensor2 = *(op.getTensorOperand(2));
  const auto tensor2_hash = tensor2.getTensorHash();
@@ -581,7 +1048,20 @@ int TalshNodeExecutor::execute(numerics::TensorOpContract & op,
   assert(false);
  }
  tens2_pos->second.resetTensorShapeToReduced();
- auto & tens2 = *(tens2_pos->second.talsh_tensor);
+ auto & tens2_orig = *(tens2_pos->second.talsh_tensor);
+
+ //Mixed precision: Convert the input tensor operands to the data kind of the output tensor operand:
+ std::shared_ptr<talsh::Tensor> tens1_conv, tens2_conv;
+ if(tens1_orig.getElementType() != tens0.getElementType()){
+  tens1_conv = convertTensorDataKind(tens1_orig,tens0.getElementType());
+  if(!tens1_conv) return TRY_LATER;
+ }
+ if(tens2_orig.getElementType() != tens0.getElementType()){
+  tens2_conv = convertTensorDataKind(tens2_orig,tens0.getElementType());
+  if(!tens2_conv) return TRY_LATER;
+ }
+ auto & tens1 = (tens1_conv ? *tens1_conv : tens1_orig);
+ auto & tens2 = (tens2_conv ? *tens2_conv : tens2_orig);
 
  *exec_handle = op.getId();
  auto task_res = tasks_.emplace(std::make_pair(*exec_handle,
@@ -593,11 +1073,30 @@ int TalshNodeExecutor::execute(numerics::TensorOpContract & op,
  }
 
  //std::cout << "#DEBUG(exatn::runtime::node_executor_talsh): Tensor contraction " << op.getIndexPattern() << std::endl; //debug
+ if(numa_) bindHostThreads(selectNumaDomain(op)); //NUMA-aware Host execution
+ shareHostThreads();
+ const auto beta = op.getScalar(1);
+ if(beta != std::complex<double>{0.0,0.0} && beta != std::complex<double>{1.0,0.0}){
+  std::cout << "#ERROR(exatn::runtime::node_executor_talsh): CONTRACT: Beta prefactor other than 0 or 1 is not supported: " << std::endl;
+  op.printIt();
+  assert(false);
+ }
+ const bool accumulative = (beta != std::complex<double>{0.0,0.0}); //beta = 0: overwrite the output tensor
+ if(tuner_){ //autotuned kernel selection
+  const auto kernel = selectContractionKernel(op,tens0,tens1,tens2);
+  if(kernel == ContractionKernel::DIRECT){
+   if(contractDirect(op,tens0,tens1,tens2,accumulative)){ //completed synchronously (empty TAL-SH task)
+    op.setKernel(get_contraction_kernel_name(kernel));
+    tuner_->countExecution(kernel);
+    return TALSH_SUCCESS;
+   }
+  }
+ }
  auto error_code = tens0.contractAccumulate((task_res.first)->second.get(),
                                             op.getIndexPatternReduced(),
                                             tens1,tens2,
                                             DEV_DEFAULT,DEV_DEFAULT,
-                                            op.getScalar(0));
+                                            op.getScalar(0),accumulative);
  if(error_code == DEVICE_UNABLE){ //use out-of-core version if tensor contraction does not fit in GPU
   //std::cout << "#DEBUG(exatn::runtime::node_executor_talsh): CONTRACT: Redirected to XL\n" << std::flush; //debug
   (task_res.first)->second->clean();
@@ -611,13 +1110,14 @@ int TalshNodeExecutor::execute(numerics::TensorOpContract & op,
                                            op.getIndexPatternReduced(),
                                            tens1,tens2,
                                            DEV_DEFAULT,DEV_DEFAULT,
-                                           op.getScalar(0));
+                                           op.getScalar(0),accumulative);
+   if(error_code == TALSH_SUCCESS) op.setKernel("talsh-xl");
   }else{
    error_code = tens0.contractAccumulate((task_res.first)->second.get(),
                                          op.getIndexPatternReduced(),
                                          tens1,tens2,
                                          DEV_HOST,0,
-                                         op.getScalar(0));
+                                         op.getScalar(0),accumulative);
   }
  }else if(error_code == TALSH_NOT_AVAILABLE || error_code == TALSH_NOT_IMPLEMENTED){
   (task_res.first)->second->clean();
@@ -625,13 +1125,28 @@ int TalshNodeExecutor::execute(numerics::TensorOpContract & op,
                                          op.getIndexPatternReduced(),
                                          tens1,tens2,
                                          DEV_HOST,0,
-                                         op.getScalar(0));
+                                         op.getScalar(0),accumulative);
  }else if(error_code == TRY_LATER){
   std::size_t total_tensor_size = tensor0.getSize() + tensor1.getSize() + tensor2.getSize();
   bool evicting = evictMovedTensors(talsh::determineOptimalDevice(tens0,tens1,tens2),total_tensor_size);
+  //Spill idle tensors to make room for the TAL-SH temporaries (if spilling is on) and try again:
+  if(spillIdleTensors(total_tensor_size,&op) > 0){
+   (task_res.first)->second->clean();
+   error_code = tens0.contractAccumulate((task_res.first)->second.get(),
+                                         op.getIndexPatternReduced(),
+                                         tens1,tens2,
+                                         DEV_HOST,0,
+                                         op.getScalar(0),accumulative);
+  }
  }else if(error_code == TALSH_SUCCESS){
   prefetch_enabled_ = true;
  }
+ if(error_code == TALSH_SUCCESS){ //keep converted tensor operands alive until the tensor contraction completes
+  if(tens1_conv) converted_[*exec_handle].emplace_back(tens1_conv);
+  if(tens2_conv) converted_[*exec_handle].emplace_back(tens2_conv);
+  if(op.getKernel().empty()) op.setKernel(get_contraction_kernel_name(ContractionKernel::TALSH));
+  if(tuner_) tuner_->countExecution(ContractionKernel::TALSH);
+ }
  return error_code;
 }
 
@@ -641,6 +1156,7 @@ int TalshNodeExecutor::execute(numerics::TensorOpDecomposeSVD3 & op,
 {
  assert(op.isSet());
  if(!finishPrefetching(op)) return TRY_LATER;
+ if(!unpackTensorOperands(op,exec_handle)) return TRY_LATER;
 
  const auto & tensor0 = *(op.getTensorOperand(0));
  const auto tensor0_hash = tensor0.getTensorHash();
@@ -708,6 +1224,7 @@ int TalshNodeExecutor::execute(numerics::TensorOpDecomposeSVD2 & op,
 {
  assert(op.isSet());
  if(!finishPrefetching(op)) return TRY_LATER;
+ if(!unpackTensorOperands(op,exec_handle)) return TRY_LATER;
 
  const auto & tensor0 = *(op.getTensorOperand(0));
  const auto tensor0_hash = tensor0.getTensorHash();
@@ -764,6 +1281,7 @@ int TalshNodeExecutor::execute(numerics::TensorOpOrthogonalizeSVD & op,
 {
  assert(op.isSet());
  if(!finishPrefetching(op)) return TRY_LATER;
+ if(!unpackTensorOperands(op,exec_handle)) return TRY_LATER;
 
  const auto & tensor0 = *(op.getTensorOperand(0));
  const auto tensor0_hash = tensor0.getTensorHash();
@@ -797,6 +1315,7 @@ int TalshNodeExecutor::execute(numerics::TensorOpOrthogonalizeMGS & op,
 {
  assert(op.isSet());
  if(!finishPrefetching(op)) return TRY_LATER;
+ if(!unpackTensorOperands(op,exec_handle)) return TRY_LATER;
 
  const auto & tensor0 = *(op.getTensorOperand(0));
  const auto tensor0_hash = tensor0.getTensorHash();
@@ -833,6 +1352,7 @@ int TalshNodeExecutor::execute(numerics::TensorOpBroadcast & op,
 {
  assert(op.isSet());
  if(!finishPrefetching(op)) return TRY_LATER;
+ if(!unpackTensorOperands(op,exec_handle)) return TRY_LATER;
 
  const auto & tensor = *(op.getTensorOperand(0));
  const auto tensor_hash = tensor.getTensorHash();
@@ -910,6 +1430,7 @@ int TalshNodeExecutor::execute(numerics::TensorOpAllreduce & op,
 {
  assert(op.isSet());
  if(!finishPrefetching(op)) return TRY_LATER;
+ if(!unpackTensorOperands(op,exec_handle)) return TRY_LATER;
 
  const auto & tensor = *(op.getTensorOperand(0));
  const auto tensor_hash = tensor.getTensorHash();
@@ -981,11 +1502,128 @@ int TalshNodeExecutor::execute(numerics::TensorOpAllreduce & op,
 }
 
 
+int TalshNodeExecutor::execute(numerics::TensorOpContractBatch & op,
+                               TensorOpExecHandle * exec_handle)
+{
+ assert(op.isSet());
+ if(!finishPrefetching(op)) return TRY_LATER;
+ if(!unpackTensorOperands(op,exec_handle)) return TRY_LATER;
+
+ *exec_handle = op.getId();
+
+ //All members of the batch share the same reduced index pattern:
+ const auto contr_pattern = op.getMemberIndexPatternReduced();
+ const auto batch_size = op.getBatchSize();
+ std::vector<talsh::Tensor*> talsh_tens(batch_size*3,nullptr);
+ for(unsigned int i = op.getNumMembersExecuted()*3; i < batch_size*3; ++i){
+  const auto & tensor = *(op.getTensorOperand(i));
+  auto tens_pos = tensors_.find(tensor.getTensorHash());
+  if(tens_pos == tensors_.end()){
+   std::cout << "#ERROR(exatn::runtime::node_executor_talsh): CONTRACT_BATCH: Tensor operand " << i
+             << " not found: " << std::endl;
+   op.printIt();
+   assert(false);
+  }
+  tens_pos->second.resetTensorShapeToReduced();
+  talsh_tens[i] = tens_pos->second.talsh_tensor.get();
+ }
+ shareHostThreads();
+
+ //Small tensor contractions of the same element type share the loop nest of the direct kernel:
+ DirectContraction plan;
+ bool direct = false;
+ unsigned int member = op.getNumMembersExecuted();
+ if(member < batch_size){
+  const auto & tens0 = *(talsh_tens[member*3+0]);
+  const auto & tens1 = *(talsh_tens[member*3+1]);
+  const auto & tens2 = *(talsh_tens[member*3+2]);
+  std::size_t member_size = 0;
+  for(unsigned int i = 0; i < 3; ++i) member_size += op.getTensorOperand(member*3+i)->getSize();
+  if(member_size <= direct_max_bytes_ &&
+     tens1.getElementType() == tens0.getElementType() && tens2.getElementType() == tens0.getElementType()){
+   const std::vector<std::vector<int>> dims {get_talsh_tensor_dims(tens0),
+                                             get_talsh_tensor_dims(tens1),
+                                             get_talsh_tensor_dims(tens2)};
+   direct = plan_direct_contraction(contr_pattern,dims,plan);
+  }
+ }
+
+ int error_code = TALSH_SUCCESS;
+ while(member < batch_size){
+  //Execute the next run of mutually independent tensor contractions with the direct kernel in a single multithreaded loop:
+  if(direct){
+   std::vector<DirectContractionOperands> run;
+   std::unordered_set<numerics::TensorHashType> run_inputs, run_outputs;
+   for(unsigned int next = member; next < batch_size; ++next){
+    const auto hash0 = op.getTensorOperand(next*3+0)->getTensorHash();
+    const auto hash1 = op.getTensorOperand(next*3+1)->getTensorHash();
+    const auto hash2 = op.getTensorOperand(next*3+2)->getTensorHash();
+    if(run_inputs.find(hash0) != run_inputs.end() || run_outputs.find(hash0) != run_outputs.end() ||
+       run_outputs.find(hash1) != run_outputs.end() || run_outputs.find(hash2) != run_outputs.end() ||
+       hash0 == hash1 || hash0 == hash2) break; //dependent tensor contraction
+    std::size_t size0 = 0, size1 = 0, size2 = 0;
+    void * body0 = get_talsh_tensor_body_host(*(talsh_tens[next*3+0]),&size0);
+    const void * body1 = get_talsh_tensor_body_host(static_cast<const talsh::Tensor&>(*(talsh_tens[next*3+1])),&size1);
+    const void * body2 = get_talsh_tensor_body_host(static_cast<const talsh::Tensor&>(*(talsh_tens[next*3+2])),&size2);
+    if(body0 == nullptr || body1 == nullptr || body2 == nullptr) break; //tensor body is not accessible on Host
+    run.emplace_back(DirectContractionOperands{body0,body1,body2,op.getMemberPrefactor(next),op.isMemberAccumulative(next)});
+    run_outputs.emplace(hash0);
+    run_inputs.emplace(hash1);
+    run_inputs.emplace(hash2);
+   }
+   if(!run.empty()){
+    auto executed = contract_direct_batch(plan,talsh_tens[member*3]->getElementType(),run); assert(executed);
+    for(unsigned int i = 0; i < run.size(); ++i) op.registerMemberExecuted();
+    member += run.size();
+    continue;
+   }
+  }
+  //Execute the next tensor contraction with TAL-SH on the optimal device:
+  talsh::TensorTask task;
+  error_code = talsh_tens[member*3+0]->contractAccumulate(&task,contr_pattern,
+                                                        *(talsh_tens[member*3+1]),*(talsh_tens[member*3+2]),
+                                                        DEV_DEFAULT,DEV_DEFAULT,
+                                                        op.getMemberPrefactor(member),
+                                                        op.isMemberAccumulative(member));
+  if(error_code == DEVICE_UNABLE || error_code == TALSH_NOT_AVAILABLE || error_code == TALSH_NOT_IMPLEMENTED){
+   task.clean();
+   error_code = talsh_tens[member*3+0]->contractAccumulate(&task,contr_pattern,
+                                                         *(talsh_tens[member*3+1]),*(talsh_tens[member*3+2]),
+                                                         DEV_HOST,0,
+                                                         op.getMemberPrefactor(member),
+                                                         op.isMemberAccumulative(member));
+  }
+  if(error_code != TALSH_SUCCESS){ //TRY_LATER will resume from the current member
+   //Keep the results of the already executed members in the packed 16-bit output tensors:
+   if(error_code == TRY_LATER && op.getNumMembersExecuted() > 0) packTensorOperands(op.getId(),true);
+   break;
+  }
+  auto completed = task.wait();
+  if(!completed){
+   error_code = TALSH_TASK_ERROR;
+   break;
+  }
+  op.registerMemberExecuted();
+  ++member;
+ }
+ return error_code;
+}
+
+
 bool TalshNodeExecutor::sync(TensorOpExecHandle op_handle,
                              int * error_code,
                              bool wait)
 {
  *error_code = 0;
+ auto host_task = host_tasks_.find(op_handle);
+ if(host_task != host_tasks_.end()){
+  bool synced = testHostTask(host_task->second,error_code,wait);
+  if(synced){
+   host_tasks_.erase(host_task);
+   packTensorOperands(op_handle,(*error_code == 0));
+  }
+  return synced;
+ }
  bool synced = true;
  auto iter = tasks_.find(op_handle);
  if(iter != tasks_.end()){
@@ -1000,8 +1638,12 @@ bool TalshNodeExecutor::sync(TensorOpExecHandle op_handle,
    }
    if(synced && *error_code == 0) cacheMovedTensors(task);
   }
-  if(synced) tasks_.erase(iter);
+  if(synced){
+   tasks_.erase(iter);
+   converted_.erase(op_handle);
+  }
  }
+ if(synced) packTensorOperands(op_handle,(*error_code == 0));
  return synced;
 }
 
@@ -1010,6 +1652,13 @@ bool TalshNodeExecutor::sync()
 {
  bool synced = true;
 
+ for(auto & task: host_tasks_){
+  int error_code = 0;
+  bool snc = testHostTask(task.second,&error_code,true);
+  synced = synced && snc;
+ }
+ host_tasks_.clear();
+
  for(auto & task: evictions_){
   bool snc = task.second->wait();
   synced = synced && snc;
@@ -1022,6 +1671,7 @@ bool TalshNodeExecutor::sync()
   synced = synced && snc;
  }
  tasks_.clear();
+ converted_.clear();
 
  for(auto & task: prefetches_){
   bool snc = task.second->wait();
@@ -1036,11 +1686,22 @@ bool TalshNodeExecutor::sync()
 
 bool TalshNodeExecutor::discard(TensorOpExecHandle op_handle)
 {
+ auto host_task = host_tasks_.find(op_handle);
+ if(host_task != host_tasks_.end()){
+  int error_code = 0;
+  auto synced = testHostTask(host_task->second,&error_code,true); assert(synced);
+  host_tasks_.erase(host_task);
+  packTensorOperands(op_handle,false);
+  return true;
+ }
  auto iter = tasks_.find(op_handle);
  if(iter != tasks_.end()){
   tasks_.erase(iter);
+  converted_.erase(op_handle);
+  packTensorOperands(op_handle,false);
   return true;
  }
+ packTensorOperands(op_handle,false);
  return false;
 }
 
@@ -1048,6 +1709,21 @@ bool TalshNodeExecutor::discard(TensorOpExecHandle op_handle)
 bool TalshNodeExecutor::prefetch(const numerics::TensorOperation & op)
 {
  bool prefetching = false;
+ //Stage spilled tensor operands back to Host ahead of use:
+ if(!spilled_tensors_.empty() && op.getOpcode() != TensorOpCode::DESTROY){
+  const auto num_operands = op.getNumOperands();
+  for(unsigned int i = 0; i < num_operands; ++i){
+   const auto tensor_hash = op.getTensorOperand(i)->getTensorHash();
+   auto spilled = spilled_tensors_.find(tensor_hash);
+   if(spilled != spilled_tensors_.end()){
+    if(!(spilled->second.staged)){
+     bool staging = stageSpilledTensor(tensor_hash);
+     if(staging) ++num_staged_;
+     prefetching = prefetching || staging;
+    }
+   }
+  }
+ }
  if(prefetch_enabled_){
   const auto opcode = op.getOpcode();
   if(opcode == TensorOpCode::CONTRACT){
@@ -1108,7 +1784,7 @@ std::shared_ptr<talsh::Tensor> TalshNodeExecutor::getLocalTensor(const numerics:
   dims[i] = static_cast<int>(slice_spec[i].second);
  }
  std::shared_ptr<talsh::Tensor> slice(nullptr);
- switch(tensor.getElementType()){
+ switch(getComputeElementType(tensor.getElementType())){ //16-bit tensors are returned in single precision
   case TensorElementType::REAL32:
    slice = std::make_shared<talsh::Tensor>(signature,dims,static_cast<float>(0.0));
    break;
@@ -1127,8 +1803,10 @@ std::shared_ptr<talsh::Tensor> TalshNodeExecutor::getLocalTensor(const numerics:
    std::abort();
  }
  if(!(slice->isEmpty())){
+  bool unpacked = restoreSpilledTensor(tensor.getTensorHash()) //spilled tensors need to be restored first
+               && unpackTensor(tensor.getTensorHash()); //16-bit tensors need to be unpacked first
   auto tens_pos = tensors_.find(tensor.getTensorHash());
-  if(tens_pos == tensors_.end()){
+  if(!unpacked || tens_pos == tensors_.end()){
    std::cout << "#ERROR(exatn::runtime::TalshNodeExecutor::getLocalTensor): Tensor not found: " << std::endl;
    tensor.printIt();
    std::abort();
@@ -1137,6 +1815,7 @@ std::shared_ptr<talsh::Tensor> TalshNodeExecutor::getLocalTensor(const numerics:
   auto & talsh_tensor = *(tens_pos->second.talsh_tensor);
   auto error_code = talsh_tensor.extractSlice(nullptr,*slice,offsets);
   assert(error_code == TALSH_SUCCESS);
+  packTensor(tensor.getTensorHash(),false);
  }else{
   slice.reset();
   std::cout << "#WARNING(exatn::runtime::TalshNodeExecutor::getLocalTensor): "
@@ -1147,6 +1826,189 @@ std::shared_ptr<talsh::Tensor> TalshNodeExecutor::getLocalTensor(const numerics:
 }
 
 
+std::shared_ptr<talsh::Tensor> TalshNodeExecutor::convertTensorDataKind(talsh::Tensor & talsh_tens,
+                                                                      int data_kind)
+{
+ unsigned int num_dims = 0;
+ const int * extents = talsh_tens.getDimExtents(num_dims);
+ std::vector<int> dims(extents,extents+num_dims);
+ auto * converted_tens = new talsh::Tensor(talsh_tens.getDimOffsets(),dims,data_kind,talsh_tens_no_init);
+ if(converted_tens->isEmpty()){ //no memory available at this time
+  delete converted_tens;
+  return std::shared_ptr<talsh::Tensor>(nullptr);
+ }
+ //The converted copy occupies the Host memory buffer until it is released:
+ int data_kind_size;
+ auto valid = talshValidDataKind(data_kind,&data_kind_size); assert(valid == YEP);
+ const std::size_t converted_size = converted_tens->getVolume() * data_kind_size;
+ auxiliary_bytes_ += converted_size;
+ std::shared_ptr<talsh::Tensor> converted(converted_tens,
+  [this,converted_size](talsh::Tensor * tens){auxiliary_bytes_ -= converted_size; delete tens;});
+ auto synced = talsh_tens.sync(DEV_HOST,0); assert(synced);
+ bool success = false;
+ const int src_data_kind = talsh_tens.getElementType();
+ switch(src_data_kind){
+  case(talsh::REAL32):
+   switch(data_kind){
+    case(talsh::REAL64): success = convert_tensor_body<float,double>(talsh_tens,*converted); break;
+    case(talsh::COMPLEX32): success = convert_tensor_body<float,std::complex<float>>(talsh_tens,*converted); break;
+    case(talsh::COMPLEX64): success = convert_tensor_body<float,std::complex<double>>(talsh_tens,*converted); break;
+   }
+   break;
+  case(talsh::REAL64):
+   switch(data_kind){
+    case(talsh::REAL32): success = convert_tensor_body<double,float>(talsh_tens,*converted); break;
+    case(talsh::COMPLEX32): success = convert_tensor_body<double,std::complex<float>>(talsh_tens,*converted); break;
+    case(talsh::COMPLEX64): success = convert_tensor_body<double,std::complex<double>>(talsh_tens,*converted); break;
+   }
+   break;
+  case(talsh::COMPLEX32):
+   switch(data_kind){
+    case(talsh::COMPLEX64): success = convert_tensor_body<std::complex<float>,std::complex<double>>(talsh_tens,*converted); break;
+   }
+   break;
+  case(talsh::COMPLEX64):
+   switch(data_kind){
+    case(talsh::COMPLEX32): success = convert_tensor_body<std::complex<double>,std::complex<float>>(talsh_tens,*converted); break;
+   }
+   break;
+ }
+ if(!success){
+  std::cout << "#ERROR(exatn::runtime::node_executor_talsh): Unable to convert TAL-SH data kind "
+            << src_data_kind << " to " << data_kind << std::endl << std::flush;
+  assert(false);
+ }
+ return converted;
+}
+
+
+bool TalshNodeExecutor::unpackTensorOperands(const numerics::TensorOperation & op,
+                                             TensorOpExecHandle * exec_handle)
+{
+ *exec_handle = op.getId();
+ if(packed_tensors_.empty()) return true; //no 16-bit tensors
+ if(unpacked_.find(*exec_handle) != unpacked_.end()) return true; //tensor operands have already been unpacked
+ std::vector<std::pair<numerics::TensorHashType,bool>> operands;
+ const auto num_operands = op.getNumOperands();
+ for(unsigned int i = 0; i < num_operands; ++i){
+  bool conjugated, mutated;
+  const auto tensor_hash = op.getTensorOperand(i,&conjugated,&mutated)->getTensorHash();
+  if(packed_tensors_.find(tensor_hash) != packed_tensors_.end()){
+   if(!unpackTensor(tensor_hash)){ //no memory at this time: Roll back
+    for(const auto & operand: operands) packTensor(operand.first,false);
+    return false;
+   }
+   operands.emplace_back(std::make_pair(tensor_hash,mutated));
+  }
+ }
+ if(!operands.empty()) unpacked_.emplace(std::make_pair(*exec_handle,operands));
+ return true;
+}
+
+
+void TalshNodeExecutor::packTensorOperands(TensorOpExecHandle op_handle,
+                                           bool write_back)
+{
+ auto iter = unpacked_.find(op_handle);
+ if(iter != unpacked_.end()){
+  for(const auto & operand: iter->second) packTensor(operand.first,write_back && operand.second);
+  unpacked_.erase(iter);
+ }
+ return;
+}
+
+
+bool TalshNodeExecutor::unpackTensor(numerics::TensorHashType tensor_hash)
+{
+ auto packed = packed_tensors_.find(tensor_hash);
+ if(packed == packed_tensors_.end()) return true; //not a packed 16-bit tensor
+ auto & packed_tensor = packed->second;
+ if(packed_tensor.num_users == 0){ //create a single-precision copy
+  const auto elem_type = packed_tensor.element_type;
+  auto res = tensors_.emplace(std::make_pair(tensor_hash,
+                              TensorImpl(packed_tensor.full_offsets,packed_tensor.full_extents,
+                                         packed_tensor.reduced_offsets,packed_tensor.reduced_extents,
+                                         get_talsh_tensor_element_kind(getComputeElementType(elem_type)))));
+  assert(res.second);
+  auto & talsh_tensor = *(res.first->second.talsh_tensor);
+  if(talsh_tensor.isEmpty()){ //no memory at this time
+   tensors_.erase(res.first);
+   return false;
+  }
+  bool access_granted = false;
+  float * body = nullptr;
+  if(elem_type == TensorElementType::REAL16 || elem_type == TensorElementType::REALBF16){
+   access_granted = talsh_tensor.getDataAccessHost(&body);
+  }else{
+   std::complex<float> * body_c = nullptr;
+   access_granted = talsh_tensor.getDataAccessHost(&body_c);
+   body = reinterpret_cast<float*>(body_c);
+  }
+  assert(access_granted);
+  const auto * packed_body = packed_tensor.body.data();
+  if(elem_type == TensorElementType::REAL16 || elem_type == TensorElementType::COMPLEX16){
+   convertFloat16ToFloat(reinterpret_cast<const Float16*>(packed_body),body,packed_tensor.body.size());
+  }else{
+   convertBFloat16ToFloat(reinterpret_cast<const BFloat16*>(packed_body),body,packed_tensor.body.size());
+  }
+  auxiliary_bytes_ += packed_tensor.body.size() * sizeof(float);
+ }
+ ++(packed_tensor.num_users);
+ return true;
+}
+
+
+void TalshNodeExecutor::packTensor(numerics::TensorHashType tensor_hash,
+                                   bool write_back)
+{
+ auto packed = packed_tensors_.find(tensor_hash);
+ if(packed == packed_tensors_.end()) return; //not a packed 16-bit tensor
+ auto & packed_tensor = packed->second;
+ assert(packed_tensor.num_users > 0);
+ auto iter = tensors_.find(tensor_hash);
+ assert(iter != tensors_.end());
+ auto & talsh_tensor = *(iter->second.talsh_tensor);
+ if(write_back){ //convert the updated single-precision copy back into the packed 16-bit format
+  auto synced = talsh_tensor.sync(DEV_HOST,0); assert(synced);
+  const auto elem_type = packed_tensor.element_type;
+  bool access_granted = false;
+  const float * body = nullptr;
+  if(elem_type == TensorElementType::REAL16 || elem_type == TensorElementType::REALBF16){
+   access_granted = talsh_tensor.getDataAccessHostConst(&body);
+  }else{
+   const std::complex<float> * body_c = nullptr;
+   access_granted = talsh_tensor.getDataAccessHostConst(&body_c);
+   body = reinterpret_cast<const float*>(body_c);
+  }
+  assert(access_granted);
+  auto * packed_body = packed_tensor.body.data();
+  if(elem_type == TensorElementType::REAL16 || elem_type == TensorElementType::COMPLEX16){
+   convertFloatToFloat16(body,reinterpret_cast<Float16*>(packed_body),packed_tensor.body.size());
+  }else{
+   convertFloatToBFloat16(body,reinterpret_cast<BFloat16*>(packed_body),packed_tensor.body.size());
+  }
+ }
+ if(--(packed_tensor.num_users) == 0){ //release the single-precision copy
+  auto prefetch = prefetches_.find(tensor_hash);
+  if(prefetch != prefetches_.end()){
+   auto snc = prefetch->second->wait();
+   prefetches_.erase(prefetch);
+  }
+  auto eviction = evictions_.find(&talsh_tensor);
+  if(eviction != evictions_.end()){
+   auto snc = eviction->second->wait();
+   evictions_.erase(eviction);
+  }
+  for(int dev = 0; dev < DEV_MAX; ++dev) accel_cache_[dev].erase(&talsh_tensor);
+  auto synced = talsh_tensor.sync(DEV_HOST,0,nullptr,true); assert(synced);
+  iter->second.resetTensorShapeToReduced();
+  tensors_.erase(iter);
+  auxiliary_bytes_ -= packed_tensor.body.size() * sizeof(float);
+ }
+ return;
+}
+
+
 bool TalshNodeExecutor::finishPrefetching(const numerics::TensorOperation & op)
 {
  bool synced = true;
@@ -1181,6 +2043,18 @@ bool TalshNodeExecutor::finishPrefetching(const numerics::TensorOperation & op)
    synced = synced && snc;
   }
  }
+ //Restore spilled tensor operands (destroyed tensors need not be restored):
+ if(op.getOpcode() != TensorOpCode::DESTROY){
+  const double time_stamp = exatn::Timer::timeInSecHR();
+  for(unsigned int oprnd = 0; oprnd < num_operands; ++oprnd){
+   const auto tens_hash = op.getTensorOperand(oprnd)->getTensorHash();
+   bool restored = restoreSpilledTensor(tens_hash,&op);
+   if(restored){
+    if(tensors_.find(tens_hash) != tensors_.end()) host_usage_[tens_hash] = CachedAttr{time_stamp};
+   }
+   synced = synced && restored;
+  }
+ }
  return synced;
 }
 
@@ -1262,8 +2136,30 @@ bool TalshNodeExecutor::evictMovedTensors(int device_id, std::size_t required_sp
 }
 
 
-bool TalshNodeExecutor::tensorIsCurrentlyInUse(const talsh::Tensor * talsh_tens) const
+bool TalshNodeExecutor::testHostTask(HostTask & host_task,
+                                      int * error_code,
+                                      bool wait)
+{
+ *error_code = 0;
+ if(!host_task.status.valid()) return true;
+ if(!wait){
+  if(host_task.status.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return false;
+ }
+ *error_code = host_task.status.get();
+ return true;
+}
+
+
+bool TalshNodeExecutor::tensorIsCurrentlyInUse(const talsh::Tensor * talsh_tens,
+                                               bool host_tasks) const
 {
+ for(const auto & task: host_tasks_){
+  if(host_tasks || task.second.transform){ //tensor transformations mutate their argument
+   for(const auto * tens: task.second.arguments){
+    if(tens == talsh_tens) return true;
+   }
+  }
+ }
  for(const auto & task: evictions_){
   const auto num_task_args = task.second->getNumTensorArguments();
   for(unsigned int i = 0; i < num_task_args; ++i){
@@ -1285,5 +2181,400 @@ bool TalshNodeExecutor::tensorIsCurrentlyInUse(const talsh::Tensor * talsh_tens)
  return false;
 }
 
+
+void TalshNodeExecutor::placeTensorOnNumaDomain(numerics::TensorHashType tensor_hash,
+                                                const talsh::Tensor & talsh_tens)
+{
+ assert(numa_);
+ std::size_t body_size = 0;
+ const void * body = get_talsh_tensor_body_host(talsh_tens,&body_size);
+ if(body == nullptr) return;
+ const auto domain = static_cast<unsigned int>(std::distance(numa_domain_bytes_.cbegin(),
+                      std::min_element(numa_domain_bytes_.cbegin(),numa_domain_bytes_.cend())));
+ //Only the touched pages can be migrated (untouched pages will reside wherever they are touched first):
+ const auto placed_size = numa_->moveMemory(body,body_size,domain);
+ if(placed_size == 0) return;
+ numa_domain_bytes_[domain] += placed_size;
+ numa_placement_[tensor_hash] = std::make_pair(domain,placed_size);
+ return;
+}
+
+
+int TalshNodeExecutor::selectNumaDomain(const numerics::TensorOperation & op)
+{
+ if(!numa_ || !(numa_->isNuma())) return -1;
+ std::vector<std::size_t> domain_bytes(numa_->getNumDomains(),0);
+ std::size_t total_bytes = 0;
+ const auto num_operands = op.getNumOperands();
+ for(unsigned int i = 0; i < num_operands; ++i){
+  const auto tensor_hash = op.getTensorOperand(i)->getTensorHash();
+  auto placement = numa_placement_.find(tensor_hash);
+  if(placement != numa_placement_.end()){
+   domain_bytes[placement->second.first] += placement->second.second;
+   total_bytes += placement->second.second;
+  }else{ //tensor placed by TAL-SH (query its actual NUMA domain)
+   auto iter = tensors_.find(tensor_hash);
+   if(iter != tensors_.end()){
+    std::size_t body_size = 0;
+    const void * body = get_talsh_tensor_body_host(*(iter->second.talsh_tensor),&body_size);
+    if(body != nullptr){
+     total_bytes += body_size;
+     const auto domain = numa_->getMemoryDomain(body);
+     if(domain >= 0) domain_bytes[domain] += body_size;
+    }
+   }
+  }
+ }
+ if(total_bytes < numa_min_bytes_) return -1; //small tensor operations are executed by unbound Host threads
+ const auto owner = std::max_element(domain_bytes.cbegin(),domain_bytes.cend());
+ if(*owner == 0) return -1;
+ const auto domain = static_cast<int>(std::distance(domain_bytes.cbegin(),owner));
+ numa_domain_usage_[domain].first++;
+ numa_domain_usage_[domain].second += static_cast<double>(total_bytes);
+ return domain;
+}
+
+
+void TalshNodeExecutor::bindHostThreads(int domain)
+{
+ assert(numa_);
+ if(domain == numa_bound_domain_) return;
+ const auto * numa = numa_.get();
+#ifdef _OPENMP
+ const int num_threads = ((domain >= 0) ? static_cast<int>(numa->getDomainCpus(domain).size()) : numa_default_threads_);
+ omp_set_num_threads(num_threads);
+#pragma omp parallel shared(numa,domain)
+ {
+  numa->bindThread(domain);
+ }
+#else
+ numa->bindThread(domain);
+#endif
+ numa_bound_domain_ = domain;
+ return;
+}
+
+
+int TalshNodeExecutor::getTransformThreads(bool exclusive) const
+{
+ return (exclusive ? std::max(1,host_max_threads_/2) : 1);
+}
+
+
+void TalshNodeExecutor::shareHostThreads()
+{
+#ifdef _OPENMP
+ int busy_threads = 0;
+ for(const auto & task: host_tasks_){
+  if(task.second.transform) busy_threads += getTransformThreads(task.second.exclusive);
+ }
+ int num_threads = host_max_threads_;
+ if(numa_ && numa_bound_domain_ >= 0) num_threads = static_cast<int>(numa_->getDomainCpus(numa_bound_domain_).size());
+ omp_set_num_threads(std::max(1,num_threads-busy_threads));
+#endif
+ return;
+}
+
+
+void TalshNodeExecutor::printNumaStatistics() const
+{
+ assert(numa_);
+ std::cout << "#MSG(exatn::runtime::TalshNodeExecutor): NUMA domain utilization:" << std::endl;
+ for(unsigned int domain = 0; domain < numa_->getNumDomains(); ++domain){
+  std::cout << " Domain " << domain << " (" << numa_->getDomainCpus(domain).size() << " CPUs): "
+            << numa_domain_usage_[domain].first << " bound tensor contractions with "
+            << numa_domain_usage_[domain].second << " operand bytes; "
+            << numa_domain_bytes_[domain] << " bytes of tensor data currently placed" << std::endl;
+ }
+ return;
+}
+
+
+std::size_t TalshNodeExecutor::spillIdleTensors(std::size_t required_space,
+                                                const numerics::TensorOperation * op)
+{
+ std::size_t freed_bytes = 0;
+ if(spill_directory_.empty() && compression_mode_ == 0) return freed_bytes;
+ std::unordered_set<numerics::TensorHashType> excluded;
+ if(op != nullptr){
+  const auto num_operands = op->getNumOperands();
+  for(unsigned int i = 0; i < num_operands; ++i) excluded.emplace(op->getTensorOperand(i)->getTensorHash());
+ }
+ //Order resident tensors by their last usage:
+ std::vector<std::pair<double,numerics::TensorHashType>> candidates;
+ for(const auto & tens: tensors_){
+  if(excluded.find(tens.first) == excluded.end()){
+   auto usage = host_usage_.find(tens.first);
+   const double last_used = ((usage != host_usage_.end()) ? usage->second.last_used : 0.0);
+   candidates.emplace_back(std::make_pair(last_used,tens.first));
+  }
+ }
+ std::sort(candidates.begin(),candidates.end());
+ //Spill the least recently used idle tensors:
+ for(const auto & candidate: candidates){
+  if(required_space > 0 && freed_bytes >= required_space) break;
+  freed_bytes += spillTensor(candidate.second);
+ }
+ return freed_bytes;
+}
+
+
+std::size_t TalshNodeExecutor::spillTensor(numerics::TensorHashType tensor_hash)
+{
+ if(spill_directory_.empty() && compression_mode_ == 0) return 0;
+ if(packed_tensors_.find(tensor_hash) != packed_tensors_.end()) return 0; //single-precision copies of 16-bit tensors are transient
+ auto iter = tensors_.find(tensor_hash);
+ if(iter == tensors_.end()) return 0;
+ auto * talsh_tens = iter->second.talsh_tensor.get();
+ if(tensorIsCurrentlyInUse(talsh_tens)) return 0;
+ int data_kind_size;
+ auto valid = talshValidDataKind(talsh_tens->getElementType(),&data_kind_size); assert(valid == YEP);
+ const std::size_t tens_size = talsh_tens->getVolume() * data_kind_size;
+ const bool to_disk = (!spill_directory_.empty() && tens_size >= spill_min_bytes_);
+ const bool to_compress = (compression_mode_ > 0 && tens_size >= compression_min_bytes_ &&
+                           incompressible_tensors_.find(tensor_hash) == incompressible_tensors_.end());
+ if(tens_size == 0 || !(to_disk || to_compress)) return 0;
+ //Create the spill file (unless the tensor is going to be compressed):
+ std::unique_ptr<SpillFile> file(nullptr);
+ if(!to_compress){
+  file.reset(new SpillFile(spill_directory_,tens_size));
+  if(!(file->isValid())) return 0;
+ }
+ //Evict the tensor from device caches and move its image to Host:
+ for(int dev = 0; dev < DEV_MAX; ++dev){
+  auto cached = accel_cache_[dev].find(talsh_tens);
+  if(cached != accel_cache_[dev].end()) accel_cache_[dev].erase(cached);
+ }
+ auto synced = talsh_tens->sync(DEV_HOST,0,nullptr,true); assert(synced);
+ //Copy the tensor body into the spill file:
+ iter->second.resetTensorShapeToReduced();
+ std::size_t body_size = 0;
+ const void * body = get_talsh_tensor_body_host(static_cast<const talsh::Tensor &>(*talsh_tens),&body_size);
+ if(body == nullptr || body_size != tens_size) return 0;
+ //Compress the tensor body, see Rationale (f):
+ std::unique_ptr<CompressedBody> compressed(nullptr);
+ if(to_compress){
+  const auto data_kind = talsh_tens->getElementType();
+  const std::size_t word_size = ((data_kind == talsh::REAL32 || data_kind == talsh::COMPLEX32) ? 4 : 8);
+  const bool lossy = (lossy_tensors_.find(tensor_hash) != lossy_tensors_.end());
+  const auto truncated_bits = (lossy ? get_truncated_mantissa_bits(word_size,compression_error_bound_) : 0U);
+  compressed.reset(new CompressedBody());
+  compress_tensor_body(body,body_size,word_size,truncated_bits,*compressed);
+  const auto compressed_size = compressed->getCompressedSize();
+  if(static_cast<double>(body_size) >= MIN_COMPRESSION_RATIO * static_cast<double>(compressed_size)){
+   ++num_compressions_;
+   if(lossy) ++num_lossy_compressions_;
+   compression_input_bytes_ += static_cast<double>(body_size);
+   compression_output_bytes_ += static_cast<double>(compressed_size);
+  }else{ //insufficient compression: spill to disk instead, if possible
+   compressed.reset();
+   incompressible_tensors_.emplace(tensor_hash); //do not compress this tensor again
+   if(!to_disk) return 0;
+   file.reset(new SpillFile(spill_directory_,tens_size));
+   if(!(file->isValid())) return 0;
+  }
+ }
+ //Copy the tensor body into the spill file:
+ if(file){
+  std::memcpy(file->getData(),body,body_size);
+  file->writeBack();
+ }
+ //Record the metadata needed to recreate the TAL-SH tensor:
+ SpilledTensor spilled_tensor;
+ spilled_tensor.full_offsets = iter->second.full_base_offsets;
+ const auto * full_shape = iter->second.stored_shape; //reduced shape is on, thus the stored shape is full
+ for(int i = 0; i < full_shape->num_dim; ++i) spilled_tensor.full_extents.emplace_back(full_shape->dims[i]);
+ spilled_tensor.reduced_offsets = iter->second.reduced_base_offsets;
+ unsigned int num_dims = 0;
+ const int * extents = talsh_tens->getDimExtents(num_dims);
+ spilled_tensor.reduced_extents.assign(extents,extents+num_dims);
+ spilled_tensor.data_kind = talsh_tens->getElementType();
+ spilled_tensor.size = tens_size;
+ spilled_tensor.file = std::move(file);
+ spilled_tensor.compressed = std::move(compressed);
+ //Release the Host memory:
+ tensors_.erase(iter);
+ host_usage_.erase(tensor_hash);
+ auto placement = numa_placement_.find(tensor_hash);
+ if(placement != numa_placement_.end()){
+  numa_domain_bytes_[placement->second.first] -= placement->second.second;
+  numa_placement_.erase(placement);
+ }
+ if(spilled_tensor.compressed){
+  compressed_bytes_ += spilled_tensor.compressed->getCompressedSize();
+ }else{
+  spilled_bytes_ += tens_size;
+  if(spilled_bytes_ > peak_spilled_bytes_) peak_spilled_bytes_ = spilled_bytes_;
+  ++num_spills_;
+ }
+ released_bytes_ += tens_size;
+ auto res = spilled_tensors_.emplace(std::make_pair(tensor_hash,std::move(spilled_tensor))); assert(res.second);
+ return tens_size;
+}
+
+
+bool TalshNodeExecutor::stageSpilledTensor(numerics::TensorHashType tensor_hash)
+{
+ auto spilled = spilled_tensors_.find(tensor_hash);
+ assert(spilled != spilled_tensors_.end());
+ auto & spilled_tensor = spilled->second;
+ if(spilled_tensor.staged) return true;
+ std::unique_ptr<TensorImpl> tensor_impl(new TensorImpl(spilled_tensor.full_offsets,spilled_tensor.full_extents,
+                                                        spilled_tensor.reduced_offsets,spilled_tensor.reduced_extents,
+                                                        spilled_tensor.data_kind));
+ if(tensor_impl->talsh_tensor->isEmpty()) return false; //Host memory is temporarily unavailable
+ std::size_t body_size = 0;
+ void * body = get_talsh_tensor_body_host(*(tensor_impl->talsh_tensor),&body_size);
+ assert(body != nullptr && body_size == spilled_tensor.size);
+ if(spilled_tensor.compressed){ //decompression
+  const CompressedBody * compressed = spilled_tensor.compressed.get();
+  spilled_tensor.staging = std::async(std::launch::async,
+                                      [body,compressed] () {
+                                       return (decompress_tensor_body(*compressed,body) ? 0 : TALSH_FAILURE);
+                                      });
+ }else{ //reading back from disk
+  spilled_tensor.file->stage();
+  const void * file_data = spilled_tensor.file->getData();
+  spilled_tensor.staging = std::async(std::launch::async,
+                                      [body,file_data,body_size] () {
+                                       std::memcpy(body,file_data,body_size);
+                                       return 0;
+                                      });
+ }
+ spilled_tensor.staged = std::move(tensor_impl);
+ released_bytes_ -= spilled_tensor.size; //the staged image occupies the Host memory buffer
+ return true;
+}
+
+
+bool TalshNodeExecutor::restoreSpilledTensor(numerics::TensorHashType tensor_hash,
+                                             const numerics::TensorOperation * op)
+{
+ if(spilled_tensors_.find(tensor_hash) == spilled_tensors_.end()) return true; //tensor is resident
+ bool staged = stageSpilledTensor(tensor_hash);
+ if(!staged){ //make room by spilling other idle tensors
+  const auto tens_size = spilled_tensors_.find(tensor_hash)->second.size;
+  if(spillIdleTensors(tens_size,op) > 0) staged = stageSpilledTensor(tensor_hash);
+ }
+ if(!staged) return false;
+ auto spilled = spilled_tensors_.find(tensor_hash); //spilling may have rehashed the map
+ auto & spilled_tensor = spilled->second;
+ auto error_code = spilled_tensor.staging.get(); assert(error_code == 0);
+ auto res = tensors_.emplace(std::make_pair(tensor_hash,std::move(*(spilled_tensor.staged)))); assert(res.second);
+ if(spilled_tensor.compressed){
+  compressed_bytes_ -= spilled_tensor.compressed->getCompressedSize();
+ }else{
+  spilled_bytes_ -= spilled_tensor.size;
+ }
+ spilled_tensors_.erase(spilled);
+ ++num_restores_;
+ if(numa_) placeTensorOnNumaDomain(tensor_hash,*(res.first->second.talsh_tensor));
+ return true;
+}
+
+
+void TalshNodeExecutor::printSpillStatistics() const
+{
+ std::cout << "#MSG(exatn::runtime::TalshNodeExecutor): Tensor spilling: " << num_spills_ << " spills to disk, "
+           << num_compressions_ << " compressions, " << num_restores_ << " restores (" << num_staged_
+           << " staged ahead of use)" << std::endl;
+ if(!spill_directory_.empty()){
+  std::cout << " Spill directory " << spill_directory_ << ": Peak spilled data = " << peak_spilled_bytes_
+            << " bytes; Currently spilled = " << spilled_bytes_ << " bytes" << std::endl;
+ }
+ if(num_compressions_ > 0){
+  std::cout << " Compression: " << num_lossy_compressions_ << " lossy; Compression ratio = "
+            << std::fixed << std::setprecision(2) << (compression_input_bytes_ / compression_output_bytes_)
+            << std::defaultfloat << "; Currently compressed data = " << compressed_bytes_ << " bytes" << std::endl;
+ }
+ return;
+}
+
+
+ContractionKernel TalshNodeExecutor::selectContractionKernel(const numerics::TensorOpContract & op,
+                                                             talsh::Tensor & tens0,
+                                                             talsh::Tensor & tens1,
+                                                             talsh::Tensor & tens2)
+{
+ assert(tuner_);
+ //Only tensor contractions with small Host-resident operands have candidates other than TAL-SH:
+ std::size_t size0 = 0, size1 = 0, size2 = 0;
+ const void * body0 = get_talsh_tensor_body_host(static_cast<const talsh::Tensor&>(tens0),&size0);
+ const void * body1 = get_talsh_tensor_body_host(static_cast<const talsh::Tensor&>(tens1),&size1);
+ const void * body2 = get_talsh_tensor_body_host(static_cast<const talsh::Tensor&>(tens2),&size2);
+ if(body0 == nullptr || body1 == nullptr || body2 == nullptr) return ContractionKernel::TALSH;
+ if(size0 + size1 + size2 > direct_max_bytes_) return ContractionKernel::TALSH;
+ //Tensor contractions TAL-SH would execute on an accelerator are not tuned (candidates are timed on Host):
+ int dev_kind;
+ talshKindDevId(talsh::determineOptimalDevice(tens0,tens1,tens2),&dev_kind);
+ if(dev_kind != DEV_HOST) return ContractionKernel::TALSH;
+ //Look up the tensor contraction signature:
+ const auto pattern = op.getIndexPatternReduced();
+ const int data_kind = tens0.getElementType();
+ const std::vector<std::vector<int>> dims {get_talsh_tensor_dims(tens0),
+                                           get_talsh_tensor_dims(tens1),
+                                           get_talsh_tensor_dims(tens2)};
+ const auto signature = get_contraction_signature(pattern,dims,data_kind);
+ auto kernel = ContractionKernel::TALSH;
+ if(tuner_->findKernel(signature,&kernel)) return kernel;
+ //Benchmark TAL-SH on Host into a scratch output tensor:
+ const double tuning_start = exatn::Timer::timeInSecHR();
+ talsh::Tensor scratch(tens0.getDimOffsets(),dims[0],data_kind,talsh_tens_no_init);
+ if(scratch.isEmpty()) return ContractionKernel::TALSH; //no memory available at this time (tune later)
+ double talsh_time = std::numeric_limits<double>::max();
+ for(unsigned int i = 0; i < TUNING_REPEATS; ++i){
+  talsh::TensorTask task;
+  const double time_start = exatn::Timer::timeInSecHR();
+  auto error_code = scratch.contractAccumulate(&task,pattern,tens1,tens2,DEV_HOST,0,op.getScalar(0),false);
+  if(error_code != TALSH_SUCCESS || !(task.wait())) return ContractionKernel::TALSH; //tune later
+  talsh_time = std::min(talsh_time,exatn::Timer::timeInSecHR(time_start));
+ }
+ //Benchmark direct loops on Host and validate their result against TAL-SH:
+ double direct_time = -1.0;
+ DirectContraction plan;
+ if(plan_direct_contraction(pattern,dims,plan)){
+  std::size_t ref_size = 0;
+  const void * ref_body = get_talsh_tensor_body_host(static_cast<const talsh::Tensor&>(scratch),&ref_size);
+  if(ref_body != nullptr){
+   std::vector<char> direct_body(ref_size);
+   double time = std::numeric_limits<double>::max();
+   for(unsigned int i = 0; i < TUNING_REPEATS; ++i){
+    const double time_start = exatn::Timer::timeInSecHR();
+    contract_direct(plan,data_kind,direct_body.data(),body1,body2,op.getScalar(0),false);
+    time = std::min(time,exatn::Timer::timeInSecHR(time_start));
+   }
+   if(compare_tensor_bodies(data_kind,direct_body.data(),ref_body,tens0.getVolume())){
+    direct_time = time;
+    if(direct_time < talsh_time) kernel = ContractionKernel::DIRECT;
+   }else{
+    std::cout << "#WARNING(exatn::runtime::TalshNodeExecutor): Direct tensor contraction kernel result mismatch: "
+              << signature << std::endl;
+   }
+  }
+ }
+ tuner_->recordKernel(signature,kernel,talsh_time,direct_time,exatn::Timer::timeInSecHR(tuning_start));
+ return kernel;
+}
+
+
+bool TalshNodeExecutor::contractDirect(const numerics::TensorOpContract & op,
+                                       talsh::Tensor & tens0,
+                                       talsh::Tensor & tens1,
+                                       talsh::Tensor & tens2,
+                                       bool accumulative)
+{
+ const std::vector<std::vector<int>> dims {get_talsh_tensor_dims(tens0),
+                                           get_talsh_tensor_dims(tens1),
+                                           get_talsh_tensor_dims(tens2)};
+ DirectContraction plan;
+ if(!plan_direct_contraction(op.getIndexPatternReduced(),dims,plan)) return false;
+ std::size_t size0 = 0, size1 = 0, size2 = 0;
+ void * body0 = get_talsh_tensor_body_host(tens0,&size0);
+ const void * body1 = get_talsh_tensor_body_host(static_cast<const talsh::Tensor&>(tens1),&size1);
+ const void * body2 = get_talsh_tensor_body_host(static_cast<const talsh::Tensor&>(tens2),&size2);
+ if(body0 == nullptr || body1 == nullptr || body2 == nullptr) return false;
+ return contract_direct(plan,tens0.getElementType(),body0,body1,body2,op.getScalar(0),accumulative);
+}
+
 } //namespace runtime
 } //namespace exatn
@@ -1,23 +1,111 @@
 /** ExaTN:: Tensor Runtime: Tensor graph node executor: Talsh
-REVISION: 2020/09/29
+REVISION: 2020/12/14
 
 Copyright (C) 2018-2020 Dmitry Lyakh, Tiffany Mintz, Alex McCaskey
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle)
 
 Rationale:
-
+ (a) 16-bit tensors (Float16/BFloat16, real/complex) are not supported by TAL-SH,
+     thus they are stored packed by the node executor itself and unpacked into
+     single-precision TAL-SH tensors for the duration of each tensor operation
+     referencing them. Mutated 16-bit tensor operands are packed back upon
+     completion of the tensor operation, thus computing in single precision.
+     The packed tensor bodies are accounted by the graph executor as live tensors
+     (16-bit size) whereas the single-precision copies occupying the Host memory
+     buffer while in use are reported as auxiliary memory of the node executor,
+     as are the temporary data-kind converted copies of mixed-precision operands.
+ (b) Tensor slicing executed on Host can be performed asynchronously by the Host worker
+     threads, such that slices of the input tensors needed by subsequent tensor operations
+     are extracted while the current tensor operation is being computed. The number of
+     such Host slicing tasks in flight (lookahead) is set by the "host_prefetch_depth"
+     parameter (0 by default: asynchronous slicing is off).
+ (c) Tensor transformations (TRANSFORM) are executed asynchronously by a dedicated
+     pool of Host worker threads, such that other ready tensor operations keep being
+     issued while user-defined tensor functors are applied. The number of Host worker
+     threads is configurable via the "host_transform_threads" parameter (0 turns
+     asynchronous tensor transformations off). Multithreaded (THREAD_PARALLEL) tensor
+     functors are not applied concurrently with other tensor transformations, whereas
+     single-threaded (SERIAL) tensor functors can be applied concurrently, up to the
+     number of Host worker threads. A tensor transformation which cannot be scheduled
+     at the moment is postponed (TRY_LATER). The Host threads (OpenMP) are shared:
+     A multithreaded tensor functor runs with half of them and each single-threaded
+     tensor functor occupies one, whereas the Host tensor contractions issued in the
+     meantime run with the remaining Host threads.
+ (d) NUMA-aware Host execution is activated by the "host_numa_binding" parameter.
+     Each newly created tensor is placed on the NUMA domain with the least amount of
+     tensor data placed on it so far (its touched memory pages are migrated there and
+     only the migrated bytes are accounted to that domain), and
+     Host worker threads are distributed across NUMA domains. Tensor contractions
+     whose operands exceed "host_numa_min_bytes" bytes in total are executed by
+     Host threads bound to the NUMA domain owning most of their operand bytes,
+     whereas smaller tensor contractions are executed by unbound Host threads. Binding
+     applies to the whole OpenMP thread team, including the executor thread itself (team
+     master), for as long as NUMA-bound tensor contractions are being executed. Unbinding
+     restores the original CPU affinity each of these threads had (set by the launcher),
+     which also happens upon executor destruction.
+     Per-domain utilization is reported upon executor destruction. The TAL-SH Host
+     memory buffer remains a single allocation, thus tensors placed on different
+     NUMA domains may share memory pages at their boundaries which are not migrated.
+ (e) Out-of-core execution is activated by the "host_spill_directory" parameter (local disk).
+     Once the Host memory buffer is exhausted (failed tensor creation or a tensor contraction
+     whose TAL-SH temporaries do not fit), idle tensors larger than "host_spill_min_bytes"
+     are spilled to memory-mapped files in the least-recently-used order (last Host usage),
+     releasing their Host memory (reported to the graph executor as spilled memory). A spilled tensor is staged back asynchronously as soon as
+     a tensor operation referencing it is prefetched (DAG lookahead), or synchronously right
+     before that tensor operation is executed otherwise. Spilling statistics are reported
+     upon executor destruction. Packed 16-bit tensors are never spilled.
+ (f) Compression of idle tensors is activated by the "host_compression" parameter
+     (1: lossless, 2: lossless plus error-bounded lossy for tensors whose names begin
+     with "host_compression_lossy_prefix", by default the intermediate tensors "_x").
+     Compression is the first spilling tier, see Rationale (e): An idle tensor larger
+     than "host_compression_min_bytes" is compressed (multithreaded) into Host RAM
+     outside the Host memory buffer, provided it compresses well enough, otherwise it
+     is spilled to disk (if enabled) and is never compressed again during its lifetime. The relative error of lossy compression is bounded
+     by "host_compression_error_bound". Decompression is staged ahead of use exactly as
+     reading back from disk. Compression ratios are reported upon executor destruction.
+ (g) Autotuned tensor contraction kernel selection is activated by the "contraction_autotuning"
+     parameter. The first time a tensor contraction signature (index pattern, tensor extents,
+     tensor element type) is encountered, candidate kernels (TAL-SH and direct loops on Host)
+     are benchmarked on Host into a scratch output tensor, the direct kernel result is validated
+     against the TAL-SH result, and the winner is used for all subsequent tensor contractions
+     with the same signature. The direct kernel is a candidate only for tensor contractions whose
+     operands do not exceed "contraction_direct_max_bytes" bytes in total (larger ones are not tuned).
+     Tensor contractions which TAL-SH would execute on an accelerator are not tuned either, since
+     the candidates are only benchmarked on Host.
+     Tuning results persist in the "contraction_tuning_database" file (if specified), reused across
+     runs and MPI processes. The executed kernel is recorded in each tensor contraction (profiling).
+ (h) A batch of tensor contractions (CONTRACT_BATCH) whose members do not exceed "contraction_direct_max_bytes"
+     bytes each is executed by the direct kernel, one multithreaded loop per run of consecutive
+     mutually independent members (a member reading or writing the output tensor of another member
+     of the same run starts a new run). Larger or otherwise unsupported members are executed by TAL-SH
+     one by one on the optimal device (accelerators included), falling back to Host. Each member either
+     accumulates into (beta = 1) or overwrites (beta = 0) its output tensor. A batch postponed (TRY_LATER)
+     after some of its members have been executed packs their updated 16-bit output tensors back first.
 **/
 
 #ifndef EXATN_RUNTIME_TALSH_NODE_EXECUTOR_HPP_
 #define EXATN_RUNTIME_TALSH_NODE_EXECUTOR_HPP_
 
 #include "tensor_node_executor.hpp"
+#include "numa_topology.hpp"
+#include "spill_file.hpp"
+#include "tensor_codec.hpp"
+#include "contraction_tuner.hpp"
 
 #include "talshxx.hpp"
 
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
+#include <string>
+#include <deque>
+#include <cstdint>
 #include <memory>
+#include <functional>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include <atomic>
 
 namespace exatn {
@@ -28,8 +116,28 @@ class TalshNodeExecutor : public TensorNodeExecutor {
 public:
 
   static constexpr const std::size_t DEFAULT_MEM_BUFFER_SIZE = 2UL * 1024UL * 1024UL * 1024UL; //bytes
-
-  TalshNodeExecutor(): max_tensor_rank_(-1), prefetch_enabled_(true) {}
+  static constexpr const unsigned int DEFAULT_HOST_PREFETCH_DEPTH = 0; //max number of asynchronous Host slicing tasks in flight (off)
+  static constexpr const unsigned int DEFAULT_HOST_TRANSFORM_THREADS = 2; //number of Host worker threads executing tensor transformations
+  static constexpr const std::size_t DEFAULT_NUMA_MIN_BYTES = 64UL * 1024UL * 1024UL; //min operand bytes of a NUMA-bound tensor contraction
+  static constexpr const std::size_t DEFAULT_SPILL_MIN_BYTES = 1UL * 1024UL * 1024UL; //min size of a tensor spilled to disk
+  static constexpr const std::size_t DEFAULT_COMPRESSION_MIN_BYTES = 16UL * 1024UL * 1024UL; //min size of a compressed tensor
+  static constexpr const double DEFAULT_COMPRESSION_ERROR_BOUND = 1e-6; //relative error bound of lossy compression
+  static constexpr const double MIN_COMPRESSION_RATIO = 1.25; //tensors compressing worse are not kept compressed
+  static constexpr const std::size_t DEFAULT_DIRECT_MAX_BYTES = 4UL * 1024UL * 1024UL; //max operand bytes of a directly executed tensor contraction
+  static constexpr const unsigned int TUNING_REPEATS = 3; //number of benchmark runs of each candidate kernel (the fastest one counts)
+
+  TalshNodeExecutor(): max_tensor_rank_(-1), prefetch_enabled_(true),
+                       host_prefetch_depth_(DEFAULT_HOST_PREFETCH_DEPTH),
+                       host_transform_threads_(DEFAULT_HOST_TRANSFORM_THREADS), host_max_threads_(1),
+                       numa_binding_(false), numa_min_bytes_(DEFAULT_NUMA_MIN_BYTES),
+                       numa_bound_domain_(-1), numa_default_threads_(1),
+                       spill_min_bytes_(DEFAULT_SPILL_MIN_BYTES), spilled_bytes_(0),
+                       peak_spilled_bytes_(0), released_bytes_(0), auxiliary_bytes_(0), num_spills_(0), num_restores_(0), num_staged_(0),
+                       compression_mode_(0), compression_min_bytes_(DEFAULT_COMPRESSION_MIN_BYTES),
+                       compression_error_bound_(DEFAULT_COMPRESSION_ERROR_BOUND), compression_lossy_prefix_("_x"),
+                       compressed_bytes_(0), num_compressions_(0), num_lossy_compressions_(0),
+                       compression_input_bytes_(0), compression_output_bytes_(0),
+                       direct_max_bytes_(DEFAULT_DIRECT_MAX_BYTES) {}
 
   TalshNodeExecutor(const TalshNodeExecutor &) = delete;
   TalshNodeExecutor & operator=(const TalshNodeExecutor &) = delete;
@@ -42,6 +150,10 @@ public:
 
   std::size_t getMemoryBufferSize() const override;
 
+  std::size_t getSpilledMemorySize() const override;
+
+  std::size_t getAuxiliaryMemorySize() const override;
+
   int execute(numerics::TensorOpCreate & op,
               TensorOpExecHandle * exec_handle) override;
   int execute(numerics::TensorOpDestroy & op,
@@ -68,6 +180,8 @@ public:
               TensorOpExecHandle * exec_handle) override;
   int execute(numerics::TensorOpAllreduce & op,
               TensorOpExecHandle * exec_handle) override;
+  int execute(numerics::TensorOpContractBatch & op,
+              TensorOpExecHandle * exec_handle) override;
 
   bool sync(TensorOpExecHandle op_handle,
             int * error_code,
@@ -83,6 +197,22 @@ public:
   std::shared_ptr<talsh::Tensor> getLocalTensor(const numerics::Tensor & tensor,
                  const std::vector<std::pair<DimOffset,DimExtent>> & slice_spec) override;
 
+  /** Returns a temporary Host copy of a TAL-SH tensor converted to a different data kind
+      (mixed-precision execution), or nullptr if memory is temporarily unavailable.
+      The copy is accounted as auxiliary memory until it is released. **/
+  std::shared_ptr<talsh::Tensor> convertTensorDataKind(talsh::Tensor & talsh_tens, //in: TAL-SH tensor
+                                                       int data_kind);             //in: requested TAL-SH data kind
+
+  /** Unpacks all 16-bit tensor operands of a given tensor operation into single-precision
+      TAL-SH tensors. Returns FALSE if memory is temporarily unavailable. **/
+  bool unpackTensorOperands(const numerics::TensorOperation & op, //in: tensor operation
+                            TensorOpExecHandle * exec_handle);    //out: execution handle
+
+  /** Releases single-precision copies of 16-bit tensor operands of a tensor operation,
+      packing the mutated tensor operands back if requested. **/
+  void packTensorOperands(TensorOpExecHandle op_handle, //in: execution handle
+                          bool write_back);             //in: whether or not to pack mutated tensor operands back
+
   /** Finishes tensor operand prefetching for a given tensor operation. **/
   bool finishPrefetching(const numerics::TensorOperation & op); //in: tensor operation
 
@@ -101,9 +231,72 @@ public:
 
 protected:
 
+  /** Places a newly created TAL-SH tensor on the least loaded NUMA domain. **/
+  void placeTensorOnNumaDomain(numerics::TensorHashType tensor_hash, //in: tensor hash
+                               const talsh::Tensor & talsh_tens);     //in: TAL-SH tensor
+
+  /** Returns the NUMA domain owning most of the operand bytes of a tensor operation,
+      or -1 if the tensor operation is too small for NUMA-bound execution. **/
+  int selectNumaDomain(const numerics::TensorOperation & op); //in: tensor operation
+
+  /** Binds the Host threads (OpenMP thread team, including the calling executor thread)
+      executing tensor operations to a given NUMA domain, or, if the domain is negative,
+      restores their original CPU affinity (see NumaTopology::bindThread). **/
+  void bindHostThreads(int domain);
+
+  /** Returns the number of Host threads (OpenMP) applying a tensor functor asynchronously. **/
+  int getTransformThreads(bool exclusive) const; //in: whether the tensor functor is multithreaded
+
+  /** Sets the number of Host threads (OpenMP) executing the next tensor operation
+      to the Host threads not occupied by the asynchronous tensor transformations. **/
+  void shareHostThreads();
+
+  /** Prints the utilization of NUMA domains. **/
+  void printNumaStatistics() const;
+
+  /** Spills idle tensors (compression or disk) in the least-recently-used order until the required amount
+      of Host memory has been released (0 spills all idle tensors), excluding the tensor
+      operands of a given tensor operation. Returns the amount of released Host memory in bytes. **/
+  std::size_t spillIdleTensors(std::size_t required_space,                     //in: required space to free in bytes
+                               const numerics::TensorOperation * op = nullptr); //in: tensor operation whose operands must stay
+
+  /** Spills an idle tensor (compression or disk), releasing its Host memory buffer space.
+      Returns the amount of released Host memory in bytes (0 if the tensor cannot be spilled). **/
+  std::size_t spillTensor(numerics::TensorHashType tensor_hash);
+
+  /** Initiates asynchronous staging of a spilled tensor back to the Host memory buffer.
+      Returns FALSE if Host memory is temporarily unavailable. **/
+  bool stageSpilledTensor(numerics::TensorHashType tensor_hash);
+
+  /** Restores a spilled tensor in the Host memory buffer (no effect on a resident tensor),
+      spilling other idle tensors if needed, except the operands of a given tensor operation.
+      Returns FALSE if Host memory is temporarily unavailable. **/
+  bool restoreSpilledTensor(numerics::TensorHashType tensor_hash,
+                            const numerics::TensorOperation * op = nullptr);
+
+  /** Prints the statistics of tensor spilling and compression. **/
+  void printSpillStatistics() const;
+
+  /** Selects the kernel executing a tensor contraction, autotuning the candidate kernels
+      the first time the tensor contraction signature is encountered. **/
+  ContractionKernel selectContractionKernel(const numerics::TensorOpContract & op, //in: tensor contraction
+                                            talsh::Tensor & tens0,                 //in: output TAL-SH tensor
+                                            talsh::Tensor & tens1,                 //in: left TAL-SH tensor
+                                            talsh::Tensor & tens2);                //in: right TAL-SH tensor
+
+  /** Executes a tensor contraction by direct loops on Host (synchronously).
+      Returns FALSE if the tensor contraction cannot be executed directly. **/
+  bool contractDirect(const numerics::TensorOpContract & op, //in: tensor contraction
+                      talsh::Tensor & tens0,                 //inout: output TAL-SH tensor
+                      talsh::Tensor & tens1,                 //in: left TAL-SH tensor
+                      talsh::Tensor & tens2,                 //in: right TAL-SH tensor
+                      bool accumulative);                    //in: accumulate into (TRUE) or overwrite (FALSE) the output tensor
+
   /** Determines whether a given TAL-SH tensor is currently participating
-      in an active tensor operation, tensor prefetch or tensor eviction. **/
-  bool tensorIsCurrentlyInUse(const talsh::Tensor * talsh_tens) const;
+      in an active tensor operation, tensor prefetch or tensor eviction.
+      Asynchronous Host slicing tasks (read-only access to their input) can be ignored. **/
+  bool tensorIsCurrentlyInUse(const talsh::Tensor * talsh_tens,
+                              bool host_tasks = true) const;
 
   struct TensorImpl{
     //TAL-SH tensor with reduced shape (all extent-1 tensor dimensions removed):
@@ -132,6 +325,88 @@ protected:
     void resetTensorShapeToReduced();
   };
 
+  /** Creates (or reuses) a single-precision copy of a packed 16-bit tensor. **/
+  bool unpackTensor(numerics::TensorHashType tensor_hash);
+
+  /** Releases a single-precision copy of a packed 16-bit tensor, packing it back if requested. **/
+  void packTensor(numerics::TensorHashType tensor_hash,
+                  bool write_back);
+
+  struct PackedTensor{
+    //16-bit tensor element type:
+    TensorElementType element_type;
+    //The original full tensor signature and shape:
+    std::vector<std::size_t> full_offsets;
+    std::vector<DimExtent> full_extents;
+    //The reduced tensor signature and shape:
+    std::vector<std::size_t> reduced_offsets;
+    std::vector<int> reduced_extents;
+    //Packed tensor body (two 16-bit words per complex element):
+    std::vector<std::uint16_t> body;
+    //Number of active tensor operations using the single-precision copy:
+    unsigned int num_users;
+  };
+
+  struct SpilledTensor{
+    //The original full tensor signature and shape:
+    std::vector<std::size_t> full_offsets;
+    std::vector<DimExtent> full_extents;
+    //The reduced tensor signature and shape:
+    std::vector<std::size_t> reduced_offsets;
+    std::vector<int> reduced_extents;
+    //TAL-SH tensor data kind:
+    int data_kind;
+    //Tensor body size in bytes:
+    std::size_t size;
+    //Spilled tensor body (either in a spill file or compressed in Host RAM):
+    std::unique_ptr<SpillFile> file;
+    std::unique_ptr<CompressedBody> compressed;
+    //TAL-SH tensor implementation being staged back to Host (nullptr if not staged yet):
+    std::unique_ptr<TensorImpl> staged;
+    //Completion status of the staging copy executed by a helper thread:
+    std::future<int> staging;
+  };
+
+  struct HostTask{
+    //Completion status of the Host task executed by a Host worker thread:
+    std::future<int> status;
+    //TAL-SH tensors participating in the Host task:
+    std::vector<const talsh::Tensor*> arguments;
+    //Whether the Host task is a tensor transformation (mutates its argument):
+    bool transform;
+    //Whether the Host task is applying a multithreaded tensor functor:
+    bool exclusive;
+  };
+
+  /** Pool of Host worker threads executing asynchronous tensor transformations and slicing. **/
+  class HostWorkerPool{
+  public:
+    HostWorkerPool(unsigned int num_workers,
+                   const NumaTopology * numa = nullptr); //worker threads are distributed across NUMA domains, if provided
+    HostWorkerPool(const HostWorkerPool &) = delete;
+    HostWorkerPool & operator=(const HostWorkerPool &) = delete;
+    HostWorkerPool(HostWorkerPool &&) noexcept = delete;
+    HostWorkerPool & operator=(HostWorkerPool &&) noexcept = delete;
+    ~HostWorkerPool(); //finishes all submitted jobs
+    //Submits a job for asynchronous execution, returning its completion status:
+    std::future<int> submit(std::function<int()> job);
+  private:
+    void run(const NumaTopology * numa, int domain);
+    std::vector<std::thread> workers_;
+    std::deque<std::packaged_task<int()>> jobs_;
+    std::mutex jobs_lock_;
+    std::condition_variable jobs_cv_;
+    bool stopping_;
+  };
+
+  /** Returns the pool of Host worker threads, creating it upon first use. **/
+  HostWorkerPool & getHostWorkers();
+
+  /** Tests (or waits on) a Host task for completion, returning its error code. **/
+  bool testHostTask(HostTask & host_task,
+                    int * error_code,
+                    bool wait);
+
   struct CachedAttr{
     double last_used; //time stamp of last usage of the cached tensor image
   };
@@ -140,6 +415,14 @@ protected:
   std::unordered_map<numerics::TensorHashType,TensorImpl> tensors_;
   /** Active execution handles associated with tensor operations currently executed by TAL-SH **/
   std::unordered_map<TensorOpExecHandle,std::shared_ptr<talsh::TensorTask>> tasks_;
+  /** Temporary data-kind converted copies of tensor operands used by active tensor operations **/
+  std::unordered_map<TensorOpExecHandle,std::vector<std::shared_ptr<talsh::Tensor>>> converted_;
+  /** Packed 16-bit tensors (their single-precision copies are stored in tensors_ while in use) **/
+  std::unordered_map<numerics::TensorHashType,PackedTensor> packed_tensors_;
+  /** 16-bit tensor operands {tensor hash, mutated} unpacked for active tensor operations **/
+  std::unordered_map<TensorOpExecHandle,std::vector<std::pair<numerics::TensorHashType,bool>>> unpacked_;
+  /** Active Host tasks (asynchronous tensor transformations and slicing) executed by Host worker threads **/
+  std::unordered_map<TensorOpExecHandle,HostTask> host_tasks_;
   /** Active tensor operand prefetching to accelerators tasks **/
   std::unordered_map<numerics::TensorHashType,std::shared_ptr<talsh::TensorTask>> prefetches_;
   /** Active tensor image eviction from accelerators tasks **/
@@ -150,6 +433,73 @@ protected:
   int max_tensor_rank_;
   /** Prefetching enabled flag **/
   bool prefetch_enabled_;
+  /** Max number of asynchronous Host slicing tasks in flight **/
+  unsigned int host_prefetch_depth_;
+  /** Number of Host worker threads executing asynchronous tensor transformations **/
+  unsigned int host_transform_threads_;
+  /** Total number of Host threads (OpenMP) shared by Host tensor operations and asynchronous tensor transformations **/
+  int host_max_threads_;
+  /** Pool of Host worker threads (created upon first asynchronous tensor transformation or slicing) **/
+  std::unique_ptr<HostWorkerPool> host_workers_;
+  /** NUMA-aware Host execution flag **/
+  bool numa_binding_;
+  /** Min total operand size (bytes) of a tensor contraction executed by NUMA-bound Host threads **/
+  std::size_t numa_min_bytes_;
+  /** NUMA domain the Host threads are currently bound to (-1: unbound) **/
+  int numa_bound_domain_;
+  /** Default number of Host threads (OpenMP) executing unbound tensor operations **/
+  int numa_default_threads_;
+  /** NUMA topology of the Host (only if NUMA-aware Host execution is on) **/
+  std::unique_ptr<NumaTopology> numa_;
+  /** NUMA placement of tensors: Tensor hash --> {NUMA domain, placed bytes} **/
+  std::unordered_map<numerics::TensorHashType,std::pair<unsigned int,std::size_t>> numa_placement_;
+  /** Amount of tensor data currently placed on each NUMA domain (bytes) **/
+  std::vector<std::size_t> numa_domain_bytes_;
+  /** Number of tensor contractions executed by each NUMA domain and their total operand bytes **/
+  std::vector<std::pair<std::size_t,double>> numa_domain_usage_;
+  /** Spill directory on local disk (empty: spilling is off) **/
+  std::string spill_directory_;
+  /** Min size of a tensor spilled to disk (bytes) **/
+  std::size_t spill_min_bytes_;
+  /** Tensors spilled to disk: Tensor hash --> Spilled tensor **/
+  std::unordered_map<numerics::TensorHashType,SpilledTensor> spilled_tensors_;
+  /** Last usage of tensors residing in the Host memory buffer (spilling order) **/
+  std::unordered_map<numerics::TensorHashType,CachedAttr> host_usage_;
+  /** Amount of tensor data currently spilled to disk and its peak (bytes) **/
+  std::size_t spilled_bytes_;
+  std::size_t peak_spilled_bytes_;
+  /** Total size of the spilled (or compressed) tensors which do not occupy the Host memory buffer (bytes) **/
+  std::size_t released_bytes_;
+  /** Total size of the temporary tensor copies (single-precision copies of 16-bit tensors
+      and data-kind converted copies of tensor operands) in use (bytes) **/
+  std::size_t auxiliary_bytes_;
+  /** Number of tensor spills, tensor restores and tensor restores staged ahead of use **/
+  std::size_t num_spills_;
+  std::size_t num_restores_;
+  std::size_t num_staged_;
+  /** Compression of idle tensors (0: off, 1: lossless, 2: lossless plus lossy for selected tensors) **/
+  unsigned int compression_mode_;
+  /** Min size of a compressed tensor (bytes) **/
+  std::size_t compression_min_bytes_;
+  /** Relative error bound of lossy compression **/
+  double compression_error_bound_;
+  /** Name prefix of tensors subject to lossy compression **/
+  std::string compression_lossy_prefix_;
+  /** Tensors subject to lossy compression **/
+  std::unordered_set<numerics::TensorHashType> lossy_tensors_;
+  /** Tensors which have failed to compress well enough (not compressed again) **/
+  std::unordered_set<numerics::TensorHashType> incompressible_tensors_;
+  /** Amount of compressed tensor data currently kept in Host RAM (bytes) **/
+  std::size_t compressed_bytes_;
+  /** Number of tensor compressions (total and lossy) and their total input and output (bytes) **/
+  std::size_t num_compressions_;
+  std::size_t num_lossy_compressions_;
+  double compression_input_bytes_;
+  double compression_output_bytes_;
+  /** Tensor contraction kernel autotuner (only if autotuning is on) **/
+  std::unique_ptr<ContractionTuner> tuner_;
+  /** Max total operand size of a directly executed tensor contraction (bytes) **/
+  std::size_t direct_max_bytes_;
   /** TAL-SH Host memory buffer size (bytes) **/
   static std::atomic<std::size_t> talsh_host_mem_buffer_size_;
   /** TAL-SH initialization status **/
@@ -0,0 +1,163 @@
+/** ExaTN:: Tensor Runtime: Tensor graph node executor: Host NUMA topology
+REVISION: 2020/12/14
+
+Copyright (C) 2018-2020 Dmitry Lyakh, Tiffany Mintz, Alex McCaskey
+Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle)
+**/
+
+#include "numa_topology.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <algorithm>
+
+#include <cstdint>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+#include "errors.hpp"
+
+namespace exatn {
+namespace runtime {
+
+#if defined(__linux__) && defined(SYS_move_pages)
+#define EXATN_NUMA_MOVE_PAGES
+constexpr const int NUMA_MOVE_PAGES_FLAGS = 2; //MPOL_MF_MOVE: Move pages owned by this process only
+#endif
+
+#ifdef __linux__
+//Original CPU affinity of the calling thread (set by the launcher), saved upon its first binding:
+static thread_local bool thread_affinity_saved = false;
+static thread_local cpu_set_t thread_affinity;
+#endif
+
+
+std::vector<int> parse_cpu_list(const std::string & cpu_list)
+{
+ std::vector<int> cpus;
+ std::stringstream list_stream(cpu_list);
+ std::string range;
+ while(std::getline(list_stream,range,',')){
+  if(range.empty() || range[0] == '\n') continue;
+  const auto dash = range.find('-');
+  try{
+   if(dash == std::string::npos){
+    cpus.emplace_back(std::stoi(range));
+   }else{
+    const int first = std::stoi(range.substr(0,dash));
+    const int last = std::stoi(range.substr(dash+1));
+    for(int cpu = first; cpu <= last; ++cpu) cpus.emplace_back(cpu);
+   }
+  }catch(...){
+   std::cout << "#ERROR(exatn::runtime::NumaTopology): Unable to parse the CPU list: " << cpu_list << std::endl;
+   return std::vector<int>{};
+  }
+ }
+ return cpus;
+}
+
+
+NumaTopology::NumaTopology(const std::string & node_directory):
+ page_size_(4096)
+{
+#ifdef __linux__
+ const long page_size = sysconf(_SC_PAGESIZE);
+ if(page_size > 0) page_size_ = static_cast<std::size_t>(page_size);
+ for(unsigned int node = 0; node < MAX_NUMA_NODES; ++node){
+  std::ifstream cpu_list_file(node_directory + "/node" + std::to_string(node) + "/cpulist");
+  if(cpu_list_file.is_open()){
+   std::string cpu_list;
+   std::getline(cpu_list_file,cpu_list);
+   auto cpus = parse_cpu_list(cpu_list);
+   if(!cpus.empty()){ //memory-only NUMA nodes are ignored
+    domain_cpus_.emplace_back(std::move(cpus));
+    domain_nodes_.emplace_back(static_cast<int>(node));
+   }
+  }
+ }
+#endif
+ if(domain_cpus_.empty()){ //single NUMA domain with all CPUs
+  const int num_cpus = static_cast<int>(std::max(std::thread::hardware_concurrency(),1U));
+  std::vector<int> all_cpus;
+  for(int cpu = 0; cpu < num_cpus; ++cpu) all_cpus.emplace_back(cpu);
+  domain_cpus_.emplace_back(std::move(all_cpus));
+  domain_nodes_.emplace_back(-1);
+ }
+}
+
+
+int NumaTopology::getMemoryDomain(const void * addr) const
+{
+ int domain = -1;
+ if(!isNuma()) return 0;
+#ifdef EXATN_NUMA_MOVE_PAGES
+ void * page = reinterpret_cast<void*>(reinterpret_cast<std::uintptr_t>(addr) & ~(page_size_ - 1));
+ int status = -1;
+ const long errc = syscall(SYS_move_pages,0,1UL,&page,nullptr,&status,0);
+ if(errc == 0 && status >= 0){
+  const auto iter = std::find(domain_nodes_.cbegin(),domain_nodes_.cend(),status);
+  if(iter != domain_nodes_.cend()) domain = static_cast<int>(std::distance(domain_nodes_.cbegin(),iter));
+ }
+#endif
+ return domain;
+}
+
+
+std::size_t NumaTopology::moveMemory(const void * addr, std::size_t size, unsigned int domain) const
+{
+ assert(domain < getNumDomains());
+ if(!isNuma()) return size;
+ std::size_t moved_size = 0;
+#ifdef EXATN_NUMA_MOVE_PAGES
+ const auto begin = (reinterpret_cast<std::uintptr_t>(addr) + page_size_ - 1) & ~(page_size_ - 1);
+ const auto end = (reinterpret_cast<std::uintptr_t>(addr) + size) & ~(page_size_ - 1);
+ if(end > begin){
+  const std::size_t num_pages = (end - begin) / page_size_;
+  std::vector<void*> pages(num_pages);
+  for(std::size_t i = 0; i < num_pages; ++i) pages[i] = reinterpret_cast<void*>(begin + i * page_size_);
+  std::vector<int> nodes(num_pages,domain_nodes_[domain]);
+  std::vector<int> status(num_pages,-1);
+  const long errc = syscall(SYS_move_pages,0,static_cast<unsigned long>(num_pages),pages.data(),
+                            nodes.data(),status.data(),NUMA_MOVE_PAGES_FLAGS);
+  if(errc >= 0){ //some pages may not be movable (untouched or busy)
+   for(const auto & node: status) if(node == domain_nodes_[domain]) moved_size += page_size_;
+  }
+ }
+#endif
+ return moved_size;
+}
+
+
+bool NumaTopology::bindThread(int domain) const
+{
+ bool bound = false;
+#ifdef __linux__
+ if(domain >= 0){
+  if(!thread_affinity_saved){ //save the original CPU affinity before the first binding
+   thread_affinity_saved = (pthread_getaffinity_np(pthread_self(),sizeof(cpu_set_t),&thread_affinity) == 0);
+  }
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for(const auto & cpu: domain_cpus_[domain]) if(cpu >= 0 && cpu < CPU_SETSIZE) CPU_SET(cpu,&cpu_set);
+  bound = (pthread_setaffinity_np(pthread_self(),sizeof(cpu_set_t),&cpu_set) == 0);
+ }else{ //restore the original CPU affinity (a thread which has never been bound keeps its own)
+  bound = true;
+  if(thread_affinity_saved){
+   bound = (pthread_setaffinity_np(pthread_self(),sizeof(cpu_set_t),&thread_affinity) == 0);
+   if(bound) thread_affinity_saved = false;
+  }
+ }
+#endif
+ return bound;
+}
+
+} //namespace runtime
+} //namespace exatn
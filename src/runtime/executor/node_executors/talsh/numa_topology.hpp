@@ -0,0 +1,86 @@
+/** ExaTN:: Tensor Runtime: Tensor graph node executor: Host NUMA topology
+REVISION: 2020/12/14
+
+Copyright (C) 2018-2020 Dmitry Lyakh, Tiffany Mintz, Alex McCaskey
+Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle)
+
+Rationale:
+ (a) NumaTopology discovers the NUMA domains of the Host (Linux sysfs) together
+     with the CPUs belonging to each domain. If the NUMA topology cannot be
+     discovered, the Host is represented by a single NUMA domain.
+ (b) Memory pages can be queried for the NUMA domain they reside on and can be
+     migrated to a chosen NUMA domain (only the pages fully contained in the
+     given memory range are migrated, such that neighboring data is not moved).
+     Pages which have not been touched yet cannot be migrated: They will reside
+     on the NUMA domain of the thread touching them first.
+ (c) Threads can be bound to the CPUs of a chosen NUMA domain, and unbound later.
+     The original CPU affinity of each thread (as set by the launcher, for example,
+     an MPI process pinned to one socket or OMP_PROC_BIND) is saved upon its first
+     binding and restored upon unbinding, it is never widened to all CPUs of the Host.
+**/
+
+#ifndef EXATN_RUNTIME_NUMA_TOPOLOGY_HPP_
+#define EXATN_RUNTIME_NUMA_TOPOLOGY_HPP_
+
+#include <vector>
+#include <string>
+
+#include <cstddef>
+
+namespace exatn {
+namespace runtime {
+
+/** Parses a Linux CPU list (e.g., "0-7,16-23"). Returns an empty list on a parsing error. **/
+std::vector<int> parse_cpu_list(const std::string & cpu_list);
+
+
+class NumaTopology {
+
+public:
+
+  static constexpr const unsigned int MAX_NUMA_NODES = 64; //max OS NUMA node id probed
+
+  /** Discovers the NUMA topology of the Host from the sysfs NUMA node directory. **/
+  NumaTopology(const std::string & node_directory = "/sys/devices/system/node");
+
+  NumaTopology(const NumaTopology &) = default;
+  NumaTopology & operator=(const NumaTopology &) = default;
+  NumaTopology(NumaTopology &&) noexcept = default;
+  NumaTopology & operator=(NumaTopology &&) noexcept = default;
+  ~NumaTopology() = default;
+
+  /** Returns the number of NUMA domains (at least one). **/
+  unsigned int getNumDomains() const {return static_cast<unsigned int>(domain_cpus_.size());}
+
+  /** Returns TRUE if the Host has more than one NUMA domain. **/
+  bool isNuma() const {return (domain_cpus_.size() > 1);}
+
+  /** Returns the CPUs of a given NUMA domain. **/
+  const std::vector<int> & getDomainCpus(unsigned int domain) const {return domain_cpus_[domain];}
+
+  /** Returns the NUMA domain the memory page containing a given address resides on,
+      or -1 if unknown (page not touched yet or no NUMA support). **/
+  int getMemoryDomain(const void * addr) const;
+
+  /** Migrates the memory pages fully contained in a given memory range to a given NUMA domain.
+      Returns the number of bytes residing on the NUMA domain upon return. **/
+  std::size_t moveMemory(const void * addr,    //in: beginning of the memory range
+                         std::size_t size,     //in: size of the memory range in bytes
+                         unsigned int domain) const; //in: NUMA domain
+
+  /** Binds the calling thread to the CPUs of a given NUMA domain, or, if the domain
+      is negative, restores the original CPU affinity the calling thread had before
+      it was first bound (a thread which has never been bound is not affected). **/
+  bool bindThread(int domain) const;
+
+private:
+
+  std::vector<std::vector<int>> domain_cpus_; //CPUs of each NUMA domain
+  std::vector<int> domain_nodes_;             //OS NUMA node id of each NUMA domain
+  std::size_t page_size_;                     //memory page size in bytes
+};
+
+} //namespace runtime
+} //namespace exatn
+
+#endif //EXATN_RUNTIME_NUMA_TOPOLOGY_HPP_
@@ -0,0 +1,79 @@
+/** ExaTN:: Tensor Runtime: Tensor graph node executor: Memory-mapped spill file
+REVISION: 2020/12/10
+
+Copyright (C) 2018-2020 Dmitry Lyakh, Tiffany Mintz, Alex McCaskey
+Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle)
+**/
+
+#include "spill_file.hpp"
+
+#include <iostream>
+#include <vector>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#endif
+
+#include "errors.hpp"
+
+namespace exatn {
+namespace runtime {
+
+SpillFile::SpillFile(const std::string & directory,
+                     std::size_t size):
+ data_(nullptr), size_(size)
+{
+ assert(size_ > 0);
+#ifdef __linux__
+ std::string file_name = directory + "/exatn_spill.XXXXXX";
+ std::vector<char> file_path(file_name.cbegin(),file_name.cend());
+ file_path.emplace_back('\0');
+ const int fd = mkstemp(file_path.data());
+ if(fd < 0){
+  std::cout << "#ERROR(exatn::runtime::SpillFile): Unable to create a spill file in " << directory << std::endl;
+  return;
+ }
+ unlink(file_path.data()); //the file will cease to exist once unmapped
+ if(ftruncate(fd,static_cast<off_t>(size_)) == 0){
+  void * data = mmap(nullptr,size_,PROT_READ|PROT_WRITE,MAP_SHARED,fd,0);
+  if(data != MAP_FAILED) data_ = data;
+ }
+ close(fd); //the mapping keeps the file alive
+ if(data_ == nullptr){
+  std::cout << "#ERROR(exatn::runtime::SpillFile): Unable to map a spill file of size "
+            << size_ << " bytes in " << directory << std::endl;
+ }
+#endif
+}
+
+
+SpillFile::~SpillFile()
+{
+#ifdef __linux__
+ if(data_ != nullptr) munmap(data_,size_);
+#endif
+ data_ = nullptr;
+}
+
+
+void SpillFile::writeBack() const
+{
+#ifdef __linux__
+ if(data_ != nullptr) msync(data_,size_,MS_ASYNC);
+#endif
+ return;
+}
+
+
+void SpillFile::stage() const
+{
+#ifdef __linux__
+ if(data_ != nullptr) madvise(data_,size_,MADV_WILLNEED);
+#endif
+ return;
+}
+
+} //namespace runtime
+} //namespace exatn
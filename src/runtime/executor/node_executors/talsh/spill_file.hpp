@@ -0,0 +1,64 @@
+/** ExaTN:: Tensor Runtime: Tensor graph node executor: Memory-mapped spill file
+REVISION: 2020/12/10
+
+Copyright (C) 2018-2020 Dmitry Lyakh, Tiffany Mintz, Alex McCaskey
+Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle)
+
+Rationale:
+ (a) SpillFile is a memory-mapped file on local disk storing a copy of a tensor body
+     evicted from the Host memory buffer. The file is unlinked right after its creation,
+     thus it only exists while it is mapped (no leftovers after an abnormal termination).
+ (b) Reading the spill file back can be staged ahead of time by asking the OS to
+     start reading its pages asynchronously.
+**/
+
+#ifndef EXATN_RUNTIME_SPILL_FILE_HPP_
+#define EXATN_RUNTIME_SPILL_FILE_HPP_
+
+#include <string>
+
+#include <cstddef>
+
+namespace exatn {
+namespace runtime {
+
+class SpillFile {
+
+public:
+
+  /** Creates and maps a new spill file of a given size in a given directory.
+      Check isValid() to find out whether the spill file has been created. **/
+  SpillFile(const std::string & directory, //in: spill directory (local disk)
+            std::size_t size);             //in: spill file size in bytes
+
+  SpillFile(const SpillFile &) = delete;
+  SpillFile & operator=(const SpillFile &) = delete;
+  SpillFile(SpillFile &&) noexcept = delete;
+  SpillFile & operator=(SpillFile &&) noexcept = delete;
+  ~SpillFile(); //unmaps the spill file (which ceases to exist)
+
+  /** Returns TRUE if the spill file has been created and mapped. **/
+  bool isValid() const {return (data_ != nullptr);}
+
+  /** Returns the mapped spill file content. **/
+  void * getData() const {return data_;}
+
+  /** Returns the spill file size in bytes. **/
+  std::size_t getSize() const {return size_;}
+
+  /** Writes the dirty pages back to disk asynchronously (releasing Host memory later). **/
+  void writeBack() const;
+
+  /** Initiates an asynchronous read of the spill file pages into Host memory. **/
+  void stage() const;
+
+private:
+
+  void * data_;      //mapped spill file content
+  std::size_t size_; //spill file size in bytes
+};
+
+} //namespace runtime
+} //namespace exatn
+
+#endif //EXATN_RUNTIME_SPILL_FILE_HPP_
@@ -0,0 +1,238 @@
+/** ExaTN:: Tensor Runtime: Tensor graph node executor: Tensor body compression
+REVISION: 2020/12/11
+
+Copyright (C) 2018-2020 Dmitry Lyakh, Tiffany Mintz, Alex McCaskey
+Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle)
+**/
+
+#include "tensor_codec.hpp"
+
+#include <algorithm>
+
+#include <cstring>
+#include <cmath>
+
+#include "errors.hpp"
+
+namespace exatn {
+namespace runtime {
+
+constexpr const std::size_t CompressedBody::BLOCK_SIZE;
+
+constexpr const unsigned int LZ_HASH_BITS = 14;     //size of the match finder hash table (log2)
+constexpr const std::size_t LZ_MIN_MATCH = 4;       //min match length (bytes)
+constexpr const std::size_t LZ_MAX_OFFSET = 65535;  //max match offset (bytes)
+constexpr const std::size_t LZ_END_LITERALS = 8;    //trailing bytes always encoded as literals
+constexpr const std::uint8_t BLOCK_RAW = 0;         //block stored uncompressed
+constexpr const std::uint8_t BLOCK_LZ = 1;          //block stored compressed
+
+
+inline std::uint32_t lz_read32(const std::uint8_t * ptr)
+{
+ std::uint32_t val;
+ std::memcpy(&val,ptr,sizeof(val));
+ return val;
+}
+
+
+inline std::uint32_t lz_hash(std::uint32_t val)
+{
+ return (val * 2654435761U) >> (32 - LZ_HASH_BITS);
+}
+
+
+/** Appends the extension of a length not less than 15. **/
+inline void lz_write_length(std::vector<std::uint8_t> & dst, std::size_t len)
+{
+ len -= 15;
+ while(len >= 255){
+  dst.emplace_back(255);
+  len -= 255;
+ }
+ dst.emplace_back(static_cast<std::uint8_t>(len));
+ return;
+}
+
+
+/** Reads the extension of a length equal to 15. Returns FALSE on truncated input. **/
+inline bool lz_read_length(const std::uint8_t * src, std::size_t src_size, std::size_t & pos, std::size_t & len)
+{
+ std::uint8_t byte = 255;
+ while(byte == 255){
+  if(pos >= src_size) return false;
+  byte = src[pos++];
+  len += byte;
+ }
+ return true;
+}
+
+
+/** Appends an LZ sequence: literals followed by a match (no match if match_len == 0). **/
+inline void lz_write_sequence(std::vector<std::uint8_t> & dst,
+                              const std::uint8_t * literals, std::size_t lit_len,
+                              std::size_t offset, std::size_t match_len)
+{
+ const std::size_t match_code = ((match_len > 0) ? (match_len - LZ_MIN_MATCH) : 0);
+ dst.emplace_back(static_cast<std::uint8_t>((std::min(lit_len,std::size_t{15}) << 4) | std::min(match_code,std::size_t{15})));
+ if(lit_len >= 15) lz_write_length(dst,lit_len);
+ dst.insert(dst.end(),literals,literals+lit_len);
+ if(match_len > 0){
+  dst.emplace_back(static_cast<std::uint8_t>(offset & 255));
+  dst.emplace_back(static_cast<std::uint8_t>(offset >> 8));
+  if(match_code >= 15) lz_write_length(dst,match_code);
+ }
+ return;
+}
+
+
+/** Compresses a byte sequence into LZ sequences (the last sequence has no match). **/
+inline void lz_compress(const std::uint8_t * src, std::size_t src_size, std::vector<std::uint8_t> & dst)
+{
+ std::vector<std::uint32_t> table(std::size_t{1} << LZ_HASH_BITS,0); //position + 1 (0: empty)
+ std::size_t anchor = 0, pos = 0;
+ if(src_size > LZ_END_LITERALS + LZ_MIN_MATCH){
+  const std::size_t limit = src_size - LZ_END_LITERALS;
+  while(pos + LZ_MIN_MATCH <= limit){
+   const auto seq = lz_read32(src+pos);
+   const auto hash = lz_hash(seq);
+   const std::size_t ref = table[hash];
+   table[hash] = static_cast<std::uint32_t>(pos + 1);
+   if(ref > 0 && pos - (ref - 1) <= LZ_MAX_OFFSET && lz_read32(src+(ref-1)) == seq){
+    const std::size_t match = ref - 1;
+    std::size_t len = LZ_MIN_MATCH;
+    while(pos + len < limit && src[match+len] == src[pos+len]) ++len;
+    lz_write_sequence(dst,src+anchor,pos-anchor,pos-match,len);
+    pos += len;
+    anchor = pos;
+   }else{
+    ++pos;
+   }
+  }
+ }
+ lz_write_sequence(dst,src+anchor,src_size-anchor,0,0);
+ return;
+}
+
+
+/** Decompresses LZ sequences. Returns FALSE on corrupted input. **/
+inline bool lz_decompress(const std::uint8_t * src, std::size_t src_size, std::uint8_t * dst, std::size_t dst_size)
+{
+ std::size_t ipos = 0, opos = 0;
+ while(ipos < src_size){
+  const auto token = src[ipos++];
+  std::size_t lit_len = (token >> 4);
+  if(lit_len == 15 && !lz_read_length(src,src_size,ipos,lit_len)) return false;
+  if(ipos + lit_len > src_size || opos + lit_len > dst_size) return false;
+  std::memcpy(dst+opos,src+ipos,lit_len);
+  ipos += lit_len; opos += lit_len;
+  if(ipos == src_size) break; //last sequence
+  if(ipos + 2 > src_size) return false;
+  const std::size_t offset = static_cast<std::size_t>(src[ipos]) | (static_cast<std::size_t>(src[ipos+1]) << 8);
+  ipos += 2;
+  if(offset == 0 || offset > opos) return false;
+  std::size_t match_len = (token & 15);
+  if(match_len == 15 && !lz_read_length(src,src_size,ipos,match_len)) return false;
+  match_len += LZ_MIN_MATCH;
+  if(opos + match_len > dst_size) return false;
+  for(std::size_t i = 0; i < match_len; ++i) dst[opos+i] = dst[opos-offset+i]; //matches may overlap
+  opos += match_len;
+ }
+ return (opos == dst_size);
+}
+
+
+unsigned int get_truncated_mantissa_bits(std::size_t word_size, double error_bound)
+{
+ assert(word_size == 4 || word_size == 8);
+ if(!(error_bound > 0.0)) return 0;
+ const int mantissa_bits = ((word_size == 4) ? 23 : 52);
+ const int truncated_bits = static_cast<int>(std::floor(static_cast<double>(mantissa_bits) + std::log2(error_bound)));
+ return static_cast<unsigned int>(std::max(0,std::min(truncated_bits,mantissa_bits)));
+}
+
+
+void compress_tensor_body(const void * body,
+                          std::size_t size,
+                          std::size_t word_size,
+                          unsigned int truncated_bits,
+                          CompressedBody & compressed)
+{
+ assert(word_size == 4 || word_size == 8);
+ assert(size % word_size == 0);
+ assert(truncated_bits < word_size * 8);
+ //Byte mask truncating the trailing mantissa bits of a word (in its memory layout):
+ std::uint8_t mask[8];
+ const std::uint64_t word_mask = ~((std::uint64_t{1} << truncated_bits) - 1);
+ if(word_size == 4){
+  const auto word_mask32 = static_cast<std::uint32_t>(word_mask);
+  std::memcpy(mask,&word_mask32,4);
+ }else{
+  std::memcpy(mask,&word_mask,8);
+ }
+ const auto * src = static_cast<const std::uint8_t*>(body);
+ const std::size_t num_blocks = (size + CompressedBody::BLOCK_SIZE - 1) / CompressedBody::BLOCK_SIZE;
+ compressed.size = size;
+ compressed.word_size = word_size;
+ compressed.blocks.assign(num_blocks,std::vector<std::uint8_t>());
+#pragma omp parallel for schedule(dynamic)
+ for(std::int64_t blk = 0; blk < static_cast<std::int64_t>(num_blocks); ++blk){
+  const std::size_t offset = static_cast<std::size_t>(blk) * CompressedBody::BLOCK_SIZE;
+  const std::size_t block_size = std::min(CompressedBody::BLOCK_SIZE,size-offset);
+  const std::size_t num_words = block_size / word_size;
+  //Truncate and shuffle bytes:
+  std::vector<std::uint8_t> shuffled(block_size);
+  for(std::size_t i = 0; i < num_words; ++i){
+   for(std::size_t b = 0; b < word_size; ++b) shuffled[b*num_words+i] = (src[offset+i*word_size+b] & mask[b]);
+  }
+  //Compress:
+  auto & block = compressed.blocks[blk];
+  block.reserve(block_size / 2);
+  block.emplace_back(BLOCK_LZ);
+  lz_compress(shuffled.data(),block_size,block);
+  if(block.size() >= block_size + 1){ //incompressible block
+   block.assign(1,BLOCK_RAW);
+   block.insert(block.end(),shuffled.cbegin(),shuffled.cend());
+  }
+  block.shrink_to_fit();
+ }
+ return;
+}
+
+
+bool decompress_tensor_body(const CompressedBody & compressed,
+                            void * body)
+{
+ const auto word_size = compressed.word_size;
+ auto * dst = static_cast<std::uint8_t*>(body);
+ const std::size_t num_blocks = compressed.blocks.size();
+ bool success = true;
+#pragma omp parallel for schedule(dynamic) reduction(&&:success)
+ for(std::int64_t blk = 0; blk < static_cast<std::int64_t>(num_blocks); ++blk){
+  const std::size_t offset = static_cast<std::size_t>(blk) * CompressedBody::BLOCK_SIZE;
+  const std::size_t block_size = std::min(CompressedBody::BLOCK_SIZE,compressed.size-offset);
+  const std::size_t num_words = block_size / word_size;
+  const auto & block = compressed.blocks[blk];
+  //Decompress:
+  std::vector<std::uint8_t> shuffled(block_size);
+  bool decompressed = false;
+  if(!block.empty()){
+   if(block[0] == BLOCK_LZ){
+    decompressed = lz_decompress(block.data()+1,block.size()-1,shuffled.data(),block_size);
+   }else if(block[0] == BLOCK_RAW && block.size() == block_size + 1){
+    std::memcpy(shuffled.data(),block.data()+1,block_size);
+    decompressed = true;
+   }
+  }
+  //Unshuffle bytes:
+  if(decompressed){
+   for(std::size_t i = 0; i < num_words; ++i){
+    for(std::size_t b = 0; b < word_size; ++b) dst[offset+i*word_size+b] = shuffled[b*num_words+i];
+   }
+  }
+  success = success && decompressed;
+ }
+ return success;
+}
+
+} //namespace runtime
+} //namespace exatn
@@ -0,0 +1,64 @@
+/** ExaTN:: Tensor Runtime: Tensor graph node executor: Tensor body compression
+REVISION: 2020/12/11
+
+Copyright (C) 2018-2020 Dmitry Lyakh, Tiffany Mintz, Alex McCaskey
+Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle)
+
+Rationale:
+ (a) A tensor body is split into blocks which are compressed independently
+     by multiple Host threads (OpenMP). Each block is byte-shuffled first
+     (bytes of the same significance of all floating point words are grouped
+     together), followed by a fast LZ77-type compression (LZ4-like sequences of
+     literals and matches). Incompressible blocks are stored as they are.
+ (b) Error-bounded lossy compression truncates the trailing mantissa bits of
+     each floating point word, such that the relative error of each element
+     does not exceed the requested error bound. The truncated mantissa bits
+     become zero byte planes after byte shuffling, which compress well.
+**/
+
+#ifndef EXATN_RUNTIME_TENSOR_CODEC_HPP_
+#define EXATN_RUNTIME_TENSOR_CODEC_HPP_
+
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace exatn {
+namespace runtime {
+
+struct CompressedBody {
+  static constexpr const std::size_t BLOCK_SIZE = 1024UL * 1024UL; //size of an independently compressed block (bytes)
+
+  std::size_t size;      //uncompressed size in bytes
+  std::size_t word_size; //floating point word size in bytes (4 or 8)
+  std::vector<std::vector<std::uint8_t>> blocks; //compressed blocks
+
+  /** Returns the total compressed size in bytes. **/
+  std::size_t getCompressedSize() const {
+    std::size_t compressed_size = 0;
+    for(const auto & block: blocks) compressed_size += block.size();
+    return compressed_size;
+  }
+};
+
+/** Returns the number of trailing mantissa bits of a floating point word which can be truncated
+    while keeping the relative error within a given error bound (0 means lossless). **/
+unsigned int get_truncated_mantissa_bits(std::size_t word_size, //in: floating point word size in bytes (4 or 8)
+                                         double error_bound);   //in: relative error bound (0 means lossless)
+
+/** Compresses a tensor body (multithreaded). The size must be a multiple of the word size. **/
+void compress_tensor_body(const void * body,                //in: tensor body
+                          std::size_t size,                 //in: tensor body size in bytes
+                          std::size_t word_size,            //in: floating point word size in bytes (4 or 8)
+                          unsigned int truncated_bits,      //in: number of truncated mantissa bits (0 means lossless)
+                          CompressedBody & compressed);     //out: compressed tensor body
+
+/** Decompresses a tensor body (multithreaded). Returns FALSE on corrupted compressed data. **/
+bool decompress_tensor_body(const CompressedBody & compressed, //in: compressed tensor body
+                            void * body);                      //out: tensor body (of the uncompressed size)
+
+} //namespace runtime
+} //namespace exatn
+
+#endif //EXATN_RUNTIME_TENSOR_CODEC_HPP_
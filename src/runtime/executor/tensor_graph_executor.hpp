@@ -1,5 +1,5 @@
 /** ExaTN:: Tensor Runtime: Tensor graph executor
-REVISION: 2020/11/16
+REVISION: 2020/12/14
 
 Copyright (C) 2018-2020 Dmitry Lyakh, Tiffany Mintz, Alex McCaskey
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle)
@@ -11,6 +11,11 @@ Rationale:
      (tensor operation stored in the DAG node accepts a polymorphic
      tensor node executor which then executes that tensor operation).
      The execution of each DAG node is generally asynchronous.
+ (b) When multiple DAGs are executed concurrently by the same execution thread,
+     the issue quota limits the number of tensor operations issued from a DAG
+     per invocation of the execute method, which then returns early even if
+     the DAG has not been completed yet. The execution state of the DAG is
+     kept inside the DAG such that its execution can be continued later.
 **/
 
 #ifndef EXATN_RUNTIME_TENSOR_GRAPH_EXECUTOR_HPP_
@@ -44,7 +49,7 @@ public:
 
   TensorGraphExecutor():
    node_executor_(nullptr), num_ops_issued_(0), process_rank_(-1), global_process_rank_(-1),
-   logging_(0), stopping_(false), active_(false), time_start_(exatn::Timer::timeInSecHR())
+   logging_(0), stopping_(false), active_(false), issue_quota_(0), time_start_(exatn::Timer::timeInSecHR())
   {}
 
   TensorGraphExecutor(const TensorGraphExecutor &) = delete;
@@ -97,6 +102,9 @@ public:
     return node_executor_->getMemoryBufferSize();
   }
 
+  /** Returns the peak memory usage in bytes observed by the graph executor (0: not tracked). **/
+  virtual std::size_t getPeakMemorySize() const {return 0;}
+
   /** Traverses the DAG and executes all its nodes (operations).
       [THREAD: This function is executed by the execution thread] **/
   virtual void execute(TensorGraph & dag) = 0;
@@ -104,6 +112,14 @@ public:
   /** Regulates the tensor prefetch depth (0 turns prefetch off). **/
   virtual void setPrefetchDepth(unsigned int depth) = 0;
 
+  /** Sets the maximal number of tensor operations issued per invocation of the execute method
+      (0: unlimited, execute until the DAG is completed), see Rationale (b).
+      [THREAD: This function is executed by the execution thread] **/
+  void setIssueQuota(std::size_t quota) {issue_quota_ = quota;}
+
+  /** Returns the current issue quota (0: unlimited). **/
+  inline std::size_t getIssueQuota() const {return issue_quota_;}
+
   /** Factory method **/
   virtual std::shared_ptr<TensorGraphExecutor> clone() = 0;
 
@@ -138,6 +154,7 @@ protected:
   std::atomic<int> logging_;      //logging level (0:none)
   std::atomic<bool> stopping_;    //signal to pause the execution thread
   std::atomic<bool> active_;      //TRUE while the execution thread is executing DAG operations
+  std::size_t issue_quota_;       //max number of tensor operations issued per execute() invocation (0:unlimited)
   const double time_start_;       //start time stamp
   std::ofstream logfile_;         //logging file stream (output)
 };
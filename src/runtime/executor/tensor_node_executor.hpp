@@ -1,5 +1,5 @@
 /** ExaTN:: Tensor Runtime: Tensor graph node executor
-REVISION: 2020/08/11
+REVISION: 2020/12/14
 
 Copyright (C) 2018-2020 Dmitry Lyakh, Tiffany Mintz, Alex McCaskey
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle)
@@ -50,6 +50,15 @@ public:
   /** Returns the Host memory buffer size in bytes provided by the node executor. **/
   virtual std::size_t getMemoryBufferSize() const = 0;
 
+  /** Returns the total size of the live tensors which currently do not occupy
+      the Host memory buffer since they have been spilled out of it (bytes). **/
+  virtual std::size_t getSpilledMemorySize() const {return 0;}
+
+  /** Returns the total size of the auxiliary data currently held by the node executor
+      in the Host memory buffer on top of the live tensors, for example temporary
+      copies of tensor operands in a different data kind (bytes). **/
+  virtual std::size_t getAuxiliaryMemorySize() const {return 0;}
+
   /** Executes the tensor operation found in a DAG node asynchronously,
       returning the execution handle in exec_handle that can later be
       used for testing for completion of the operation execution.
@@ -80,6 +89,8 @@ public:
                       TensorOpExecHandle * exec_handle) = 0;
   virtual int execute(numerics::TensorOpAllreduce & op,
                       TensorOpExecHandle * exec_handle) = 0;
+  virtual int execute(numerics::TensorOpContractBatch & op,
+                      TensorOpExecHandle * exec_handle) = 0;
 
   /** Synchronizes the execution of a previously submitted tensor operation. **/
   virtual bool sync(TensorOpExecHandle op_handle,
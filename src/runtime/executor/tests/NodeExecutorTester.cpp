@@ -0,0 +1,301 @@
+#include <gtest/gtest.h>
+
+#include "tensor_codec.hpp"
+#include "contraction_tuner.hpp"
+#include "numa_topology.hpp"
+
+#include "talshxx.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <random>
+#include <thread>
+#include <complex>
+
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "errors.hpp"
+
+using namespace exatn::runtime;
+
+//Test activation:
+#define EXATN_TEST0
+#define EXATN_TEST1
+#define EXATN_TEST2
+#define EXATN_TEST3
+
+
+/** Compresses and decompresses a tensor body, returning the decompressed body. **/
+std::vector<std::uint8_t> round_trip(const std::vector<std::uint8_t> & body,
+                                     std::size_t word_size,
+                                     unsigned int truncated_bits,
+                                     std::size_t * compressed_size = nullptr)
+{
+ CompressedBody compressed;
+ compress_tensor_body(body.data(),body.size(),word_size,truncated_bits,compressed);
+ EXPECT_EQ(compressed.size,body.size());
+ EXPECT_EQ(compressed.blocks.size(),(body.size() + CompressedBody::BLOCK_SIZE - 1) / CompressedBody::BLOCK_SIZE);
+ if(compressed_size != nullptr) *compressed_size = compressed.getCompressedSize();
+ std::vector<std::uint8_t> restored(body.size(),0xFF);
+ EXPECT_TRUE(decompress_tensor_body(compressed,restored.data()));
+ return restored;
+}
+
+
+#ifdef EXATN_TEST0
+TEST(NodeExecutorTester, TensorCodec) {
+ std::mt19937_64 generator(63);
+ std::uniform_real_distribution<double> distribution(-1.0,1.0);
+
+ //Empty tensor body:
+ {
+  std::vector<std::uint8_t> body;
+  auto restored = round_trip(body,8,0);
+  EXPECT_TRUE(restored.empty());
+ }
+
+ //Tensor bodies below the min size of an LZ match plus trailing literals (12 bytes):
+ for(std::size_t word_size: {4,8}){
+  for(std::size_t size = word_size; size < 12; size += word_size){
+   std::vector<std::uint8_t> body(size);
+   for(std::size_t i = 0; i < size; ++i) body[i] = static_cast<std::uint8_t>(i * 37 + 1);
+   EXPECT_EQ(round_trip(body,word_size,0),body);
+  }
+ }
+
+ //Multi-block compressible tensor body (partial last block):
+ {
+  const std::size_t volume = (5 * CompressedBody::BLOCK_SIZE) / 16 + 3;
+  std::vector<double> values(volume);
+  for(std::size_t i = 0; i < volume; ++i) values[i] = static_cast<double>(i % 100) * 0.25;
+  std::vector<std::uint8_t> body(volume * sizeof(double));
+  std::memcpy(body.data(),values.data(),body.size());
+  std::size_t compressed_size = 0;
+  EXPECT_EQ(round_trip(body,sizeof(double),0,&compressed_size),body);
+  std::cout << " Compressible body: " << body.size() << " --> " << compressed_size << " bytes" << std::endl;
+  EXPECT_LT(compressed_size * 4,body.size());
+ }
+
+ //Multi-block incompressible tensor body (random bytes are stored as they are):
+ {
+  std::vector<std::uint8_t> body(2 * CompressedBody::BLOCK_SIZE + 40);
+  for(auto & byte: body) byte = static_cast<std::uint8_t>(generator() & 255);
+  std::size_t compressed_size = 0;
+  EXPECT_EQ(round_trip(body,sizeof(float),0,&compressed_size),body);
+  EXPECT_LE(compressed_size,body.size() + 3);
+ }
+
+ //Lossy compression stays within the relative error bound:
+ for(double error_bound: {1e-3,1e-6,1e-10}){
+  const std::size_t volume = CompressedBody::BLOCK_SIZE / 4 + 5;
+  std::vector<double> values(volume);
+  for(auto & value: values) value = distribution(generator) * 1e3;
+  std::vector<float> values32(values.cbegin(),values.cend());
+  //Double precision:
+  const auto truncated_bits = get_truncated_mantissa_bits(sizeof(double),error_bound);
+  EXPECT_GT(truncated_bits,0U);
+  std::vector<std::uint8_t> body(volume * sizeof(double));
+  std::memcpy(body.data(),values.data(),body.size());
+  auto restored = round_trip(body,sizeof(double),truncated_bits);
+  std::vector<double> restored_values(volume);
+  std::memcpy(restored_values.data(),restored.data(),restored.size());
+  for(std::size_t i = 0; i < volume; ++i){
+   EXPECT_LE(std::abs(restored_values[i] - values[i]),error_bound * std::abs(values[i]));
+  }
+  //Single precision (the error bound may exceed its precision):
+  const auto truncated_bits32 = get_truncated_mantissa_bits(sizeof(float),error_bound);
+  body.resize(volume * sizeof(float));
+  std::memcpy(body.data(),values32.data(),body.size());
+  restored = round_trip(body,sizeof(float),truncated_bits32);
+  std::vector<float> restored_values32(volume);
+  std::memcpy(restored_values32.data(),restored.data(),restored.size());
+  for(std::size_t i = 0; i < volume; ++i){
+   EXPECT_LE(std::abs(restored_values32[i] - values32[i]),error_bound * std::abs(values32[i]));
+  }
+ }
+ EXPECT_EQ(get_truncated_mantissa_bits(sizeof(double),0.0),0U);
+ EXPECT_EQ(get_truncated_mantissa_bits(sizeof(float),1e-10),0U);
+
+ //Corrupted compressed data is detected:
+ {
+  std::vector<std::uint8_t> body(CompressedBody::BLOCK_SIZE / 2,7);
+  CompressedBody compressed;
+  compress_tensor_body(body.data(),body.size(),sizeof(double),0,compressed);
+  compressed.blocks[0].resize(compressed.blocks[0].size() / 2);
+  std::vector<std::uint8_t> restored(body.size());
+  EXPECT_FALSE(decompress_tensor_body(compressed,restored.data()));
+ }
+}
+#endif
+
+
+#ifdef EXATN_TEST1
+TEST(NodeExecutorTester, ContractionTuningDatabase) {
+ const std::string database_file("exatn_node_executor_tester.tuning");
+ std::remove(database_file.c_str());
+
+ //Tune two signatures (appended to the tuning database file):
+ ContractionKernel kernel = ContractionKernel::TALSH;
+ {
+  ContractionTuner tuner(database_file);
+  EXPECT_FALSE(tuner.findKernel("D(a,b)+=L(c,a)*R(b,c)|4,4;2,4;4,2|5",&kernel));
+  tuner.recordKernel("D(a,b)+=L(c,a)*R(b,c)|4,4;2,4;4,2|5",ContractionKernel::DIRECT,2e-6,1e-6,1e-4);
+  tuner.recordKernel("D(a,b)+=L(a,c)*R(c,b)|64,64;64,64;64,64|5",ContractionKernel::TALSH,1e-5,-1.0,1e-4);
+  EXPECT_TRUE(tuner.findKernel("D(a,b)+=L(c,a)*R(b,c)|4,4;2,4;4,2|5",&kernel));
+  EXPECT_EQ(kernel,ContractionKernel::DIRECT);
+  //Retuned signature (the last entry wins upon reloading):
+  tuner.recordKernel("D(a,b)+=L(a,c)*R(c,b)|64,64;64,64;64,64|5",ContractionKernel::DIRECT,2e-5,1e-5,1e-4);
+ }
+ //Entries with an unknown kernel are ignored:
+ {
+  std::ofstream database(database_file,std::ios::out|std::ios::app);
+  database << "D(a)+=L(a,b)*R(b)|8;8,8;8|5 unknown 1.0e-05 1.0e-05" << std::endl;
+ }
+
+ //Reload the tuning database:
+ {
+  ContractionTuner tuner(database_file);
+  EXPECT_TRUE(tuner.findKernel("D(a,b)+=L(c,a)*R(b,c)|4,4;2,4;4,2|5",&kernel));
+  EXPECT_EQ(kernel,ContractionKernel::DIRECT);
+  EXPECT_TRUE(tuner.findKernel("D(a,b)+=L(a,c)*R(c,b)|64,64;64,64;64,64|5",&kernel));
+  EXPECT_EQ(kernel,ContractionKernel::DIRECT);
+  EXPECT_FALSE(tuner.findKernel("D(a)+=L(a,b)*R(b)|8;8,8;8|5",&kernel));
+  tuner.printStatistics();
+ }
+
+ //An in-memory tuning database is not backed by a file:
+ {
+  ContractionTuner tuner("");
+  tuner.recordKernel("D(a,b)+=L(c,a)*R(b,c)|4,4;2,4;4,2|5",ContractionKernel::TALSH,1e-6,2e-6,1e-4);
+  EXPECT_TRUE(tuner.findKernel("D(a,b)+=L(c,a)*R(b,c)|4,4;2,4;4,2|5",&kernel));
+  EXPECT_EQ(kernel,ContractionKernel::TALSH);
+ }
+ std::remove(database_file.c_str());
+}
+#endif
+
+
+#ifdef EXATN_TEST2
+TEST(NodeExecutorTester, NumaTopology) {
+ //Linux CPU lists:
+ EXPECT_EQ(parse_cpu_list("0-3,8,10-11"),(std::vector<int>{0,1,2,3,8,10,11}));
+ EXPECT_EQ(parse_cpu_list("5"),(std::vector<int>{5}));
+ EXPECT_TRUE(parse_cpu_list("").empty());
+ EXPECT_TRUE(parse_cpu_list("0-x").empty());
+
+ //Single NUMA domain fallback (no NUMA topology information):
+ {
+  NumaTopology numa("exatn_node_executor_tester.none");
+  EXPECT_EQ(numa.getNumDomains(),1U);
+  EXPECT_FALSE(numa.isNuma());
+  EXPECT_EQ(numa.getDomainCpus(0).size(),static_cast<std::size_t>(std::max(std::thread::hardware_concurrency(),1U)));
+  std::vector<double> buffer(4096,1.0);
+  EXPECT_EQ(numa.getMemoryDomain(buffer.data()),0);
+  EXPECT_EQ(numa.moveMemory(buffer.data(),buffer.size()*sizeof(double),0),buffer.size()*sizeof(double));
+  EXPECT_TRUE(numa.bindThread(-1));
+ }
+
+#ifdef __linux__
+ //NUMA topology discovery (memory-only NUMA nodes are ignored):
+ {
+  const std::string node_directory("exatn_node_executor_tester.numa");
+  const std::vector<std::string> cpu_lists {"0-1,4","","2-3"};
+  mkdir(node_directory.c_str(),0755);
+  for(std::size_t node = 0; node < cpu_lists.size(); ++node){
+   const std::string node_path = node_directory + "/node" + std::to_string(node);
+   mkdir(node_path.c_str(),0755);
+   std::ofstream cpu_list_file(node_path + "/cpulist");
+   cpu_list_file << cpu_lists[node] << std::endl;
+  }
+  NumaTopology numa(node_directory);
+  EXPECT_EQ(numa.getNumDomains(),2U);
+  EXPECT_TRUE(numa.isNuma());
+  EXPECT_EQ(numa.getDomainCpus(0),(std::vector<int>{0,1,4}));
+  EXPECT_EQ(numa.getDomainCpus(1),(std::vector<int>{2,3}));
+  for(std::size_t node = 0; node < cpu_lists.size(); ++node){
+   const std::string node_path = node_directory + "/node" + std::to_string(node);
+   std::remove((node_path + "/cpulist").c_str());
+   rmdir(node_path.c_str());
+  }
+  rmdir(node_directory.c_str());
+ }
+
+ //Unbinding restores the original CPU affinity of a thread (pinned by the launcher):
+ std::thread pinned([](){
+  cpu_set_t original, pinned_set, current;
+  ASSERT_EQ(pthread_getaffinity_np(pthread_self(),sizeof(cpu_set_t),&original),0);
+  int first_cpu = 0;
+  while(first_cpu < CPU_SETSIZE && !CPU_ISSET(first_cpu,&original)) ++first_cpu;
+  ASSERT_LT(first_cpu,CPU_SETSIZE);
+  CPU_ZERO(&pinned_set);
+  CPU_SET(first_cpu,&pinned_set);
+  ASSERT_EQ(pthread_setaffinity_np(pthread_self(),sizeof(cpu_set_t),&pinned_set),0);
+  NumaTopology numa("exatn_node_executor_tester.none");
+  EXPECT_TRUE(numa.bindThread(0));
+  EXPECT_TRUE(numa.bindThread(-1));
+  ASSERT_EQ(pthread_getaffinity_np(pthread_self(),sizeof(cpu_set_t),&current),0);
+  EXPECT_TRUE(CPU_EQUAL(&current,&pinned_set));
+  EXPECT_TRUE(numa.bindThread(-1)); //never bound since: not affected
+  ASSERT_EQ(pthread_getaffinity_np(pthread_self(),sizeof(cpu_set_t),&current),0);
+  EXPECT_TRUE(CPU_EQUAL(&current,&pinned_set));
+ });
+ pinned.join();
+#endif
+}
+#endif
+
+
+#ifdef EXATN_TEST3
+TEST(NodeExecutorTester, DirectContractionBatch) {
+ std::mt19937_64 generator(29);
+ std::uniform_real_distribution<double> distribution(-1.0,1.0);
+
+ //D(a,b) += L(c,a)+ * R(b,c) with complex conjugation of the left tensor:
+ const std::vector<std::vector<int>> dims {{6,5},{4,6},{5,4}};
+ DirectContraction plan;
+ ASSERT_TRUE(plan_direct_contraction("D(a,b)+=L+(c,a)*R(b,c)",dims,plan));
+ const unsigned int batch_size = 5;
+ std::vector<std::vector<std::complex<double>>> dbodies(batch_size), refs(batch_size);
+ std::vector<std::vector<std::complex<double>>> lbodies(batch_size), rbodies(batch_size);
+ std::vector<DirectContractionOperands> batch;
+ for(unsigned int i = 0; i < batch_size; ++i){
+  dbodies[i].resize(30); lbodies[i].resize(24); rbodies[i].resize(20);
+  for(auto & value: dbodies[i]) value = {distribution(generator),distribution(generator)};
+  for(auto & value: lbodies[i]) value = {distribution(generator),distribution(generator)};
+  for(auto & value: rbodies[i]) value = {distribution(generator),distribution(generator)};
+  const std::complex<double> alpha {static_cast<double>(i+1),-0.5};
+  const bool accumulative = (i % 2 == 0); //odd members overwrite their output tensors
+  //Reference: Individual direct tensor contractions:
+  refs[i] = dbodies[i];
+  ASSERT_TRUE(contract_direct(plan,talsh::COMPLEX64,refs[i].data(),lbodies[i].data(),rbodies[i].data(),alpha,accumulative));
+  batch.emplace_back(DirectContractionOperands{dbodies[i].data(),lbodies[i].data(),rbodies[i].data(),alpha,accumulative});
+ }
+ ASSERT_TRUE(contract_direct_batch(plan,talsh::COMPLEX64,batch));
+ for(unsigned int i = 0; i < batch_size; ++i){
+  EXPECT_TRUE(compare_tensor_bodies(talsh::COMPLEX64,dbodies[i].data(),refs[i].data(),dbodies[i].size()));
+ }
+ //Explicit check of the output element D(1,2) of the second (overwriting) member:
+ std::complex<double> element {0.0,0.0};
+ for(int c = 0; c < 4; ++c) element += std::conj(lbodies[1][c+4*1]) * rbodies[1][2+5*c];
+ element *= std::complex<double>{2.0,-0.5};
+ EXPECT_LT(std::abs(dbodies[1][1+6*2] - element),1e-12);
+}
+#endif
+
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,5 +1,5 @@
 /** ExaTN:: Tensor Runtime: Directed acyclic graph of tensor operations
-REVISION: 2020/06/23
+REVISION: 2020/11/19
 
 Copyright (C) 2018-2020 Tiffany Mintz, Dmitry Lyakh, Alex McCaskey
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle)
@@ -34,14 +34,26 @@ VertexIdType DirectedBoostGraph::addOperation(std::shared_ptr<TensorOperation> o
   }
   exec_state_.registerTensorWrite(*output_tensor,vid);
   unsigned int num_operands = op->getNumOperands();
-  for(unsigned int i = 1; i < num_operands; ++i){ //input tensor operands
+  for(unsigned int i = 1; i < num_operands; ++i){ //other tensor operands
     auto tensor = op->getTensorOperand(i);
     nodes = exec_state_.getTensorEpochNodes(*tensor,&epoch);
-    if(epoch < 0){ //write epoch: Read-after-Write
-      for(const auto & node_id: *nodes) addDependency(vid,node_id);
-      dependent = true;
+    if(op->operandIsMutable(i)){ //additional output tensor operand (e.g., batched tensor operations)
+      if(nodes != nullptr){
+        for(const auto & node_id: *nodes){ //Write-after-Read & Write-after-Write
+          if(node_id != vid) addDependency(vid,node_id);
+        }
+        dependent = true;
+      }
+      exec_state_.registerTensorWrite(*tensor,vid);
+    }else{ //input tensor operand
+      if(epoch < 0){ //write epoch: Read-after-Write
+        for(const auto & node_id: *nodes){
+          if(node_id != vid) addDependency(vid,node_id);
+        }
+        dependent = true;
+      }
+      exec_state_.registerTensorRead(*tensor,vid);
     }
-    exec_state_.registerTensorRead(*tensor,vid);
   }
   //if(!dependent) exec_state_.registerDependencyFreeNode(vid);
   unlock();
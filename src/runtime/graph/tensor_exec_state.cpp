@@ -1,5 +1,5 @@
 /** ExaTN:: Tensor Runtime: Tensor graph execution state
-REVISION: 2020/06/23
+REVISION: 2020/12/09
 
 Copyright (C) 2018-2020 Dmitry Lyakh, Tiffany Mintz, Alex McCaskey
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle)
@@ -96,6 +96,17 @@ bool TensorExecState::extractDependencyFreeNode(VertexIdType * node_id)
   return !empty;
 }
 
+bool TensorExecState::extractDependencyFreeNode(VertexIdType node_id)
+{
+  for(auto iter = nodes_ready_.begin(); iter != nodes_ready_.end(); ++iter){
+    if(*iter == node_id){
+      nodes_ready_.erase(iter);
+      return true;
+    }
+  }
+  return false;
+}
+
 std::list<VertexIdType> TensorExecState::getDependencyFreeNodes() const
 {
   return nodes_ready_;
@@ -137,5 +148,15 @@ VertexIdType TensorExecState::getFrontNode() const
  return front_node_;
 }
 
+std::size_t TensorExecState::registerNodeCompletion()
+{
+ return ++num_completed_;
+}
+
+std::size_t TensorExecState::getNumCompletedNodes() const
+{
+ return num_completed_;
+}
+
 } // namespace runtime
 } // namespace exatn
@@ -1,5 +1,5 @@
 /** ExaTN:: Tensor Runtime: Tensor graph execution state
-REVISION: 2020/06/23
+REVISION: 2020/12/09
 
 Copyright (C) 2018-2020 Dmitry Lyakh, Tiffany Mintz, Alex McCaskey
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle)
@@ -80,7 +80,7 @@ protected:
 
 public:
 
-  TensorExecState(): front_node_(0) {}
+  TensorExecState(): front_node_(0), num_completed_(0) {}
 
   TensorExecState(const TensorExecState &) = delete;
   TensorExecState & operator=(const TensorExecState &) = delete;
@@ -111,6 +111,9 @@ public:
   /** Extracts a dependency-free node from the list.
       Returns FALSE if no such node exists. **/
   bool extractDependencyFreeNode(VertexIdType * node_id);
+  /** Extracts a specific dependency-free node from the list.
+      Returns FALSE if the node is not in the list. **/
+  bool extractDependencyFreeNode(VertexIdType node_id);
   /** Returns the current list of dependency free nodes. **/
   std::list<VertexIdType> getDependencyFreeNodes() const;
 
@@ -132,6 +135,11 @@ public:
   /** Returns the front node id. **/
   VertexIdType getFrontNode() const;
 
+  /** Registers completion of a DAG node. Returns the total number of completed DAG nodes. **/
+  std::size_t registerNodeCompletion();
+  /** Returns the total number of completed DAG nodes. **/
+  std::size_t getNumCompletedNodes() const;
+
 private:
   /** Table for tracking the execution status of a given tensor:
       Tensor Hash --> TensorExecInfo **/
@@ -142,6 +150,8 @@ private:
   std::list<std::pair<VertexIdType,TensorOpExecHandle>> nodes_executing_;
   /** Execution front node (all previous DAG nodes have been executed). **/
   VertexIdType front_node_;
+  /** Total number of completed DAG nodes **/
+  std::size_t num_completed_;
 };
 
 } // namespace runtime
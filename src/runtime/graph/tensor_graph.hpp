@@ -1,5 +1,5 @@
 /** ExaTN:: Tensor Runtime: Directed acyclic graph (DAG) of tensor operations
-REVISION: 2020/06/23
+REVISION: 2020/12/14
 
 Copyright (C) 2018-2020 Tiffany Mintz, Dmitry Lyakh, Alex McCaskey
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle)
@@ -222,9 +222,14 @@ public:
     TensorOpNode & node_properties = getNodeProperties(vertex_id);
     node_properties.setExecuted(error_code);
     auto & op = node_properties.getOperation();
-    auto & output_tensor = *(op->getTensorOperand(0)); //`Assumes a single output tensor
+    auto & output_tensor = *(op->getTensorOperand(0));
     lock();
+    exec_state_.registerNodeCompletion();
     auto update_cnt = exec_state_.registerWriteCompletion(output_tensor);
+    const auto num_operands = op->getNumOperands();
+    for(unsigned int i = 1; i < num_operands; ++i){ //additional output tensor operands
+      if(op->operandIsMutable(i)) update_cnt = exec_state_.registerWriteCompletion(*(op->getTensorOperand(i)));
+    }
     unlock();
     return;
   }
@@ -290,6 +295,15 @@ public:
     return avail;
   }
 
+  /** Extracts a specific dependency-free node from the list.
+      Returns FALSE if the node is not in the list. **/
+  inline bool extractDependencyFreeNode(VertexIdType node_id) {
+    lock();
+    auto avail = exec_state_.extractDependencyFreeNode(node_id);
+    unlock();
+    return avail;
+  }
+
   /** Returns the current list of dependency free nodes. **/
   inline std::list<VertexIdType> getDependencyFreeNodes() {
     lock();
@@ -343,6 +357,41 @@ public:
     return (exec_state_.getFrontNode() < this->getNumNodes());
   }
 
+  /** Returns TRUE if the tensor participates in unexecuted DAG nodes. **/
+  inline bool tensorInUse(const Tensor & tensor) {
+    bool in_use = false;
+    lock();
+    int epoch;
+    const auto * epoch_nodes = exec_state_.getTensorEpochNodes(tensor,&epoch);
+    if(epoch_nodes != nullptr){
+      for(const auto & node: *epoch_nodes){
+        if(!nodeExecuted(node)){
+          in_use = true;
+          break;
+        }
+      }
+    }
+    unlock();
+    return in_use;
+  }
+
+  /** Returns TRUE if reading (write = FALSE) or writing (write = TRUE) the tensor
+      conflicts with unexecuted DAG nodes, that is, there is an outstanding write
+      on the tensor (read-after-write, write-after-write) or an outstanding read
+      in case of writing (write-after-read). **/
+  inline bool tensorHazard(const Tensor & tensor, bool write) {
+    if(getTensorUpdateCount(tensor) > 0) return true;
+    return (write && tensorInUse(tensor));
+  }
+
+  /** Returns the total number of DAG nodes executed to completion. **/
+  inline std::size_t getNumExecutedNodes() {
+    lock();
+    auto num_executed = exec_state_.getNumCompletedNodes();
+    unlock();
+    return num_executed;
+  }
+
   inline void lock() {mtx_.lock();}
   inline void unlock() {mtx_.unlock();}
 
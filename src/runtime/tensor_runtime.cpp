@@ -1,5 +1,5 @@
 /** ExaTN:: Tensor Runtime: Task-based execution layer for tensor operations
-REVISION: 2020/11/16
+REVISION: 2020/12/14
 
 Copyright (C) 2018-2020 Dmitry Lyakh, Tiffany Mintz, Alex McCaskey
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle)
@@ -8,6 +8,8 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle)
 #include "tensor_runtime.hpp"
 #include "exatn_service.hpp"
 
+#include "tensor_op_transform.hpp"
+
 #include "talshxx.hpp"
 
 #ifdef MPI_ENABLED
@@ -15,6 +17,7 @@ Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle)
 #endif
 
 #include <vector>
+#include <chrono>
 #include <iostream>
 
 #include "errors.hpp"
@@ -101,12 +104,31 @@ void TensorRuntime::executionThreadWorkflow()
                                      parameters_,process_rank_,global_process_rank_);
   //std::cout << "#DEBUG(exatn::runtime::TensorRuntime)[EXEC_THREAD]: DAG node executor set to "
             //<< node_executor_name_ << std::endl << std::flush;
+  std::vector<std::pair<std::shared_ptr<TensorGraph>,std::size_t>> running_dags; //running DAGs with their issue quotas
   while(alive_.load()){ //alive_ is set by the main thread
     while(executing_.load()){ //executing_ is set to TRUE by the main thread when new operations and syncs are submitted
-      graph_executor_->execute(*current_dag_);
+      //Collect all running DAGs:
+      running_dags.clear();
+      lockScopes();
+      for(const auto & scope: dags_){
+        if(!(scope.second.paused) || scope.second.num_hazards > 0) //paused DAGs are executed while clients wait on them
+          running_dags.emplace_back(std::make_pair(scope.second.dag,scope.second.priority * DEFAULT_ISSUE_QUOTA));
+      }
+      unlockScopes();
+      //Execute the running DAGs in a weighted round-robin manner:
+      bool unexecuted = false;
+      for(auto & running_dag: running_dags){
+        if(running_dag.first->hasUnexecutedNodes()){
+          graph_executor_->setIssueQuota((running_dags.size() > 1) ? running_dag.second : 0);
+          graph_executor_->execute(*(running_dag.first));
+          processTensorDataRequests(); //process all outstanding client requests for tensor data (synchronous)
+          if(running_dag.first->hasUnexecutedNodes()) unexecuted = true;
+          notifyTensorHazards(); //wake up clients waiting on conflicting tensor operations
+        }
+      }
       processTensorDataRequests(); //process all outstanding client requests for tensor data (synchronous)
-      if(current_dag_->hasUnexecutedNodes()){
-       executing_.store(true); //reaffirm that DAG is still executing
+      if(unexecuted){
+       executing_.store(true); //reaffirm that DAGs are still executing
       }else{
        executing_.store(false); //executing_ is set to FALSE by the execution thread
       }
@@ -132,6 +154,60 @@ void TensorRuntime::processTensorDataRequests()
 }
 
 
+bool TensorRuntime::waitOnTensorHazards(const std::vector<TensorAccess> & accesses, bool wait)
+{
+  //Find other open DAGs with conflicting unexecuted tensor operations:
+  std::vector<std::pair<std::string,std::shared_ptr<TensorGraph>>> hazard_dags;
+  lockScopes();
+  for(auto & scope: dags_){
+    if(scope.second.dag == current_dag_) continue;
+    for(const auto & access: accesses){
+      if(scope.second.dag->tensorHazard(*(access.first),access.second)){
+        if(wait) ++(scope.second.num_hazards); //a paused DAG will be executed until the hazards are resolved
+        hazard_dags.emplace_back(std::make_pair(scope.first,scope.second.dag));
+        break;
+      }
+    }
+  }
+  unlockScopes();
+  if(hazard_dags.empty()) return true;
+  if(!wait) return false;
+  //Wait until the conflicting tensor operations have been executed:
+  auto resolved = [&](){
+    for(auto & hazard_dag: hazard_dags){
+      for(const auto & access: accesses){
+        if(hazard_dag.second->tensorHazard(*(access.first),access.second)) return false;
+      }
+    }
+    return true;
+  };
+  {
+    std::unique_lock<std::mutex> lock(hazard_mtx_);
+    executing_.store(true); //activate the execution thread
+    while(!hazard_cv_.wait_for(lock,std::chrono::milliseconds(1),resolved)){
+      executing_.store(true); //reactivate the execution thread in case it was not active
+    }
+  }
+  lockScopes();
+  for(const auto & hazard_dag: hazard_dags){
+    auto iter = dags_.find(hazard_dag.first);
+    if(iter != dags_.end()) --(iter->second.num_hazards);
+  }
+  unlockScopes();
+  return true;
+}
+
+
+void TensorRuntime::notifyTensorHazards()
+{
+  { //the waiting client either has not checked the hazards yet or is already waiting
+    std::lock_guard<std::mutex> lock(hazard_mtx_);
+  }
+  hazard_cv_.notify_all();
+  return;
+}
+
+
 void TensorRuntime::resetLoggingLevel(int level)
 {
  while(!graph_executor_);
@@ -148,21 +224,23 @@ std::size_t TensorRuntime::getMemoryBufferSize() const
 }
 
 
+std::size_t TensorRuntime::getPeakMemorySize() const
+{
+ while(!graph_executor_);
+ return graph_executor_->getPeakMemorySize();
+}
+
+
 void TensorRuntime::openScope(const std::string & scope_name) {
   assert(!scope_name.empty());
-  // Complete the current scope first:
-  if(currentScopeIsSet()){
-    assert(scope_name != current_scope_);
-    closeScope();
-  }
   // Create new DAG with name given by scope name and store it in the dags map:
-  auto new_dag = dags_.emplace(std::make_pair(
-                                scope_name,
-                                exatn::getService<TensorGraph>("boost-digraph")
-                               )
-                              );
-  assert(new_dag.second); // make sure there was no other scope with the same name
-  current_dag_ = (new_dag.first)->second; //storing a shared pointer to the DAG
+  auto new_dag = exatn::getService<TensorGraph>("boost-digraph");
+  lockScopes();
+  auto res = dags_.emplace(std::make_pair(scope_name,
+                                          ScopeStatus{new_dag,1,false,exatn::Timer::timeInSecHR(),0}));
+  unlockScopes();
+  assert(res.second); // make sure there was no other scope with the same name
+  current_dag_ = new_dag; //storing a shared pointer to the DAG
   current_scope_ = scope_name; // change the name of the current scope
   scope_set_.store(true);
   return;
@@ -170,17 +248,24 @@ void TensorRuntime::openScope(const std::string & scope_name) {
 
 
 void TensorRuntime::pauseScope() {
-  graph_executor_->stopExecution(); //execution thread will pause and reset executing_ to FALSE
+  if(currentScopeIsSet()){
+    lockScopes();
+    dags_[current_scope_].paused = true; //execution thread will stop issuing tensor operations from the current DAG
+    unlockScopes();
+    graph_executor_->stopExecution();
+  }
   return;
 }
 
 
 void TensorRuntime::resumeScope(const std::string & scope_name) {
   assert(!scope_name.empty());
-  // Pause the current scope first:
-  if(currentScopeIsSet()) pauseScope();
-  while(executing_.load()){}; //wait until the execution thread stops executing previous DAG
-  current_dag_ = dags_[scope_name]; //storing a shared pointer to the DAG
+  lockScopes();
+  auto iter = dags_.find(scope_name);
+  assert(iter != dags_.end());
+  iter->second.paused = false;
+  current_dag_ = iter->second.dag; //storing a shared pointer to the DAG
+  unlockScopes();
   current_scope_ = scope_name; // change the name of the current scope
   scope_set_.store(true);
   executing_.store(true); //will trigger DAG execution by the execution thread
@@ -190,21 +275,98 @@ void TensorRuntime::resumeScope(const std::string & scope_name) {
 
 void TensorRuntime::closeScope() {
   if(currentScopeIsSet()){
+    lockScopes();
+    dags_[current_scope_].paused = false; //paused DAG must be completed
+    unlockScopes();
     sync();
-    while(executing_.load()){}; //wait until the execution thread has completed execution of the current DAG
     const std::string scope_name = current_scope_;
     scope_set_.store(false);
     current_scope_ = "";
-    current_dag_.reset();
+    current_dag_.reset(); //execution thread may still hold the completed DAG till the end of the current round
+    lockScopes();
     auto num_deleted = dags_.erase(scope_name);
+    unlockScopes();
     assert(num_deleted == 1);
   }
   return;
 }
 
 
+void TensorRuntime::setScopePriority(const std::string & scope_name, unsigned int priority) {
+  assert(priority > 0);
+  lockScopes();
+  auto iter = dags_.find(scope_name);
+  if(iter != dags_.end()) iter->second.priority = priority;
+  unlockScopes();
+  return;
+}
+
+
+bool TensorRuntime::getScopeProgress(const std::string & scope_name, ScopeProgress & progress) {
+  std::shared_ptr<TensorGraph> dag;
+  lockScopes();
+  auto iter = dags_.find(scope_name);
+  if(iter != dags_.end()){
+    dag = iter->second.dag;
+    progress.priority = iter->second.priority;
+    progress.paused = iter->second.paused;
+    progress.elapsed_time = exatn::Timer::timeInSecHR(iter->second.time_opened);
+  }
+  unlockScopes();
+  if(!dag) return false;
+  progress.num_submitted = dag->getNumNodes();
+  progress.num_executed = dag->getNumExecutedNodes();
+  progress.throughput = 0.0;
+  if(progress.elapsed_time > 0.0) progress.throughput = static_cast<double>(progress.num_executed) / progress.elapsed_time;
+  return true;
+}
+
+
 VertexIdType TensorRuntime::submit(std::shared_ptr<TensorOperation> op) {
   assert(currentScopeIsSet());
+  // Order the tensor operation after conflicting unexecuted tensor operations in other open DAGs:
+  lockScopes();
+  const bool multiple_dags = (dags_.size() > 1);
+  unlockScopes();
+  if(multiple_dags){
+    std::vector<std::shared_ptr<Tensor>> tensors;
+    std::vector<TensorAccess> accesses;
+    const auto num_operands = op->getNumOperands();
+    for(unsigned int i = 0; i < num_operands; ++i){
+      bool conj, mutated;
+      tensors.emplace_back(op->getTensorOperand(i,&conj,&mutated));
+      accesses.emplace_back(std::make_pair(tensors.back().get(),mutated));
+    }
+    auto resolved = waitOnTensorHazards(accesses); assert(resolved);
+  }
+  // Fuse a tensor transformation into the preceding idle tensor transformation of the same tensor:
+  if(op->getOpcode() == TensorOpCode::TRANSFORM){
+    const auto num_nodes = current_dag_->getNumNodes();
+    if(num_nodes > 0){
+      const VertexIdType last_node = num_nodes - 1;
+      auto & dag_node = current_dag_->getNodeProperties(last_node);
+      bool fused = false;
+      dag_node.lock(); //the execution thread claims idle DAG nodes under the same lock
+      if(!(dag_node.isDummy()) && dag_node.isIdle()){
+        auto & last_op = dag_node.getOperation();
+        if(last_op->getOpcode() == TensorOpCode::TRANSFORM){
+          std::shared_ptr<TensorOperation> fused_op = static_cast<numerics::TensorOpTransform&>(*last_op).
+                                                      fuse(static_cast<const numerics::TensorOpTransform&>(*op));
+          if(fused_op){
+            fused_op->setId(last_node);
+            last_op = fused_op;
+            fused = true;
+          }
+        }
+      }
+      dag_node.unlock();
+      if(fused){
+        op->setId(last_node);
+        executing_.store(true); //signal to the execution thread to execute the DAG
+        return last_node;
+      }
+    }
+  }
   auto node_id = current_dag_->addOperation(op);
   op->setId(node_id);
   //current_dag_->printIt(); //debug
@@ -229,6 +391,13 @@ bool TensorRuntime::sync(TensorOperation & op, bool wait) {
 bool TensorRuntime::sync(const Tensor & tensor, bool wait) {
   //if(wait) std::cout << "#DEBUG(TensorRuntime::sync)[MAIN_THREAD]: Syncing on tensor " << tensor.getName() << " ... "; //debug
   assert(currentScopeIsSet());
+  // Complete outstanding updates on the tensor in other open DAGs first:
+  lockScopes();
+  const bool multiple_dags = (dags_.size() > 1);
+  unlockScopes();
+  if(multiple_dags){
+    if(!waitOnTensorHazards(std::vector<TensorAccess>{std::make_pair(&tensor,false)},wait)) return false;
+  }
   executing_.store(true); //reactivate the execution thread to execute the DAG in case it was not active
   bool completed = (current_dag_->getTensorUpdateCount(tensor) == 0);
   while(wait && (!completed)){
@@ -242,11 +411,11 @@ bool TensorRuntime::sync(const Tensor & tensor, bool wait) {
 
 bool TensorRuntime::sync(bool wait) {
   assert(currentScopeIsSet());
-  if(current_dag_->hasUnexecutedNodes()) executing_.store(true);
-  bool still_working = executing_.load();
+  bool still_working = current_dag_->hasUnexecutedNodes();
+  if(still_working) executing_.store(true); //reactivate the execution thread to execute the DAG in case it was not active
   while(wait && still_working){
-   if(current_dag_->hasUnexecutedNodes()) executing_.store(true);
-   still_working = executing_.load();
+   still_working = current_dag_->hasUnexecutedNodes();
+   if(still_working) executing_.store(true);
   }
   return !still_working;
 }
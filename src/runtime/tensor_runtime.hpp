@@ -1,5 +1,5 @@
 /** ExaTN:: Tensor Runtime: Task-based execution layer for tensor operations
-REVISION: 2020/11/16
+REVISION: 2020/12/14
 
 Copyright (C) 2018-2020 Dmitry Lyakh, Tiffany Mintz, Alex McCaskey
 Copyright (C) 2018-2020 Oak Ridge National Laboratory (UT-Battelle)
@@ -13,15 +13,16 @@ Rationale:
      server are forwarded into the DAG associated with the TaProL scope
      in which the Client currently resides.
  (b) The DAG lifecycle:
-     openScope(name): Opens a new TAProL scope and creates its associated empty DAG.
+     openScope(name): Opens a new TAProL scope and creates its associated empty DAG,
+                      making it current. The previously current scope remains open.
                       The .submit method can then be used to append new tensor
                       operations or whole tensor networks into the current DAG.
                       The actual execution of the submitted tensor operations
                       is asynchronous and may start any time after submission.
-     pauseScope(): Completes the actual execution of all started tensor operations in the
-                   current DAG and defers the execution of the rest of the DAG for later.
-     resumeScope(name): Pauses the execution of the currently active DAG (if any) and
-                        resumes the execution of a previously paused DAG, making it current.
+     pauseScope(): Defers the issue of new tensor operations from the current DAG
+                   until resumed. Tensor operations already in flight complete upon resume.
+     resumeScope(name): Makes a previously opened scope current and resumes its execution
+                        if it was paused. The previously current scope remains running.
      closeScope(): Completes all tensor operations in the current DAG and destroys it.
  (c) submit(TensorOperation): Submits a tensor operation for (generally deferred) execution.
      sync(TensorOperation): Tests for completion of a specific tensor operation.
@@ -35,7 +36,25 @@ Rationale:
      Correspondingly, the TensorGraphExecutor contains a polymorphic TensorNodeExecutor responsible
      for the actual execution of submitted tensor operations via an associated computational backend.
      The concrete TensorNodeExecutor is specified during the construction of the TensorRuntime oject.
- (e) DEVELOPERS ONLY: The TensorGraph object (DAG) provides lock/unlock methods for concurrent update
+ (e) All open scopes that are not paused are executed concurrently by the execution
+     thread in a weighted round-robin manner: In each round, the execution thread issues up
+     to priority * DEFAULT_ISSUE_QUOTA tensor operations from each DAG, thus sharing the
+     issue rate of the node executor between the DAGs according to their priorities.
+     The memory and threads of the node executor are not partitioned between the DAGs:
+     Tensor operations issued from any DAG compete for them on a first-come basis.
+     A tensor operation submitted into a DAG is ordered after all conflicting unexecuted tensor
+     operations in other open DAGs, paused ones included: The client waits on submission until
+     no other DAG has an outstanding write on the tensors it reads or writes, or an outstanding
+     read on the tensors it writes (concurrent reads are not ordered). A paused DAG with such
+     conflicts is executed until the conflicts are resolved. Likewise, sync(tensor) waits for
+     outstanding writes on the tensor in all open DAGs. Thus independent workflows proceed
+     concurrently whereas shared tensors remain consistent.
+     The progress and throughput of each open scope can be queried via getScopeProgress.
+ (f) A tensor transformation (TRANSFORM) submitted right after another tensor transformation
+     of the same tensor which has not started executing yet is fused into the latter if both
+     tensor functors are fusable (see TensorOpTransform::fuse), thus the tensor body is traversed
+     once. Both tensor operations then share the same DAG node id (sync on either one works).
+ (g) DEVELOPERS ONLY: The TensorGraph object (DAG) provides lock/unlock methods for concurrent update
      of the DAG structure (by Client thread) and its execution state (by Execution thread).
      Additionally each node of the TensorGraph (TensorOpNode object) provides more fine grain
      locking mechanism (lock/unlock methods) for providing exclusive access to individual DAG nodes.
@@ -61,14 +80,29 @@ Rationale:
 #include <atomic>
 #include <future>
 #include <mutex>
+#include <condition_variable>
+#include <utility>
 
 namespace exatn {
 namespace runtime {
 
+/** Execution progress of an open scope (DAG) **/
+struct ScopeProgress {
+  std::size_t num_submitted; //number of tensor operations submitted into the DAG
+  std::size_t num_executed;  //number of tensor operations executed to completion
+  unsigned int priority;     //current fair-share priority of the DAG
+  bool paused;               //whether or not the execution of the DAG is paused
+  double elapsed_time;       //time since the scope was opened (seconds)
+  double throughput;         //average number of executed tensor operations per second
+};
+
+
 class TensorRuntime final {
 
 public:
 
+  static constexpr const std::size_t DEFAULT_ISSUE_QUOTA = 16; //tensor operations issued from each DAG per round (times priority)
+
 #ifdef MPI_ENABLED
   TensorRuntime(const MPICommProxy & communicator,                               //MPI communicator proxy
                 const ParamConf & parameters,                                    //runtime configuration parameters
@@ -91,6 +125,9 @@ public:
   /** Returns the Host memory buffer size in bytes provided by the executor. **/
   std::size_t getMemoryBufferSize() const;
 
+  /** Returns the peak memory usage in bytes observed by the executor (0: not tracked). **/
+  std::size_t getPeakMemorySize() const;
+
   /** Opens a new scope represented by a new execution graph (DAG). **/
   void openScope(const std::string & scope_name);
 
@@ -106,6 +143,16 @@ public:
       in the current execution graph. **/
   void closeScope();
 
+  /** Sets the fair-share priority of an open scope (execution graph), see Rationale (e).
+      The default priority is 1, higher priorities get proportionally larger issue quotas. **/
+  void setScopePriority(const std::string & scope_name,
+                        unsigned int priority);
+
+  /** Retrieves the execution progress of an open scope (execution graph).
+      Returns FALSE if the scope does not exist. **/
+  bool getScopeProgress(const std::string & scope_name,
+                        ScopeProgress & progress);
+
   /** Returns TRUE if there is the current scope is set. **/
   inline bool currentScopeIsSet() const {return scope_set_.load();}
 
@@ -133,6 +180,18 @@ public:
                             const std::vector<std::pair<DimOffset,DimExtent>> & slice_spec); //in: tensor slice specification
 
 private:
+  /** Open scope (execution graph) **/
+  struct ScopeStatus {
+    std::shared_ptr<TensorGraph> dag; //execution graph (DAG) of the scope
+    unsigned int priority;            //fair-share priority of the DAG
+    bool paused;                      //whether or not the execution of the DAG is paused
+    double time_opened;               //time stamp of the scope opening
+    unsigned int num_hazards;         //number of client waits on conflicting tensor operations in the DAG (executed even if paused)
+  };
+
+  /** Tensor access by a tensor operation **/
+  using TensorAccess = std::pair<const Tensor*,bool>; //{tensor, whether or not the tensor is written}
+
   /** Tensor data request **/
   class TensorDataReq{
   public:
@@ -158,10 +217,21 @@ private:
   void executionThreadWorkflow();
   /** Processes all outstanding tensor data requests (by execution thread). **/
   void processTensorDataRequests();
+  /** Tests whether other open DAGs (not the current one) have unexecuted tensor operations
+      conflicting with given tensor accesses, see Rationale (e). If wait = TRUE, it will block
+      until all conflicting tensor operations have been executed. Returns TRUE if there are
+      no conflicting tensor operations (anymore) [MAIN THREAD]. **/
+  bool waitOnTensorHazards(const std::vector<TensorAccess> & accesses,
+                           bool wait = true);
+  /** Wakes up client threads waiting on tensor hazards (by execution thread). **/
+  void notifyTensorHazards();
 
   inline void lockDataReqQ(){data_req_mtx_.lock();}
   inline void unlockDataReqQ(){data_req_mtx_.unlock();}
 
+  inline void lockScopes(){scopes_mtx_.lock();}
+  inline void unlockScopes(){scopes_mtx_.unlock();}
+
   /** Runtime configuration parameters **/
   ParamConf parameters_;
   /** Tensor graph (DAG) executor name **/
@@ -176,8 +246,8 @@ private:
   int global_process_rank_;
   /** Current tensor graph (DAG) executor **/
   std::shared_ptr<TensorGraphExecutor> graph_executor_;
-  /** Active execution graphs (DAGs) **/
-  std::map<std::string, std::shared_ptr<TensorGraph>> dags_;
+  /** Open scopes with their execution graphs (DAGs) **/
+  std::map<std::string, ScopeStatus> dags_;
   /** Name of the current scope (current DAG name) **/
   std::string current_scope_;
   /** Current DAG **/
@@ -196,6 +266,11 @@ private:
   std::thread exec_thread_;
   /** Data request mutex **/
   std::mutex data_req_mtx_;
+  /** Open scopes mutex **/
+  std::mutex scopes_mtx_;
+  /** Tensor hazard mutex and condition variable (signaled by the execution thread after each DAG execution round) **/
+  std::mutex hazard_mtx_;
+  std::condition_variable hazard_cv_;
 };
 
 } // namespace runtime